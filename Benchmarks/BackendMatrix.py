@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""Speed and accuracy matrix of the FDecimal backends.
+
+Runs DecimalBenchmark-DecFloat, -BinFloat and -Fixed128 (built with -DDECIMALNUMBER_BENCHMARK_MATRIX=ON), or reads
+their result files, and prints one row per benchmark: ns/op on every backend, the speedup over the reference backend
+and how far each backend's result is from the reference result.
+
+The accuracy delta is the largest relative difference over the numbers in a result (vectors have three), which the
+benchmark prints with 40 decimal places, computed with 60 significant digits. "same" means no difference at that
+precision. Results that are not numbers only report whether they match. The reference defaults to
+cpp_dec_float_50, the backend FDecimal has always used.
+
+    Benchmarks/BackendMatrix.py --build-dir=Benchmarks/Build
+    Benchmarks/BackendMatrix.py --result=DecFloat=a.json --result=BinFloat=b.json --result=Fixed128=c.json
+
+Only the Python standard library is used.
+"""
+
+import argparse
+import decimal
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+BACKENDS = ("DecFloat", "BinFloat", "Fixed128")
+
+decimal.getcontext().prec = 60
+
+
+def run_backend(executable, extra_args):
+	with tempfile.NamedTemporaryFile(suffix=".json", delete=False) as output:
+		output_path = output.name
+	try:
+		print(f"Running {executable}...", file=sys.stderr, flush=True)
+		subprocess.run([executable, f"--out={output_path}"] + extra_args, check=True, stderr=subprocess.DEVNULL)
+		with open(output_path) as file:
+			return json.load(file)
+	finally:
+		os.unlink(output_path)
+
+
+def parse_numbers(text):
+	"""@return The numbers in a result, or None when it is not a list of numbers."""
+	try:
+		numbers = [decimal.Decimal(token) for token in text.split()]
+	except decimal.InvalidOperation:
+		return None
+	return numbers if numbers and all(number.is_finite() for number in numbers) else None
+
+
+def accuracy_delta(reference, value):
+	"""
+	@return Largest relative difference between the numbers of two results, absolute where the reference is zero,
+	0 or 1 for results that are not numbers, None when either result is missing.
+	"""
+	if reference is None or value is None:
+		return None
+	reference_numbers = parse_numbers(reference)
+	value_numbers = parse_numbers(value)
+	if reference_numbers is None or value_numbers is None or len(reference_numbers) != len(value_numbers):
+		return 0.0 if reference.strip() == value.strip() else 1.0
+
+	largest = decimal.Decimal(0)
+	for expected, actual in zip(reference_numbers, value_numbers):
+		difference = abs(actual - expected)
+		largest = max(largest, difference / abs(expected) if expected != 0 else difference)
+	return float(largest)
+
+
+def build_matrix(results, reference_backend):
+	"""@return One row per benchmark, in the order of the reference run, then benchmarks it does not have."""
+	names = []
+	by_backend = {}
+	for backend, result in results.items():
+		by_backend[backend] = {benchmark["name"]: benchmark for benchmark in result["benchmarks"]}
+	for backend in [reference_backend] + [backend for backend in results if backend != reference_backend]:
+		for benchmark in results[backend]["benchmarks"]:
+			if benchmark["name"] not in names:
+				names.append(benchmark["name"])
+
+	rows = []
+	for name in names:
+		reference = by_backend[reference_backend].get(name)
+		row = {"name": name, "backends": {}}
+		for backend in results:
+			benchmark = by_backend[backend].get(name)
+			if benchmark is None:
+				continue
+			entry = {"ns_per_op": benchmark["ns_per_op"], "result": benchmark.get("result")}
+			if reference is not None:
+				entry["speedup"] = reference["ns_per_op"] / benchmark["ns_per_op"] if benchmark["ns_per_op"] > 0 else None
+				entry["accuracy_delta"] = accuracy_delta(reference.get("result"), benchmark.get("result"))
+			row["backends"][backend] = entry
+		rows.append(row)
+	return rows
+
+
+def format_delta(delta):
+	if delta is None:
+		return "-"
+	return "same" if delta == 0.0 else f"{delta:.1e}"
+
+
+def print_matrix(rows, backends, reference_backend):
+	width = max([len(row["name"]) for row in rows] + [9])
+	header = f"{'Benchmark':<{width}}"
+	for backend in backends:
+		header += f"  {backend + ' ns/op':>16}"
+		if backend != reference_backend:
+			header += f"  {'speedup':>8}  {'rel. error':>10}"
+	print(header)
+
+	for row in rows:
+		line = f"{row['name']:<{width}}"
+		for backend in backends:
+			entry = row["backends"].get(backend)
+			line += f"  {entry['ns_per_op']:>16.1f}" if entry else f"  {'-':>16}"
+			if backend != reference_backend:
+				speedup = entry.get("speedup") if entry else None
+				line += f"  {f'{speedup:.2f}x' if speedup else '-':>8}  {format_delta(entry.get('accuracy_delta') if entry else None):>10}"
+		print(line)
+
+	print()
+	print(f"Speedups and errors are relative to {reference_backend}.")
+	for backend in backends:
+		if backend == reference_backend:
+			continue
+		speedups = sorted(row["backends"][backend]["speedup"] for row in rows if row["backends"].get(backend, {}).get("speedup"))
+		inexact = sum(1 for row in rows if row["backends"].get(backend, {}).get("accuracy_delta"))
+		if speedups:
+			print(f"  {backend}: median speedup {speedups[len(speedups) // 2]:.2f}x, {inexact} of {len(speedups)} results differ from {reference_backend}")
+
+
+def main():
+	parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+	parser.add_argument("--build-dir", help="directory holding DecimalBenchmark-<Backend> executables")
+	parser.add_argument("--result", action="append", default=[], help="Backend=File.json from an earlier run, may be repeated")
+	parser.add_argument("--reference", default="DecFloat", help="backend the others are compared against (default: %(default)s)")
+	parser.add_argument("--filter", default="", help="forwarded to the benchmarks as --filter=")
+	parser.add_argument("--min-time-ms", type=float, help="forwarded to the benchmarks")
+	parser.add_argument("--repetitions", type=int, help="forwarded to the benchmarks")
+	parser.add_argument("--out", help="also write the matrix as JSON")
+	args = parser.parse_args()
+
+	if bool(args.build_dir) == bool(args.result):
+		parser.error("pass either --build-dir or at least one --result")
+
+	results = {}
+	if args.build_dir:
+		extra_args = []
+		if args.filter:
+			extra_args.append(f"--filter={args.filter}")
+		if args.min_time_ms is not None:
+			extra_args.append(f"--min-time-ms={args.min_time_ms}")
+		if args.repetitions is not None:
+			extra_args.append(f"--repetitions={args.repetitions}")
+		for backend in BACKENDS:
+			executable = os.path.join(args.build_dir, f"DecimalBenchmark-{backend}")
+			if not os.path.exists(executable):
+				print(f"error: {executable} not found, configure with -DDECIMALNUMBER_BENCHMARK_MATRIX=ON", file=sys.stderr)
+				return 2
+			try:
+				results[backend] = run_backend(executable, extra_args)
+			except (OSError, subprocess.CalledProcessError) as error:
+				print(f"error: running {executable} failed: {error}", file=sys.stderr)
+				return 2
+	else:
+		for argument in args.result:
+			backend, _, path = argument.partition("=")
+			try:
+				with open(path) as file:
+					results[backend] = json.load(file)
+			except (OSError, ValueError) as error:
+				print(f"error: {error}", file=sys.stderr)
+				return 2
+
+	if args.reference not in results:
+		print(f"error: no results for the reference backend {args.reference}", file=sys.stderr)
+		return 2
+
+	backends = [args.reference] + [backend for backend in results if backend != args.reference]
+	rows = build_matrix(results, args.reference)
+	print_matrix(rows, backends, args.reference)
+
+	if args.out:
+		with open(args.out, "w") as file:
+			json.dump({"reference": args.reference, "contexts": {backend: results[backend]["context"] for backend in backends}, "benchmarks": rows}, file, indent=1)
+			file.write("\n")
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,308 @@
+// Minimal benchmark harness for the DecimalNumber benchmarks.
+
+#include "BenchmarkHarness.h"
+#include "Decimal.h"
+#include "DecimalShadow.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+
+#include <sys/utsname.h>
+
+namespace
+{
+	thread_local uint64 GAllocations = 0;
+	thread_local uint64 GAllocatedBytes = 0;
+
+	void* CountedAlloc(std::size_t Size, std::size_t Alignment)
+	{
+		++GAllocations;
+		GAllocatedBytes += Size;
+
+		void* Result = nullptr;
+		if (Alignment <= alignof(std::max_align_t))
+		{
+			Result = std::malloc(Size != 0 ? Size : 1);
+		}
+		else if (posix_memalign(&Result, Alignment, Size != 0 ? Size : 1) != 0)
+		{
+			Result = nullptr;
+		}
+		if (Result == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		return Result;
+	}
+
+	double NowNs()
+	{
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	void WriteEscaped(FILE* File, const std::string& Value)
+	{
+		std::fputc('"', File);
+		for (const char Character : Value)
+		{
+			if (Character == '"' || Character == '\\')
+			{
+				std::fputc('\\', File);
+			}
+			std::fputc(Character, File);
+		}
+		std::fputc('"', File);
+	}
+}
+
+// Every heap allocation in the process goes through these, which is how allocations/op are measured.
+void* operator new(std::size_t Size) { return CountedAlloc(Size, alignof(std::max_align_t)); }
+void* operator new[](std::size_t Size) { return CountedAlloc(Size, alignof(std::max_align_t)); }
+void* operator new(std::size_t Size, std::align_val_t Alignment) { return CountedAlloc(Size, static_cast<std::size_t>(Alignment)); }
+void* operator new[](std::size_t Size, std::align_val_t Alignment) { return CountedAlloc(Size, static_cast<std::size_t>(Alignment)); }
+void operator delete(void* Ptr) noexcept { std::free(Ptr); }
+void operator delete[](void* Ptr) noexcept { std::free(Ptr); }
+void operator delete(void* Ptr, std::size_t) noexcept { std::free(Ptr); }
+void operator delete[](void* Ptr, std::size_t) noexcept { std::free(Ptr); }
+void operator delete(void* Ptr, std::align_val_t) noexcept { std::free(Ptr); }
+void operator delete[](void* Ptr, std::align_val_t) noexcept { std::free(Ptr); }
+void operator delete(void* Ptr, std::size_t, std::align_val_t) noexcept { std::free(Ptr); }
+void operator delete[](void* Ptr, std::size_t, std::align_val_t) noexcept { std::free(Ptr); }
+
+namespace DecimalBenchmark
+{
+	std::string FormatResult(const FDecimal& Value)
+	{
+		return TCHAR_TO_ANSI(*Value.ToString(40));
+	}
+
+	std::string FormatResult(const FDecimalVector& Value)
+	{
+		return FormatResult(Value.X) + " " + FormatResult(Value.Y) + " " + FormatResult(Value.Z);
+	}
+
+	std::string FormatResult(const FVector& Value)
+	{
+		return FormatResult(Value.X) + " " + FormatResult(Value.Y) + " " + FormatResult(Value.Z);
+	}
+
+	std::string FormatResult(const FString& Value)
+	{
+		return TCHAR_TO_ANSI(*Value);
+	}
+
+	std::string FormatResult(double Value)
+	{
+		char Buffer[32];
+		std::snprintf(Buffer, sizeof(Buffer), "%.17g", Value);
+		return Buffer;
+	}
+
+	std::string FormatResult(int64 Value)
+	{
+		return std::to_string(Value);
+	}
+
+	std::string FormatResult(bool Value)
+	{
+		return Value ? "true" : "false";
+	}
+
+	FCounters ReadCounters()
+	{
+		FCounters Result;
+		Result.Allocations = GAllocations;
+		Result.AllocatedBytes = GAllocatedBytes;
+#if DECIMALNUMBER_COUNT_COPIES
+		Result.DecimalBytesCopied = GDecimalBytesCopied.load(std::memory_order_relaxed);
+#endif
+#if DECIMALNUMBER_SHADOW_STATS
+		const FDecimalShadowCounter Shadow = GDecimalShadowCounters.Read();
+		Result.ShadowFiltered = Shadow.Filtered;
+		Result.ShadowExact = Shadow.Exact;
+#endif
+		return Result;
+	}
+
+	bool FOptions::Parse(int Argc, char** Argv)
+	{
+		for (int Index = 1; Index < Argc; ++Index)
+		{
+			const std::string Argument = Argv[Index];
+			const auto Value = [&Argument](const char* Prefix) { return Argument.substr(std::strlen(Prefix)); };
+
+			if (Argument.rfind("--filter=", 0) == 0)
+			{
+				Filter = Value("--filter=");
+			}
+			else if (Argument.rfind("--out=", 0) == 0)
+			{
+				OutputPath = Value("--out=");
+			}
+			else if (Argument.rfind("--repetitions=", 0) == 0)
+			{
+				Repetitions = std::max(1, std::atoi(Value("--repetitions=").c_str()));
+			}
+			else if (Argument.rfind("--min-time-ms=", 0) == 0)
+			{
+				MinTimeMs = std::max(0.0, std::atof(Value("--min-time-ms=").c_str()));
+			}
+			else if (Argument == "--list")
+			{
+				bList = true;
+			}
+			else
+			{
+				std::fprintf(stderr, "Unknown argument '%s'\n", Argument.c_str());
+				std::fprintf(stderr, "Usage: %s [--filter=Text] [--out=File.json] [--repetitions=N] [--min-time-ms=Ms] [--list]\n", Argv[0]);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FResult FRegistry::RunCase(const FCase& Case, const FOptions& Options) const
+	{
+		FResult Result;
+		Result.Group = Case.Group;
+		Result.Name = Case.Name;
+		Result.Value = Case.Describe();
+
+		// Grow the batch until one batch takes at least the minimum time.
+		int64 Iterations = 1;
+		for (;;)
+		{
+			const double Start = NowNs();
+			Case.Run(Iterations);
+			const double Elapsed = NowNs() - Start;
+			if (Elapsed >= Options.MinTimeMs * 1.e6 || Iterations >= (int64(1) << 40))
+			{
+				break;
+			}
+			const double Scale = Elapsed > 0.0 ? (Options.MinTimeMs * 1.e6 * 1.2) / Elapsed : 10.0;
+			Iterations = std::max(Iterations + 1, static_cast<int64>(static_cast<double>(Iterations) * std::min(Scale, 10.0)));
+		}
+		Result.Iterations = Iterations;
+
+		FCounters Total;
+		for (int32 Repetition = 0; Repetition < Options.Repetitions; ++Repetition)
+		{
+			const FCounters Before = ReadCounters();
+			const double Start = NowNs();
+			Case.Run(Iterations);
+			const double Elapsed = NowNs() - Start;
+			const FCounters After = ReadCounters();
+
+			Result.Samples.push_back(Elapsed / static_cast<double>(Iterations));
+			Total.Allocations += After.Allocations - Before.Allocations;
+			Total.AllocatedBytes += After.AllocatedBytes - Before.AllocatedBytes;
+			Total.DecimalBytesCopied += After.DecimalBytesCopied - Before.DecimalBytesCopied;
+			Total.ShadowFiltered += After.ShadowFiltered - Before.ShadowFiltered;
+			Total.ShadowExact += After.ShadowExact - Before.ShadowExact;
+		}
+
+		std::vector<double> Sorted = Result.Samples;
+		std::sort(Sorted.begin(), Sorted.end());
+		const size_t Middle = Sorted.size() / 2;
+		Result.MedianNs = (Sorted.size() % 2 != 0) ? Sorted[Middle] : 0.5 * (Sorted[Middle - 1] + Sorted[Middle]);
+		Result.MinNs = Sorted.front();
+		Result.MaxNs = Sorted.back();
+
+		const double TotalOps = static_cast<double>(Iterations) * Options.Repetitions;
+		Result.AllocationsPerOp = static_cast<double>(Total.Allocations) / TotalOps;
+		Result.AllocatedBytesPerOp = static_cast<double>(Total.AllocatedBytes) / TotalOps;
+		Result.BytesCopiedPerOp = static_cast<double>(Total.DecimalBytesCopied) / TotalOps;
+		Result.ShadowExactPerOp = static_cast<double>(Total.ShadowExact) / TotalOps;
+		if (Total.ShadowFiltered + Total.ShadowExact > 0)
+		{
+			Result.ShadowHitRate = static_cast<double>(Total.ShadowFiltered) / static_cast<double>(Total.ShadowFiltered + Total.ShadowExact);
+		}
+		return Result;
+	}
+
+	int32 FRegistry::RunAll(const FOptions& Options, const char* SuiteName) const
+	{
+		if (Options.bList)
+		{
+			for (const FCase& Case : Cases)
+			{
+				std::printf("%s/%s\n", Case.Group.c_str(), Case.Name.c_str());
+			}
+			return 0;
+		}
+
+		std::vector<FResult> Results;
+		for (const FCase& Case : Cases)
+		{
+			const std::string FullName = Case.Group + "/" + Case.Name;
+			if (!Options.Filter.empty() && FullName.find(Options.Filter) == std::string::npos)
+			{
+				continue;
+			}
+			Results.push_back(RunCase(Case, Options));
+			std::fprintf(stderr, "%-48s %12.1f ns/op %8.2f allocs/op %10.1f bytes copied/op\n",
+				FullName.c_str(), Results.back().MedianNs, Results.back().AllocationsPerOp, Results.back().BytesCopiedPerOp);
+		}
+
+		FILE* File = Options.OutputPath.empty() ? stdout : std::fopen(Options.OutputPath.c_str(), "w");
+		if (File == nullptr)
+		{
+			std::fprintf(stderr, "Cannot open '%s' for writing\n", Options.OutputPath.c_str());
+			return 1;
+		}
+
+		utsname System;
+		uname(&System);
+
+		std::fprintf(File, "{\n  \"suite\": ");
+		WriteEscaped(File, SuiteName);
+		std::fprintf(File, ",\n  \"context\": {\n");
+		std::fprintf(File, "    \"system\": ");
+		WriteEscaped(File, std::string(System.sysname) + " " + System.release + " " + System.machine);
+		std::fprintf(File, ",\n    \"compiler\": ");
+		WriteEscaped(File, __VERSION__);
+		std::fprintf(File, ",\n    \"backend\": ");
+		WriteEscaped(File, TCHAR_TO_ANSI(DECIMALNUMBER_BACKEND_NAME));
+		std::fprintf(File, ",\n    \"hardware_threads\": %u,\n", std::thread::hardware_concurrency());
+		std::fprintf(File, "    \"repetitions\": %d,\n    \"min_time_ms\": %.3f,\n", Options.Repetitions, Options.MinTimeMs);
+		std::fprintf(File, "    \"counts_decimal_copies\": %s\n  },\n", DECIMALNUMBER_COUNT_COPIES ? "true" : "false");
+		std::fprintf(File, "  \"benchmarks\": [");
+		for (size_t Index = 0; Index < Results.size(); ++Index)
+		{
+			const FResult& Result = Results[Index];
+			std::fprintf(File, "%s\n    {\"name\": ", Index == 0 ? "" : ",");
+			WriteEscaped(File, Result.Group + "/" + Result.Name);
+			std::fprintf(File, ", \"group\": ");
+			WriteEscaped(File, Result.Group);
+			std::fprintf(File, ", \"result\": ");
+			WriteEscaped(File, Result.Value);
+			std::fprintf(File, ", \"iterations\": %lld, \"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, \"max_ns_per_op\": %.3f, ",
+				static_cast<long long>(Result.Iterations), Result.MedianNs, Result.MinNs, Result.MaxNs);
+			std::fprintf(File, "\"allocations_per_op\": %.4f, \"allocated_bytes_per_op\": %.2f, \"bytes_copied_per_op\": %.2f, \"shadow_exact_per_op\": %.4f, ",
+				Result.AllocationsPerOp, Result.AllocatedBytesPerOp, Result.BytesCopiedPerOp, Result.ShadowExactPerOp);
+			if (Result.ShadowHitRate >= 0.0)
+			{
+				std::fprintf(File, "\"shadow_hit_rate\": %.6f, ", Result.ShadowHitRate);
+			}
+			std::fprintf(File, "\"samples_ns_per_op\": [");
+			for (size_t Sample = 0; Sample < Result.Samples.size(); ++Sample)
+			{
+				std::fprintf(File, "%s%.3f", Sample == 0 ? "" : ", ", Result.Samples[Sample]);
+			}
+			std::fprintf(File, "]}");
+		}
+		std::fprintf(File, "\n  ]\n}\n");
+
+		if (File != stdout)
+		{
+			std::fclose(File);
+		}
+		return 0;
+	}
+}
@@ -0,0 +1,154 @@
+// Minimal benchmark harness for the DecimalNumber benchmarks.
+//
+// Every case is timed in batches that run for at least the minimum time, repeated a number of times, and reported
+// as JSON with the median and spread of ns/op plus heap allocations, allocated bytes and decimal bytes copied per op,
+// and for cases that compare shadowed decimals the share of queries settled from the shadows.
+// The value every case computes is recorded too, so runs on different backends can be compared for accuracy.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DecimalVector.h"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace DecimalBenchmark
+{
+	/** Per-op resource counters, sampled around every timed batch. */
+	struct FCounters
+	{
+		uint64 Allocations = 0;
+		uint64 AllocatedBytes = 0;
+		uint64 DecimalBytesCopied = 0;
+		uint64 ShadowFiltered = 0;
+		uint64 ShadowExact = 0;
+	};
+
+	/** @return Counters accumulated so far on the calling thread. */
+	FCounters ReadCounters();
+
+	/** Keep the compiler from discarding a value whose computation is being measured. */
+	template <typename T>
+	FORCEINLINE void DoNotOptimize(const T& Value)
+	{
+		asm volatile("" : : "r"(&Value) : "memory");
+	}
+
+	/** @return Value as text with every digit the backend holds, for the "result" field of the report. */
+	std::string FormatResult(const FDecimal& Value);
+	std::string FormatResult(const FDecimalVector& Value);
+	std::string FormatResult(const FVector& Value);
+	std::string FormatResult(const FString& Value);
+	std::string FormatResult(double Value);
+	std::string FormatResult(int64 Value);
+	std::string FormatResult(bool Value);
+
+	/** One registered benchmark: runs the measured operation Iterations times. */
+	struct FCase
+	{
+		std::string Group;
+		std::string Name;
+		std::function<void(int64 Iterations)> Run;
+		std::function<std::string()> Describe;
+	};
+
+	/** Result of one case, ready to be written out. */
+	struct FResult
+	{
+		std::string Group;
+		std::string Name;
+		int64 Iterations = 0;
+		std::string Value;
+		std::vector<double> Samples;
+		double MedianNs = 0.0;
+		double MinNs = 0.0;
+		double MaxNs = 0.0;
+		double AllocationsPerOp = 0.0;
+		double AllocatedBytesPerOp = 0.0;
+		double BytesCopiedPerOp = 0.0;
+
+		/** Shadow queries that fell back to exact math, and the share settled from the shadows, negative without queries. */
+		double ShadowExactPerOp = 0.0;
+		double ShadowHitRate = -1.0;
+	};
+
+	/** Command line options shared by every benchmark program. */
+	struct FOptions
+	{
+		/** Only cases whose "Group/Name" contains this string run. */
+		std::string Filter;
+
+		/** Where the JSON goes, stdout when empty. */
+		std::string OutputPath;
+
+		/** Timed samples per case. */
+		int32 Repetitions = 5;
+
+		/** Minimum wall time of one sample, in milliseconds. */
+		double MinTimeMs = 50.0;
+
+		/** Print the registered cases and exit. */
+		bool bList = false;
+
+		/**
+		 * Parse --filter=, --out=, --repetitions=, --min-time-ms= and --list.
+		 *
+		 * @return false and print usage on an unknown argument.
+		 */
+		bool Parse(int Argc, char** Argv);
+	};
+
+	/** Collects cases, runs them and writes the JSON report. */
+	class FRegistry
+	{
+	public:
+		/**
+		 * Register a case. Op is called once per iteration and should return the value it computed, if any,
+		 * so that it is not optimized away.
+		 */
+		template <typename OpType>
+		void Add(const std::string& Group, const std::string& Name, OpType Op)
+		{
+			Cases.push_back({ Group, Name, [Op](int64 Iterations) mutable
+			{
+				for (int64 Iteration = 0; Iteration < Iterations; ++Iteration)
+				{
+					if constexpr (std::is_void_v<decltype(Op())>)
+					{
+						Op();
+					}
+					else
+					{
+						DoNotOptimize(Op());
+					}
+				}
+			}, [Op]() mutable -> std::string
+			{
+				if constexpr (std::is_void_v<decltype(Op())>)
+				{
+					Op();
+					return std::string();
+				}
+				else if constexpr (std::is_integral_v<decltype(Op())> && !std::is_same_v<decltype(Op()), bool>)
+				{
+					return FormatResult(static_cast<int64>(Op()));
+				}
+				else
+				{
+					return FormatResult(Op());
+				}
+			}});
+		}
+
+		/** Run every case selected by the options and write the report. @return Process exit code. */
+		int32 RunAll(const FOptions& Options, const char* SuiteName) const;
+
+	private:
+		FResult RunCase(const FCase& Case, const FOptions& Options) const;
+
+		std::vector<FCase> Cases;
+	};
+}
@@ -0,0 +1,247 @@
+#!/usr/bin/env python3
+"""Performance regression gate for the DecimalNumber benchmarks.
+
+Runs the benchmark executable several times (or reads existing result files), pools the timing samples of every case
+and compares them against a baseline JSON with a bootstrap confidence interval on the ratio of medians.
+
+A case regresses when the whole confidence interval lies above 1 + threshold, so noise alone does not fail the gate,
+or when its allocations/op or FDecimal bytes copied/op grow. Those two counters are deterministic and are compared
+exactly.
+
+Only the Python standard library is used, so it runs on any Linux box:
+
+    Benchmarks/CompareBenchmarks.py --benchmark=Benchmarks/Build/DecimalBenchmark
+    Benchmarks/CompareBenchmarks.py --current=a.json --current=b.json
+    Benchmarks/CompareBenchmarks.py --benchmark=Benchmarks/Build/DecimalBenchmark --update-baseline
+
+The exit code is 0 when nothing regressed, 1 on a regression and 2 on a usage or input error.
+"""
+
+import argparse
+import json
+import os
+import random
+import statistics
+import subprocess
+import sys
+import tempfile
+
+DEFAULT_BASELINE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "Baselines", "Linux-x86_64.json")
+
+# Counter metrics compared exactly, with the tolerance absorbing the rounding of the JSON output.
+COUNTER_METRICS = (("allocations_per_op", "allocs/op", 0.01), ("bytes_copied_per_op", "bytes copied/op", 0.5), ("shadow_exact_per_op", "exact fallbacks/op", 0.01))
+
+
+def load_results(path):
+	with open(path) as file:
+		return json.load(file)
+
+
+def run_benchmark(executable, runs, extra_args):
+	"""Run the benchmark executable runs times. @return The parsed result of every run."""
+	results = []
+	for run in range(runs):
+		with tempfile.NamedTemporaryFile(suffix=".json", delete=False) as output:
+			output_path = output.name
+		try:
+			print(f"Benchmark run {run + 1}/{runs}...", file=sys.stderr, flush=True)
+			subprocess.run([executable, f"--out={output_path}"] + extra_args, check=True, stderr=subprocess.DEVNULL)
+			results.append(load_results(output_path))
+		finally:
+			os.unlink(output_path)
+	return results
+
+
+def merge_results(results):
+	"""Pool the samples of several runs into one result with the same layout the benchmark writes."""
+	merged = {"suite": results[0]["suite"], "context": dict(results[0]["context"]), "benchmarks": []}
+	merged["context"]["runs"] = len(results)
+	by_name = {}
+	for result in results:
+		for benchmark in result["benchmarks"]:
+			entry = by_name.get(benchmark["name"])
+			if entry is None:
+				entry = dict(benchmark)
+				entry["samples_ns_per_op"] = []
+				entry["counters"] = {metric: [] for metric, _, _ in COUNTER_METRICS}
+				by_name[benchmark["name"]] = entry
+				merged["benchmarks"].append(entry)
+			entry["samples_ns_per_op"].extend(benchmark["samples_ns_per_op"])
+			for metric, _, _ in COUNTER_METRICS:
+				entry["counters"][metric].append(benchmark[metric])
+
+	for entry in merged["benchmarks"]:
+		samples = entry["samples_ns_per_op"]
+		entry["ns_per_op"] = statistics.median(samples)
+		entry["min_ns_per_op"] = min(samples)
+		entry["max_ns_per_op"] = max(samples)
+		for metric, _, _ in COUNTER_METRICS:
+			entry[metric] = statistics.median(entry["counters"][metric])
+		del entry["counters"]
+	return merged
+
+
+def bootstrap_ratio_interval(baseline, current, confidence, resamples, rng):
+	"""
+	Confidence interval of median(current) / median(baseline), by resampling both sample sets with replacement.
+
+	@return (low, high) bounds of the ratio.
+	"""
+	ratios = []
+	for _ in range(resamples):
+		base = statistics.median(rng.choices(baseline, k=len(baseline)))
+		cur = statistics.median(rng.choices(current, k=len(current)))
+		ratios.append(cur / base if base > 0.0 else float("inf"))
+	ratios.sort()
+	tail = (1.0 - confidence) / 2.0
+	low = ratios[int(tail * (resamples - 1))]
+	high = ratios[int((1.0 - tail) * (resamples - 1))]
+	return low, high
+
+
+def compare(baseline, current, args):
+	"""@return (rows, regressed) where every row describes one case for the report."""
+	rng = random.Random(args.seed)
+	baseline_by_name = {benchmark["name"]: benchmark for benchmark in baseline["benchmarks"]}
+	current_names = set()
+	rows = []
+	regressed = False
+
+	for benchmark in current["benchmarks"]:
+		name = benchmark["name"]
+		current_names.add(name)
+		reference = baseline_by_name.get(name)
+		if reference is None:
+			rows.append({"name": name, "status": "NEW", "current": benchmark["ns_per_op"], "notes": []})
+			continue
+
+		base_samples = reference["samples_ns_per_op"]
+		cur_samples = benchmark["samples_ns_per_op"]
+		ratio = statistics.median(cur_samples) / statistics.median(base_samples)
+		low, high = bootstrap_ratio_interval(base_samples, cur_samples, args.confidence, args.resamples, rng)
+
+		status = "ok"
+		notes = []
+		if low > 1.0 + args.threshold:
+			status = "REGRESSED"
+			notes.append(f"time +{(low - 1.0) * 100.0:.1f}% at least")
+		elif high < 1.0 - args.threshold:
+			status = "improved"
+
+		for metric, label, tolerance in COUNTER_METRICS:
+			before = reference.get(metric, 0.0)
+			after = benchmark.get(metric, 0.0)
+			if after > before + tolerance:
+				status = "REGRESSED"
+				notes.append(f"{label} {before:g} -> {after:g}")
+
+		regressed |= status == "REGRESSED"
+		rows.append({
+			"name": name,
+			"status": status,
+			"baseline": reference["ns_per_op"],
+			"current": benchmark["ns_per_op"],
+			"ratio": ratio,
+			"low": low,
+			"high": high,
+			"notes": notes,
+		})
+
+	for name in baseline_by_name:
+		if name not in current_names and (not args.filter or args.filter in name):
+			rows.append({"name": name, "status": "MISSING", "baseline": baseline_by_name[name]["ns_per_op"], "notes": []})
+
+	return rows, regressed
+
+
+def print_report(rows, baseline, current, args):
+	confidence = int(round(args.confidence * 100.0))
+	for key in ("system", "compiler"):
+		if baseline["context"].get(key) != current["context"].get(key):
+			print(f"warning: baseline {key} '{baseline['context'].get(key)}' differs from current '{current['context'].get(key)}'")
+
+	width = max([len(row["name"]) for row in rows] + [9])
+	print(f"{'Benchmark':<{width}}  {'base ns/op':>12}  {'cur ns/op':>12}  {'change':>8}  {f'{confidence}% CI':>17}  status")
+	for row in rows:
+		if "ratio" in row:
+			change = f"{(row['ratio'] - 1.0) * 100.0:+.1f}%"
+			interval = f"[{(row['low'] - 1.0) * 100.0:+.1f}, {(row['high'] - 1.0) * 100.0:+.1f}]%"
+		else:
+			change = interval = "-"
+		base = f"{row['baseline']:.1f}" if "baseline" in row else "-"
+		cur = f"{row['current']:.1f}" if "current" in row else "-"
+		line = f"{row['name']:<{width}}  {base:>12}  {cur:>12}  {change:>8}  {interval:>17}  {row['status']}"
+		if row["notes"]:
+			line += "  (" + ", ".join(row["notes"]) + ")"
+		print(line)
+
+	regressions = [row for row in rows if row["status"] == "REGRESSED"]
+	improvements = [row for row in rows if row["status"] == "improved"]
+	print()
+	print(f"{len(rows)} benchmarks, {len(regressions)} regressed, {len(improvements)} improved, threshold {args.threshold * 100.0:.0f}%")
+	for row in regressions:
+		print(f"  REGRESSED {row['name']}: " + ", ".join(row["notes"]))
+
+
+def main():
+	parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+	parser.add_argument("--baseline", default=DEFAULT_BASELINE, help="baseline JSON (default: %(default)s)")
+	parser.add_argument("--benchmark", help="benchmark executable to run")
+	parser.add_argument("--current", action="append", default=[], help="existing result JSON, may be repeated")
+	parser.add_argument("--runs", type=int, default=3, help="benchmark runs to pool (default: %(default)s)")
+	parser.add_argument("--filter", default="", help="forwarded to the benchmark as --filter=")
+	parser.add_argument("--min-time-ms", type=float, help="forwarded to the benchmark")
+	parser.add_argument("--repetitions", type=int, help="forwarded to the benchmark")
+	parser.add_argument("--threshold", type=float, default=0.10, help="relative slowdown that fails the gate (default: %(default)s)")
+	parser.add_argument("--confidence", type=float, default=0.95, help="confidence level of the interval (default: %(default)s)")
+	parser.add_argument("--resamples", type=int, default=2000, help="bootstrap resamples (default: %(default)s)")
+	parser.add_argument("--seed", type=int, default=1, help="bootstrap seed, fixed so reports are reproducible")
+	parser.add_argument("--update-baseline", action="store_true", help="write the pooled results to the baseline and exit")
+	args = parser.parse_args()
+
+	if bool(args.benchmark) == bool(args.current):
+		parser.error("pass either --benchmark or at least one --current")
+
+	if args.benchmark:
+		extra_args = []
+		if args.filter:
+			extra_args.append(f"--filter={args.filter}")
+		if args.min_time_ms is not None:
+			extra_args.append(f"--min-time-ms={args.min_time_ms}")
+		if args.repetitions is not None:
+			extra_args.append(f"--repetitions={args.repetitions}")
+		try:
+			results = run_benchmark(args.benchmark, max(1, args.runs), extra_args)
+		except (OSError, subprocess.CalledProcessError) as error:
+			print(f"error: running {args.benchmark} failed: {error}", file=sys.stderr)
+			return 2
+	else:
+		try:
+			results = [load_results(path) for path in args.current]
+		except (OSError, ValueError) as error:
+			print(f"error: {error}", file=sys.stderr)
+			return 2
+
+	current = merge_results(results)
+
+	if args.update_baseline:
+		os.makedirs(os.path.dirname(os.path.abspath(args.baseline)), exist_ok=True)
+		with open(args.baseline, "w") as file:
+			json.dump(current, file, indent=1)
+			file.write("\n")
+		print(f"Wrote {len(current['benchmarks'])} benchmarks to {args.baseline}")
+		return 0
+
+	try:
+		baseline = load_results(args.baseline)
+	except (OSError, ValueError) as error:
+		print(f"error: cannot read baseline: {error}", file=sys.stderr)
+		return 2
+
+	rows, regressed = compare(baseline, current, args)
+	print_report(rows, baseline, current, args)
+	return 1 if regressed else 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())
@@ -0,0 +1,956 @@
+// Benchmarks for FDecimal, FDecimalMath and FDecimalVector.
+//
+// Usage: DecimalBenchmark [--filter=Text] [--out=File.json] [--repetitions=N] [--min-time-ms=Ms] [--list]
+
+#include "BenchmarkHarness.h"
+#include "Decimal.h"
+#include "DecimalBVH.h"
+#include "DecimalBarnesHut.h"
+#include "DecimalBox.h"
+#include "DecimalIntegrator.h"
+#include "DecimalLiteral.h"
+#include "DecimalKMeans.h"
+#include "DecimalMath.h"
+#include "DecimalPredicates.h"
+#include "DecimalRebase.h"
+#include "DecimalSectorVector.h"
+#include "DecimalShadow.h"
+#include "DecimalSpatialHash.h"
+#include "DecimalVector.h"
+#include "DecimalVectorArray.h"
+#include <algorithm>
+#include <memory>
+
+using namespace DecimalBenchmark;
+
+namespace
+{
+	void RegisterConstruction(FRegistry& Registry)
+	{
+		const FDecimal Source(TEXT("12345.6789"));
+		const FString String(TEXT("12345.6789"));
+
+		int32 Int32Value = -123456;
+		uint32 UInt32Value = 123456u;
+		int64 Int64Value = -1234567890123ll;
+		uint64 UInt64Value = 1234567890123ull;
+		float FloatValue = 1234.5678f;
+		double DoubleValue = 12345.6789;
+
+		Registry.Add("Construct", "Default", [] { return FDecimal(); });
+		Registry.Add("Construct", "Copy", [Source] { return FDecimal(Source); });
+		Registry.Add("Construct", "FString", [String] { return FDecimal(String); });
+		Registry.Add("Construct", "Literal", [] { return FDecimal(12'345.6789_dec); });
+		Registry.Add("Construct", "int32", [Int32Value] { return FDecimal(Int32Value); });
+		Registry.Add("Construct", "uint32", [UInt32Value] { return FDecimal(UInt32Value); });
+		Registry.Add("Construct", "int64", [Int64Value] { return FDecimal(Int64Value); });
+		Registry.Add("Construct", "uint64", [UInt64Value] { return FDecimal(UInt64Value); });
+		Registry.Add("Construct", "float", [FloatValue] { return FDecimal(FloatValue); });
+		Registry.Add("Construct", "double", [DoubleValue] { return FDecimal(DoubleValue); });
+
+		FDecimal Target;
+		Registry.Add("Assign", "FDecimal", [Target, Source]() mutable { Target = Source; return Target.IsZero(); });
+		Registry.Add("Assign", "FString", [Target, String]() mutable { Target = String; return Target.IsZero(); });
+		Registry.Add("Assign", "int32", [Target, Int32Value]() mutable { Target = Int32Value; return Target.IsZero(); });
+		Registry.Add("Assign", "int64", [Target, Int64Value]() mutable { Target = Int64Value; return Target.IsZero(); });
+		Registry.Add("Assign", "float", [Target, FloatValue]() mutable { Target = FloatValue; return Target.IsZero(); });
+		Registry.Add("Assign", "double", [Target, DoubleValue]() mutable { Target = DoubleValue; return Target.IsZero(); });
+	}
+
+	template <typename OperandType>
+	void RegisterArithmetic(FRegistry& Registry, const char* TypeName, const FDecimal& A, OperandType B)
+	{
+		const auto Name = [TypeName](const char* Operator) { return std::string(Operator) + " " + TypeName; };
+
+		Registry.Add("Operator", Name("+"), [A, B] { return A + B; });
+		Registry.Add("Operator", Name("-"), [A, B] { return A - B; });
+		Registry.Add("Operator", Name("*"), [A, B] { return A * B; });
+		Registry.Add("Operator", Name("/"), [A, B] { return A / B; });
+		Registry.Add("Operator", Name("+="), [A, B]() mutable { FDecimal Value(A); Value += B; return Value; });
+		Registry.Add("Operator", Name("-="), [A, B]() mutable { FDecimal Value(A); Value -= B; return Value; });
+		Registry.Add("Operator", Name("*="), [A, B]() mutable { FDecimal Value(A); Value *= B; return Value; });
+		Registry.Add("Operator", Name("/="), [A, B]() mutable { FDecimal Value(A); Value /= B; return Value; });
+	}
+
+	void RegisterOperators(FRegistry& Registry)
+	{
+		const FDecimal A(TEXT("98765.4321"));
+		const FDecimal B(TEXT("-1234.5678"));
+
+		RegisterArithmetic(Registry, "FDecimal", A, B);
+		RegisterArithmetic(Registry, "FString", A, FString(TEXT("-1234.5678")));
+		RegisterArithmetic(Registry, "int32", A, int32(-1234));
+		RegisterArithmetic(Registry, "uint32", A, uint32(1234));
+		RegisterArithmetic(Registry, "int64", A, int64(-1234));
+		RegisterArithmetic(Registry, "uint64", A, uint64(1234));
+		RegisterArithmetic(Registry, "float", A, -1234.5678f);
+		RegisterArithmetic(Registry, "double", A, -1234.5678);
+
+		const FDecimalDivisor Divisor(B);
+		Registry.Add("Operator", "/ FDecimalDivisor", [A, Divisor] { return A / Divisor; });
+		Registry.Add("Operator", "unary -", [A] { return -A; });
+		Registry.Add("Compare", "==", [A, B] { return A == B; });
+		Registry.Add("Compare", "!=", [A, B] { return A != B; });
+		Registry.Add("Compare", "<", [A, B] { return A < B; });
+		Registry.Add("Compare", "<=", [A, B] { return A <= B; });
+		Registry.Add("Compare", ">", [A, B] { return A > B; });
+		Registry.Add("Compare", ">=", [A, B] { return A >= B; });
+		Registry.Add("Compare", "Compare", [A, B] { return A.Compare(B); });
+		Registry.Add("Compare", "CompareAbs", [A, B] { return A.CompareAbs(B); });
+	}
+
+	void RegisterConversions(FRegistry& Registry)
+	{
+		const FDecimal Value(TEXT("98765.4321"));
+		const FString String(TEXT("98765.4321"));
+
+		Registry.Add("Convert", "ToString", [Value] { return Value.ToString(); });
+		Registry.Add("Convert", "ToString(20)", [Value] { return Value.ToString(20); });
+		Registry.Add("Convert", "FromString", [String]
+		{
+			FDecimal Result;
+			FDecimal::FromString(String, Result);
+			return Result;
+		});
+		Registry.Add("Convert", "ToDouble", [Value] { return Value.ToDouble(); });
+	}
+
+	void RegisterMath(FRegistry& Registry)
+	{
+		const FDecimal Positive(TEXT("2.718281828459045"));
+		const FDecimal Unit(TEXT("0.6180339887"));
+		const FDecimal Negative(TEXT("-123.456"));
+		const FDecimal Degrees(TEXT("725.5"));
+
+		Registry.Add("Math", "InvSqrt", [Positive] { return FDecimalMath::InvSqrt(Positive); });
+		Registry.Add("Math", "Abs", [Negative] { return FDecimalMath::Abs(Negative); });
+		Registry.Add("Math", "Floor", [Negative] { return FDecimalMath::Floor(Negative); });
+		Registry.Add("Math", "Ceil", [Negative] { return FDecimalMath::Ceil(Negative); });
+		Registry.Add("Math", "Sqrt", [Positive] { return FDecimalMath::Sqrt(Positive); });
+		Registry.Add("Math", "Square", [Positive] { return FDecimalMath::Square(Positive); });
+		Registry.Add("Math", "Sin", [Positive] { return FDecimalMath::Sin(Positive); });
+		Registry.Add("Math", "Cos", [Positive] { return FDecimalMath::Cos(Positive); });
+		Registry.Add("Math", "Acos", [Unit] { return FDecimalMath::Acos(Unit); });
+		Registry.Add("Math", "Atan", [Positive] { return FDecimalMath::Atan(Positive); });
+		Registry.Add("Math", "Atan2", [Positive, Negative] { return FDecimalMath::Atan2(Negative, Positive); });
+		Registry.Add("Math", "Power int32", [Positive] { return FDecimalMath::Power(Positive, 3); });
+		Registry.Add("Math", "Power FDecimal", [Positive, Unit] { return FDecimalMath::Power(Positive, Unit); });
+		Registry.Add("Math", "SindCos", [Positive]
+		{
+			FDecimal Sin, Cos;
+			FDecimalMath::SindCos(Sin, Cos, Positive);
+			return Sin + Cos;
+		});
+		Registry.Add("Math", "UnwindDegrees", [Degrees] { return FDecimalMath::UnwindDegrees(Degrees); });
+		Registry.Add("Math", "IsFinite", [Positive] { return FDecimalMath::IsFinite(Positive); });
+		Registry.Add("Math", "IsNearlyZero", [Unit] { return FDecimalMath::IsNearlyZero(Unit); });
+		Registry.Add("Math", "DegreesToRadians", [Degrees] { return FDecimalMath::DegreesToRadians(Degrees); });
+		Registry.Add("Math", "RadiansToDegrees", [Positive] { return FDecimalMath::RadiansToDegrees(Positive); });
+		Registry.Add("Math", "GridSnap", [Negative, Unit] { return FDecimalMath::GridSnap(Negative, Unit); });
+		Registry.Add("Math", "Min", [Positive, Negative] { return FDecimalMath::Min(Positive, Negative); });
+		Registry.Add("Math", "Max", [Positive, Negative] { return FDecimalMath::Max(Positive, Negative); });
+		Registry.Add("Math", "Min3", [Positive, Negative, Unit] { return FDecimalMath::Min3(Positive, Negative, Unit); });
+		Registry.Add("Math", "Max3", [Positive, Negative, Unit] { return FDecimalMath::Max3(Positive, Negative, Unit); });
+		Registry.Add("Math", "Clamp", [Positive, Negative, Unit] { return FDecimalMath::Clamp(Positive, Negative, Unit); });
+	}
+
+	void RegisterVector(FRegistry& Registry)
+	{
+		const FDecimalVector A(FDecimal(TEXT("1234.5")), FDecimal(TEXT("-678.25")), FDecimal(TEXT("91.125")));
+		const FDecimalVector B(FDecimal(TEXT("-3.5")), FDecimal(TEXT("8.75")), FDecimal(TEXT("2.0625")));
+		const FDecimalVector Axis = FDecimalVector(1, 2, 3).GetSafeNormal();
+		const FDecimal Scale(TEXT("1.5"));
+		const FVector EngineVector(1234.5, -678.25, 91.125);
+
+		Registry.Add("Vector", "Construct components", [Scale] { return FDecimalVector(Scale, Scale, Scale); });
+		Registry.Add("Vector", "Construct FVector", [EngineVector] { return FDecimalVector(EngineVector); });
+		Registry.Add("Vector", "Copy", [A] { return FDecimalVector(A); });
+		Registry.Add("Vector", "+", [A, B] { return A + B; });
+		Registry.Add("Vector", "-", [A, B] { return A - B; });
+		Registry.Add("Vector", "* scalar", [A, Scale] { return A * Scale; });
+		Registry.Add("Vector", "/ scalar", [A, Scale] { return A / Scale; });
+		Registry.Add("Vector", "* vector", [A, B] { return A * B; });
+		Registry.Add("Vector", "+=", [A, B]() mutable { FDecimalVector Value(A); Value += B; return Value; });
+		Registry.Add("Vector", "Dot", [A, B] { return A | B; });
+		Registry.Add("Vector", "Cross", [A, B] { return A ^ B; });
+		Registry.Add("Vector", "Size", [A] { return A.Size(); });
+		Registry.Add("Vector", "SizeSquared", [A] { return A.SizeSquared(); });
+		Registry.Add("Vector", "Dist", [A, B] { return FDecimalVector::Dist(A, B); });
+		Registry.Add("Vector", "DistSquared", [A, B] { return FDecimalVector::DistSquared(A, B); });
+		Registry.Add("Vector", "GetSafeNormal", [A] { return A.GetSafeNormal(); });
+		Registry.Add("Vector", "Normalize", [A]() mutable { FDecimalVector Value(A); return Value.Normalize(); });
+		Registry.Add("Vector", "Equals", [A, B] { return A.Equals(B); });
+		Registry.Add("Vector", "IsNearlyZero", [A] { return A.IsNearlyZero(); });
+		Registry.Add("Vector", "ComponentMin", [A, B] { return A.ComponentMin(B); });
+		Registry.Add("Vector", "GetAbsMax", [A] { return A.GetAbsMax(); });
+		Registry.Add("Vector", "RotateAngleAxis", [A, Axis] { return A.RotateAngleAxis(30.0, Axis); });
+		Registry.Add("Vector", "ToFVector", [A] { return FVector(A); });
+		Registry.Add("Vector", "ToString", [A] { return A.ToString(); });
+	}
+
+	// Same positions as RegisterVector, to compare against the FDecimalVector cases.
+	void RegisterSectorVector(FRegistry& Registry)
+	{
+		const FDecimalVector DecimalA(FDecimal(TEXT("1234.5")), FDecimal(TEXT("-678.25")), FDecimal(TEXT("91.125")));
+		const FDecimalVector DecimalB(FDecimal(TEXT("-3.5")), FDecimal(TEXT("8.75")), FDecimal(TEXT("2.0625")));
+		const FDecimalVector DecimalFar = DecimalA + FDecimalVector(FDecimal(TEXT("1000000000000000")), FDecimal(TEXT("-2500000000000")), FDecimal(0));
+		const FDecimalSectorVector A(DecimalA);
+		const FDecimalSectorVector B(DecimalB);
+		const FDecimalSectorVector Far(DecimalFar);
+		const FVector Step(3.5, -8.75, 0.0625);
+
+		Registry.Add("SectorVector", "From FDecimalVector", [DecimalFar] { return FDecimalSectorVector(DecimalFar).Offset; });
+		Registry.Add("SectorVector", "ToDecimalVector", [Far] { return Far.ToDecimalVector(); });
+		Registry.Add("SectorVector", "+ FVector", [A, Step] { return (A + Step).Offset; });
+		Registry.Add("SectorVector", "- neighbour", [A, B] { return A - B; });
+		Registry.Add("SectorVector", "- far", [A, Far] { return Far - A; });
+		Registry.Add("SectorVector", "DistSquared", [A, B] { return FDecimalSectorVector::DistSquared(A, B); });
+		Registry.Add("SectorVector", "Dist", [A, Far] { return FDecimalSectorVector::Dist(A, Far); });
+	}
+
+	// Each case also reports shadow_hit_rate, the share of queries settled without touching the decimal digits.
+	void RegisterShadow(FRegistry& Registry)
+	{
+		// Actors within a hundred kilometres of a point a thousand kilometres from the world origin, in millimetre steps.
+		static constexpr int32 NumActors = 10000;
+		const FDecimalVector Origin(FDecimal(TEXT("100000000.125")), FDecimal(TEXT("-250000000.5")), FDecimal(TEXT("3000.75")));
+		const FDecimal Millimetre(TEXT("0.1"));
+		uint64 Seed = 0x9E3779B97F4A7C15ull;
+		const auto Random = [&Seed]
+		{
+			Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+			return static_cast<int64>(Seed >> 41) - (int64(1) << 22);
+		};
+
+		auto Decimals = std::make_shared<TArray<FDecimal>>();
+		auto Shadowed = std::make_shared<TArray<FDecimalShadowed>>();
+		auto Points = std::make_shared<TArray<FDecimalVector>>();
+		auto ShadowedPoints = std::make_shared<TArray<FDecimalShadowedVector>>();
+		for (int32 Index = 0; Index < NumActors; ++Index)
+		{
+			const FDecimalVector Point = Origin + FDecimalVector(FDecimal(Random()) * Millimetre, FDecimal(Random()) * Millimetre, FDecimal(Random() / 64) * Millimetre);
+			Decimals->Add(Point.X);
+			Shadowed->Add(FDecimalShadowed(Point.X));
+			Points->Add(Point);
+			ShadowedPoints->Add(FDecimalShadowedVector(Point));
+		}
+		const FDecimalShadowedVector ShadowedOrigin(Origin);
+		const FDecimal Radius(100000);
+		const FDecimalShadowed ShadowedRadius(Radius);
+
+		Registry.Add("Shadow", "Sort 10k FDecimal", [Decimals]
+		{
+			TArray<FDecimal> Sorted(*Decimals);
+			std::sort(Sorted.GetData(), Sorted.GetData() + Sorted.Num());
+			return Sorted[0];
+		});
+		Registry.Add("Shadow", "Sort 10k shadowed", [Shadowed]
+		{
+			TArray<FDecimalShadowed> Sorted(*Shadowed);
+			std::sort(Sorted.GetData(), Sorted.GetData() + Sorted.Num());
+			return Sorted[0].GetValue();
+		});
+		Registry.Add("Shadow", "Within radius 10k FDecimalVector", [Origin, Points, Radius]
+		{
+			const FDecimal RadiusSquared = Radius * Radius;
+			int64 Count = 0;
+			for (const FDecimalVector& Point : *Points)
+			{
+				Count += FDecimalVector::DistSquared(Origin, Point) <= RadiusSquared;
+			}
+			return Count;
+		});
+		Registry.Add("Shadow", "Within radius 10k shadowed", [ShadowedOrigin, ShadowedPoints, ShadowedRadius]
+		{
+			int64 Count = 0;
+			for (const FDecimalShadowedVector& Point : *ShadowedPoints)
+			{
+				Count += FDecimalShadowedVector::IsWithinDistance(ShadowedOrigin, Point, ShadowedRadius);
+			}
+			return Count;
+		});
+		Registry.Add("Shadow", "Nearest of 10k FDecimalVector", [Origin, Points]
+		{
+			int32 Nearest = 0;
+			FDecimal NearestDistSquared = FDecimalVector::DistSquared(Origin, (*Points)[0]);
+			for (int32 Index = 1; Index < Points->Num(); ++Index)
+			{
+				const FDecimal DistSquared = FDecimalVector::DistSquared(Origin, (*Points)[Index]);
+				if (DistSquared < NearestDistSquared)
+				{
+					Nearest = Index;
+					NearestDistSquared = DistSquared;
+				}
+			}
+			return Nearest;
+		});
+		Registry.Add("Shadow", "Nearest of 10k shadowed", [ShadowedOrigin, ShadowedPoints]
+		{
+			int32 Nearest = 0;
+			for (int32 Index = 1; Index < ShadowedPoints->Num(); ++Index)
+			{
+				if (FDecimalShadowedVector::CompareDistance(ShadowedOrigin, (*ShadowedPoints)[Index], (*ShadowedPoints)[Nearest]) < 0)
+				{
+					Nearest = Index;
+				}
+			}
+			return Nearest;
+		});
+	}
+
+	// Queries cycle through random points a few kilometres apart, a thousand kilometres from the world origin, and report
+	// shadow_hit_rate. The cospherical case is degenerate on purpose, it always takes the decimal path.
+	void RegisterPredicates(FRegistry& Registry)
+	{
+		static constexpr int32 NumPoints = 1024;
+		const FDecimalVector Origin(FDecimal(TEXT("100000000.125")), FDecimal(TEXT("-250000000.5")), FDecimal(TEXT("3000.75")));
+		const FDecimal Millimetre(TEXT("0.1"));
+		uint64 Seed = 0xD1B54A32D192ED03ull;
+		const auto Random = [&Seed]
+		{
+			Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+			return static_cast<int64>(Seed >> 44) - (int64(1) << 19);
+		};
+
+		auto Points = std::make_shared<TArray<FDecimalVector>>();
+		auto ShadowedPoints = std::make_shared<TArray<FDecimalShadowedVector>>();
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			Points->Add(Origin + FDecimalVector(FDecimal(Random()) * Millimetre, FDecimal(Random()) * Millimetre, FDecimal(Random()) * Millimetre));
+			ShadowedPoints->Add(FDecimalShadowedVector(Points->Last()));
+		}
+
+		// Every call takes the next five points.
+		const auto Next = [](int32& Cursor)
+		{
+			Cursor = (Cursor + 5) % (NumPoints - 5);
+			return Cursor;
+		};
+
+		Registry.Add("Predicates", "Orient2D", [Points, Next, Cursor = 0]() mutable
+		{
+			const int32 I = Next(Cursor);
+			return FDecimalPredicates::Orient2D((*Points)[I], (*Points)[I + 1], (*Points)[I + 2]);
+		});
+		Registry.Add("Predicates", "Orient3D", [Points, Next, Cursor = 0]() mutable
+		{
+			const int32 I = Next(Cursor);
+			return FDecimalPredicates::Orient3D((*Points)[I], (*Points)[I + 1], (*Points)[I + 2], (*Points)[I + 3]);
+		});
+		Registry.Add("Predicates", "Orient3D shadowed", [ShadowedPoints, Next, Cursor = 0]() mutable
+		{
+			const int32 I = Next(Cursor);
+			return FDecimalPredicates::Orient3D((*ShadowedPoints)[I], (*ShadowedPoints)[I + 1], (*ShadowedPoints)[I + 2], (*ShadowedPoints)[I + 3]);
+		});
+		Registry.Add("Predicates", "Orient3D FDecimal Triple", [Points, Next, Cursor = 0]() mutable
+		{
+			const int32 I = Next(Cursor);
+			const FDecimalVector& D = (*Points)[I + 3];
+			return FDecimalVector::Triple((*Points)[I] - D, (*Points)[I + 1] - D, (*Points)[I + 2] - D).Sign();
+		});
+		Registry.Add("Predicates", "InSphere", [Points, Next, Cursor = 0]() mutable
+		{
+			const int32 I = Next(Cursor);
+			return FDecimalPredicates::InSphere((*Points)[I], (*Points)[I + 1], (*Points)[I + 2], (*Points)[I + 3], (*Points)[I + 4]);
+		});
+		Registry.Add("Predicates", "InSphere shadowed", [ShadowedPoints, Next, Cursor = 0]() mutable
+		{
+			const int32 I = Next(Cursor);
+			return FDecimalPredicates::InSphere((*ShadowedPoints)[I], (*ShadowedPoints)[I + 1], (*ShadowedPoints)[I + 2], (*ShadowedPoints)[I + 3], (*ShadowedPoints)[I + 4]);
+		});
+
+		// Five points on a sphere of radius 5 around Origin.
+		const FDecimalVector SphereA = Origin + FDecimalVector(3, 4, 0);
+		const FDecimalVector SphereB = Origin + FDecimalVector(0, 0, 5);
+		const FDecimalVector SphereC = Origin + FDecimalVector(5, 0, 0);
+		const FDecimalVector SphereD = Origin + FDecimalVector(0, -5, 0);
+		const FDecimalVector SphereE = Origin + FDecimalVector(-3, -4, 0);
+		Registry.Add("Predicates", "InSphere cospherical", [SphereA, SphereB, SphereC, SphereD, SphereE]
+		{
+			return FDecimalPredicates::InSphere(SphereA, SphereB, SphereC, SphereD, SphereE);
+		});
+
+		const FDecimalVector PlaneNormal(FDecimal(TEXT("0.6")), FDecimal(TEXT("-0.8")), FDecimal(0));
+		Registry.Add("Predicates", "PlaneSide", [Points, Origin, PlaneNormal, Next, Cursor = 0]() mutable
+		{
+			return FDecimalPredicates::PlaneSide((*Points)[Next(Cursor)], Origin, PlaneNormal);
+		});
+		Registry.Add("Predicates", "PlaneSide FDecimal PointPlaneDist", [Points, Origin, PlaneNormal, Next, Cursor = 0]() mutable
+		{
+			return FDecimalVector::PointPlaneDist((*Points)[Next(Cursor)], Origin, PlaneNormal).Sign();
+		});
+	}
+
+	// Overlapping blobs of actors a few tens of kilometres across a thousand kilometres from the world
+	// origin. The assignment pass is what every iteration cost before FDecimalKMeans: a decimal distance per point and center.
+	void RegisterKMeans(FRegistry& Registry)
+	{
+		static constexpr int32 NumPoints = 20000;
+		static constexpr int32 NumClusters = 16;
+		const FDecimalVector Origin(FDecimal(TEXT("100000000.125")), FDecimal(TEXT("-250000000.5")), FDecimal(TEXT("3000.75")));
+		const FDecimal Centimetre(TEXT("0.01"));
+		uint64 Seed = 0x9E3779B97F4A7C15ull;
+		const auto Random = [&Seed](int64 Range)
+		{
+			Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+			return static_cast<int64>((Seed >> 33) % static_cast<uint64>(Range));
+		};
+
+		auto Points = std::make_shared<TArray<FDecimalVector>>();
+		auto Seeds = std::make_shared<TArray<FDecimalVector>>();
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			const int64 Blob = Random(NumClusters);
+			const FDecimalVector BlobCenter(FDecimal(Blob % 4 * 2000000), FDecimal(Blob / 4 * 2000000), FDecimal(0));
+			Points->Add(Origin + BlobCenter + FDecimalVector(FDecimal(Random(300000000)), FDecimal(Random(300000000)), FDecimal(Random(1000000))) * Centimetre);
+		}
+		for (int32 Cluster = 0; Cluster < NumClusters; ++Cluster)
+		{
+			Seeds->Add((*Points)[Cluster * 997]);
+		}
+
+		Registry.Add("KMeans", "Decimal assignment pass 20k x 16", [Points, Seeds]
+		{
+			int64 Checksum = 0;
+			for (const FDecimalVector& Point : *Points)
+			{
+				int32 Nearest = 0;
+				FDecimal NearestDistSquared = FDecimalVector::DistSquared(Point, (*Seeds)[0]);
+				for (int32 Cluster = 1; Cluster < Seeds->Num(); ++Cluster)
+				{
+					const FDecimal DistSquared = FDecimalVector::DistSquared(Point, (*Seeds)[Cluster]);
+					if (DistSquared < NearestDistSquared)
+					{
+						Nearest = Cluster;
+						NearestDistSquared = DistSquared;
+					}
+				}
+				Checksum += Nearest;
+			}
+			return Checksum;
+		});
+		Registry.Add("KMeans", "FDecimalKMeans 20k x 16", [Points, Seeds]
+		{
+			TArray<FDecimalVector> Centers(*Seeds);
+			TArray<int32> Assignments;
+			TArray<int32> ClusterSizes;
+			const FDecimalKMeansStats Stats = FDecimalKMeans::Run(Centers, *Points, 100, Assignments, ClusterSizes);
+			return Stats.NumIterations;
+		});
+		Registry.Add("KMeans", "GenerateClusterCenters 20k x 16", [Points, Seeds]
+		{
+			TArray<FDecimalVector> Centers(*Seeds);
+			FDecimalVector::GenerateClusterCenters(Centers, *Points, 100, 10);
+			return Centers.Num();
+		});
+	}
+
+	// Actors in a ten kilometre square a thousand kilometres from the world origin, queried around actors in turn.
+	// The brute force cases test every actor with the same exact distance tests the grid uses.
+	void RegisterSpatialHash(FRegistry& Registry)
+	{
+		static constexpr int32 NumActors = 100000;
+		static constexpr int32 NumNeighbors = 8;
+		const FDecimalVector Origin(FDecimal(TEXT("100000000.125")), FDecimal(TEXT("-250000000.5")), FDecimal(TEXT("3000.75")));
+		const FDecimal Centimetre(TEXT("0.01"));
+		uint64 Seed = 0x9E3779B97F4A7C15ull;
+		const auto Random = [&Seed](int64 Range)
+		{
+			Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+			return static_cast<int64>((Seed >> 33) % static_cast<uint64>(Range));
+		};
+
+		auto Hash = std::make_shared<FDecimalSpatialHash>(FDecimal(2000));
+		auto Actors = std::make_shared<TArray<FDecimalShadowedVector>>();
+		for (int32 Index = 0; Index < NumActors; ++Index)
+		{
+			const FDecimalVector Position = Origin + FDecimalVector(FDecimal(Random(100000000)), FDecimal(Random(100000000)), FDecimal(Random(1000000))) * Centimetre;
+			Hash->Add(Position);
+			Actors->Add(FDecimalShadowedVector(Position));
+		}
+		const FDecimal Radius(1000);
+		const FDecimalShadowed ShadowedRadius(Radius);
+		auto Cursor = std::make_shared<int32>(0);
+		auto Ids = std::make_shared<TArray<int32>>();
+
+		Registry.Add("SpatialHash", "FindInRadius 100k", [Hash, Actors, Radius, Cursor, Ids]
+		{
+			*Cursor = (*Cursor + 7919) % NumActors;
+			Hash->FindInRadius((*Actors)[*Cursor].GetValue(), Radius, *Ids);
+			return Ids->Num();
+		});
+		Registry.Add("SpatialHash", "Brute force radius 100k", [Actors, ShadowedRadius, Cursor, Ids]
+		{
+			*Cursor = (*Cursor + 7919) % NumActors;
+			const FDecimalShadowedVector& Center = (*Actors)[*Cursor];
+			Ids->Reset();
+			for (int32 Index = 0; Index < NumActors; ++Index)
+			{
+				if (FDecimalShadowedVector::IsWithinDistance(Center, (*Actors)[Index], ShadowedRadius))
+				{
+					Ids->Add(Index);
+				}
+			}
+			return Ids->Num();
+		});
+		Registry.Add("SpatialHash", "FindNearest 8 of 100k", [Hash, Actors, Cursor, Ids]
+		{
+			*Cursor = (*Cursor + 7919) % NumActors;
+			Hash->FindNearest((*Actors)[*Cursor].GetValue(), NumNeighbors, *Ids);
+			return (*Ids)[NumNeighbors - 1];
+		});
+		Registry.Add("SpatialHash", "Brute force nearest 8 of 100k", [Actors, Cursor, Ids]
+		{
+			*Cursor = (*Cursor + 7919) % NumActors;
+			const FDecimalShadowedVector& Center = (*Actors)[*Cursor];
+			const auto IsNearer = [&Center, &Actors](int32 A, int32 B)
+			{
+				const int32 Order = FDecimalShadowedVector::CompareDistance(Center, (*Actors)[A], (*Actors)[B]);
+				return Order != 0 ? Order < 0 : A < B;
+			};
+			Ids->SetNumUninitialized(NumActors);
+			for (int32 Index = 0; Index < NumActors; ++Index)
+			{
+				(*Ids)[Index] = Index;
+			}
+			std::partial_sort(Ids->GetData(), Ids->GetData() + NumNeighbors, Ids->GetData() + NumActors, IsNearer);
+			return (*Ids)[NumNeighbors - 1];
+		});
+		Registry.Add("SpatialHash", "Move", [Hash, Actors, Cursor, Centimetre]
+		{
+			// Actors step a metre back and forth, crossing a cell boundary now and then.
+			*Cursor = (*Cursor + 7919) % NumActors;
+			const FDecimalVector Step = FDecimalVector(FDecimal(*Cursor % 2 == 0 ? 100 : -100), FDecimal(0), FDecimal(0)) * Centimetre;
+			FDecimalShadowedVector& Actor = (*Actors)[*Cursor];
+			Actor += Step;
+			Hash->Move(*Cursor, Actor.GetValue());
+			return *Cursor;
+		});
+	}
+
+	void RegisterBVH(FRegistry& Registry)
+	{
+		// Actor bounds of half a metre to five metres spread over a square kilometre, a thousand kilometres from the world origin.
+		static constexpr int32 NumActors = 100000;
+		const FDecimalVector Origin(FDecimal(TEXT("100000000.125")), FDecimal(TEXT("-250000000.5")), FDecimal(TEXT("3000.75")));
+		const FDecimal Centimetre(TEXT("0.01"));
+		uint64 Seed = 0x9E3779B97F4A7C15ull;
+		const auto Random = [&Seed](int64 Range)
+		{
+			Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+			return static_cast<int64>((Seed >> 33) % static_cast<uint64>(Range));
+		};
+		const auto RandomBox = [&]()
+		{
+			const FDecimalVector Min = Origin + FDecimalVector(FDecimal(Random(100000)), FDecimal(Random(100000)), FDecimal(Random(10000))) * Centimetre;
+			const FDecimalVector Size = FDecimalVector(FDecimal(50 + Random(450)), FDecimal(50 + Random(450)), FDecimal(50 + Random(450))) * Centimetre;
+			return FDecimalBox(Min, Min + Size);
+		};
+
+		auto Boxes = std::make_shared<TArray<FDecimalBox>>();
+		for (int32 Index = 0; Index < NumActors; ++Index)
+		{
+			Boxes->Add(RandomBox());
+		}
+		auto Queries = std::make_shared<TArray<FDecimalBox>>();
+		for (int32 Index = 0; Index < 64; ++Index)
+		{
+			Queries->Add(RandomBox().ExpandBy(FDecimal(10)));
+		}
+		auto Tree = std::make_shared<FDecimalBVH>();
+		Tree->Build(*Boxes);
+		auto Moved = std::make_shared<TArray<FDecimalBox>>(*Boxes);
+		for (FDecimalBox& Box : *Moved)
+		{
+			const FDecimalVector Step = FDecimalVector(FDecimal(Random(200) - 100), FDecimal(Random(200) - 100), FDecimal(0)) * Centimetre;
+			Box = FDecimalBox(Box.Min + Step, Box.Max + Step);
+		}
+		const FDecimal Radius(20);
+		const FDecimal MaxTime(1);
+		const FDecimalVector RayStep(FDecimal(300), FDecimal(-200), FDecimal(5));
+		auto Cursor = std::make_shared<int32>(0);
+		auto Indices = std::make_shared<TArray<int32>>();
+
+		Registry.Add("BVH", "Build 100k", [Boxes]
+		{
+			FDecimalBVH Built;
+			Built.Build(*Boxes);
+			return Built.Num();
+		});
+		Registry.Add("BVH", "Refit 100k", [Tree, Boxes, Moved, Cursor]
+		{
+			// Alternate between two frames so every refit moves every box.
+			*Cursor = 1 - *Cursor;
+			Tree->Refit(*Cursor != 0 ? *Moved : *Boxes);
+			return Tree->Num();
+		});
+		Registry.Add("BVH", "QueryBox 100k", [Tree, Queries, Cursor, Indices]
+		{
+			*Cursor = (*Cursor + 1) % Queries->Num();
+			Tree->QueryBox((*Queries)[*Cursor], *Indices);
+			return Indices->Num();
+		});
+		Registry.Add("BVH", "Brute force box 100k", [Boxes, Queries, Cursor, Indices]
+		{
+			*Cursor = (*Cursor + 1) % Queries->Num();
+			(*Queries)[*Cursor].FindIntersecting(*Boxes, *Indices);
+			return Indices->Num();
+		});
+		Registry.Add("BVH", "QuerySphere 100k", [Tree, Queries, Radius, Cursor, Indices]
+		{
+			*Cursor = (*Cursor + 1) % Queries->Num();
+			Tree->QuerySphere((*Queries)[*Cursor].Min, Radius, *Indices);
+			return Indices->Num();
+		});
+		Registry.Add("BVH", "Brute force sphere 100k", [Boxes, Queries, Radius, Cursor, Indices]
+		{
+			*Cursor = (*Cursor + 1) % Queries->Num();
+			const FDecimalVector& Center = (*Queries)[*Cursor].Min;
+			Indices->Reset();
+			for (int32 Index = 0; Index < NumActors; ++Index)
+			{
+				if ((*Boxes)[Index].IntersectSphere(Center, Radius))
+				{
+					Indices->Add(Index);
+				}
+			}
+			return Indices->Num();
+		});
+		Registry.Add("BVH", "RayCast 100k", [Tree, Queries, RayStep, MaxTime, Cursor]
+		{
+			*Cursor = (*Cursor + 1) % Queries->Num();
+			int32 Hit = INDEX_NONE;
+			FDecimal Time;
+			Tree->RayCast((*Queries)[*Cursor].Min, RayStep, MaxTime, Hit, Time);
+			return Hit;
+		});
+		Registry.Add("BVH", "Brute force ray 100k", [Boxes, Queries, RayStep, MaxTime, Cursor]
+		{
+			*Cursor = (*Cursor + 1) % Queries->Num();
+			const FDecimalVector& RayOrigin = (*Queries)[*Cursor].Min;
+			int32 Hit = INDEX_NONE;
+			FDecimal HitTime;
+			for (int32 Index = 0; Index < NumActors; ++Index)
+			{
+				FDecimal Time;
+				if ((*Boxes)[Index].IntersectRay(RayOrigin, RayStep, MaxTime, Time) && (Hit == INDEX_NONE || Time < HitTime))
+				{
+					Hit = Index;
+					HitTime = Time;
+				}
+			}
+			return Hit;
+		});
+	}
+
+	/** Accelerations of every body, summing every pair in FDecimal. */
+	void ComputeAccelerationsDirect(TConstArrayView<FDecimalVector> Positions, TConstArrayView<double> Masses, const FDecimal& SofteningSquared, TArray<FVector>& OutAccelerations)
+	{
+		OutAccelerations.SetNumUninitialized(Positions.Num());
+		for (int32 Body = 0; Body < Positions.Num(); ++Body)
+		{
+			FDecimalVector Acceleration = FDecimalVector::ZeroVector;
+			for (int32 Other = 0; Other < Positions.Num(); ++Other)
+			{
+				if (Other != Body)
+				{
+					const FDecimalVector Offset = Positions[Other] - Positions[Body];
+					const FDecimal DistSquared = FDecimalVector::DistSquared(Positions[Other], Positions[Body]) + SofteningSquared;
+					Acceleration += Offset * (FDecimal(Masses[Other]) / (DistSquared * FDecimalMath::Sqrt(DistSquared)));
+				}
+			}
+			OutAccelerations[Body] = FVector(FDecimalShadowed::MakeShadow(Acceleration.X), FDecimalShadowed::MakeShadow(Acceleration.Y), FDecimalShadowed::MakeShadow(Acceleration.Z));
+		}
+	}
+
+	/** Total energy of a system, with the potential summed over every pair in doubles relative to the first body. */
+	double ComputeEnergy(TConstArrayView<FDecimalVector> Positions, TConstArrayView<FVector> Velocities, TConstArrayView<double> Masses, double Softening)
+	{
+		TArray<FVector> Relative;
+		Relative.SetNumUninitialized(Positions.Num());
+		FDecimalMath::Batch::ToRelative(Positions[0], Positions, Relative);
+		double Energy = 0.0;
+		for (int32 Body = 0; Body < Positions.Num(); ++Body)
+		{
+			Energy += 0.5 * Masses[Body] * Velocities[Body].SizeSquared();
+			for (int32 Other = Body + 1; Other < Positions.Num(); ++Other)
+			{
+				Energy -= Masses[Body] * Masses[Other] / FMath::Sqrt(FVector::DistSquared(Relative[Body], Relative[Other]) + Softening * Softening);
+			}
+		}
+		return Energy;
+	}
+
+	/** Integrate with kick-drift-kick leapfrog, moving positions exactly in FDecimal. @return The relative change of the total energy. */
+	template <typename AccelerationFuncType>
+	double RunLeapfrog(TArray<FDecimalVector> Positions, TArray<FVector> Velocities, TConstArrayView<double> Masses, double Softening, double TimeStep, int32 NumSteps, const AccelerationFuncType& ComputeAccelerations)
+	{
+		const double StartEnergy = ComputeEnergy(Positions, Velocities, Masses, Softening);
+		TArray<FVector> Accelerations;
+		ComputeAccelerations(Positions, Accelerations);
+		for (int32 Step = 0; Step < NumSteps; ++Step)
+		{
+			for (int32 Body = 0; Body < Positions.Num(); ++Body)
+			{
+				Velocities[Body] += Accelerations[Body] * (0.5 * TimeStep);
+				Positions[Body] += FDecimalSectorVector(FInt64Vector(0, 0, 0), Velocities[Body] * TimeStep).ToDecimalVector();
+			}
+			ComputeAccelerations(Positions, Accelerations);
+			for (int32 Body = 0; Body < Positions.Num(); ++Body)
+			{
+				Velocities[Body] += Accelerations[Body] * (0.5 * TimeStep);
+			}
+		}
+		return FMath::Abs(ComputeEnergy(Positions, Velocities, Masses, Softening) / StartEnergy - 1.0);
+	}
+
+	// A star cluster of unit masses in a ball of ten kilometres, a thousand kilometres from the world origin, with G = 1.
+	// The drift cases report the relative energy change over a few leapfrog steps as their result.
+	void RegisterNBody(FRegistry& Registry)
+	{
+		static constexpr int32 NumSmall = 256;
+		static constexpr int32 NumLarge = 10000;
+		static constexpr double Softening = 10.0;
+		static constexpr double TimeStep = 20.0;
+		static constexpr int32 NumSteps = 4;
+		const FDecimalVector Origin(FDecimal(TEXT("100000000.125")), FDecimal(TEXT("-250000000.5")), FDecimal(TEXT("3000.75")));
+		const FDecimal Centimetre(TEXT("0.01"));
+		uint64 Seed = 0x9E3779B97F4A7C15ull;
+		const auto Random = [&Seed](int64 Range)
+		{
+			Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+			return static_cast<int64>((Seed >> 33) % static_cast<uint64>(Range));
+		};
+
+		auto Positions = std::make_shared<TArray<FDecimalVector>>();
+		auto Velocities = std::make_shared<TArray<FVector>>();
+		auto Masses = std::make_shared<TArray<double>>();
+		while (Positions->Num() < NumLarge)
+		{
+			const FInt64Vector Offset(Random(2000000) - 1000000, Random(2000000) - 1000000, Random(2000000) - 1000000);
+			const double Radius = FVector(static_cast<double>(Offset.X), static_cast<double>(Offset.Y), static_cast<double>(Offset.Z)).Size();
+			if (Radius <= 1000000.0)
+			{
+				Positions->Add(Origin + FDecimalVector(Offset) * Centimetre);
+				Velocities->Add(FVector(static_cast<double>(Random(2001) - 1000), static_cast<double>(Random(2001) - 1000), static_cast<double>(Random(2001) - 1000)) * 0.0002);
+				Masses->Add(1.0);
+			}
+		}
+		auto SmallPositions = std::make_shared<TArray<FDecimalVector>>(Positions->GetData(), NumSmall);
+		auto SmallVelocities = std::make_shared<TArray<FVector>>(Velocities->GetData(), NumSmall);
+		auto SmallMasses = std::make_shared<TArray<double>>(Masses->GetData(), NumSmall);
+		const FDecimal SofteningSquared(Softening * Softening);
+		auto Accelerations = std::make_shared<TArray<FVector>>();
+
+		const auto ComputeBarnesHut = [](TConstArrayView<FDecimalVector> InPositions, TConstArrayView<double> InMasses, TArray<FVector>& OutAccelerations)
+		{
+			FDecimalBarnesHut Solver;
+			Solver.Softening = Softening;
+			Solver.Build(InPositions, InMasses);
+			OutAccelerations.SetNumUninitialized(InPositions.Num());
+			Solver.ComputeAccelerations(OutAccelerations);
+		};
+
+		Registry.Add("NBody", "Barnes-Hut 256", [SmallPositions, SmallMasses, Accelerations, ComputeBarnesHut]
+		{
+			ComputeBarnesHut(*SmallPositions, *SmallMasses, *Accelerations);
+			return (*Accelerations)[0].X;
+		});
+		Registry.Add("NBody", "Direct FDecimal 256", [SmallPositions, SmallMasses, SofteningSquared, Accelerations]
+		{
+			ComputeAccelerationsDirect(*SmallPositions, *SmallMasses, SofteningSquared, *Accelerations);
+			return (*Accelerations)[0].X;
+		});
+		Registry.Add("NBody", "Barnes-Hut 10k", [Positions, Masses, Accelerations, ComputeBarnesHut]
+		{
+			ComputeBarnesHut(*Positions, *Masses, *Accelerations);
+			return (*Accelerations)[0].X;
+		});
+		Registry.Add("NBody", "Energy drift Barnes-Hut 256 x 4 steps", [SmallPositions, SmallVelocities, SmallMasses, ComputeBarnesHut]
+		{
+			return RunLeapfrog(*SmallPositions, *SmallVelocities, *SmallMasses, Softening, TimeStep, NumSteps, [&SmallMasses, &ComputeBarnesHut](const TArray<FDecimalVector>& InPositions, TArray<FVector>& OutAccelerations)
+			{
+				ComputeBarnesHut(InPositions, *SmallMasses, OutAccelerations);
+			});
+		});
+		Registry.Add("NBody", "Energy drift direct FDecimal 256 x 4 steps", [SmallPositions, SmallVelocities, SmallMasses, SofteningSquared]
+		{
+			return RunLeapfrog(*SmallPositions, *SmallVelocities, *SmallMasses, Softening, TimeStep, NumSteps, [&SmallMasses, &SofteningSquared](const TArray<FDecimalVector>& InPositions, TArray<FVector>& OutAccelerations)
+			{
+				ComputeAccelerationsDirect(InPositions, *SmallMasses, SofteningSquared, OutAccelerations);
+			});
+		});
+	}
+
+	// Ten thousand bodies on circular orbits a thousand to two thousand units around a point mass far from the world origin,
+	// one step per op. The hand-written case is a single-threaded RK4 loop over FDecimalVector with FDecimal accelerations.
+	void RegisterIntegrator(FRegistry& Registry)
+	{
+		static constexpr int32 NumBodies = 10000;
+		static constexpr double GravitationalParameter = 1.0e6;
+		static constexpr double TimeStep = 0.5;
+		const FDecimalVector Center(FDecimal(TEXT("123456789012345.125")), FDecimal(TEXT("-98765432109876.5")), FDecimal(TEXT("5000000000.25")));
+		uint64 Seed = 0x9E3779B97F4A7C15ull;
+		const auto Random = [&Seed](int64 Range)
+		{
+			Seed = Seed * 6364136223846793005ull + 1442695040888963407ull;
+			return static_cast<int64>((Seed >> 33) % static_cast<uint64>(Range));
+		};
+
+		auto Positions = std::make_shared<TArray<FDecimalVector>>();
+		auto Velocities = std::make_shared<TArray<FDecimalVector>>();
+		for (int32 Index = 0; Index < NumBodies; ++Index)
+		{
+			// In the XY plane at an angle of a whole number of milliradians, moving counterclockwise.
+			const double Radius = 1000.0 + static_cast<double>(Random(1000));
+			const double Angle = static_cast<double>(Random(6283)) * 0.001;
+			const double Speed = FMath::Sqrt(GravitationalParameter / Radius);
+			const FVector Offset(Radius * FMath::Cos(Angle), Radius * FMath::Sin(Angle), 0.0);
+			const FVector Velocity(-Speed * FMath::Sin(Angle), Speed * FMath::Cos(Angle), 0.0);
+			Positions->Add(Center + FDecimalSectorVector(FInt64Vector(0, 0, 0), Offset).ToDecimalVector());
+			Velocities->Add(FDecimalSectorVector(FInt64Vector(0, 0, 0), Velocity).ToDecimalVector());
+		}
+
+		const auto ComputeAccelerations = [](int32 Begin, int32 End, double, TConstArrayView<FVector> InPositions, TConstArrayView<FVector>, TArrayView<FVector> OutAccelerations)
+		{
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				const double DistSquared = InPositions[Index].SizeSquared();
+				OutAccelerations[Index] = InPositions[Index] * (-GravitationalParameter / (DistSquared * FMath::Sqrt(DistSquared)));
+			}
+		};
+
+		const auto RegisterMethod = [&Registry, &Positions, &Velocities, &Center, &ComputeAccelerations](const char* Name, EDecimalIntegrator Method)
+		{
+			auto Integrator = std::make_shared<FDecimalIntegrator>();
+			Integrator->Positions.FromVectors(*Positions);
+			Integrator->Velocities.FromVectors(*Velocities);
+			Integrator->Origin = Center;
+			Registry.Add("Integrator", Name, [Integrator, Method, Center, ComputeAccelerations]
+			{
+				Integrator->Step(Method, TimeStep, 1, ComputeAccelerations);
+				return FDecimalShadowed::MakeShadow(Integrator->Positions.X[0] - Center.X);
+			});
+		};
+		RegisterMethod("Symplectic Euler 10k", EDecimalIntegrator::SymplecticEuler);
+		RegisterMethod("Velocity Verlet 10k", EDecimalIntegrator::VelocityVerlet);
+		RegisterMethod("RK4 10k", EDecimalIntegrator::RungeKutta4);
+
+		const FDecimal DecimalParameter(1000000);
+		const FDecimal FullStep(TEXT("0.5"));
+		const FDecimal HalfStep(TEXT("0.25"));
+		const FDecimal SixthStep = FullStep / FDecimal(6);
+		Registry.Add("Integrator", "Hand-written RK4 FDecimalVector 10k", [Positions, Velocities, Center, DecimalParameter, FullStep, HalfStep, SixthStep]
+		{
+			const auto GetAcceleration = [&Center, &DecimalParameter](const FDecimalVector& Position)
+			{
+				const FDecimal DistSquared = FDecimalVector::DistSquared(Position, Center);
+				return (Center - Position) * (DecimalParameter / (DistSquared * FDecimalMath::Sqrt(DistSquared)));
+			};
+			for (int32 Index = 0; Index < NumBodies; ++Index)
+			{
+				FDecimalVector& Position = (*Positions)[Index];
+				FDecimalVector& Velocity = (*Velocities)[Index];
+				const FDecimalVector Acceleration1 = GetAcceleration(Position);
+				const FDecimalVector Velocity2 = Velocity + Acceleration1 * HalfStep;
+				const FDecimalVector Acceleration2 = GetAcceleration(Position + Velocity * HalfStep);
+				const FDecimalVector Velocity3 = Velocity + Acceleration2 * HalfStep;
+				const FDecimalVector Acceleration3 = GetAcceleration(Position + Velocity2 * HalfStep);
+				const FDecimalVector Velocity4 = Velocity + Acceleration3 * FullStep;
+				const FDecimalVector Acceleration4 = GetAcceleration(Position + Velocity3 * FullStep);
+				Position += (Velocity + (Velocity2 + Velocity3) * FDecimal(2) + Velocity4) * SixthStep;
+				Velocity += (Acceleration1 + (Acceleration2 + Acceleration3) * FDecimal(2) + Acceleration4) * SixthStep;
+			}
+			return FDecimalShadowed::MakeShadow((*Positions)[0].X - Center.X);
+		});
+	}
+
+	void RegisterBatch(FRegistry& Registry)
+	{
+		// Actors spread over a few kilometres, a thousand kilometres from the world origin, seen from a camera among them.
+		static constexpr int32 NumActors = 100000;
+		const FDecimalVector Origin(FDecimal(TEXT("100000000.125")), FDecimal(TEXT("-250000000.5")), FDecimal(TEXT("3000.75")));
+		auto Actors = std::make_shared<TArray<FDecimalVector>>();
+		Actors->Reserve(NumActors);
+		for (int32 Index = 0; Index < NumActors; ++Index)
+		{
+			const FDecimalVector Offset(FDecimal(Index % 997) * FDecimal(TEXT("317.0625")), FDecimal(Index % 991) * FDecimal(TEXT("-211.5")), FDecimal(Index % 101) * FDecimal(TEXT("13.25")));
+			Actors->Add(Origin + Offset);
+		}
+		auto ActorArray = std::make_shared<FDecimalVectorArray>(*Actors);
+		auto Doubles = std::make_shared<TArray<FVector>>();
+		auto Floats = std::make_shared<TArray<FVector3f>>();
+		Doubles->SetNumUninitialized(NumActors);
+		Floats->SetNumUninitialized(NumActors);
+
+		Registry.Add("Batch", "ToRelative FVector 100k", [Origin, Actors, Doubles]
+		{
+			FDecimalMath::Batch::ToRelative(Origin, *Actors, *Doubles);
+			return (*Doubles)[NumActors - 1];
+		});
+		Registry.Add("Batch", "ToRelative FVector3f 100k", [Origin, Actors, Floats]
+		{
+			FDecimalMath::Batch::ToRelative(Origin, *Actors, *Floats);
+			return static_cast<double>((*Floats)[NumActors - 1].X);
+		});
+		Registry.Add("Batch", "ToRelative FVector3f SoA 100k", [Origin, ActorArray, Floats]
+		{
+			FDecimalMath::Batch::ToRelative(Origin, *ActorArray, *Floats);
+			return static_cast<double>((*Floats)[NumActors - 1].X);
+		});
+
+		// A frame in which 1% of the actors moved and the view stayed within the rebase threshold, and one in which the
+		// view crossed it.
+		auto Rebase = std::make_shared<FDecimalRebaseSet>();
+		for (const FDecimalVector& Actor : *Actors)
+		{
+			Rebase->Add(Actor);
+		}
+		Rebase->Update(Origin);
+		const FDecimalVector Step(FDecimal(TEXT("0.5")), FDecimal(0), FDecimal(0));
+		const FDecimalVector FarOrigin = Origin + FDecimalVector(FDecimal(1000000), FDecimal(0), FDecimal(0));
+
+		Registry.Add("Batch", "Rebase update 100k 1% moved", [Origin, Rebase, Step]() mutable
+		{
+			for (int32 Id = 0; Id < NumActors; Id += 100)
+			{
+				Rebase->SetPosition(Id, Rebase->GetPosition(Id) + Step);
+			}
+			Rebase->Update(Origin);
+			return Rebase->GetRenderPosition(NumActors - 1);
+		});
+		Registry.Add("Batch", "Rebase update 100k rebased", [Origin, FarOrigin, Rebase]() mutable
+		{
+			const bool bFar = Rebase->GetRenderOrigin() == Origin;
+			Rebase->Update(bFar ? FarOrigin : Origin);
+			return Rebase->GetRenderPosition(NumActors - 1) - Rebase->GetRenderPosition(0);
+		});
+	}
+}
+
+int main(int Argc, char** Argv)
+{
+	FOptions Options;
+	if (!Options.Parse(Argc, Argv))
+	{
+		return 2;
+	}
+
+	FRegistry Registry;
+	RegisterConstruction(Registry);
+	RegisterOperators(Registry);
+	RegisterConversions(Registry);
+	RegisterMath(Registry);
+	RegisterVector(Registry);
+	RegisterSectorVector(Registry);
+	RegisterShadow(Registry);
+	RegisterPredicates(Registry);
+	RegisterKMeans(Registry);
+	RegisterSpatialHash(Registry);
+	RegisterBVH(Registry);
+	RegisterNBody(Registry);
+	RegisterIntegrator(Registry);
+	RegisterBatch(Registry);
+
+	return Registry.RunAll(Options, "DecimalNumber");
+}
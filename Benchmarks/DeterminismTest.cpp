@@ -0,0 +1,52 @@
+// Standalone Linux run of the DecimalNumber.Determinism automation test, see Private/Tests/DecimalDeterminism.h.
+//
+//   DeterminismTest          compares every case against the reference hashes, exit code 1 on a mismatch
+//   DeterminismTest --print  prints the current hashes in the layout of the reference table
+
+#include "DecimalDeterminism.h"
+
+int main(int argc, char** argv)
+{
+	TArray<DecimalDeterminism::FResult> Results;
+	DecimalDeterminism::Evaluate(Results);
+
+	if (argc > 1 && std::strcmp(argv[1], "--print") == 0)
+	{
+		for (const DecimalDeterminism::FResult& Result : Results)
+		{
+			std::printf("\t\t{ TEXT(\"%s\"), 0x%016llxull },\n", *Result.Name, (unsigned long long)Result.Hash);
+		}
+		return 0;
+	}
+
+	const bool bHasReference = DecimalDeterminism::HasReference();
+	if (!bHasReference)
+	{
+		std::printf("No reference hashes for this backend, only checking batch results against the thread count.\n");
+	}
+
+	int32 NumFailed = 0;
+	uint64 SerialHash = 0;
+	uint64 ParallelHash = 0;
+	for (const DecimalDeterminism::FResult& Result : Results)
+	{
+		const bool bMatches = !bHasReference || Result.Hash == Result.ReferenceHash;
+		std::printf("%-20s %s\n", *Result.Name, bMatches ? "ok" : "MISMATCH");
+		if (!bMatches)
+		{
+			std::printf("    got 0x%016llx, expected 0x%016llx: %s\n", (unsigned long long)Result.Hash, (unsigned long long)Result.ReferenceHash, *Result.Value);
+			++NumFailed;
+		}
+		SerialHash = (Result.Name == TEXT("BatchSumSerial")) ? Result.Hash : SerialHash;
+		ParallelHash = (Result.Name == TEXT("BatchSumParallel")) ? Result.Hash : ParallelHash;
+	}
+
+	if (SerialHash != ParallelHash)
+	{
+		std::printf("Batch results differ between one task and many\n");
+		++NumFailed;
+	}
+
+	std::printf("%d of %d cases differ\n", NumFailed, Results.Num());
+	return NumFailed > 0 ? 1 : 0;
+}
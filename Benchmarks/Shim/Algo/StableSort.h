@@ -0,0 +1,5 @@
+// Stand-in for Algo/StableSort.h, Algo::StableSort lives in CoreMinimal.h.
+
+#pragma once
+
+#include "CoreMinimal.h"
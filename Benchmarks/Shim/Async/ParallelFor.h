@@ -0,0 +1,66 @@
+// Stand-in for Async/ParallelFor.h built on std::thread.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EParallelForFlags
+{
+	None = 0,
+	ForceSingleThread = 1,
+	Unbalanced = 2,
+	PumpRenderingThread = 4,
+	BackgroundPriority = 8,
+};
+
+inline EParallelForFlags operator|(EParallelForFlags A, EParallelForFlags B) { return (EParallelForFlags)((int)A | (int)B); }
+inline bool EnumHasAnyFlags(EParallelForFlags Flags, EParallelForFlags Contains) { return ((int)Flags & (int)Contains) != 0; }
+
+namespace ParallelForShim
+{
+	/** Upper bound on the worker count, settable by benchmark drivers to measure scaling. */
+	inline int32& MaxWorkers()
+	{
+		static int32 Value = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+		return Value;
+	}
+}
+
+inline void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	const int32 NumWorkers = EnumHasAnyFlags(Flags, EParallelForFlags::ForceSingleThread) ? 1 : std::min(Num, ParallelForShim::MaxWorkers());
+	if (NumWorkers <= 1)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Body(Index);
+		}
+		return;
+	}
+
+	std::atomic<int32> Next(0);
+	auto Worker = [&]()
+	{
+		for (int32 Index = Next++; Index < Num; Index = Next++)
+		{
+			Body(Index);
+		}
+	};
+
+	std::vector<std::thread> Threads;
+	Threads.reserve(NumWorkers - 1);
+	for (int32 WorkerIndex = 1; WorkerIndex < NumWorkers; ++WorkerIndex)
+	{
+		Threads.emplace_back(Worker);
+	}
+	Worker();
+	for (std::thread& Thread : Threads)
+	{
+		Thread.join();
+	}
+}
+
+inline void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, bool bForceSingleThread)
+{
+	ParallelFor(Num, Body, bForceSingleThread ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
@@ -0,0 +1,897 @@
+// Minimal stand-in for the parts of Unreal's Core module used by DecimalNumber.
+// Only what the plugin sources touch is provided; semantics follow the engine
+// closely enough for benchmarking, not for shipping.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cfloat>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+typedef std::int8_t   int8;
+typedef std::int16_t  int16;
+typedef std::int32_t  int32;
+typedef std::int64_t  int64;
+typedef std::uint8_t  uint8;
+typedef std::uint16_t uint16;
+typedef std::uint32_t uint32;
+typedef std::uint64_t uint64;
+typedef char          TCHAR;
+typedef char          ANSICHAR;
+typedef std::size_t   SIZE_T;
+
+#define TEXT(x) x
+#define TCHAR_TO_ANSI(x) (x)
+#define ANSI_TO_TCHAR(x) (x)
+
+#define FORCEINLINE inline __attribute__((always_inline))
+#define FORCENOINLINE __attribute__((noinline))
+#define DECIMALNUMBER_API
+#define UE_BUILD_SHIPPING 0
+#define DO_CHECK 0
+#define ENABLE_NAN_DIAGNOSTIC 0
+#define STATS 0
+#define CPUPROFILERTRACE_ENABLED 0
+#define PLATFORM_CACHE_LINE_SIZE 64
+#define PLATFORM_LINUX 1
+#define PLATFORM_WINDOWS 0
+#define PLATFORM_LITTLE_ENDIAN 1
+#define LINE_TERMINATOR TEXT("\n")
+#define INDEX_NONE (-1)
+#define MAX_int32 std::numeric_limits<int32>::max()
+#define MIN_int32 std::numeric_limits<int32>::min()
+#define UE_ARRAY_COUNT(Array) (sizeof(Array) / sizeof((Array)[0]))
+
+#define THIRD_PARTY_INCLUDES_START
+#define THIRD_PARTY_INCLUDES_END
+#define PRAGMA_DISABLE_DEPRECATION_WARNINGS _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Wdeprecated-declarations\"")
+#define PRAGMA_ENABLE_DEPRECATION_WARNINGS _Pragma("GCC diagnostic pop")
+#define UE_DEPRECATED(Version, Message)
+
+#define USTRUCT(...)
+#define UCLASS(...)
+#define UENUM(...)
+#define UPROPERTY(...)
+#define UFUNCTION(...)
+#define GENERATED_BODY(...)
+
+#define TEMPLATE_REQUIRES(...) std::enable_if_t<(__VA_ARGS__), int> = 0
+
+#define check(expr) ((void)0)
+#define checkSlow(expr) ((void)0)
+#define checkf(expr, ...) ((void)0)
+#define ensure(expr) (!!(expr))
+#define ensureMsgf(expr, ...) (!!(expr))
+#define verify(expr) ((void)(expr))
+
+#define UE_PI 					(3.1415926535897932f)
+#define UE_DOUBLE_PI			(3.141592653589793238462643383279502884197169399)
+#define UE_SMALL_NUMBER			(1.e-8f)
+#define UE_KINDA_SMALL_NUMBER	(1.e-4f)
+#define UE_BIG_NUMBER			(3.4e+38f)
+#define UE_DOUBLE_SMALL_NUMBER			(1.e-8)
+#define UE_DOUBLE_KINDA_SMALL_NUMBER	(1.e-4)
+#define UE_DOUBLE_BIG_NUMBER			(3.4e+38)
+#define UE_DELTA				(0.00001f)
+#define UE_THRESH_POINT_ON_PLANE			(0.10f)
+#define UE_THRESH_POINTS_ARE_SAME			(0.00002f)
+#define UE_THRESH_NORMALS_ARE_PARALLEL		(0.999845f)
+#define UE_THRESH_NORMALS_ARE_ORTHOGONAL	(0.017455f)
+#define UE_THRESH_VECTOR_NORMALIZED			(0.01f)
+
+enum EForceInit { ForceInit, ForceInitToZero };
+enum ENoInit { NoInit };
+
+namespace EAxis
+{
+	enum Type { None, X, Y, Z };
+}
+
+/*----------------------------------------------------------------------------
+	Strings
+----------------------------------------------------------------------------*/
+
+class FString
+{
+public:
+	FString() = default;
+	FString(const TCHAR* In) : Data(In ? In : "") {}
+	FString(const std::string& In) : Data(In) {}
+	FString(int32 Count, const TCHAR* In) : Data(In, Count) {}
+
+	const TCHAR* operator*() const { return Data.c_str(); }
+	int32 Len() const { return (int32)Data.size(); }
+	bool IsEmpty() const { return Data.empty(); }
+	void Empty() { Data.clear(); }
+	void Reserve(int32 Num) { Data.reserve(Num); }
+	void Reset() { Data.clear(); }
+	TCHAR& operator[](int32 Index) { return Data[Index]; }
+	TCHAR operator[](int32 Index) const { return Data[Index]; }
+
+	FString& operator+=(const FString& Other) { Data += Other.Data; return *this; }
+	FString& operator+=(const TCHAR* Other) { Data += Other; return *this; }
+	FString& operator+=(TCHAR Other) { Data += Other; return *this; }
+	FString& AppendChar(TCHAR Other) { Data += Other; return *this; }
+	FString& Append(const FString& Other) { Data += Other.Data; return *this; }
+	FString operator+(const FString& Other) const { return FString(Data + Other.Data); }
+	FString operator+(const TCHAR* Other) const { return FString(Data + Other); }
+	bool operator==(const FString& Other) const { return Data == Other.Data; }
+	bool operator!=(const FString& Other) const { return Data != Other.Data; }
+	bool operator<(const FString& Other) const { return Data < Other.Data; }
+
+	bool IsNumeric() const
+	{
+		const char* Str = Data.c_str();
+		if (*Str == '\0')
+		{
+			return false;
+		}
+		if (*Str == '-' || *Str == '+')
+		{
+			++Str;
+		}
+		bool bHasDot = false;
+		bool bHasDigit = false;
+		for (; *Str; ++Str)
+		{
+			if (*Str == '.')
+			{
+				if (bHasDot)
+				{
+					return false;
+				}
+				bHasDot = true;
+			}
+			else if (*Str >= '0' && *Str <= '9')
+			{
+				bHasDigit = true;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		return bHasDigit;
+	}
+
+	bool StartsWith(const TCHAR* Prefix) const { return Data.rfind(Prefix, 0) == 0; }
+	bool Contains(const TCHAR* Sub) const { return Data.find(Sub) != std::string::npos; }
+	FString Left(int32 Count) const { return FString(Data.substr(0, std::max(0, Count))); }
+	FString Mid(int32 Start, int32 Count = INT32_MAX) const { return Start >= Len() ? FString() : FString(Data.substr(Start, Count)); }
+
+	static FString Printf(const TCHAR* Fmt, ...) __attribute__((format(printf, 1, 2)))
+	{
+		va_list Args;
+		va_start(Args, Fmt);
+		va_list ArgsCopy;
+		va_copy(ArgsCopy, Args);
+		const int Needed = std::vsnprintf(nullptr, 0, Fmt, ArgsCopy);
+		va_end(ArgsCopy);
+		std::string Out(Needed > 0 ? Needed : 0, '\0');
+		std::vsnprintf(Out.data(), Out.size() + 1, Fmt, Args);
+		va_end(Args);
+		return FString(Out);
+	}
+
+	static FString FromInt(int64 Value) { return FString(std::to_string(Value)); }
+	static FString SanitizeFloat(double Value) { return Printf("%g", Value); }
+
+	SIZE_T GetAllocatedSize() const { return Data.capacity() > std::string().capacity() ? (Data.capacity() + 1) * sizeof(TCHAR) : 0; }
+
+	const std::string& ToStdString() const { return Data; }
+
+private:
+	std::string Data;
+};
+
+inline FString operator+(const TCHAR* A, const FString& B) { return FString(A) + B; }
+
+struct FCString
+{
+	static const TCHAR* Strifind(const TCHAR* Str, const TCHAR* Find)
+	{
+		const size_t FindLen = std::strlen(Find);
+		for (; *Str; ++Str)
+		{
+			if (strncasecmp(Str, Find, FindLen) == 0)
+			{
+				return Str;
+			}
+		}
+		return nullptr;
+	}
+	static double Atod(const TCHAR* Str) { return std::strtod(Str, nullptr); }
+	static int32 Atoi(const TCHAR* Str) { return (int32)std::strtol(Str, nullptr, 10); }
+	static int32 Strcmp(const TCHAR* A, const TCHAR* B) { return std::strcmp(A, B); }
+};
+
+struct FParse
+{
+	/** Mirrors FParse::Value for FString outputs: reads up to the next delimiter after Match. */
+	static bool Value(const TCHAR* Stream, const TCHAR* Match, FString& Out)
+	{
+		const TCHAR* Found = FCString::Strifind(Stream, Match);
+		if (Found == nullptr)
+		{
+			return false;
+		}
+		Found += std::strlen(Match);
+		const TCHAR* End = Found;
+		while (*End && *End != ' ' && *End != ',' && *End != ')' && *End != '\t')
+		{
+			++End;
+		}
+		Out = FString((int32)(End - Found), Found);
+		return true;
+	}
+	static bool Value(const TCHAR* Stream, const TCHAR* Match, int32& Out)
+	{
+		FString Temp;
+		if (!Value(Stream, Match, Temp))
+		{
+			return false;
+		}
+		Out = FCString::Atoi(*Temp);
+		return true;
+	}
+	static bool Value(const TCHAR* Stream, const TCHAR* Match, double& Out)
+	{
+		FString Temp;
+		if (!Value(Stream, Match, Temp))
+		{
+			return false;
+		}
+		Out = FCString::Atod(*Temp);
+		return true;
+	}
+	static bool Param(const TCHAR* Stream, const TCHAR* Param)
+	{
+		const size_t ParamLen = std::strlen(Param);
+		for (const TCHAR* Found = FCString::Strifind(Stream, Param); Found; Found = FCString::Strifind(Found + 1, Param))
+		{
+			if (Found > Stream && (Found[-1] == '-' || Found[-1] == '/') && (Found[ParamLen] == '\0' || Found[ParamLen] == ' '))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+class FName
+{
+public:
+	FName() = default;
+	FName(const TCHAR* In) : Name(In) {}
+	bool operator==(const FName& Other) const { return Name == Other.Name; }
+	bool operator==(const TCHAR* Other) const { return Name == FString(Other); }
+	FString ToString() const { return Name; }
+
+private:
+	FString Name;
+};
+
+inline const FName NAME_Vector(TEXT("Vector"));
+
+/*----------------------------------------------------------------------------
+	Containers
+----------------------------------------------------------------------------*/
+
+enum class EAllowShrinking { No, Yes };
+
+template <typename T>
+class TArray
+{
+public:
+	typedef int32 SizeType;
+	typedef T ElementType;
+
+	TArray() = default;
+	TArray(std::initializer_list<T> Init) : Data(Init) {}
+	TArray(const T* Ptr, int32 Count) : Data(Ptr, Ptr + Count) {}
+
+	int32 Num() const { return (int32)Data.size(); }
+	bool IsEmpty() const { return Data.empty(); }
+	bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < Num(); }
+	T* GetData() { return Data.data(); }
+	const T* GetData() const { return Data.data(); }
+	T& operator[](int32 Index) { return Data[Index]; }
+	const T& operator[](int32 Index) const { return Data[Index]; }
+	T& Last(int32 IndexFromTheEnd = 0) { return Data[Data.size() - 1 - IndexFromTheEnd]; }
+	const T& Last(int32 IndexFromTheEnd = 0) const { return Data[Data.size() - 1 - IndexFromTheEnd]; }
+
+	int32 Add(const T& Item) { Data.push_back(Item); return Num() - 1; }
+	int32 Add(T&& Item) { Data.push_back(std::move(Item)); return Num() - 1; }
+	template <typename... ArgTypes>
+	int32 Emplace(ArgTypes&&... Args) { Data.emplace_back(std::forward<ArgTypes>(Args)...); return Num() - 1; }
+	template <typename... ArgTypes>
+	T& Emplace_GetRef(ArgTypes&&... Args) { Data.emplace_back(std::forward<ArgTypes>(Args)...); return Data.back(); }
+	int32 AddUnique(const T& Item) { int32 Index = Find(Item); return Index != INDEX_NONE ? Index : Add(Item); }
+	int32 AddDefaulted(int32 Count = 1) { const int32 Index = Num(); Data.resize(Data.size() + Count); return Index; }
+	int32 AddZeroed(int32 Count = 1) { return AddDefaulted(Count); }
+	int32 AddUninitialized(int32 Count = 1) { return AddDefaulted(Count); }
+	void Append(const TArray& Other) { Data.insert(Data.end(), Other.Data.begin(), Other.Data.end()); }
+	void Append(const T* Ptr, int32 Count) { Data.insert(Data.end(), Ptr, Ptr + Count); }
+	void Insert(const T& Item, int32 Index) { Data.insert(Data.begin() + Index, Item); }
+	void RemoveAt(int32 Index, int32 Count = 1, EAllowShrinking = EAllowShrinking::Yes) { Data.erase(Data.begin() + Index, Data.begin() + Index + Count); }
+	void RemoveAtSwap(int32 Index, int32 Count = 1, EAllowShrinking = EAllowShrinking::Yes)
+	{
+		for (int32 Removed = 0; Removed < Count; ++Removed)
+		{
+			std::swap(Data[Index + Removed], Data.back());
+			Data.pop_back();
+		}
+	}
+	int32 RemoveSwap(const T& Item)
+	{
+		const int32 Before = Num();
+		for (int32 Index = Num() - 1; Index >= 0; --Index)
+		{
+			if (Data[Index] == Item)
+			{
+				RemoveAtSwap(Index);
+			}
+		}
+		return Before - Num();
+	}
+	T& AddDefaulted_GetRef() { Data.emplace_back(); return Data.back(); }
+	T Pop(EAllowShrinking = EAllowShrinking::Yes) { T Result = std::move(Data.back()); Data.pop_back(); return Result; }
+	int32 Find(const T& Item) const
+	{
+		for (int32 Index = 0; Index < Num(); ++Index)
+		{
+			if (Data[Index] == Item)
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+	bool Contains(const T& Item) const { return Find(Item) != INDEX_NONE; }
+	void Reserve(int32 Count) { Data.reserve(Count); }
+	void Empty(int32 Slack = 0) { Data.clear(); Data.reserve(Slack); }
+	void Reset(int32 Slack = 0) { Data.clear(); Data.reserve(Slack); }
+	void SetNum(int32 Count, EAllowShrinking = EAllowShrinking::Yes) { Data.resize(Count); }
+	void SetNumUninitialized(int32 Count, EAllowShrinking = EAllowShrinking::Yes) { Data.resize(Count); }
+	void SetNumZeroed(int32 Count, EAllowShrinking = EAllowShrinking::Yes) { Data.resize(Count); }
+	void Init(const T& Value, int32 Count) { Data.assign(Count, Value); }
+	void Shrink() { Data.shrink_to_fit(); }
+	int32 Max() const { return (int32)Data.capacity(); }
+	SIZE_T GetAllocatedSize() const { return Data.capacity() * sizeof(T); }
+	void Swap(int32 A, int32 B) { std::swap(Data[A], Data[B]); }
+	template <typename PredicateType>
+	void Sort(PredicateType Predicate) { std::sort(Data.begin(), Data.end(), Predicate); }
+	void Sort() { std::sort(Data.begin(), Data.end()); }
+	template <typename PredicateType>
+	void StableSort(PredicateType Predicate) { std::stable_sort(Data.begin(), Data.end(), Predicate); }
+	bool operator==(const TArray& Other) const { return Data == Other.Data; }
+	bool operator!=(const TArray& Other) const { return Data != Other.Data; }
+
+	auto begin() { return Data.begin(); }
+	auto end() { return Data.end(); }
+	auto begin() const { return Data.begin(); }
+	auto end() const { return Data.end(); }
+
+private:
+	std::vector<T> Data;
+};
+
+template <typename T>
+class TArrayView
+{
+public:
+	typedef std::remove_const_t<T> ElementType;
+
+	TArrayView() = default;
+	TArrayView(T* InData, int32 InNum) : DataPtr(InData), ArrayNum(InNum) {}
+	template <typename OtherT, std::enable_if_t<std::is_convertible_v<OtherT*, T*>, int> = 0>
+	TArrayView(const TArrayView<OtherT>& Other) : DataPtr(Other.GetData()), ArrayNum(Other.Num()) {}
+	TArrayView(TArray<ElementType>& InArray) : DataPtr(InArray.GetData()), ArrayNum(InArray.Num()) {}
+	template <typename U = T, std::enable_if_t<std::is_const_v<U>, int> = 0>
+	TArrayView(const TArray<ElementType>& InArray) : DataPtr(InArray.GetData()), ArrayNum(InArray.Num()) {}
+	TArrayView(std::initializer_list<ElementType> Init) : DataPtr(Init.begin()), ArrayNum((int32)Init.size()) {}
+
+	T* GetData() const { return DataPtr; }
+	int32 Num() const { return ArrayNum; }
+	bool IsEmpty() const { return ArrayNum == 0; }
+	bool IsValidIndex(int32 Index) const { return Index >= 0 && Index < ArrayNum; }
+	T& operator[](int32 Index) const { return DataPtr[Index]; }
+	TArrayView Slice(int32 Index, int32 InNum) const { return TArrayView(DataPtr + Index, InNum); }
+	TArrayView Left(int32 Count) const { return TArrayView(DataPtr, std::min(Count, ArrayNum)); }
+	T* begin() const { return DataPtr; }
+	T* end() const { return DataPtr + ArrayNum; }
+
+private:
+	T* DataPtr = nullptr;
+	int32 ArrayNum = 0;
+};
+
+template <typename T>
+using TConstArrayView = TArrayView<const T>;
+
+template <typename T>
+TArrayView<T> MakeArrayView(T* Data, int32 Num) { return TArrayView<T>(Data, Num); }
+
+template <typename T>
+TArrayView<T> MakeArrayView(TArray<T>& Array) { return TArrayView<T>(Array); }
+
+template <typename T>
+TArrayView<const T> MakeArrayView(const TArray<T>& Array) { return TArrayView<const T>(Array); }
+
+template <typename KeyType, typename ValueType>
+struct TPair
+{
+	KeyType Key;
+	ValueType Value;
+};
+
+template <typename T>
+FORCEINLINE typename std::remove_reference<T>::type&& MoveTemp(T&& Value) { return static_cast<typename std::remove_reference<T>::type&&>(Value); }
+
+template <typename T>
+FORCEINLINE void Swap(T& A, T& B) { std::swap(A, B); }
+
+namespace Algo
+{
+	template <typename RangeType>
+	void Sort(RangeType&& Range) { std::sort(Range.begin(), Range.end()); }
+
+	template <typename RangeType, typename PredicateType>
+	void Sort(RangeType&& Range, PredicateType Predicate) { std::sort(Range.begin(), Range.end(), Predicate); }
+
+	template <typename RangeType, typename PredicateType>
+	void StableSort(RangeType&& Range, PredicateType Predicate) { std::stable_sort(Range.begin(), Range.end(), Predicate); }
+
+	template <typename RangeType, typename ProjectionType>
+	void SortBy(RangeType&& Range, ProjectionType Projection)
+	{
+		std::sort(Range.begin(), Range.end(), [&Projection](const auto& A, const auto& B) { return Projection(A) < Projection(B); });
+	}
+}
+
+template <typename FuncType>
+using TFunctionRef = std::function<FuncType>;
+
+template <typename FuncType>
+using TFunction = std::function<FuncType>;
+
+/*----------------------------------------------------------------------------
+	Math
+----------------------------------------------------------------------------*/
+
+struct FMath
+{
+	template <typename T> static constexpr T Abs(const T A) { return A < T(0) ? -A : A; }
+	template <typename T> static constexpr T Min(const T A, const T B) { return A <= B ? A : B; }
+	template <typename T> static constexpr T Max(const T A, const T B) { return A >= B ? A : B; }
+	template <typename T> static T Min(const TArray<T>& Values, int32* MinIndex = nullptr) { int32 Best = INDEX_NONE; for (int32 I = 0; I < Values.Num(); ++I) { if (Best == INDEX_NONE || Values[I] < Values[Best]) { Best = I; } } if (MinIndex) { *MinIndex = Best; } return Best == INDEX_NONE ? T() : Values[Best]; }
+	template <typename T> static constexpr T Min3(const T A, const T B, const T C) { return Min(Min(A, B), C); }
+	template <typename T> static constexpr T Max3(const T A, const T B, const T C) { return Max(Max(A, B), C); }
+	template <typename T> static constexpr T Clamp(const T X, const T MinValue, const T MaxValue) { return X < MinValue ? MinValue : (X < MaxValue ? X : MaxValue); }
+	template <typename T> static constexpr T Square(const T A) { return A * A; }
+	template <typename T> static constexpr T DivideAndRoundUp(T Dividend, T Divisor) { return (Dividend + Divisor - 1) / Divisor; }
+	template <typename T> static constexpr T Sign(const T A) { return (A > (T)0) ? (T)1 : ((A < (T)0) ? (T)-1 : (T)0); }
+	static float Sin(float Value) { return std::sin(Value); }
+	static double Sin(double Value) { return std::sin(Value); }
+	static float Cos(float Value) { return std::cos(Value); }
+	static double Cos(double Value) { return std::cos(Value); }
+	static float Sqrt(float Value) { return std::sqrt(Value); }
+	static double Sqrt(double Value) { return std::sqrt(Value); }
+	static double InvSqrt(double Value) { return 1.0 / std::sqrt(Value); }
+	static double Floor(double Value) { return std::floor(Value); }
+	static double FloorToDouble(double Value) { return std::floor(Value); }
+	static int64 FloorToInt64(double Value) { return (int64)std::floor(Value); }
+	static double CeilToDouble(double Value) { return std::ceil(Value); }
+	static double LogX(double Base, double Value) { return std::log(Value) / std::log(Base); }
+	static int32 FloorToInt32(double Value) { return (int32)std::floor(Value); }
+	static double Fmod(double X, double Y) { return std::fmod(X, Y); }
+	static double Atan2(double Y, double X) { return std::atan2(Y, X); }
+	static bool IsNearlyZero(double Value, double Tolerance = UE_DOUBLE_SMALL_NUMBER) { return std::abs(Value) <= Tolerance; }
+	static bool IsFinite(double Value) { return std::isfinite(Value); }
+	static uint32 CeilLogTwo(uint32 Arg) { return Arg <= 1 ? 0 : 32 - __builtin_clz(Arg - 1); }
+	static uint32 RoundUpToPowerOfTwo(uint32 Arg) { return 1u << CeilLogTwo(Arg); }
+	static uint32 CountLeadingZeros(uint32 Value) { return Value == 0 ? 32 : __builtin_clz(Value); }
+	static uint64 CountLeadingZeros64(uint64 Value) { return Value == 0 ? 64 : __builtin_clzll(Value); }
+};
+
+namespace UE
+{
+namespace Math
+{
+	template <typename T>
+	struct TVector
+	{
+		T X, Y, Z;
+
+		static const TVector ZeroVector;
+
+		TVector() = default;
+		TVector(T InF) : X(InF), Y(InF), Z(InF) {}
+		TVector(T InX, T InY, T InZ) : X(InX), Y(InY), Z(InZ) {}
+		TVector operator+(const TVector& V) const { return TVector(X + V.X, Y + V.Y, Z + V.Z); }
+		TVector operator-(const TVector& V) const { return TVector(X - V.X, Y - V.Y, Z - V.Z); }
+		TVector operator*(T Scale) const { return TVector(X * Scale, Y * Scale, Z * Scale); }
+		TVector& operator+=(const TVector& V) { X += V.X; Y += V.Y; Z += V.Z; return *this; }
+		T operator|(const TVector& V) const { return X * V.X + Y * V.Y + Z * V.Z; }
+		TVector operator^(const TVector& V) const { return TVector(Y * V.Z - Z * V.Y, Z * V.X - X * V.Z, X * V.Y - Y * V.X); }
+		bool operator==(const TVector& V) const { return X == V.X && Y == V.Y && Z == V.Z; }
+		T& operator[](int32 Index) { return (&X)[Index]; }
+		T operator[](int32 Index) const { return (&X)[Index]; }
+		TVector ComponentMin(const TVector& V) const { return TVector(std::min(X, V.X), std::min(Y, V.Y), std::min(Z, V.Z)); }
+		TVector ComponentMax(const TVector& V) const { return TVector(std::max(X, V.X), std::max(Y, V.Y), std::max(Z, V.Z)); }
+		T SizeSquared() const { return X * X + Y * Y + Z * Z; }
+		T Size() const { return std::sqrt(SizeSquared()); }
+		static T DistSquared(const TVector& A, const TVector& B) { return (A - B).SizeSquared(); }
+		static T Dist(const TVector& A, const TVector& B) { return (A - B).Size(); }
+	};
+
+	template <typename T>
+	const TVector<T> TVector<T>::ZeroVector(0, 0, 0);
+
+	template <typename T>
+	struct TVector2
+	{
+		T X, Y;
+	};
+
+	template <typename T>
+	struct TVector4
+	{
+		T X, Y, Z, W;
+	};
+
+	template <typename T>
+	struct TPlane : public TVector<T>
+	{
+		T W;
+	};
+
+	template <typename T>
+	struct TIntVector3
+	{
+		T X, Y, Z;
+
+		TIntVector3() = default;
+		TIntVector3(T InX, T InY, T InZ) : X(InX), Y(InY), Z(InZ) {}
+		bool operator==(const TIntVector3& Other) const { return X == Other.X && Y == Other.Y && Z == Other.Z; }
+		bool operator!=(const TIntVector3& Other) const { return !(*this == Other); }
+	};
+
+	template <typename T>
+	struct TIntPoint
+	{
+		T X, Y;
+	};
+
+	template <typename T>
+	struct TRotator
+	{
+		T Pitch, Yaw, Roll;
+	};
+
+	template <typename T>
+	struct TQuat
+	{
+		T X, Y, Z, W;
+	};
+}
+}
+
+typedef UE::Math::TVector<double> FVector;
+typedef UE::Math::TVector<double> FVector3d;
+typedef UE::Math::TVector<float> FVector3f;
+typedef UE::Math::TIntVector3<int32> FIntVector;
+typedef UE::Math::TIntVector3<int64> FInt64Vector;
+
+template <typename T, typename U>
+struct TIsUECoreVariant
+{
+	static constexpr bool Value = false;
+};
+
+struct FLinearColor
+{
+	float R, G, B, A;
+};
+
+struct FCrc
+{
+	static uint32 MemCrc32(const void* Data, int32 Length, uint32 CRC = 0)
+	{
+		const uint8* Bytes = static_cast<const uint8*>(Data);
+		CRC = ~CRC;
+		for (int32 Index = 0; Index < Length; ++Index)
+		{
+			CRC ^= Bytes[Index];
+			for (int32 Bit = 0; Bit < 8; ++Bit)
+			{
+				CRC = (CRC >> 1) ^ (0xEDB88320u & (0u - (CRC & 1u)));
+			}
+		}
+		return ~CRC;
+	}
+	static uint32 MemCrc_DEPRECATED(const void* Data, int32 Length, uint32 CRC = 0) { return MemCrc32(Data, Length, CRC); }
+};
+
+inline uint32 HashCombine(uint32 A, uint32 C)
+{
+	return A ^ (C + 0x9e3779b9u + (A << 6) + (A >> 2));
+}
+
+inline uint32 GetTypeHash(int64 Value) { return (uint32)Value ^ (uint32)(Value >> 32); }
+
+inline uint32 GetTypeHash(const FInt64Vector& Vector) { return HashCombine(HashCombine(GetTypeHash(Vector.X), GetTypeHash(Vector.Y)), GetTypeHash(Vector.Z)); }
+
+/** Hash map with the subset of TMap's interface the plugin uses. */
+template <typename KeyType, typename ValueType>
+class TMap
+{
+public:
+	int32 Num() const { return (int32)Data.size(); }
+	ValueType& Add(const KeyType& Key, const ValueType& Value) { return Data.insert_or_assign(Key, Value).first->second; }
+	ValueType& FindOrAdd(const KeyType& Key) { return Data[Key]; }
+	ValueType* Find(const KeyType& Key) { auto It = Data.find(Key); return It != Data.end() ? &It->second : nullptr; }
+	const ValueType* Find(const KeyType& Key) const { auto It = Data.find(Key); return It != Data.end() ? &It->second : nullptr; }
+	const ValueType& FindChecked(const KeyType& Key) const { return Data.at(Key); }
+	bool Contains(const KeyType& Key) const { return Data.count(Key) != 0; }
+	int32 Remove(const KeyType& Key) { return (int32)Data.erase(Key); }
+	void Reset() { Data.clear(); }
+	void Empty() { Data.clear(); }
+	void Reserve(int32 Number) { Data.reserve(Number); }
+
+private:
+	struct FHasher
+	{
+		size_t operator()(const KeyType& Key) const { return GetTypeHash(Key); }
+	};
+
+	std::unordered_map<KeyType, ValueType, FHasher> Data;
+};
+
+/*----------------------------------------------------------------------------
+	Text
+----------------------------------------------------------------------------*/
+
+enum ERoundingMode { HalfToEven, HalfFromZero, HalfToZero, FromZero, ToZero, ToNegativeInfinity, ToPositiveInfinity };
+
+struct FNumberFormattingOptions
+{
+	bool AlwaysSign = false;
+	bool UseGrouping = true;
+	ERoundingMode RoundingMode = HalfToEven;
+	int32 MinimumIntegralDigits = 1;
+	int32 MaximumIntegralDigits = 324;
+	int32 MinimumFractionalDigits = 0;
+	int32 MaximumFractionalDigits = 3;
+
+	FNumberFormattingOptions& SetAlwaysSign(bool bValue) { AlwaysSign = bValue; return *this; }
+	FNumberFormattingOptions& SetUseGrouping(bool bValue) { UseGrouping = bValue; return *this; }
+	FNumberFormattingOptions& SetRoundingMode(ERoundingMode Value) { RoundingMode = Value; return *this; }
+	FNumberFormattingOptions& SetMinimumFractionalDigits(int32 Value) { MinimumFractionalDigits = Value; return *this; }
+	FNumberFormattingOptions& SetMaximumFractionalDigits(int32 Value) { MaximumFractionalDigits = Value; return *this; }
+};
+
+struct FNumberParsingOptions
+{
+	bool UseGrouping = true;
+	bool InsideLimits = false;
+	bool UseClamping = false;
+
+	FNumberParsingOptions& SetUseGrouping(bool bValue) { UseGrouping = bValue; return *this; }
+	FNumberParsingOptions& SetInsideLimits(bool bValue) { InsideLimits = bValue; return *this; }
+	FNumberParsingOptions& SetUseClamping(bool bValue) { UseClamping = bValue; return *this; }
+};
+
+class FText
+{
+public:
+	FText() = default;
+	static FText FromString(const FString& In) { FText Result; Result.Str = In; return Result; }
+	static FText AsNumber(double Value, const FNumberFormattingOptions* Options = nullptr)
+	{
+		return FromString(FString::Printf(TEXT("%.*f"), Options ? (int)Options->MinimumFractionalDigits : 0, Value));
+	}
+	template <typename ArgsType>
+	static FText Format(const FText& Pattern, const ArgsType& Args) { return Pattern; }
+	const FString& ToString() const { return Str; }
+
+private:
+	FString Str;
+};
+
+class FFormatNamedArguments
+{
+public:
+	void Add(const TCHAR* Key, double Value) {}
+	void Add(const TCHAR* Key, const FText& Value) {}
+};
+
+#define NSLOCTEXT(Namespace, Key, Text) FText::FromString(TEXT(Text))
+#define LOCTEXT(Key, Text) FText::FromString(TEXT(Text))
+
+/*----------------------------------------------------------------------------
+	Serialization
+----------------------------------------------------------------------------*/
+
+class UPackageMap;
+
+class FArchive
+{
+public:
+	virtual ~FArchive() = default;
+	bool IsLoading() const { return bIsLoading; }
+	bool IsSaving() const { return !bIsLoading; }
+	virtual FArchive& operator<<(FString& Value) { return *this; }
+	virtual void Serialize(void* Data, int64 Length) {}
+
+protected:
+	bool bIsLoading = false;
+};
+
+class FStructuredArchive
+{
+public:
+	class FSlot
+	{
+	public:
+		explicit FSlot(FArchive& InAr) : Ar(InAr) {}
+		FArchive& GetUnderlyingArchive() const { return Ar; }
+		void operator<<(FString& Value) { Ar << Value; }
+
+	private:
+		FArchive& Ar;
+	};
+};
+
+/*----------------------------------------------------------------------------
+	Platform
+----------------------------------------------------------------------------*/
+
+struct FPlatformTime
+{
+	static double Seconds()
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	static uint64 Cycles64()
+	{
+		return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+	static uint32 Cycles() { return (uint32)Cycles64(); }
+	static double GetSecondsPerCycle64() { return 1.e-9; }
+	static double GetSecondsPerCycle() { return 1.e-9; }
+	static double ToMilliseconds64(uint64 Cycles) { return Cycles * 1.e-6; }
+};
+
+struct FPlatformMisc
+{
+	static int32 NumberOfCores() { return (int32)std::max(1u, std::thread::hardware_concurrency()); }
+	static int32 NumberOfCoresIncludingHyperthreads() { return NumberOfCores(); }
+	static int32 NumberOfWorkerThreadsToSpawn() { return std::max(1, NumberOfCores() - 1); }
+	static const TCHAR* GetPlatformName() { return TEXT("Linux"); }
+};
+
+/** Deterministic random stream, same generator as the engine's FRandomStream. */
+struct FRandomStream
+{
+	int32 InitialSeed = 0;
+	mutable uint32 Seed = 0;
+
+	FRandomStream() = default;
+	FRandomStream(int32 InSeed) : InitialSeed(InSeed), Seed(uint32(InSeed)) {}
+	void Initialize(int32 InSeed) { InitialSeed = InSeed; Seed = uint32(InSeed); }
+	void Reset() const { Seed = uint32(InitialSeed); }
+	void MutateSeed() const { Seed = (Seed * 196314165U) + 907633515U; }
+	float GetFraction() const { MutateSeed(); union { float F; uint32 I; } Result; Result.I = 0x3F800000U | (Seed >> 9); return Result.F - 1.0f; }
+	float FRand() const { return GetFraction(); }
+	uint32 GetUnsignedInt() const { MutateSeed(); return Seed; }
+	int32 RandHelper(int32 A) const { return A > 0 ? std::min((int32)std::trunc(GetFraction() * float(A)), A - 1) : 0; }
+	int32 RandRange(int32 Min, int32 Max) const { const int32 Range = (Max - Min) + 1; return Min + RandHelper(Range); }
+	float FRandRange(float InMin, float InMax) const { return InMin + (InMax - InMin) * FRand(); }
+};
+
+struct FMemory
+{
+	static void* Malloc(SIZE_T Size, uint32 Alignment = 16) { return std::aligned_alloc(Alignment, (Size + Alignment - 1) / Alignment * Alignment); }
+	static void Free(void* Ptr) { std::free(Ptr); }
+	static void* Memcpy(void* Dest, const void* Src, SIZE_T Count) { return std::memcpy(Dest, Src, Count); }
+	static void* Memzero(void* Dest, SIZE_T Count) { return std::memset(Dest, 0, Count); }
+	static int32 Memcmp(const void* A, const void* B, SIZE_T Count) { return std::memcmp(A, B, Count); }
+};
+
+class FCriticalSection
+{
+public:
+	void Lock() { Mutex.lock(); }
+	void Unlock() { Mutex.unlock(); }
+
+private:
+	std::mutex Mutex;
+};
+
+class FScopeLock
+{
+public:
+	explicit FScopeLock(FCriticalSection* InSection) : Section(InSection) { Section->Lock(); }
+	~FScopeLock() { Section->Unlock(); }
+
+private:
+	FCriticalSection* Section;
+};
+
+class FRWLock
+{
+public:
+	void ReadLock() { Mutex.lock_shared(); }
+	void ReadUnlock() { Mutex.unlock_shared(); }
+	void WriteLock() { Mutex.lock(); }
+	void WriteUnlock() { Mutex.unlock(); }
+
+private:
+	std::shared_mutex Mutex;
+};
+
+class FReadScopeLock
+{
+public:
+	explicit FReadScopeLock(FRWLock& InLock) : Lock(InLock) { Lock.ReadLock(); }
+	~FReadScopeLock() { Lock.ReadUnlock(); }
+
+private:
+	FRWLock& Lock;
+};
+
+class FWriteScopeLock
+{
+public:
+	explicit FWriteScopeLock(FRWLock& InLock) : Lock(InLock) { Lock.WriteLock(); }
+	~FWriteScopeLock() { Lock.WriteUnlock(); }
+
+private:
+	FRWLock& Lock;
+};
+
+/*----------------------------------------------------------------------------
+	Logging
+----------------------------------------------------------------------------*/
+
+struct FLogCategoryBase
+{
+	const TCHAR* Name;
+};
+
+#define DECLARE_LOG_CATEGORY_EXTERN(Name, Verbosity, CompileVerbosity) extern FLogCategoryBase Name;
+#define DEFINE_LOG_CATEGORY(Name) FLogCategoryBase Name{ TEXT(#Name) };
+#define DECLARE_LOG_CATEGORY_CLASS(Name, Verbosity, CompileVerbosity) static FLogCategoryBase Name{ TEXT(#Name) };
+#define DEFINE_LOG_CATEGORY_STATIC(Name, Verbosity, CompileVerbosity) static FLogCategoryBase Name{ TEXT(#Name) };
+
+inline FLogCategoryBase LogTemp{ TEXT("LogTemp") };
+
+#define UE_LOG(Category, Verbosity, Format, ...) \
+	std::fprintf(stderr, "%s: %s: " Format "\n", (Category).Name, #Verbosity, ##__VA_ARGS__)
+#define MAX_int16 ((int16)0x7fff)
+
+template <typename T>
+constexpr T Align(T Val, uint64 Alignment)
+{
+	return (T)(((uint64)Val + Alignment - 1) & ~(Alignment - 1));
+}
@@ -0,0 +1,3 @@
+// Stand-in for UnrealHeaderTool output, the reflection macros in CoreMinimal.h expand to nothing.
+
+#pragma once
@@ -0,0 +1,81 @@
+// Stand-in for HAL/IConsoleManager.h: console variables and commands without a console.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum EConsoleVariableFlags
+{
+	ECVF_Default = 0,
+	ECVF_Cheat = 1,
+	ECVF_ReadOnly = 4,
+	ECVF_Scalability = 0x10,
+};
+
+template <typename T>
+class TAutoConsoleVariable
+{
+public:
+	TAutoConsoleVariable(const TCHAR* Name, const T& DefaultValue, const TCHAR* Help, uint32 Flags = ECVF_Default)
+		: Value(DefaultValue)
+	{
+	}
+
+	T GetValueOnAnyThread() const { return Value.load(std::memory_order_relaxed); }
+	T GetValueOnGameThread() const { return GetValueOnAnyThread(); }
+
+	struct FSetter
+	{
+		std::atomic<T>& Target;
+		void Set(T NewValue, uint32 SetBy = 0) { Target.store(NewValue, std::memory_order_relaxed); }
+	};
+
+	FSetter* operator->() { Setter.reset(new FSetter{ Value }); return Setter.get(); }
+
+private:
+	std::atomic<T> Value;
+	std::unique_ptr<FSetter> Setter;
+};
+
+enum ECVFSetBy { ECVF_SetByCode = 0x08000000 };
+
+template <typename T>
+class FAutoConsoleVariableRef
+{
+};
+
+class FOutputDevice
+{
+public:
+	virtual ~FOutputDevice() = default;
+	virtual void Log(const FString& Line) { std::fprintf(stdout, "%s\n", *Line); }
+	template <typename... ArgTypes>
+	void Logf(const TCHAR* Fmt, ArgTypes... Args) { Log(FString::Printf(Fmt, Args...)); }
+};
+
+inline FOutputDevice* GLog = new FOutputDevice();
+
+struct FConsoleCommandDelegate
+{
+	std::function<void()> Func;
+	template <typename FuncType>
+	static FConsoleCommandDelegate CreateStatic(FuncType InFunc) { return FConsoleCommandDelegate{ InFunc }; }
+	template <typename FuncType>
+	static FConsoleCommandDelegate CreateLambda(FuncType InFunc) { return FConsoleCommandDelegate{ InFunc }; }
+};
+
+struct FConsoleCommandWithArgsDelegate
+{
+	std::function<void(const TArray<FString>&)> Func;
+	template <typename FuncType>
+	static FConsoleCommandWithArgsDelegate CreateStatic(FuncType InFunc) { return FConsoleCommandWithArgsDelegate{ InFunc }; }
+	template <typename FuncType>
+	static FConsoleCommandWithArgsDelegate CreateLambda(FuncType InFunc) { return FConsoleCommandWithArgsDelegate{ InFunc }; }
+};
+
+class FAutoConsoleCommand
+{
+public:
+	FAutoConsoleCommand(const TCHAR* Name, const TCHAR* Help, const FConsoleCommandDelegate& Command, uint32 Flags = ECVF_Default) {}
+	FAutoConsoleCommand(const TCHAR* Name, const TCHAR* Help, const FConsoleCommandWithArgsDelegate& Command, uint32 Flags = ECVF_Default) {}
+};
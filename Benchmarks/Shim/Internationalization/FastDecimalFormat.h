@@ -0,0 +1,52 @@
+// Stand-in for Internationalization/FastDecimalFormat.h (culture agnostic rules only).
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FDecimalNumberFormattingRules
+{
+};
+
+namespace FastDecimalFormat
+{
+	inline const FDecimalNumberFormattingRules& GetCultureAgnosticFormattingRules()
+	{
+		static const FDecimalNumberFormattingRules Rules;
+		return Rules;
+	}
+
+	inline void NumberToString(double InVal, const FDecimalNumberFormattingRules& InFormattingRules, const FNumberFormattingOptions& InFormattingOptions, FString& OutString)
+	{
+		char Buffer[512];
+		std::snprintf(Buffer, sizeof(Buffer), "%.*f", (int)InFormattingOptions.MaximumFractionalDigits, InVal);
+
+		// Trim trailing zeros beyond the minimum fractional digits, as the engine formatter does.
+		char* Dot = std::strchr(Buffer, '.');
+		if (Dot != nullptr)
+		{
+			char* End = Buffer + std::strlen(Buffer) - 1;
+			char* MinEnd = Dot + InFormattingOptions.MinimumFractionalDigits;
+			while (End > MinEnd && *End == '0')
+			{
+				*End-- = '\0';
+			}
+			if (End == Dot)
+			{
+				*End = '\0';
+			}
+		}
+		if (std::strcmp(Buffer, "-0") == 0)
+		{
+			std::strcpy(Buffer, "0");
+		}
+		OutString = Buffer;
+	}
+
+	inline bool StringToNumber(const TCHAR* InStr, const FDecimalNumberFormattingRules& InFormattingRules, const FNumberParsingOptions& InParsingOptions, double& OutVal)
+	{
+		char* End = nullptr;
+		OutVal = std::strtod(InStr, &End);
+		return End != InStr;
+	}
+}
@@ -0,0 +1,8 @@
+// Stand-in for Kismet/BlueprintFunctionLibrary.h.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UObject {};
+class UBlueprintFunctionLibrary : public UObject {};
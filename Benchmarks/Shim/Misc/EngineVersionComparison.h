@@ -0,0 +1,6 @@
+// Stand-in for Misc/EngineVersionComparison.h, the shim follows the current engine API.
+
+#pragma once
+
+#define UE_VERSION_NEWER_THAN(MajorVersion, MinorVersion, PatchVersion) 1
+#define UE_VERSION_OLDER_THAN(MajorVersion, MinorVersion, PatchVersion) 0
@@ -0,0 +1,5 @@
+// Stand-in for ProfilingDebugging/CpuProfilerTrace.h: the benchmark build has CPUPROFILERTRACE_ENABLED 0, so no trace macro is ever expanded.
+
+#pragma once
+
+#include "CoreMinimal.h"
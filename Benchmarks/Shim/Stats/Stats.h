@@ -0,0 +1,5 @@
+// Stand-in for Stats/Stats.h: the benchmark build has STATS 0, so no stat macro is ever expanded.
+
+#pragma once
+
+#include "CoreMinimal.h"
@@ -0,0 +1,56 @@
+// Standalone Linux run of the DecimalNumber.Cases automation tests, see Private/Tests/DecimalTestCases.h.
+//
+//   TestCases         runs every case, exit code 1 if any fails
+//   TestCases Name    runs one case
+//   TestCases --list  prints the case names
+
+#include "DecimalTestCases.h"
+#include "Async/ParallelFor.h"
+
+int main(int argc, char** argv)
+{
+	const bool bList = argc > 1 && std::strcmp(argv[1], "--list") == 0;
+	const char* Filter = (argc > 1 && !bList) ? argv[1] : nullptr;
+
+	// On a single core every ParallelFor would run on the calling thread, the parallel paths need real workers.
+	ParallelForShim::MaxWorkers() = std::max(ParallelForShim::MaxWorkers(), 4);
+
+	int32 NumRun = 0;
+	int32 NumFailed = 0;
+	for (const DecimalTestCases::FCase& Case : DecimalTestCases::GetCases())
+	{
+		if (bList)
+		{
+			std::printf("%s\n", Case.Name);
+			continue;
+		}
+		if (Filter != nullptr && std::strcmp(Filter, Case.Name) != 0)
+		{
+			continue;
+		}
+
+		DecimalTestCases::FContext Context;
+		Case.Run(Context);
+		++NumRun;
+
+		std::printf("%-20s %s\n", Case.Name, Context.Errors.Num() == 0 ? "ok" : "FAILED");
+		for (const FString& Error : Context.Errors)
+		{
+			std::printf("    %s\n", *Error);
+		}
+		NumFailed += Context.Errors.Num() > 0 ? 1 : 0;
+	}
+
+	if (bList)
+	{
+		return 0;
+	}
+	if (NumRun == 0)
+	{
+		std::printf("No case named %s\n", Filter);
+		return 1;
+	}
+
+	std::printf("%d of %d cases failed\n", NumFailed, NumRun);
+	return NumFailed > 0 ? 1 : 0;
+}
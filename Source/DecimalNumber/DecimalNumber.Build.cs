@@ -19,36 +19,40 @@ public class DecimalNumber : ModuleRules
 		
 		//string ThirdPartyDir = Path.Combine(ModuleDirectory, "../../ThirdParty/boost_multiprecision_1.8.5");
 		
-		PublicIncludePaths.Add(Path.Combine(ThirdPartyDir, "include"));
-		
-		PublicAdditionalLibraries.AddRange(
-			new string[]
-			{
-				Path.Combine(ThirdPartyDir, "lib/boost_system-vc144-mt-x64-1_85.lib"),
-				Path.Combine(ThirdPartyDir, "lib/boost_container-vc144-mt-x64-1_85.lib"),
-				Path.Combine(ThirdPartyDir, "lib/boost_random-vc144-mt-x64-1_85.lib"),
-				Path.Combine(ThirdPartyDir, "lib/boost_regex-vc144-mt-x64-1_85.lib")
-			});
+		// Boost is private: only the module's sources see it, through Private/DecimalBackend.h. Public headers that include
+		// boost fail to compile in dependent modules.
+		PrivateIncludePaths.Add(Path.Combine(ThirdPartyDir, "include"));
+
+		// Numeric type behind FDecimal, see DecimalBackend.h: 0 = cpp_dec_float_50, 1 = cpp_bin_float_50, 2 = 128-bit fixed point (needs __int128, so GCC or Clang).
+		PublicDefinitions.Add("DECIMALNUMBER_BACKEND=0");
+
+		// 1 adds construction and arithmetic to the DecimalNumber stat group and trace channel, see DecimalStats.h. Costs more than those operations themselves.
+		PublicDefinitions.Add("DECIMALNUMBER_STATS_VERBOSE=0");
 		
-		PublicDelayLoadDLLs.AddRange(
-			new string[]
+		// FDecimal is header-only: no compiled boost library is linked or loaded, and MSVC auto-linking is turned off.
+		PublicDefinitions.Add("BOOST_ALL_NO_LIB=1");
+
+		// Optional compiled boost libraries for other code in the project, one folder per platform
+		// (lib/Win64/*.lib, lib/Linux/*.a, ...). Static libraries only, so nothing is loaded at startup.
+		string PlatformLibDir = Path.Combine(ThirdPartyDir, "lib", Target.Platform.ToString());
+		if (Directory.Exists(PlatformLibDir))
+		{
+			foreach (string Library in Directory.GetFiles(PlatformLibDir))
 			{
-				Path.Combine(ThirdPartyDir,"boost_container-vc144-mt-x64-1_85.dll"),
-				Path.Combine(ThirdPartyDir,"boost_random-vc144-mt-x64-1_85.dll"),
-				Path.Combine(ThirdPartyDir,"boost_regex-vc144-mt-x64-1_85.dll"),
-				Path.Combine(ThirdPartyDir,"boost_system-vc144-mt-x64-1_85.dll")
-			});
-		
-		RuntimeDependencies.Add(Path.Combine(ThirdPartyDir, "bin/boost_container-vc144-mt-x64-1_85.dll"));
-		RuntimeDependencies.Add(Path.Combine(ThirdPartyDir, "bin/boost_random-vc144-mt-x64-1_85.dll"));
-		RuntimeDependencies.Add(Path.Combine(ThirdPartyDir, "bin/boost_regex-vc144-mt-x64-1_85.dll"));
-		RuntimeDependencies.Add(Path.Combine(ThirdPartyDir, "bin/boost_system-vc144-mt-x64-1_85.dll"));
+				if (Library.EndsWith(".lib") || Library.EndsWith(".a"))
+				{
+					PublicAdditionalLibraries.Add(Library);
+				}
+			}
+		}
 		
+		// CoreUObject and Engine are public: UDecimalRebaseSubsystem in Public/ derives from UTickableWorldSubsystem.
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
 				"Core",
-				"Projects"
+				"CoreUObject",
+				"Engine"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
@@ -57,8 +61,6 @@ public class DecimalNumber : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"CoreUObject",
-				"Engine"
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -1,4 +1,6 @@
 #include "Decimal.h"
+#include "DecimalBackend.h"
+#include "DecimalStats.h"
 #include "Internationalization/FastDecimalFormat.h"
 
 namespace DecimalHelper
@@ -25,68 +27,80 @@ namespace DecimalHelper
 	}
 }
 
-FDecimal FDecimal::ConstantPI = FDecimal(boost::math::constants::pi<InternalValueType>());
+#if DECIMALNUMBER_COUNT_COPIES
+std::atomic<uint64> GDecimalBytesCopied(0);
+#endif
 
-FDecimal::FDecimal()
-{
-}
+FDecimal FDecimal::ConstantPI = FDecimal::FromValue(DecimalBackend::Pi());
 
-FDecimal::FDecimal(const InternalValueType& InVal)
-	: InternalValue(InVal)
+FDecimal::FDecimal()
 {
+	new (Storage) DecimalBackend::FValue();
 }
 
 FDecimal::FDecimal(const FDecimal& InVal)
-	: InternalValue(InVal.InternalValue)
 {
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Construct);
+	new (Storage) DecimalBackend::FValue(InVal.GetValue());
+	DECIMAL_COUNT_COPY();
 }
 
 FDecimal::FDecimal(const FString& InVal)
+	: FDecimal()
 {
 	*this = InVal;
 }
 
 FDecimal::FDecimal(int32 InVal)
-	: InternalValue(InVal)
 {
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Construct);
+	new (Storage) DecimalBackend::FValue(InVal);
 }
 
 FDecimal::FDecimal(uint32 InVal)
-	: InternalValue(InVal)
 {
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Construct);
+	new (Storage) DecimalBackend::FValue(InVal);
 }
 
 FDecimal::FDecimal(int64 InVal)
-	: InternalValue(InVal)
 {
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Construct);
+	new (Storage) DecimalBackend::FValue(InVal);
 }
 
 FDecimal::FDecimal(uint64 InVal)
-	: InternalValue(InVal)
 {
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Construct);
+	new (Storage) DecimalBackend::FValue(InVal);
 }
 
 FDecimal::FDecimal(float InVal)
+	: FDecimal()
 {
 	*this = InVal;
 }
 
 FDecimal::FDecimal(double InVal)
+	: FDecimal()
 {
 	*this = InVal;
 }
 
 FDecimal& FDecimal::operator=(const FDecimal& Other)
 {
-	InternalValue = Other.InternalValue;
+	DECIMAL_COUNT_COPY();
+	GetValue() = Other.GetValue();
 	return *this;
 }
 
 FDecimal& FDecimal::operator=(const FString& Other)
 {
+	DECIMAL_SCOPE_COUNTER(FromString);
+	DECIMAL_CONVERSION_SCOPE(FromString);
 	if (Other.IsNumeric())
 	{
-		InternalValue = InternalValueType(TCHAR_TO_ANSI(*Other));
+		GetValue() = DecimalBackend::FValue(TCHAR_TO_ANSI(*Other));
 	}
 
 	return *this;
@@ -94,49 +108,56 @@ FDecimal& FDecimal::operator=(const FString& Other)
 
 FDecimal& FDecimal::operator=(int32 Other)
 {
-	InternalValue = Other;
+	GetValue() = Other;
 	return *this;
 }
 
 FDecimal& FDecimal::operator=(uint32 Other)
 {
-	InternalValue = Other;
+	GetValue() = Other;
 	return *this;
 }
 
 FDecimal& FDecimal::operator=(int64 Other)
 {
-	InternalValue = Other;
+	GetValue() = Other;
 	return *this;
 }
 
 FDecimal& FDecimal::operator=(uint64 Other)
 {
-	InternalValue = Other;
+	GetValue() = Other;
 	return *this;
 }
 
 FDecimal& FDecimal::operator=(float Other)
 {
+	DECIMAL_SCOPE_COUNTER(FromFloat);
+	DECIMAL_CONVERSION_SCOPE(FromFloat);
 	FString ConvertedStr;
 	DecimalHelper::ConvertValueToString(Other, ConvertedStr);
-	InternalValue = InternalValueType(TCHAR_TO_ANSI(*ConvertedStr));
+	DECIMAL_COUNT_ALLOCATION(ConvertedStr);
+	GetValue() = DecimalBackend::FValue(TCHAR_TO_ANSI(*ConvertedStr));
 
 	return *this;
 }
 
 FDecimal& FDecimal::operator=(double Other)
 {
+	DECIMAL_SCOPE_COUNTER(FromFloat);
+	DECIMAL_CONVERSION_SCOPE(FromFloat);
 	FString ConvertedStr;
 	DecimalHelper::ConvertValueToString(Other, ConvertedStr);
-	InternalValue = InternalValueType(TCHAR_TO_ANSI(*ConvertedStr));
+	DECIMAL_COUNT_ALLOCATION(ConvertedStr);
+	GetValue() = DecimalBackend::FValue(TCHAR_TO_ANSI(*ConvertedStr));
 
 	return *this;
 }
 
 FDecimal FDecimal::operator+=(const FDecimal& Other)
 {
-	InternalValue += Other.InternalValue;
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Arithmetic);
+	GetValue() += Other.GetValue();
 	return *this;
 }
 
@@ -177,8 +198,9 @@ FDecimal FDecimal::operator+=(double Other)
 
 FDecimal FDecimal::operator+(const FDecimal& Other) const
 {
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Arithmetic);
 	FDecimal Result(*this);
-	Result.InternalValue += Other.InternalValue;
+	Result.GetValue() += Other.GetValue();
 
 	return Result;
 }
@@ -191,7 +213,7 @@ FDecimal FDecimal::operator+(const FString& Other) const
 		return FDecimal();
 	}
 
-	Result.InternalValue += InternalValue;
+	Result.GetValue() += GetValue();
 
 	return Result;
 }
@@ -228,7 +250,8 @@ FDecimal FDecimal::operator+(double Other) const
 
 FDecimal FDecimal::operator-=(const FDecimal& Other)
 {
-	InternalValue -= Other.InternalValue;
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Arithmetic);
+	GetValue() -= Other.GetValue();
 	return *this;
 }
 
@@ -269,8 +292,9 @@ FDecimal FDecimal::operator-=(double Other)
 
 FDecimal FDecimal::operator-(const FDecimal& Other) const
 {
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Arithmetic);
 	FDecimal Result(*this);
-	Result.InternalValue -= Other.InternalValue;
+	Result.GetValue() -= Other.GetValue();
 	return Result;
 }
 
@@ -282,7 +306,7 @@ FDecimal FDecimal::operator-(const FString& Other) const
 		return FDecimal();
 	}
 
-	Result.InternalValue -= InternalValue;
+	Result.GetValue() -= GetValue();
 
 	return Result;
 }
@@ -319,7 +343,8 @@ FDecimal FDecimal::operator-(double Other) const
 
 FDecimal FDecimal::operator*=(const FDecimal& Other)
 {
-	InternalValue *= Other.InternalValue;
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Arithmetic);
+	GetValue() *= Other.GetValue();
 	return *this;
 }
 
@@ -360,8 +385,9 @@ FDecimal FDecimal::operator*=(double Other)
 
 FDecimal FDecimal::operator*(const FDecimal& Other) const
 {
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Arithmetic);
 	FDecimal Result(*this);
-	Result.InternalValue *= Other.InternalValue;
+	Result.GetValue() *= Other.GetValue();
 	return Result;
 }
 
@@ -373,7 +399,7 @@ FDecimal FDecimal::operator*(const FString& Other) const
 		return FDecimal();
 	}
 
-	Result.InternalValue *= InternalValue;
+	Result.GetValue() *= GetValue();
 
 	return Result;
 }
@@ -410,7 +436,8 @@ FDecimal FDecimal::operator*(double Other) const
 
 FDecimal FDecimal::operator/=(const FDecimal& Other)
 {
-	InternalValue /= Other.InternalValue;
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Arithmetic);
+	GetValue() /= Other.GetValue();
 	return *this;
 }
 
@@ -451,8 +478,9 @@ FDecimal FDecimal::operator/=(double Other)
 
 FDecimal FDecimal::operator/(const FDecimal& Other) const
 {
+	DECIMAL_SCOPE_COUNTER_VERBOSE(Arithmetic);
 	FDecimal Result(*this);
-	Result.InternalValue /= Other.InternalValue;
+	Result.GetValue() /= Other.GetValue();
 	return Result;
 }
 
@@ -464,7 +492,7 @@ FDecimal FDecimal::operator/(const FString& Other) const
 		return FDecimal();
 	}
 
-	Result.InternalValue /= InternalValue;
+	Result.GetValue() /= GetValue();
 
 	return Result;
 }
@@ -499,41 +527,73 @@ FDecimal FDecimal::operator/(double Other) const
 	return *this / FDecimal(Other);
 }
 
-bool FDecimal::operator==(const FDecimal& Other)  const
+FDecimal FDecimal::operator-() const
 {
-	return InternalValue == Other.InternalValue;
+	FDecimal Result(*this);
+	DecimalBackend::Negate(Result.GetValue());
+	return Result;
 }
 
-bool FDecimal::operator!=(const FDecimal& Other)  const
+int32 FDecimal::Compare(const FDecimal& Other) const
 {
-	return InternalValue != Other.InternalValue;
-}
+	const bool bNaNA = DecimalBackend::IsNaN(GetValue());
+	const bool bNaNB = DecimalBackend::IsNaN(Other.GetValue());
+	if (bNaNA || bNaNB)
+	{
+		return int32(bNaNA) - int32(bNaNB);
+	}
 
-bool FDecimal::operator>(const FDecimal& Other)  const
-{
-	return InternalValue > Other.InternalValue;
+	const int32 SignA = Sign();
+	const int32 SignB = Other.Sign();
+	if (SignA != SignB)
+	{
+		return (SignA < SignB) ? -1 : 1;
+	}
+	return (SignA == 0) ? 0 : DecimalBackend::Compare(GetValue(), Other.GetValue());
 }
 
-bool FDecimal::operator>=(const FDecimal& Other) const
+int32 FDecimal::CompareAbs(const FDecimal& Other) const
 {
-	return InternalValue >= Other.InternalValue;
+	const bool bNaNA = DecimalBackend::IsNaN(GetValue());
+	const bool bNaNB = DecimalBackend::IsNaN(Other.GetValue());
+	if (bNaNA || bNaNB)
+	{
+		return int32(bNaNA) - int32(bNaNB);
+	}
+
+	const bool bInfA = DecimalBackend::IsInf(GetValue());
+	const bool bInfB = DecimalBackend::IsInf(Other.GetValue());
+	if (bInfA || bInfB)
+	{
+		return int32(bInfA) - int32(bInfB);
+	}
+
+	const bool bZeroA = DecimalBackend::IsZero(GetValue());
+	const bool bZeroB = DecimalBackend::IsZero(Other.GetValue());
+	if (bZeroA || bZeroB)
+	{
+		return int32(!bZeroA) - int32(!bZeroB);
+	}
+	return DecimalBackend::CompareAbs(GetValue(), Other.GetValue());
 }
 
-bool FDecimal::operator<(const FDecimal& Other)  const
+int32 FDecimal::Sign() const
 {
-	return InternalValue < Other.InternalValue;
+	return (DecimalBackend::IsZero(GetValue()) || DecimalBackend::IsNaN(GetValue())) ? 0 : (DecimalBackend::IsNegative(GetValue()) ? -1 : 1);
 }
 
-bool FDecimal::operator<=(const FDecimal& Other) const
+bool FDecimal::IsZero() const
 {
-	return InternalValue <= Other.InternalValue;
+	return DecimalBackend::IsZero(GetValue());
 }
 
-FDecimal FDecimal::operator-() const
+int32 FDecimal::CompareOrdered(const FDecimal& Other) const
 {
-	FDecimal Result(*this);
-	Result.InternalValue *= -1;
-	return Result;
+	if (DecimalBackend::IsNaN(GetValue()) || DecimalBackend::IsNaN(Other.GetValue()))
+	{
+		return Unordered;
+	}
+	return Compare(Other);
 }
 
 bool FDecimal::FromString(const FString& InValue, FDecimal& OutValue)
@@ -547,13 +607,29 @@ bool FDecimal::FromString(const FString& InValue, FDecimal& OutValue)
 	return true;
 }
 
+FDecimal FDecimal::FromLiteral(const ANSICHAR* Text)
+{
+	DECIMAL_SCOPE_COUNTER(FromString);
+	FDecimal Result(NoInit);
+	new (Result.Storage) DecimalBackend::FValue(Text);
+	return Result;
+}
+
 FString FDecimal::ToString(int32 Precision) const
 {
-	return FString(InternalValue.str(Precision, std::ios::fixed).c_str());
+	DECIMAL_SCOPE_COUNTER(ToString);
+	DECIMAL_CONVERSION_SCOPE(ToString);
+	const std::string Digits = GetValue().str(Precision, std::ios::fixed);
+	FString Result(Digits.c_str());
+	DECIMAL_COUNT_ALLOCATION(Digits);
+	DECIMAL_COUNT_ALLOCATION(Result);
+	return Result;
 }
 
 double FDecimal::ToDouble() const
 {
+	DECIMAL_SCOPE_COUNTER(ToDouble);
+	DECIMAL_CONVERSION_SCOPE(ToDouble);
 	double Result;
 	DecimalHelper::ConvertStringToValue(ToString(), Result);
 	return Result;
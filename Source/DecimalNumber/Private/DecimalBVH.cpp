@@ -0,0 +1,511 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalBVH.h"
+#include "DecimalMath.h"
+#include "DecimalMathBatch.h"
+#include "DecimalShadow.h"
+#include <algorithm>
+#include <limits>
+
+namespace DecimalBVH
+{
+	static constexpr double Unbounded = std::numeric_limits<double>::infinity();
+
+	/** Deepest path through a tree, medians halve the boxes at every level and 2^31 boxes do not fit in an int32. */
+	static constexpr int32 MaxDepth = 64;
+
+	/** @return V - Origin, subtracted at full precision and rounded once to double. */
+	static FORCEINLINE FVector ToLocal(const FDecimalVector& Origin, const FDecimalVector& V)
+	{
+		FVector Local;
+		FDecimalMath::Batch::ToRelative(Origin, TConstArrayView<FDecimalVector>(&V, 1), TArrayView<FVector>(&Local, 1));
+		return Local;
+	}
+
+	/** @return Bound on the error of every component of a vector from ToLocal. */
+	static FORCEINLINE FVector GetLocalError(const FVector& Local)
+	{
+		return FVector(FDecimalShadowed::GetShadowError(Local.X), FDecimalShadowed::GetShadowError(Local.Y), FDecimalShadowed::GetShadowError(Local.Z));
+	}
+
+	/** Ray relative to the origin of a tree, with how far it can be from the exact ray within its time range. */
+	struct FLocalRay
+	{
+		FVector Origin;
+		FVector Direction;
+
+		/** Upper bound on the exact largest time. */
+		double MaxTime;
+
+		/** Upper bound on the distance between the exact ray and this one along every axis, for times up to MaxTime. */
+		FVector Margin;
+	};
+
+	/**
+	 * Clip a ray against a box in doubles.
+	 *
+	 * @return true unless the exact ray misses every box inside Min and Max, OutEnter receiving a lower bound on the time
+	 * at which the exact ray would enter such a box.
+	 */
+	static FORCEINLINE bool RayEnter(const FVector& Min, const FVector& Max, const FLocalRay& Ray, double& OutEnter)
+	{
+		double Enter = 0.0;
+		double Exit = Ray.MaxTime;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const double Start = Ray.Origin[Axis];
+			const double Step = Ray.Direction[Axis];
+			const double Low = Min[Axis] - Ray.Margin[Axis];
+			const double High = Max[Axis] + Ray.Margin[Axis];
+			if (Step == 0.0)
+			{
+				if (Start < Low || Start > High)
+				{
+					return false;
+				}
+				continue;
+			}
+
+			double Near = (Low - Start) / Step;
+			double Far = (High - Start) / Step;
+			if (Step < 0.0)
+			{
+				Swap(Near, Far);
+			}
+			// Widen the slab by the rounding of the subtractions and the division.
+			Near -= FMath::Abs(Near) * (4.0 * DBL_EPSILON);
+			Far += FMath::Abs(Far) * (4.0 * DBL_EPSILON);
+			Enter = FMath::Max(Enter, Near);
+			Exit = FMath::Min(Exit, Far);
+			if (Enter > Exit)
+			{
+				return false;
+			}
+		}
+		OutEnter = Enter;
+		return true;
+	}
+
+	static FORCEINLINE bool Overlaps(const FVector& AMin, const FVector& AMax, const FVector& BMin, const FVector& BMax)
+	{
+		return AMin.X <= BMax.X && BMin.X <= AMax.X
+			&& AMin.Y <= BMax.Y && BMin.Y <= AMax.Y
+			&& AMin.Z <= BMax.Z && BMin.Z <= AMax.Z;
+	}
+
+	static FORCEINLINE double DistSquaredToBox(const FVector& Min, const FVector& Max, const FVector& Point)
+	{
+		double DistSquared = 0.0;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const double Delta = FMath::Max3(Min[Axis] - Point[Axis], Point[Axis] - Max[Axis], 0.0);
+			DistSquared += Delta * Delta;
+		}
+		return DistSquared;
+	}
+
+	/**
+	 * Narrow the bounds of an item to bounds its exact box is sure to reach, an upper bound on its exact minimum and a
+	 * lower bound on its exact maximum. Items are widened by the error of their corners, so this undoes that twice over.
+	 */
+	static FORCEINLINE void GetInnerBounds(const FVector& Min, const FVector& Max, FVector& OutMin, FVector& OutMax)
+	{
+		OutMin = Min + GetLocalError(Min) * 3.0;
+		OutMax = Max - GetLocalError(Max) * 3.0;
+	}
+}
+
+int32 FDecimalBVH::GetNumNodes(int32 Count)
+{
+	if (Count <= MaxLeafSize)
+	{
+		return 1;
+	}
+	const int32 LeftCount = Count / 2;
+	return 1 + GetNumNodes(LeftCount) + GetNumNodes(Count - LeftCount);
+}
+
+void FDecimalBVH::Build(TConstArrayView<FDecimalBox> InBoxes)
+{
+	Boxes = TArray<FDecimalBox>(InBoxes.GetData(), InBoxes.Num());
+	Nodes.Reset();
+	Items.Reset();
+	Origin = FDecimalVector::ZeroVector;
+	if (Boxes.Num() == 0)
+	{
+		return;
+	}
+
+	const FDecimalBox Bounds = DecimalMathBatch::Reduce<FDecimalBox>(Boxes.Num(), [this](int32 Begin, int32 End)
+	{
+		FDecimalBox Partial;
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Partial += Boxes[Index];
+		}
+		return Partial;
+	},
+	[](const FDecimalBox& A, const FDecimalBox& B)
+	{
+		return A + B;
+	});
+	if (Bounds.IsValid)
+	{
+		Origin = Bounds.GetCenter();
+	}
+
+	Items.SetNum(Boxes.Num());
+	for (int32 Index = 0; Index < Items.Num(); ++Index)
+	{
+		Items[Index].Index = Index;
+	}
+	UpdateItems();
+
+	Nodes.SetNum(GetNumNodes(Items.Num()));
+	BuildNode(0, 0, Items.Num());
+	UpdateNodeBounds();
+}
+
+void FDecimalBVH::Refit(TConstArrayView<FDecimalBox> InBoxes)
+{
+	check(InBoxes.Num() == Boxes.Num());
+	DecimalMathBatch::ForEachChunk(Boxes.Num(), [this, InBoxes](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Boxes[Index] = InBoxes[Index];
+		}
+	});
+	UpdateItems();
+	UpdateNodeBounds();
+}
+
+void FDecimalBVH::UpdateItems()
+{
+	DecimalMathBatch::ForEachRange(Items.Num(), FDecimalMath::Batch::GetGrainSize(), 1, [this](int32 Begin, int32 End)
+	{
+		for (int32 Slot = Begin; Slot < End; ++Slot)
+		{
+			FItem& Item = Items[Slot];
+			const FDecimalBox& Box = Boxes[Item.Index];
+			if (!Box.IsValid)
+			{
+				// Empty bounds, which no node test accepts and every node merge ignores.
+				Item.Min = FVector(DecimalBVH::Unbounded);
+				Item.Max = FVector(-DecimalBVH::Unbounded);
+				continue;
+			}
+			const FVector Min = DecimalBVH::ToLocal(Origin, Box.Min);
+			const FVector Max = DecimalBVH::ToLocal(Origin, Box.Max);
+			Item.Min = Min - DecimalBVH::GetLocalError(Min);
+			Item.Max = Max + DecimalBVH::GetLocalError(Max);
+		}
+	});
+}
+
+void FDecimalBVH::BuildNode(int32 NodeIndex, int32 Begin, int32 End)
+{
+	FNode& Node = Nodes[NodeIndex];
+	const int32 Count = End - Begin;
+	if (Count <= MaxLeafSize)
+	{
+		Node.First = Begin;
+		Node.Count = Count;
+		return;
+	}
+
+	// Empty items sort as if centered on the origin.
+	const auto GetCenter = [](const FItem& Item, int32 Axis)
+	{
+		return Item.Min[Axis] <= Item.Max[Axis] ? 0.5 * (Item.Min[Axis] + Item.Max[Axis]) : 0.0;
+	};
+
+	FVector CenterMin(DecimalBVH::Unbounded);
+	FVector CenterMax(-DecimalBVH::Unbounded);
+	for (int32 Slot = Begin; Slot < End; ++Slot)
+	{
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const double Center = GetCenter(Items[Slot], Axis);
+			CenterMin[Axis] = FMath::Min(CenterMin[Axis], Center);
+			CenterMax[Axis] = FMath::Max(CenterMax[Axis], Center);
+		}
+	}
+	const FVector CenterSize = CenterMax - CenterMin;
+	const int32 SplitAxis = CenterSize.X >= CenterSize.Y && CenterSize.X >= CenterSize.Z ? 0 : (CenterSize.Y >= CenterSize.Z ? 1 : 2);
+
+	// Ties are broken by index so the tree does not depend on the order nth_element leaves the items in.
+	const int32 Mid = Begin + Count / 2;
+	FItem* const ItemData = Items.GetData();
+	std::nth_element(ItemData + Begin, ItemData + Mid, ItemData + End, [&GetCenter, SplitAxis](const FItem& A, const FItem& B)
+	{
+		const double CenterA = GetCenter(A, SplitAxis);
+		const double CenterB = GetCenter(B, SplitAxis);
+		return CenterA < CenterB || (CenterA == CenterB && A.Index < B.Index);
+	});
+
+	const int32 LeftIndex = NodeIndex + 1;
+	const int32 RightIndex = LeftIndex + GetNumNodes(Mid - Begin);
+	Node.First = RightIndex;
+	Node.Count = 0;
+
+	const int32 TaskLimit = DecimalMathBatch::MaxTasks.load(std::memory_order_relaxed);
+	if (Count > FDecimalMath::Batch::GetGrainSize() && TaskLimit != 1)
+	{
+		ParallelFor(2, [this, LeftIndex, RightIndex, Begin, Mid, End](int32 Child)
+		{
+			if (Child == 0)
+			{
+				BuildNode(LeftIndex, Begin, Mid);
+			}
+			else
+			{
+				BuildNode(RightIndex, Mid, End);
+			}
+		});
+	}
+	else
+	{
+		BuildNode(LeftIndex, Begin, Mid);
+		BuildNode(RightIndex, Mid, End);
+	}
+}
+
+void FDecimalBVH::UpdateNodeBounds()
+{
+	// Children follow their parent, so walking backwards visits them first.
+	for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; --NodeIndex)
+	{
+		FNode& Node = Nodes[NodeIndex];
+		if (Node.IsLeaf())
+		{
+			Node.Min = FVector(DecimalBVH::Unbounded);
+			Node.Max = FVector(-DecimalBVH::Unbounded);
+			for (int32 Slot = Node.First; Slot < Node.First + Node.Count; ++Slot)
+			{
+				Node.Min = Node.Min.ComponentMin(Items[Slot].Min);
+				Node.Max = Node.Max.ComponentMax(Items[Slot].Max);
+			}
+		}
+		else
+		{
+			const FNode& Left = Nodes[NodeIndex + 1];
+			const FNode& Right = Nodes[Node.First];
+			Node.Min = Left.Min.ComponentMin(Right.Min);
+			Node.Max = Left.Max.ComponentMax(Right.Max);
+		}
+	}
+}
+
+void FDecimalBVH::QueryBox(const FDecimalBox& Box, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	if (Nodes.Num() == 0 || !Box.IsValid)
+	{
+		return;
+	}
+
+	// Bounds containing the exact query box, and bounds it is sure to reach.
+	const FVector LocalMin = DecimalBVH::ToLocal(Origin, Box.Min);
+	const FVector LocalMax = DecimalBVH::ToLocal(Origin, Box.Max);
+	const FVector QueryMin = LocalMin - DecimalBVH::GetLocalError(LocalMin);
+	const FVector QueryMax = LocalMax + DecimalBVH::GetLocalError(LocalMax);
+	const FVector QueryInnerMin = LocalMin + DecimalBVH::GetLocalError(LocalMin) * 2.0;
+	const FVector QueryInnerMax = LocalMax - DecimalBVH::GetLocalError(LocalMax) * 2.0;
+
+	int32 Stack[DecimalBVH::MaxDepth];
+	int32 StackSize = 0;
+	Stack[StackSize++] = 0;
+	while (StackSize > 0)
+	{
+		const int32 NodeIndex = Stack[--StackSize];
+		const FNode& Node = Nodes[NodeIndex];
+		if (!DecimalBVH::Overlaps(Node.Min, Node.Max, QueryMin, QueryMax))
+		{
+			continue;
+		}
+		if (!Node.IsLeaf())
+		{
+			Stack[StackSize++] = Node.First;
+			Stack[StackSize++] = NodeIndex + 1;
+			continue;
+		}
+		for (int32 Slot = Node.First; Slot < Node.First + Node.Count; ++Slot)
+		{
+			const FItem& Item = Items[Slot];
+			if (!DecimalBVH::Overlaps(Item.Min, Item.Max, QueryMin, QueryMax))
+			{
+				continue;
+			}
+			// Boxes whose inner bounds overlap the query's surely intersect it, only the others are compared exactly.
+			FVector InnerMin, InnerMax;
+			DecimalBVH::GetInnerBounds(Item.Min, Item.Max, InnerMin, InnerMax);
+			if (DecimalBVH::Overlaps(InnerMin, InnerMax, QueryInnerMin, QueryInnerMax) || Boxes[Item.Index].Intersect(Box))
+			{
+				OutIndices.Add(Item.Index);
+			}
+		}
+	}
+	OutIndices.Sort();
+}
+
+void FDecimalBVH::QuerySphere(const FDecimalVector& Center, const FDecimal& Radius, TArray<int32>& OutIndices) const
+{
+	OutIndices.Reset();
+	if (Nodes.Num() == 0 || Radius.IsNegative())
+	{
+		return;
+	}
+
+	// Widening the boxes by the error of the center and the radius by its own keeps every exact hit, and the last
+	// factor covers the rounding of the squared distance.
+	const FVector LocalCenter = DecimalBVH::ToLocal(Origin, Center);
+	const FVector CenterError = DecimalBVH::GetLocalError(LocalCenter);
+	const double RadiusShadow = FDecimalShadowed::MakeShadow(Radius);
+	const double Reach = RadiusShadow + FDecimalShadowed::GetShadowError(RadiusShadow);
+	const double ReachSquared = Reach * Reach * (1.0 + 16.0 * DBL_EPSILON) + DBL_MIN;
+
+	// Boxes within this distance of the center, from the inner bounds, surely intersect the sphere.
+	const double SureReach = (RadiusShadow - FDecimalShadowed::GetShadowError(RadiusShadow)) * (1.0 - 8.0 * DBL_EPSILON) - CenterError.Size() * (1.0 + 8.0 * DBL_EPSILON);
+	const double SureReachSquared = SureReach > 0.0 ? SureReach * SureReach * (1.0 - 16.0 * DBL_EPSILON) : -1.0;
+
+	int32 Stack[DecimalBVH::MaxDepth];
+	int32 StackSize = 0;
+	Stack[StackSize++] = 0;
+	while (StackSize > 0)
+	{
+		const int32 NodeIndex = Stack[--StackSize];
+		const FNode& Node = Nodes[NodeIndex];
+		if (DecimalBVH::DistSquaredToBox(Node.Min - CenterError, Node.Max + CenterError, LocalCenter) > ReachSquared)
+		{
+			continue;
+		}
+		if (!Node.IsLeaf())
+		{
+			Stack[StackSize++] = Node.First;
+			Stack[StackSize++] = NodeIndex + 1;
+			continue;
+		}
+		for (int32 Slot = Node.First; Slot < Node.First + Node.Count; ++Slot)
+		{
+			const FItem& Item = Items[Slot];
+			if (DecimalBVH::DistSquaredToBox(Item.Min - CenterError, Item.Max + CenterError, LocalCenter) > ReachSquared)
+			{
+				continue;
+			}
+			FVector InnerMin, InnerMax;
+			DecimalBVH::GetInnerBounds(Item.Min, Item.Max, InnerMin, InnerMax);
+			const bool bSureHit = InnerMin.X <= InnerMax.X && InnerMin.Y <= InnerMax.Y && InnerMin.Z <= InnerMax.Z
+				&& DecimalBVH::DistSquaredToBox(InnerMin, InnerMax, LocalCenter) < SureReachSquared;
+			const FDecimalBox& Box = Boxes[Item.Index];
+			if (bSureHit || (Box.IsValid && Box.IntersectSphere(Center, Radius)))
+			{
+				OutIndices.Add(Item.Index);
+			}
+		}
+	}
+	OutIndices.Sort();
+}
+
+bool FDecimalBVH::RayCast(const FDecimalVector& RayOrigin, const FDecimalVector& Direction, const FDecimal& MaxTime, int32& OutIndex, FDecimal& OutTime) const
+{
+	if (Nodes.Num() == 0 || MaxTime.IsNegative())
+	{
+		return false;
+	}
+
+	// The exact ray stays within the error of the origin plus the error of the direction times the time of the double one.
+	DecimalBVH::FLocalRay Ray;
+	Ray.Origin = DecimalBVH::ToLocal(Origin, RayOrigin);
+	Ray.Direction = FVector(FDecimalShadowed::MakeShadow(Direction.X), FDecimalShadowed::MakeShadow(Direction.Y), FDecimalShadowed::MakeShadow(Direction.Z));
+	const double MaxTimeShadow = FDecimalShadowed::MakeShadow(MaxTime);
+	Ray.MaxTime = MaxTimeShadow + FDecimalShadowed::GetShadowError(MaxTimeShadow);
+	Ray.Margin = DecimalBVH::GetLocalError(Ray.Origin) + DecimalBVH::GetLocalError(Ray.Direction) * Ray.MaxTime;
+	Ray.Margin += DecimalBVH::GetLocalError(Ray.Margin);
+
+	// Upper bound on the exact time of the best hit so far. Nodes entered later cannot hold a better one, nodes entered at
+	// the same time still can hold a hit with a lower index.
+	int32 BestIndex = INDEX_NONE;
+	FDecimal BestTime;
+	double BestBound = Ray.MaxTime;
+
+	struct FEntry
+	{
+		int32 NodeIndex;
+		double Enter;
+	};
+	FEntry Stack[DecimalBVH::MaxDepth];
+	int32 StackSize = 0;
+	double RootEnter = 0.0;
+	if (DecimalBVH::RayEnter(Nodes[0].Min, Nodes[0].Max, Ray, RootEnter))
+	{
+		Stack[StackSize++] = { 0, RootEnter };
+	}
+
+	while (StackSize > 0)
+	{
+		const FEntry Entry = Stack[--StackSize];
+		if (Entry.Enter > BestBound)
+		{
+			continue;
+		}
+
+		const FNode& Node = Nodes[Entry.NodeIndex];
+		if (!Node.IsLeaf())
+		{
+			// Visit the child the ray enters first first.
+			const int32 ChildIndices[2] = { Entry.NodeIndex + 1, Node.First };
+			double ChildEnters[2];
+			bool bChildHits[2];
+			for (int32 Child = 0; Child < 2; ++Child)
+			{
+				const FNode& ChildNode = Nodes[ChildIndices[Child]];
+				bChildHits[Child] = DecimalBVH::RayEnter(ChildNode.Min, ChildNode.Max, Ray, ChildEnters[Child]) && ChildEnters[Child] <= BestBound;
+			}
+			const int32 Near = bChildHits[1] && (!bChildHits[0] || ChildEnters[1] < ChildEnters[0]) ? 1 : 0;
+			const int32 Far = 1 - Near;
+			if (bChildHits[Far])
+			{
+				Stack[StackSize++] = { ChildIndices[Far], ChildEnters[Far] };
+			}
+			if (bChildHits[Near])
+			{
+				Stack[StackSize++] = { ChildIndices[Near], ChildEnters[Near] };
+			}
+			continue;
+		}
+
+		for (int32 Slot = Node.First; Slot < Node.First + Node.Count; ++Slot)
+		{
+			const FItem& Item = Items[Slot];
+			double ItemEnter = 0.0;
+			if (!DecimalBVH::RayEnter(Item.Min, Item.Max, Ray, ItemEnter) || ItemEnter > BestBound)
+			{
+				continue;
+			}
+			const FDecimalBox& Box = Boxes[Item.Index];
+			FDecimal Time;
+			if (!Box.IsValid || !Box.IntersectRay(RayOrigin, Direction, MaxTime, Time))
+			{
+				continue;
+			}
+			const int32 Order = BestIndex == INDEX_NONE ? -1 : Time.Compare(BestTime);
+			if (Order < 0 || (Order == 0 && Item.Index < BestIndex))
+			{
+				BestIndex = Item.Index;
+				BestTime = Time;
+				const double TimeShadow = FDecimalShadowed::MakeShadow(Time);
+				BestBound = FMath::Min(BestBound, TimeShadow + FDecimalShadowed::GetShadowError(TimeShadow));
+			}
+		}
+	}
+
+	if (BestIndex == INDEX_NONE)
+	{
+		return false;
+	}
+	OutIndex = BestIndex;
+	OutTime = BestTime;
+	return true;
+}
@@ -0,0 +1,371 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "DecimalStorage.h"
+
+/**
+ * Numeric type behind FDecimal, chosen at build time with DECIMALNUMBER_BACKEND (see DecimalStorage.h).
+ * Everything in FDecimal, FDecimalMath, FDecimalVectorArray and FDecimalSortKey that needs more than the arithmetic
+ * operators goes through DecimalBackend below, so the rest of the module is the same for every backend.
+ * Private to the module: only its own sources include this header, Decimal.h does not, and boost is only on the
+ * module's private include path.
+ */
+THIRD_PARTY_INCLUDES_START
+#pragma push_macro("check")
+#undef check
+#if DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_DEC_FLOAT
+#include <boost/multiprecision/cpp_dec_float.hpp>
+#include <boost/core/nvp.hpp>
+#elif DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_BIN_FLOAT
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#endif
+#pragma pop_macro("check")
+THIRD_PARTY_INCLUDES_END
+
+#if DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_FIXED128
+#if !defined(__SIZEOF_INT128__)
+#error "DECIMALNUMBER_BACKEND_FIXED128 needs a compiler with __int128"
+#endif
+#include "DecimalFixed128.h"
+#elif DECIMALNUMBER_BACKEND != DECIMALNUMBER_BACKEND_DEC_FLOAT && DECIMALNUMBER_BACKEND != DECIMALNUMBER_BACKEND_BIN_FLOAT
+#error "Unknown DECIMALNUMBER_BACKEND"
+#endif
+
+namespace DecimalBackend
+{
+#if DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_DEC_FLOAT
+	typedef boost::multiprecision::cpp_dec_float_50 FValue;
+	static constexpr const TCHAR* Name = DECIMALNUMBER_BACKEND_NAME;
+#elif DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_BIN_FLOAT
+	typedef boost::multiprecision::cpp_bin_float_50 FValue;
+	static constexpr const TCHAR* Name = DECIMALNUMBER_BACKEND_NAME;
+#else
+	typedef FDecimalFixed128 FValue;
+	static constexpr const TCHAR* Name = DECIMALNUMBER_BACKEND_NAME;
+#endif
+
+#if DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_FIXED128
+	FORCEINLINE bool IsNaN(const FValue&) { return false; }
+	FORCEINLINE bool IsInf(const FValue&) { return false; }
+	FORCEINLINE bool IsFinite(const FValue&) { return true; }
+	FORCEINLINE bool IsZero(const FValue& Value) { return Value.GetRaw() == 0; }
+	FORCEINLINE bool IsNegative(const FValue& Value) { return Value.GetRaw() < 0; }
+	FORCEINLINE void Negate(FValue& Value) { Value = -Value; }
+
+	/** @return -1, 0 or 1, for two numbers that are not NaN. */
+	FORCEINLINE int32 Compare(const FValue& A, const FValue& B) { return A.Compare(B); }
+
+	/** @return -1, 0 or 1 comparing magnitudes, for two finite non-zero numbers. */
+	FORCEINLINE int32 CompareAbs(const FValue& A, const FValue& B) { return A.CompareAbs(B); }
+
+	FORCEINLINE FValue Floor(const FValue& Value) { return FValue::Floor(Value); }
+	FORCEINLINE FValue Ceil(const FValue& Value) { return FValue::Ceil(Value); }
+	FORCEINLINE FValue Sqrt(const FValue& Value) { return FValue::Sqrt(Value); }
+	FORCEINLINE FValue Sin(const FValue& Value) { return FValue::Sin(Value); }
+	FORCEINLINE FValue Cos(const FValue& Value) { return FValue::Cos(Value); }
+	FORCEINLINE FValue Asin(const FValue& Value) { return FValue::Asin(Value); }
+	FORCEINLINE FValue Acos(const FValue& Value) { return FValue::Acos(Value); }
+	FORCEINLINE FValue Atan(const FValue& Value) { return FValue::Atan(Value); }
+	FORCEINLINE FValue Atan2(const FValue& Y, const FValue& X) { return FValue::Atan2(Y, X); }
+	FORCEINLINE FValue Pow(const FValue& Base, const FValue& Exponent) { return FValue::Pow(Base, Exponent); }
+
+	template <typename T>
+	FORCEINLINE FValue Pow(const FValue& Base, T Exponent)
+	{
+		if constexpr (std::is_integral_v<T>)
+		{
+			return FValue::Pow(Base, static_cast<int64>(Exponent));
+		}
+		else
+		{
+			return FValue::Pow(Base, FValue(Exponent));
+		}
+	}
+
+	FORCEINLINE double ToDouble(const FValue& Value) { return Value.ToDouble(); }
+	FORCEINLINE double ToDoubleDirect(const FValue& Value) { return Value.ToDouble(); }
+	FORCEINLINE double ToDoubleNearest(const FValue& Value) { return Value.ToDouble(); }
+	FORCEINLINE FValue Pi() { return FValue::Pi(); }
+
+	// Integer division is already cheaper than the scaled multiplication a reciprocal would need, so divisors divide.
+	FORCEINLINE FValue Reciprocal(const FValue& Divisor) { return Divisor; }
+	FORCEINLINE FValue DivideBy(const FValue& A, const FValue& Divisor, const FValue&) { return A / Divisor; }
+#else
+	FORCEINLINE bool IsFinite(const FValue& Value) { return boost::multiprecision::isfinite(Value); }
+	FORCEINLINE void Negate(FValue& Value) { Value.backend().negate(); }
+
+#if DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_DEC_FLOAT
+	// The backend flags are read directly, they are much cheaper than the generic classification.
+	FORCEINLINE bool IsNaN(const FValue& Value) { return Value.backend().isnan(); }
+	FORCEINLINE bool IsInf(const FValue& Value) { return Value.backend().isinf(); }
+	FORCEINLINE bool IsZero(const FValue& Value) { return Value.backend().iszero(); }
+	FORCEINLINE bool IsNegative(const FValue& Value) { return Value.backend().isneg(); }
+
+	/** @return -1, 0 or 1, for two numbers that are not NaN. */
+	FORCEINLINE int32 Compare(const FValue& A, const FValue& B) { return A.backend().compare(B.backend()); }
+
+	/** @return -1, 0 or 1 comparing magnitudes, for two finite non-zero numbers. Exponents first, limbs only when they match. */
+	FORCEINLINE int32 CompareAbs(const FValue& A, const FValue& B)
+	{
+		const auto OrderA = A.backend().order();
+		const auto OrderB = B.backend().order();
+		if (OrderA != OrderB)
+		{
+			return (OrderA < OrderB) ? -1 : 1;
+		}
+
+		int32 Result;
+		if (A.backend().isneg() == B.backend().isneg())
+		{
+			Result = A.backend().compare(B.backend());
+		}
+		else
+		{
+			FValue::backend_type NegatedB(B.backend());
+			NegatedB.negate();
+			Result = A.backend().compare(NegatedB);
+		}
+		return A.backend().isneg() ? -Result : Result;
+	}
+
+	/** @return What DivideBy multiplies with: the divisor's reciprocal, computed the way the backend's division computes it. */
+	FORCEINLINE FValue Reciprocal(const FValue& Divisor)
+	{
+		FValue Result(Divisor);
+		Result.backend().calculate_inv();
+		return Result;
+	}
+
+	/**
+	 * @return A / Divisor, bit-identical to the backend's division, which inverts the divisor and multiplies on every call.
+	 * The cases that division handles before inverting (zero, NaN and infinite operands, and |A| == |Divisor|, exactly +-1)
+	 * go through the division itself.
+	 */
+	FORCEINLINE FValue DivideBy(const FValue& A, const FValue& Divisor, const FValue& Reciprocal)
+	{
+		if (!A.backend().isfinite() || A.backend().iszero() || !Divisor.backend().isfinite() || Divisor.backend().iszero() || CompareAbs(A, Divisor) == 0)
+		{
+			return A / Divisor;
+		}
+		FValue Result(A);
+		Result.backend() *= Reciprocal.backend();
+		return Result;
+	}
+
+	/** Mirrors cpp_dec_float_elem_number: the digits rounded up to whole base 10^8 limbs plus three guard limbs. */
+	static constexpr int32 NumLimbs = (std::numeric_limits<FValue>::digits10 + 7) / 8 + 3;
+
+	/**
+	 * Raw fields of a value, Limbs[0] * 10^Exponent + Limbs[1] * 10^(Exponent - 8) + ...
+	 * Doubles as the read-only archive handed to cpp_dec_float::serialize, which is the only public route to the limbs.
+	 * Fields arrive in declaration order: the limbs, the exponent, the sign, the class and the precision.
+	 */
+	struct FFields
+	{
+		uint32 Limbs[NumLimbs] = {};
+		int32 NumLimbsRead = 0;
+		int32 Exponent = 0;
+		bool bExponentRead = false;
+		bool bNegative = false;
+		int32 ClassType = 0;
+
+		template <typename FieldType>
+		FFields& operator&(const boost::nvp<FieldType>& Field)
+		{
+			if constexpr (std::is_same_v<FieldType, std::uint32_t>)
+			{
+				check(NumLimbsRead < NumLimbs);
+				Limbs[NumLimbsRead++] = Field.const_value();
+			}
+			else if constexpr (std::is_same_v<FieldType, bool>)
+			{
+				bNegative = Field.const_value();
+			}
+			else if constexpr (std::is_enum_v<FieldType>)
+			{
+				ClassType = static_cast<int32>(Field.const_value());
+			}
+			else if (!bExponentRead)
+			{
+				Exponent = static_cast<int32>(Field.const_value());
+				bExponentRead = true;
+			}
+			return *this;
+		}
+	};
+
+	FORCEINLINE FFields ReadFields(const FValue& Value)
+	{
+		// serialize() is non-const because it also loads, FFields only ever reads.
+		FFields Fields;
+		const_cast<FValue::backend_type&>(Value.backend()).serialize(Fields, 0);
+		check(Fields.NumLimbsRead == NumLimbs);
+		return Fields;
+	}
+
+	/** @return 10^Exponent for Exponent >= 0, exact up to 10^22. */
+	FORCEINLINE double PowerOfTen(int32 Exponent)
+	{
+		static constexpr double Exact[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+		return Exponent < static_cast<int32>(UE_ARRAY_COUNT(Exact)) ? Exact[Exponent] : std::pow(10.0, Exponent);
+	}
+
+	/**
+	 * @return Value as a double, built from its three leading limbs, where convert_to<double> formats the number and parses
+	 * it back. Up to 16 significant digits within 10^22 of the leading limb come out correctly rounded, anything else within
+	 * three units in the last place. Like convert_to<double>, magnitudes below the smallest normal double become zero.
+	 */
+	FORCEINLINE double ToDoubleDirect(const FValue& Value)
+	{
+		const FValue::backend_type& Backend = Value.backend();
+		if (!Backend.isfinite() || Backend.iszero())
+		{
+			return Backend.extract_double();
+		}
+
+		const FFields Fields = ReadFields(Value);
+
+		// Two limbs are exact in a uint64, so without a third limb the only rounding is the scaling.
+		double Significand = static_cast<double>(static_cast<uint64>(Fields.Limbs[0]) * 100000000ull + Fields.Limbs[1]);
+		int32 Scale = Fields.Exponent - 8;
+		if (Fields.Limbs[2] != 0)
+		{
+			Significand = Significand * 1e8 + static_cast<double>(Fields.Limbs[2]);
+			Scale -= 8;
+		}
+
+		// The significand is below 10^24, so anything scaled by less than 10^-400 is far below the smallest double, and
+		// 10^-Scale would overflow before the quotient underflows, so very small numbers first divide by exact powers.
+		if (Scale < -400)
+		{
+			return 0.0;
+		}
+		for (; Scale < -300; Scale += 22)
+		{
+			Significand /= PowerOfTen(22);
+		}
+		const double Result = (Scale >= 0)
+			? Significand * PowerOfTen(FMath::Min(Scale, 400))
+			: Significand / PowerOfTen(-Scale);
+		if (Result < std::numeric_limits<double>::min())
+		{
+			return 0.0;
+		}
+		return Fields.bNegative ? -Result : Result;
+	}
+
+	/**
+	 * @return Value rounded to the nearest double, ties to even, for conversions that must round-trip a double bit for bit.
+	 * Starts from ToDoubleDirect and steps to a neighbouring double while the residual Value - Result, which is exact,
+	 * exceeds half the gap to it. Only a residual within rounding error of half the gap is compared exactly.
+	 */
+	FORCEINLINE double ToDoubleNearest(const FValue& Value)
+	{
+		double Result = ToDoubleDirect(Value);
+		if (!FMath::IsFinite(Result) || Result == 0.0)
+		{
+			return Result;
+		}
+
+		// ToDoubleDirect is at most three units in the last place away, and so is its estimate of the residual.
+		static constexpr double Tolerance = 1e-12;
+		for (int32 Step = 0; Step < 4; ++Step)
+		{
+			const double Down = std::nextafter(Result, -std::numeric_limits<double>::infinity());
+			const double Up = std::nextafter(Result, std::numeric_limits<double>::infinity());
+			const double HalfDown = (Result - Down) * 0.5;
+			const double HalfUp = (Up - Result) * 0.5;
+			const FValue Residual(Value - FValue(Result));
+			const double Estimate = ToDoubleDirect(Residual);
+
+			int32 Direction;
+			if (Estimate < 0.0 ? -Estimate < HalfDown * (1.0 - Tolerance) : Estimate < HalfUp * (1.0 - Tolerance))
+			{
+				break;
+			}
+			else if (Estimate < 0.0 ? -Estimate > HalfDown * (1.0 + Tolerance) : Estimate > HalfUp * (1.0 + Tolerance))
+			{
+				Direction = Estimate < 0.0 ? -1 : 1;
+			}
+			else
+			{
+				// Halves of the gaps are exact doubles, and exact in decimal like every double.
+				const int32 Midpoint = (Estimate < 0.0) ? -Residual.compare(FValue(-HalfDown)) : Residual.compare(FValue(HalfUp));
+				uint64 Bits;
+				FMemory::Memcpy(&Bits, &Result, sizeof(Bits));
+				if (Midpoint < 0 || (Midpoint == 0 && (Bits & 1) == 0))
+				{
+					break;
+				}
+				Direction = Estimate < 0.0 ? -1 : 1;
+			}
+			Result = (Direction < 0) ? Down : Up;
+		}
+		return Result;
+	}
+#else
+	FORCEINLINE bool IsNaN(const FValue& Value) { return Value.backend().exponent() == FValue::backend_type::exponent_nan; }
+	FORCEINLINE bool IsInf(const FValue& Value) { return Value.backend().exponent() == FValue::backend_type::exponent_infinity; }
+	FORCEINLINE bool IsZero(const FValue& Value) { return Value.backend().exponent() == FValue::backend_type::exponent_zero; }
+	FORCEINLINE bool IsNegative(const FValue& Value) { return Value.backend().sign(); }
+
+	/** @return -1, 0 or 1, for two numbers that are not NaN. */
+	FORCEINLINE int32 Compare(const FValue& A, const FValue& B) { return A.backend().compare(B.backend()); }
+
+	/** @return -1, 0 or 1 comparing magnitudes, for two finite non-zero numbers. Mantissas are normalized, so exponents first. */
+	FORCEINLINE int32 CompareAbs(const FValue& A, const FValue& B)
+	{
+		const auto ExponentA = A.backend().exponent();
+		const auto ExponentB = B.backend().exponent();
+		if (ExponentA != ExponentB)
+		{
+			return (ExponentA < ExponentB) ? -1 : 1;
+		}
+		return A.backend().bits().compare(B.backend().bits());
+	}
+
+	// Division is correctly rounded. A reciprocal only gets there with a residual in twice the precision, which costs
+	// more than the division, so divisors divide.
+	FORCEINLINE FValue Reciprocal(const FValue& Divisor) { return Divisor; }
+	FORCEINLINE FValue DivideBy(const FValue& A, const FValue& Divisor, const FValue&) { return A / Divisor; }
+#endif
+
+	FORCEINLINE FValue Floor(const FValue& Value) { return boost::multiprecision::floor(Value); }
+	FORCEINLINE FValue Ceil(const FValue& Value) { return boost::multiprecision::ceil(Value); }
+	FORCEINLINE FValue Sqrt(const FValue& Value) { return boost::multiprecision::sqrt(Value); }
+	FORCEINLINE FValue Sin(const FValue& Value) { return boost::multiprecision::sin(Value); }
+	FORCEINLINE FValue Cos(const FValue& Value) { return boost::multiprecision::cos(Value); }
+	FORCEINLINE FValue Asin(const FValue& Value) { return boost::multiprecision::asin(Value); }
+	FORCEINLINE FValue Acos(const FValue& Value) { return boost::multiprecision::acos(Value); }
+	FORCEINLINE FValue Atan(const FValue& Value) { return boost::multiprecision::atan(Value); }
+	FORCEINLINE FValue Atan2(const FValue& Y, const FValue& X) { return boost::multiprecision::atan2(Y, X); }
+	FORCEINLINE FValue Pow(const FValue& Base, const FValue& Exponent) { return boost::multiprecision::pow(Base, Exponent); }
+
+	template <typename T>
+	FORCEINLINE FValue Pow(const FValue& Base, T Exponent)
+	{
+		return boost::multiprecision::pow(Base, Exponent);
+	}
+
+	FORCEINLINE double ToDouble(const FValue& Value) { return Value.template convert_to<double>(); }
+#if DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_BIN_FLOAT
+	// Binary to binary, convert_to<double> already rounds the mantissa bits directly.
+	FORCEINLINE double ToDoubleDirect(const FValue& Value) { return Value.template convert_to<double>(); }
+	FORCEINLINE double ToDoubleNearest(const FValue& Value) { return Value.template convert_to<double>(); }
+#endif
+	FORCEINLINE FValue Pi() { return boost::math::constants::pi<FValue>(); }
+#endif
+}
+
+template <typename Dummy>
+struct TDecimalBackendValue
+{
+	typedef DecimalBackend::FValue Type;
+};
+
+static_assert(sizeof(DecimalBackend::FValue) <= DECIMALNUMBER_STORAGE_SIZE, "DECIMALNUMBER_STORAGE_SIZE is too small for the backend");
+static_assert(alignof(DecimalBackend::FValue) <= DECIMALNUMBER_STORAGE_ALIGNMENT, "DECIMALNUMBER_STORAGE_ALIGNMENT is too small for the backend");
+static_assert(std::is_trivially_destructible_v<DecimalBackend::FValue>, "FDecimal does not destroy its backend value");
@@ -0,0 +1,258 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalBarnesHut.h"
+#include "DecimalMath.h"
+#include "DecimalMathBatch.h"
+#include "DecimalShadow.h"
+#include <algorithm>
+#include <limits>
+
+namespace DecimalBarnesHut
+{
+	static constexpr double Unbounded = std::numeric_limits<double>::infinity();
+
+	/** @return V - Origin, subtracted at full precision and rounded once to double. */
+	static FORCEINLINE FVector ToLocal(const FDecimalVector& Origin, const FDecimalVector& V)
+	{
+		FVector Local;
+		FDecimalMath::Batch::ToRelative(Origin, TConstArrayView<FDecimalVector>(&V, 1), TArrayView<FVector>(&Local, 1));
+		return Local;
+	}
+
+	/** @return true if the most significant bit set in A is lower than the one in B. */
+	static FORCEINLINE bool IsLessMsb(uint64 A, uint64 B)
+	{
+		return A < B && A < (A ^ B);
+	}
+
+	/** @return true if cell A comes before cell B along a Z-order curve, X in the lowest bit of every triple, without interleaving their bits. */
+	static FORCEINLINE bool IsBeforeInZOrder(const FInt64Vector& A, const FInt64Vector& B)
+	{
+		int64 Low = A.Z;
+		int64 High = B.Z;
+		uint64 Difference = static_cast<uint64>(A.Z ^ B.Z);
+		if (IsLessMsb(Difference, static_cast<uint64>(A.Y ^ B.Y)))
+		{
+			Low = A.Y;
+			High = B.Y;
+			Difference = static_cast<uint64>(A.Y ^ B.Y);
+		}
+		if (IsLessMsb(Difference, static_cast<uint64>(A.X ^ B.X)))
+		{
+			Low = A.X;
+			High = B.X;
+		}
+		return Low < High;
+	}
+
+	/** @return Which child of a node at Level a cell belongs to. */
+	static FORCEINLINE int32 GetOctant(const FInt64Vector& Cell, int32 Level)
+	{
+		const int32 Shift = Level - 1;
+		return static_cast<int32>(((Cell.X >> Shift) & 1) | (((Cell.Y >> Shift) & 1) << 1) | (((Cell.Z >> Shift) & 1) << 2));
+	}
+}
+
+void FDecimalBarnesHut::Build(TConstArrayView<FDecimalVector> Positions, TConstArrayView<double> Masses)
+{
+	check(Positions.Num() == Masses.Num());
+
+	const int32 NumBodies = Positions.Num();
+	Bodies.Reset();
+	Nodes.Reset();
+	if (NumBodies == 0)
+	{
+		return;
+	}
+
+	// Place the root on the bounds of the bodies, in doubles relative to the first one.
+	TArray<FVector> Relative;
+	Relative.SetNumUninitialized(NumBodies);
+	FDecimalMath::Batch::ToRelative(Positions[0], Positions, Relative);
+	FVector Min(DecimalBarnesHut::Unbounded);
+	FVector Max(-DecimalBarnesHut::Unbounded);
+	for (const FVector& V : Relative)
+	{
+		Min = Min.ComponentMin(V);
+		Max = Max.ComponentMax(V);
+	}
+	const FVector Size = Max - Min;
+	const double Extent = FMath::Max3(Size.X, Size.Y, Size.Z);
+	constexpr int64 NumCells = int64(1) << MaxDepth;
+
+	// The cell size is a seven digit integer times a power of ten, so it and every cell corner are exact decimals, and
+	// slightly larger than needed so the bodies fit in the root from the cell below the lowest one.
+	const double TargetCellSize = Extent > 0.0 ? Extent / (NumCells - 2) * (1.0 + 1e-6) : 1.0;
+	const int32 Exponent = FMath::FloorToInt32(FMath::LogX(10.0, TargetCellSize)) - 6;
+	const FDecimal PowerOfTen = FDecimalMath::PowerInteger(FDecimal(10), Exponent);
+	const int64 Mantissa = static_cast<int64>(FMath::CeilToDouble(TargetCellSize / FDecimalShadowed::MakeShadow(PowerOfTen))) + 1;
+	const FDecimal DecimalCellSize = FDecimal(Mantissa) * PowerOfTen;
+	CellSize = FDecimalShadowed::MakeShadow(DecimalCellSize);
+
+	const FInt64Vector MinCell(FMath::FloorToInt64(Min.X / CellSize), FMath::FloorToInt64(Min.Y / CellSize), FMath::FloorToInt64(Min.Z / CellSize));
+	Origin = Positions[0] + FDecimalVector(FDecimal(MinCell.X) * DecimalCellSize, FDecimal(MinCell.Y) * DecimalCellSize, FDecimal(MinCell.Z) * DecimalCellSize);
+	const FVector OriginOffset(static_cast<double>(MinCell.X) * CellSize, static_cast<double>(MinCell.Y) * CellSize, static_cast<double>(MinCell.Z) * CellSize);
+
+	Bodies.SetNum(NumBodies);
+	DecimalMathBatch::ForEachRange(NumBodies, FDecimalMath::Batch::GetGrainSize(), 1, [this, Positions, Masses, &Relative, &OriginOffset, &DecimalCellSize](int32 Begin, int32 End)
+	{
+		const auto GetCellAxis = [this](double Offset)
+		{
+			return FMath::Clamp(FMath::FloorToInt64(Offset / CellSize), int64(0), NumCells - 1);
+		};
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			FBody& Body = Bodies[Index];
+			const FVector Offset = Relative[Index] - OriginOffset;
+			Body.Cell = FInt64Vector(GetCellAxis(Offset.X), GetCellAxis(Offset.Y), GetCellAxis(Offset.Z));
+			const FDecimalVector Corner = Origin + FDecimalVector(FDecimal(Body.Cell.X) * DecimalCellSize, FDecimal(Body.Cell.Y) * DecimalCellSize, FDecimal(Body.Cell.Z) * DecimalCellSize);
+			Body.Offset = DecimalBarnesHut::ToLocal(Corner, Positions[Index]);
+			Body.Mass = Masses[Index];
+			Body.Index = Index;
+		}
+	});
+	Algo::Sort(Bodies, [](const FBody& A, const FBody& B)
+	{
+		if (A.Cell == B.Cell)
+		{
+			return A.Index < B.Index;
+		}
+		return DecimalBarnesHut::IsBeforeInZOrder(A.Cell, B.Cell);
+	});
+
+	BuildNode(0, NumBodies, FInt64Vector(0, 0, 0), MaxDepth);
+
+	// Children follow their parent, so walking backwards visits them first.
+	for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; --NodeIndex)
+	{
+		FNode& Node = Nodes[NodeIndex];
+		FVector Moment = FVector::ZeroVector;
+		double Mass = 0.0;
+		if (Node.bLeaf)
+		{
+			for (int32 Slot = Node.First; Slot < Node.First + Node.Count; ++Slot)
+			{
+				const FBody& Body = Bodies[Slot];
+				Moment += (GetCellOffset(Body.Cell, Node.Anchor) + Body.Offset) * Body.Mass;
+				Mass += Body.Mass;
+			}
+		}
+		else
+		{
+			for (int32 ChildIndex = NodeIndex + 1; ChildIndex < Node.Next; ChildIndex = Nodes[ChildIndex].Next)
+			{
+				const FNode& Child = Nodes[ChildIndex];
+				Moment += (GetCellOffset(Child.Anchor, Node.Anchor) + Child.CenterOfMass) * Child.Mass;
+				Mass += Child.Mass;
+			}
+		}
+		Node.Mass = Mass;
+		Node.CenterOfMass = Mass != 0.0 ? Moment * (1.0 / Mass) : FVector::ZeroVector;
+	}
+}
+
+void FDecimalBarnesHut::BuildNode(int32 Begin, int32 End, const FInt64Vector& Anchor, int32 Level)
+{
+	const int32 NodeIndex = Nodes.AddDefaulted();
+	{
+		FNode& Node = Nodes[NodeIndex];
+		Node.Anchor = Anchor;
+		Node.Level = Level;
+		Node.First = Begin;
+		Node.Count = End - Begin;
+		Node.bLeaf = Node.Count <= MaxLeafSize || Level == 0;
+	}
+
+	if (!Nodes[NodeIndex].bLeaf)
+	{
+		// Bodies are sorted along the Z-order curve, so every child's bodies follow those of the previous one.
+		const int64 Half = int64(1) << (Level - 1);
+		int32 ChildBegin = Begin;
+		for (int32 Octant = 0; Octant < 8 && ChildBegin < End; ++Octant)
+		{
+			const FBody* const ChildEnd = std::partition_point(Bodies.GetData() + ChildBegin, Bodies.GetData() + End, [Octant, Level](const FBody& Body)
+			{
+				return DecimalBarnesHut::GetOctant(Body.Cell, Level) <= Octant;
+			});
+			const int32 ChildEndIndex = static_cast<int32>(ChildEnd - Bodies.GetData());
+			if (ChildEndIndex > ChildBegin)
+			{
+				const FInt64Vector ChildAnchor(Anchor.X + (Octant & 1) * Half, Anchor.Y + ((Octant >> 1) & 1) * Half, Anchor.Z + ((Octant >> 2) & 1) * Half);
+				BuildNode(ChildBegin, ChildEndIndex, ChildAnchor, Level - 1);
+			}
+			ChildBegin = ChildEndIndex;
+		}
+	}
+
+	Nodes[NodeIndex].Next = Nodes.Num();
+}
+
+void FDecimalBarnesHut::ComputeAccelerations(TArrayView<FVector> OutAccelerations, TArrayView<double> OutPotentials) const
+{
+	check(OutAccelerations.Num() == Bodies.Num());
+	check(OutPotentials.Num() == 0 || OutPotentials.Num() == Bodies.Num());
+
+	const double ThetaSquared = Theta * Theta;
+	const double SofteningSquared = Softening * Softening;
+	DecimalMathBatch::ForEachRange(Bodies.Num(), FDecimalMath::Batch::GetGrainSize(), 1, [this, OutAccelerations, OutPotentials, ThetaSquared, SofteningSquared](int32 Begin, int32 End)
+	{
+		for (int32 Slot = Begin; Slot < End; ++Slot)
+		{
+			const FBody& Body = Bodies[Slot];
+			FVector Acceleration = FVector::ZeroVector;
+			double Potential = 0.0;
+			const auto AddPull = [&Acceleration, &Potential, SofteningSquared](const FVector& Offset, double Mass)
+			{
+				const double DistSquared = Offset.SizeSquared() + SofteningSquared;
+				if (DistSquared > 0.0)
+				{
+					const double InvDist = 1.0 / FMath::Sqrt(DistSquared);
+					Acceleration += Offset * (Mass * InvDist * InvDist * InvDist);
+					Potential -= Mass * InvDist;
+				}
+			};
+
+			int32 NodeIndex = 0;
+			while (NodeIndex < Nodes.Num())
+			{
+				const FNode& Node = Nodes[NodeIndex];
+				const int64 Span = int64(1) << Node.Level;
+				const bool bContainsBody = Body.Cell.X >= Node.Anchor.X && Body.Cell.X < Node.Anchor.X + Span
+					&& Body.Cell.Y >= Node.Anchor.Y && Body.Cell.Y < Node.Anchor.Y + Span
+					&& Body.Cell.Z >= Node.Anchor.Z && Body.Cell.Z < Node.Anchor.Z + Span;
+				if (!bContainsBody)
+				{
+					const FVector Offset = GetCellOffset(Node.Anchor, Body.Cell) + (Node.CenterOfMass - Body.Offset);
+					const double NodeSize = static_cast<double>(Span) * CellSize;
+					if (NodeSize * NodeSize < ThetaSquared * Offset.SizeSquared())
+					{
+						AddPull(Offset, Node.Mass);
+						NodeIndex = Node.Next;
+						continue;
+					}
+				}
+				if (!Node.bLeaf)
+				{
+					++NodeIndex;
+					continue;
+				}
+				for (int32 OtherSlot = Node.First; OtherSlot < Node.First + Node.Count; ++OtherSlot)
+				{
+					if (OtherSlot != Slot)
+					{
+						const FBody& Other = Bodies[OtherSlot];
+						AddPull(GetCellOffset(Other.Cell, Body.Cell) + (Other.Offset - Body.Offset), Other.Mass);
+					}
+				}
+				NodeIndex = Node.Next;
+			}
+
+			OutAccelerations[Body.Index] = Acceleration * GravitationalConstant;
+			if (OutPotentials.Num() > 0)
+			{
+				OutPotentials[Body.Index] = Potential * GravitationalConstant;
+			}
+		}
+	});
+}
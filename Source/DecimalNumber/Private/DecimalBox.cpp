@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalBox.h"
+#include "DecimalMath.h"
+#include "DecimalMathBatch.h"
+#include "DecimalShadow.h"
+
+namespace DecimalBox
+{
+	static FORCEINLINE const FDecimal& GetAxis(const FDecimalVector& V, int32 Axis)
+	{
+		return Axis == 0 ? V.X : (Axis == 1 ? V.Y : V.Z);
+	}
+
+	static FORCEINLINE FVector MakeShadow(const FDecimalVector& V)
+	{
+		return FVector(FDecimalShadowed::MakeShadow(V.X), FDecimalShadowed::MakeShadow(V.Y), FDecimalShadowed::MakeShadow(V.Z));
+	}
+
+	/** @return A.Compare(B), from the shadows when they are further apart than their error. */
+	static FORCEINLINE int32 Compare(const FDecimal& A, double AShadow, const FDecimal& B, double BShadow)
+	{
+		const double Gap = AShadow - BShadow;
+		if (FMath::Abs(Gap) > FDecimalShadowed::GetCombinedError(AShadow, BShadow))
+		{
+			DECIMAL_COUNT_SHADOW(Filtered);
+			return Gap < 0.0 ? -1 : 1;
+		}
+		DECIMAL_COUNT_SHADOW(Exact);
+		return A.Compare(B);
+	}
+
+	static FORCEINLINE bool IsInsideOrOn(const FDecimalVector& Min, const FVector& MinShadow, const FDecimalVector& Max, const FVector& MaxShadow, const FDecimalVector& Point, const FVector& PointShadow)
+	{
+		return Compare(Point.X, PointShadow.X, Min.X, MinShadow.X) >= 0 && Compare(Point.X, PointShadow.X, Max.X, MaxShadow.X) <= 0
+			&& Compare(Point.Y, PointShadow.Y, Min.Y, MinShadow.Y) >= 0 && Compare(Point.Y, PointShadow.Y, Max.Y, MaxShadow.Y) <= 0
+			&& Compare(Point.Z, PointShadow.Z, Min.Z, MinShadow.Z) >= 0 && Compare(Point.Z, PointShadow.Z, Max.Z, MaxShadow.Z) <= 0;
+	}
+
+	static FORCEINLINE bool Intersect(const FDecimalBox& A, const FVector& AMinShadow, const FVector& AMaxShadow, const FDecimalBox& B, const FVector& BMinShadow, const FVector& BMaxShadow)
+	{
+		return Compare(A.Min.X, AMinShadow.X, B.Max.X, BMaxShadow.X) <= 0 && Compare(B.Min.X, BMinShadow.X, A.Max.X, AMaxShadow.X) <= 0
+			&& Compare(A.Min.Y, AMinShadow.Y, B.Max.Y, BMaxShadow.Y) <= 0 && Compare(B.Min.Y, BMinShadow.Y, A.Max.Y, AMaxShadow.Y) <= 0
+			&& Compare(A.Min.Z, AMinShadow.Z, B.Max.Z, BMaxShadow.Z) <= 0 && Compare(B.Min.Z, BMinShadow.Z, A.Max.Z, AMaxShadow.Z) <= 0;
+	}
+
+	/** Write the indices of the flagged elements to OutIndices, in increasing order. */
+	static void GatherFlagged(const TArray<uint8>& Flags, TArray<int32>& OutIndices)
+	{
+		OutIndices.Reset();
+		for (int32 Index = 0; Index < Flags.Num(); ++Index)
+		{
+			if (Flags[Index] != 0)
+			{
+				OutIndices.Add(Index);
+			}
+		}
+	}
+}
+
+FDecimalBox::FDecimalBox(TConstArrayView<FDecimalVector> Points)
+	: Min(0)
+	, Max(0)
+	, IsValid(false)
+{
+	for (const FDecimalVector& Point : Points)
+	{
+		*this += Point;
+	}
+}
+
+FDecimalBox FDecimalBox::BuildAABB(const FDecimalVector& Origin, const FDecimalVector& Extent)
+{
+	return FDecimalBox(Origin - Extent, Origin + Extent);
+}
+
+FDecimalBox& FDecimalBox::operator+=(const FDecimalVector& Other)
+{
+	if (IsValid)
+	{
+		Min = Min.ComponentMin(Other);
+		Max = Max.ComponentMax(Other);
+	}
+	else
+	{
+		Min = Max = Other;
+		IsValid = true;
+	}
+	return *this;
+}
+
+FDecimalBox& FDecimalBox::operator+=(const FDecimalBox& Other)
+{
+	if (IsValid && Other.IsValid)
+	{
+		Min = Min.ComponentMin(Other.Min);
+		Max = Max.ComponentMax(Other.Max);
+	}
+	else if (Other.IsValid)
+	{
+		*this = Other;
+	}
+	return *this;
+}
+
+bool FDecimalBox::operator==(const FDecimalBox& Other) const
+{
+	return Min == Other.Min && Max == Other.Max;
+}
+
+FDecimalVector FDecimalBox::GetCenter() const
+{
+	return (Min + Max) * FDecimal(0.5);
+}
+
+FDecimalVector FDecimalBox::GetExtent() const
+{
+	return (Max - Min) * FDecimal(0.5);
+}
+
+FDecimalBox FDecimalBox::ExpandBy(const FDecimal& W) const
+{
+	const FDecimalVector Expansion(W, W, W);
+	return FDecimalBox(Min - Expansion, Max + Expansion);
+}
+
+bool FDecimalBox::IsInside(const FDecimalVector& Point) const
+{
+	return Point.X.Compare(Min.X) > 0 && Point.X.Compare(Max.X) < 0
+		&& Point.Y.Compare(Min.Y) > 0 && Point.Y.Compare(Max.Y) < 0
+		&& Point.Z.Compare(Min.Z) > 0 && Point.Z.Compare(Max.Z) < 0;
+}
+
+bool FDecimalBox::IsInsideOrOn(const FDecimalVector& Point) const
+{
+	return Point.X.Compare(Min.X) >= 0 && Point.X.Compare(Max.X) <= 0
+		&& Point.Y.Compare(Min.Y) >= 0 && Point.Y.Compare(Max.Y) <= 0
+		&& Point.Z.Compare(Min.Z) >= 0 && Point.Z.Compare(Max.Z) <= 0;
+}
+
+bool FDecimalBox::Intersect(const FDecimalBox& Other) const
+{
+	return Min.X.Compare(Other.Max.X) <= 0 && Other.Min.X.Compare(Max.X) <= 0
+		&& Min.Y.Compare(Other.Max.Y) <= 0 && Other.Min.Y.Compare(Max.Y) <= 0
+		&& Min.Z.Compare(Other.Max.Z) <= 0 && Other.Min.Z.Compare(Max.Z) <= 0;
+}
+
+FDecimal FDecimalBox::ComputeSquaredDistanceToPoint(const FDecimalVector& Point) const
+{
+	FDecimal DistSquared(0);
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const FDecimal& Value = DecimalBox::GetAxis(Point, Axis);
+		const FDecimal& AxisMin = DecimalBox::GetAxis(Min, Axis);
+		const FDecimal& AxisMax = DecimalBox::GetAxis(Max, Axis);
+		if (Value < AxisMin)
+		{
+			const FDecimal Delta = AxisMin - Value;
+			DistSquared += Delta * Delta;
+		}
+		else if (Value > AxisMax)
+		{
+			const FDecimal Delta = Value - AxisMax;
+			DistSquared += Delta * Delta;
+		}
+	}
+	return DistSquared;
+}
+
+bool FDecimalBox::IntersectRay(const FDecimalVector& Origin, const FDecimalVector& Direction, const FDecimal& MaxTime, FDecimal& OutTime) const
+{
+	// Clip [0, MaxTime] against the slab of every axis.
+	FDecimal Enter(0);
+	FDecimal Exit(MaxTime);
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const FDecimal& Start = DecimalBox::GetAxis(Origin, Axis);
+		const FDecimal& Step = DecimalBox::GetAxis(Direction, Axis);
+		const FDecimal& AxisMin = DecimalBox::GetAxis(Min, Axis);
+		const FDecimal& AxisMax = DecimalBox::GetAxis(Max, Axis);
+		if (Step.IsZero())
+		{
+			if (Start < AxisMin || Start > AxisMax)
+			{
+				return false;
+			}
+			continue;
+		}
+
+		FDecimal Near = (AxisMin - Start) / Step;
+		FDecimal Far = (AxisMax - Start) / Step;
+		if (Step.IsNegative())
+		{
+			Swap(Near, Far);
+		}
+		if (Near > Enter)
+		{
+			Enter = Near;
+		}
+		if (Far < Exit)
+		{
+			Exit = Far;
+		}
+		if (Enter > Exit)
+		{
+			return false;
+		}
+	}
+
+	OutTime = Enter;
+	return true;
+}
+
+void FDecimalBox::FindPointsInside(TConstArrayView<FDecimalVector> Points, TArray<int32>& OutIndices) const
+{
+	const FVector MinShadow = DecimalBox::MakeShadow(Min);
+	const FVector MaxShadow = DecimalBox::MakeShadow(Max);
+	TArray<uint8> Inside;
+	Inside.SetNumUninitialized(Points.Num());
+	DecimalMathBatch::ForEachRange(Points.Num(), FDecimalMath::Batch::GetGrainSize(), PLATFORM_CACHE_LINE_SIZE, [this, Points, &Inside, &MinShadow, &MaxShadow](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const FDecimalVector& Point = Points[Index];
+			Inside[Index] = DecimalBox::IsInsideOrOn(Min, MinShadow, Max, MaxShadow, Point, DecimalBox::MakeShadow(Point));
+		}
+	});
+	DecimalBox::GatherFlagged(Inside, OutIndices);
+}
+
+void FDecimalBox::FindIntersecting(TConstArrayView<FDecimalBox> Boxes, TArray<int32>& OutIndices) const
+{
+	const FVector MinShadow = DecimalBox::MakeShadow(Min);
+	const FVector MaxShadow = DecimalBox::MakeShadow(Max);
+	TArray<uint8> Intersecting;
+	Intersecting.SetNumUninitialized(Boxes.Num());
+	DecimalMathBatch::ForEachRange(Boxes.Num(), FDecimalMath::Batch::GetGrainSize(), PLATFORM_CACHE_LINE_SIZE, [this, Boxes, &Intersecting, &MinShadow, &MaxShadow](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const FDecimalBox& Box = Boxes[Index];
+			Intersecting[Index] = DecimalBox::Intersect(*this, MinShadow, MaxShadow, Box, DecimalBox::MakeShadow(Box.Min), DecimalBox::MakeShadow(Box.Max));
+		}
+	});
+	DecimalBox::GatherFlagged(Intersecting, OutIndices);
+}
@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalDivisor.h"
+#include "DecimalBackend.h"
+#include "DecimalVector.h"
+
+FDecimalDivisor::FDecimalDivisor()
+	: Divisor(1)
+	, Reciprocal(1)
+{
+}
+
+FDecimalDivisor::FDecimalDivisor(const FDecimal& InDivisor)
+	: Divisor(InDivisor)
+{
+	Reciprocal.GetValue() = DecimalBackend::Reciprocal(Divisor.GetValue());
+}
+
+FDecimal FDecimalDivisor::Divide(const FDecimal& Value) const
+{
+	FDecimal Result;
+	Result.GetValue() = DecimalBackend::DivideBy(Value.GetValue(), Divisor.GetValue(), Reciprocal.GetValue());
+	return Result;
+}
+
+FDecimalVector FDecimalDivisor::Divide(const FDecimalVector& Value) const
+{
+	return FDecimalVector(Divide(Value.X), Divide(Value.Y), Divide(Value.Z));
+}
+
+FDecimalVector operator/(const FDecimalVector& A, const FDecimalDivisor& B)
+{
+	return B.Divide(A);
+}
@@ -0,0 +1,412 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalFixed128.h"
+
+#if defined(__SIZEOF_INT128__)
+
+THIRD_PARTY_INCLUDES_START
+#pragma push_macro("check")
+#undef check
+#include <boost/multiprecision/cpp_bin_float.hpp>
+#pragma pop_macro("check")
+THIRD_PARTY_INCLUDES_END
+
+#include <cmath>
+
+namespace DecimalFixed128
+{
+	typedef FDecimalFixed128::RawType RawType;
+	typedef FDecimalFixed128::UnsignedRawType UnsignedRawType;
+	typedef boost::multiprecision::cpp_bin_float_50 FWideFloat;
+
+	static constexpr UnsignedRawType MaxMagnitude = static_cast<UnsignedRawType>(FDecimalFixed128::MaxRaw);
+
+	/** Powers of ten that fit in 64 bits, 10^0 to 10^19. */
+	static constexpr uint64 PowersOfTen[] =
+	{
+		1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+		10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+		1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull,
+		10000000000000000000ull
+	};
+
+	static FORCEINLINE UnsignedRawType Magnitude(RawType Value)
+	{
+		return Value < 0 ? UnsignedRawType(0) - static_cast<UnsignedRawType>(Value) : static_cast<UnsignedRawType>(Value);
+	}
+
+	/** Applies the sign to a magnitude, saturating magnitudes the signed type cannot hold. */
+	static FORCEINLINE RawType ToSigned(UnsignedRawType InMagnitude, bool bNegative)
+	{
+		if (InMagnitude > MaxMagnitude)
+		{
+			return bNegative ? FDecimalFixed128::MinRaw : FDecimalFixed128::MaxRaw;
+		}
+		return bNegative ? -static_cast<RawType>(InMagnitude) : static_cast<RawType>(InMagnitude);
+	}
+
+	static FWideFloat ToWide(const FDecimalFixed128& Value)
+	{
+		const RawType Raw = Value.GetRaw();
+		const FWideFloat High = FWideFloat(static_cast<int64>(Raw >> 64));
+		const FWideFloat Low = FWideFloat(static_cast<uint64>(Raw));
+		return (boost::multiprecision::ldexp(High, 64) + Low) / FDecimalFixed128::Scale;
+	}
+
+	static FDecimalFixed128 FromWide(const FWideFloat& Value)
+	{
+		const FWideFloat Scaled = boost::multiprecision::round(Value * FDecimalFixed128::Scale);
+		const FWideFloat Limit = boost::multiprecision::ldexp(FWideFloat(1), 127);
+		if (Scaled >= Limit)
+		{
+			return FDecimalFixed128::FromRaw(FDecimalFixed128::MaxRaw);
+		}
+		if (Scaled < -Limit)
+		{
+			return FDecimalFixed128::FromRaw(FDecimalFixed128::MinRaw);
+		}
+
+		const FWideFloat High = boost::multiprecision::floor(boost::multiprecision::ldexp(Scaled, -64));
+		const FWideFloat Low = Scaled - boost::multiprecision::ldexp(High, 64);
+		const RawType Raw = (static_cast<RawType>(High.convert_to<int64>()) << 64) | static_cast<RawType>(Low.convert_to<uint64>());
+		return FDecimalFixed128::FromRaw(Raw);
+	}
+
+	/** Appends the decimal digits of Value, at least MinDigits of them. */
+	static void AppendDigits(std::string& Out, UnsignedRawType Value, int32 MinDigits)
+	{
+		char Buffer[48];
+		int32 Length = 0;
+		while (Value != 0 || Length < MinDigits)
+		{
+			Buffer[Length++] = static_cast<char>('0' + static_cast<int32>(Value % 10));
+			Value /= 10;
+		}
+		while (Length > 0)
+		{
+			Out.push_back(Buffer[--Length]);
+		}
+	}
+}
+
+FDecimalFixed128::FDecimalFixed128(double InVal)
+{
+	using namespace DecimalFixed128;
+
+	if (!std::isfinite(InVal))
+	{
+		Raw = std::isnan(InVal) ? 0 : (InVal < 0.0 ? MinRaw : MaxRaw);
+		return;
+	}
+
+	// Integer and fractional parts are scaled separately, so the fraction keeps all of its 53 bits.
+	const double IntegerPart = std::trunc(InVal);
+	if (std::fabs(IntegerPart) >= 1.7e20)
+	{
+		Raw = InVal < 0.0 ? MinRaw : MaxRaw;
+		return;
+	}
+	Raw = static_cast<RawType>(IntegerPart) * Scale + static_cast<RawType>(std::llround((InVal - IntegerPart) * static_cast<double>(Scale)));
+}
+
+FDecimalFixed128::FDecimalFixed128(const char* InVal)
+	: Raw(0)
+{
+	using namespace DecimalFixed128;
+
+	const char* Cursor = InVal;
+	const bool bNegative = (*Cursor == '-');
+	if (*Cursor == '-' || *Cursor == '+')
+	{
+		++Cursor;
+	}
+
+	UnsignedRawType Magnitude = 0;
+	bool bOverflow = false;
+	for (; *Cursor >= '0' && *Cursor <= '9'; ++Cursor)
+	{
+		bOverflow |= __builtin_mul_overflow(Magnitude, UnsignedRawType(10), &Magnitude);
+		bOverflow |= __builtin_add_overflow(Magnitude, UnsignedRawType(*Cursor - '0'), &Magnitude);
+	}
+	bOverflow |= __builtin_mul_overflow(Magnitude, UnsignedRawType(Scale), &Magnitude);
+
+	if (*Cursor == '.')
+	{
+		++Cursor;
+		uint64 Fraction = 0;
+		int32 NumDigits = 0;
+		for (; *Cursor >= '0' && *Cursor <= '9' && NumDigits < FractionDigits; ++Cursor, ++NumDigits)
+		{
+			Fraction = Fraction * 10 + (*Cursor - '0');
+		}
+		Fraction *= PowersOfTen[FractionDigits - NumDigits];
+		if (*Cursor >= '5' && *Cursor <= '9')
+		{
+			++Fraction;
+		}
+		bOverflow |= __builtin_add_overflow(Magnitude, UnsignedRawType(Fraction), &Magnitude);
+	}
+
+	Raw = bOverflow ? (bNegative ? MinRaw : MaxRaw) : ToSigned(Magnitude, bNegative);
+}
+
+std::string FDecimalFixed128::str(std::streamsize Digits, std::ios_base::fmtflags) const
+{
+	using namespace DecimalFixed128;
+
+	const int32 Places = static_cast<int32>(Digits);
+	UnsignedRawType Magnitude = DecimalFixed128::Magnitude(Raw);
+	if (Places < FractionDigits)
+	{
+		const uint64 Step = PowersOfTen[FractionDigits - FMath::Max(Places, 0)];
+		const UnsignedRawType Remainder = Magnitude % Step;
+		Magnitude -= Remainder;
+
+		// Ties go to the even digit, like cpp_dec_float.
+		const bool bRoundUp = Remainder * 2 > Step || (Remainder * 2 == Step && (Magnitude / Step) % 2 != 0);
+		if (bRoundUp && Magnitude <= MaxMagnitude - Step)
+		{
+			Magnitude += Step;
+		}
+	}
+
+	std::string Result;
+	if (Raw < 0 && Magnitude != 0)
+	{
+		Result.push_back('-');
+	}
+	AppendDigits(Result, Magnitude / Scale, 1);
+
+	if (Places > 0)
+	{
+		Result.push_back('.');
+		std::string Fraction;
+		AppendDigits(Fraction, Magnitude % Scale, FractionDigits);
+		Fraction.resize(Places, '0');
+		Result += Fraction;
+	}
+	return Result;
+}
+
+double FDecimalFixed128::ToDouble() const
+{
+	return static_cast<double>(Raw / Scale) + static_cast<double>(Raw % Scale) / static_cast<double>(Scale);
+}
+
+FDecimalFixed128::RawType FDecimalFixed128::Multiply(RawType A, RawType B)
+{
+	using namespace DecimalFixed128;
+
+	const bool bNegative = (A < 0) != (B < 0);
+	const UnsignedRawType MagnitudeA = DecimalFixed128::Magnitude(A);
+	const UnsignedRawType MagnitudeB = DecimalFixed128::Magnitude(B);
+
+	const uint64 A0 = static_cast<uint64>(MagnitudeA);
+	const uint64 A1 = static_cast<uint64>(MagnitudeA >> 64);
+	const uint64 B0 = static_cast<uint64>(MagnitudeB);
+	const uint64 B1 = static_cast<uint64>(MagnitudeB >> 64);
+
+	// Common case: both operands below 2^64, a single 128-bit product.
+	if ((A1 | B1) == 0)
+	{
+		const UnsignedRawType Product = static_cast<UnsignedRawType>(A0) * B0;
+		UnsignedRawType Quotient = Product / Scale;
+		if ((Product % Scale) * 2 >= Scale)
+		{
+			++Quotient;
+		}
+		return ToSigned(Quotient, bNegative);
+	}
+
+	// 256-bit product as four 64-bit limbs, least significant first.
+	const UnsignedRawType P00 = static_cast<UnsignedRawType>(A0) * B0;
+	const UnsignedRawType P01 = static_cast<UnsignedRawType>(A0) * B1;
+	const UnsignedRawType P10 = static_cast<UnsignedRawType>(A1) * B0;
+	const UnsignedRawType P11 = static_cast<UnsignedRawType>(A1) * B1;
+
+	const UnsignedRawType Middle = (P00 >> 64) + static_cast<uint64>(P01) + static_cast<uint64>(P10);
+	const UnsignedRawType Upper = (Middle >> 64) + (P01 >> 64) + (P10 >> 64) + static_cast<uint64>(P11);
+	const uint64 Limbs[4] = { static_cast<uint64>(P00), static_cast<uint64>(Middle), static_cast<uint64>(Upper), static_cast<uint64>((Upper >> 64) + (P11 >> 64)) };
+
+	// Long division by the scale, one limb at a time from the top.
+	uint64 Quotient[4];
+	UnsignedRawType Remainder = 0;
+	for (int32 LimbIndex = 3; LimbIndex >= 0; --LimbIndex)
+	{
+		const UnsignedRawType Current = (Remainder << 64) | Limbs[LimbIndex];
+		Quotient[LimbIndex] = static_cast<uint64>(Current / Scale);
+		Remainder = Current % Scale;
+	}
+
+	if ((Quotient[3] | Quotient[2]) != 0)
+	{
+		return bNegative ? MinRaw : MaxRaw;
+	}
+	UnsignedRawType Result = (static_cast<UnsignedRawType>(Quotient[1]) << 64) | Quotient[0];
+	if (Remainder * 2 >= Scale && Result != ~UnsignedRawType(0))
+	{
+		++Result;
+	}
+	return ToSigned(Result, bNegative);
+}
+
+FDecimalFixed128::RawType FDecimalFixed128::Divide(RawType A, RawType B)
+{
+	using namespace DecimalFixed128;
+
+	if (B == 0)
+	{
+		return (A == 0) ? 0 : (A < 0 ? MinRaw : MaxRaw);
+	}
+
+	const bool bNegative = (A < 0) != (B < 0);
+	const UnsignedRawType MagnitudeA = DecimalFixed128::Magnitude(A);
+	UnsignedRawType Divisor = DecimalFixed128::Magnitude(B);
+
+	UnsignedRawType Integer = MagnitudeA / Divisor;
+	UnsignedRawType Remainder = MagnitudeA % Divisor;
+	if (Integer > MaxMagnitude / Scale)
+	{
+		return bNegative ? MinRaw : MaxRaw;
+	}
+	UnsignedRawType Result = Integer * Scale;
+
+	// The fraction is produced in as few chunks of decimal digits as the remainder allows without overflowing.
+	int32 Remaining = FractionDigits;
+	while (Remaining > 0)
+	{
+		int32 Chunk = Remaining;
+		while (Chunk > 0 && Remainder > ~UnsignedRawType(0) / PowersOfTen[Chunk])
+		{
+			--Chunk;
+		}
+		if (Chunk == 0)
+		{
+			// Only divisors above 3.4e19 get here, dropping their lowest bit costs far less than a last place.
+			Remainder >>= 1;
+			Divisor >>= 1;
+			continue;
+		}
+
+		Remainder *= PowersOfTen[Chunk];
+		Remaining -= Chunk;
+		Result += (Remainder / Divisor) * PowersOfTen[Remaining];
+		Remainder %= Divisor;
+	}
+
+	if (Remainder * 2 >= Divisor)
+	{
+		++Result;
+	}
+	return ToSigned(Result, bNegative);
+}
+
+FDecimalFixed128 FDecimalFixed128::Floor(const FDecimalFixed128& Value)
+{
+	const RawType Remainder = Value.Raw % static_cast<RawType>(Scale);
+	if (Remainder < 0)
+	{
+		// The integer below MinRaw is out of range, saturate like every other overflow.
+		if (Value.Raw - Remainder < MinRaw + static_cast<RawType>(Scale))
+		{
+			return FromRaw(MinRaw);
+		}
+		return FromRaw(Value.Raw - Remainder - static_cast<RawType>(Scale));
+	}
+	return FromRaw(Value.Raw - Remainder);
+}
+
+FDecimalFixed128 FDecimalFixed128::Ceil(const FDecimalFixed128& Value)
+{
+	const RawType Remainder = Value.Raw % static_cast<RawType>(Scale);
+	if (Remainder > 0)
+	{
+		if (Value.Raw - Remainder > MaxRaw - static_cast<RawType>(Scale))
+		{
+			return FromRaw(MaxRaw);
+		}
+		return FromRaw(Value.Raw - Remainder + static_cast<RawType>(Scale));
+	}
+	return FromRaw(Value.Raw - Remainder);
+}
+
+FDecimalFixed128 FDecimalFixed128::Sqrt(const FDecimalFixed128& Value)
+{
+	if (Value.Raw <= 0)
+	{
+		return FDecimalFixed128();
+	}
+
+	// A double estimate is good to 53 bits, one Newton step in fixed point takes it past the last place.
+	const FDecimalFixed128 Estimate(std::sqrt(Value.ToDouble()));
+	if (Estimate.Raw <= 0)
+	{
+		return FromRaw(1);
+	}
+	return FromRaw((Estimate.Raw + Divide(Value.Raw, Estimate.Raw)) / 2);
+}
+
+FDecimalFixed128 FDecimalFixed128::Sin(const FDecimalFixed128& Value)
+{
+	return DecimalFixed128::FromWide(boost::multiprecision::sin(DecimalFixed128::ToWide(Value)));
+}
+
+FDecimalFixed128 FDecimalFixed128::Cos(const FDecimalFixed128& Value)
+{
+	return DecimalFixed128::FromWide(boost::multiprecision::cos(DecimalFixed128::ToWide(Value)));
+}
+
+FDecimalFixed128 FDecimalFixed128::Asin(const FDecimalFixed128& Value)
+{
+	return DecimalFixed128::FromWide(boost::multiprecision::asin(DecimalFixed128::ToWide(Value)));
+}
+
+FDecimalFixed128 FDecimalFixed128::Acos(const FDecimalFixed128& Value)
+{
+	return DecimalFixed128::FromWide(boost::multiprecision::acos(DecimalFixed128::ToWide(Value)));
+}
+
+FDecimalFixed128 FDecimalFixed128::Atan(const FDecimalFixed128& Value)
+{
+	return DecimalFixed128::FromWide(boost::multiprecision::atan(DecimalFixed128::ToWide(Value)));
+}
+
+FDecimalFixed128 FDecimalFixed128::Atan2(const FDecimalFixed128& Y, const FDecimalFixed128& X)
+{
+	return DecimalFixed128::FromWide(boost::multiprecision::atan2(DecimalFixed128::ToWide(Y), DecimalFixed128::ToWide(X)));
+}
+
+FDecimalFixed128 FDecimalFixed128::Pow(const FDecimalFixed128& Base, const FDecimalFixed128& Exponent)
+{
+	if (Exponent.Raw % static_cast<RawType>(Scale) == 0 && Exponent.Raw / static_cast<RawType>(Scale) <= MAX_int32 && Exponent.Raw / static_cast<RawType>(Scale) >= MIN_int32)
+	{
+		return Pow(Base, static_cast<int64>(Exponent.Raw / static_cast<RawType>(Scale)));
+	}
+	return DecimalFixed128::FromWide(boost::multiprecision::pow(DecimalFixed128::ToWide(Base), DecimalFixed128::ToWide(Exponent)));
+}
+
+FDecimalFixed128 FDecimalFixed128::Pow(const FDecimalFixed128& Base, int64 Exponent)
+{
+	FDecimalFixed128 Result(1);
+	FDecimalFixed128 Factor(Base);
+	for (uint64 Remaining = Exponent < 0 ? 0 - static_cast<uint64>(Exponent) : static_cast<uint64>(Exponent); Remaining != 0; Remaining >>= 1)
+	{
+		if (Remaining & 1)
+		{
+			Result *= Factor;
+		}
+		if (Remaining > 1)
+		{
+			Factor *= Factor;
+		}
+	}
+	return Exponent < 0 ? FDecimalFixed128(1) / Result : Result;
+}
+
+FDecimalFixed128 FDecimalFixed128::Pi()
+{
+	return FromRaw(3141592653589793238ll);
+}
+
+#endif
@@ -0,0 +1,165 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <string>
+#include <ios>
+
+#if defined(__SIZEOF_INT128__)
+
+/**
+ * Fixed point number stored as a signed 128-bit integer scaled by 10^18, one of the types FDecimal can be built on
+ * (see DecimalBackend.h). Covers +-1.7e20 with 18 exact decimal places, which is enough for world coordinates.
+ *
+ * Addition, subtraction and comparison are single integer operations. Multiplication and division go through a
+ * 256-bit intermediate and round to the nearest last place. Results that do not fit saturate, and there is no NaN
+ * or infinity: dividing by zero saturates as well, and 0 / 0 is 0.
+ * Square roots are computed natively, other transcendental functions convert to cpp_bin_float_50 and back.
+ */
+struct DECIMALNUMBER_API FDecimalFixed128
+{
+	typedef __int128 RawType;
+	typedef unsigned __int128 UnsignedRawType;
+
+	/** Decimal places kept. */
+	static constexpr int32 FractionDigits = 18;
+
+	/** Raw value of 1. */
+	static constexpr uint64 Scale = 1000000000000000000ull;
+
+	static constexpr RawType MaxRaw = static_cast<RawType>(~UnsignedRawType(0) >> 1);
+	static constexpr RawType MinRaw = -MaxRaw - 1;
+
+	FDecimalFixed128()
+		: Raw(0)
+	{
+	}
+
+	template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+	FDecimalFixed128(T InVal)
+		: Raw(static_cast<RawType>(InVal) * Scale)
+	{
+	}
+
+	FDecimalFixed128(double InVal);
+
+	FDecimalFixed128(float InVal)
+		: FDecimalFixed128(static_cast<double>(InVal))
+	{
+	}
+
+	/** Parses [+-]digits[.digits], extra decimal places are rounded. */
+	explicit FDecimalFixed128(const char* InVal);
+
+	static FORCEINLINE FDecimalFixed128 FromRaw(RawType InRaw)
+	{
+		FDecimalFixed128 Result;
+		Result.Raw = InRaw;
+		return Result;
+	}
+
+	FORCEINLINE RawType GetRaw() const
+	{
+		return Raw;
+	}
+
+	FORCEINLINE FDecimalFixed128& operator+=(const FDecimalFixed128& Other)
+	{
+		if (__builtin_add_overflow(Raw, Other.Raw, &Raw))
+		{
+			Raw = (Other.Raw < 0) ? MinRaw : MaxRaw;
+		}
+		return *this;
+	}
+
+	FORCEINLINE FDecimalFixed128& operator-=(const FDecimalFixed128& Other)
+	{
+		if (__builtin_sub_overflow(Raw, Other.Raw, &Raw))
+		{
+			Raw = (Other.Raw < 0) ? MaxRaw : MinRaw;
+		}
+		return *this;
+	}
+
+	FORCEINLINE FDecimalFixed128& operator*=(const FDecimalFixed128& Other)
+	{
+		Raw = Multiply(Raw, Other.Raw);
+		return *this;
+	}
+
+	FORCEINLINE FDecimalFixed128& operator/=(const FDecimalFixed128& Other)
+	{
+		Raw = Divide(Raw, Other.Raw);
+		return *this;
+	}
+
+	FORCEINLINE FDecimalFixed128 operator+(const FDecimalFixed128& Other) const { return FDecimalFixed128(*this) += Other; }
+	FORCEINLINE FDecimalFixed128 operator-(const FDecimalFixed128& Other) const { return FDecimalFixed128(*this) -= Other; }
+	FORCEINLINE FDecimalFixed128 operator*(const FDecimalFixed128& Other) const { return FromRaw(Multiply(Raw, Other.Raw)); }
+	FORCEINLINE FDecimalFixed128 operator/(const FDecimalFixed128& Other) const { return FromRaw(Divide(Raw, Other.Raw)); }
+
+	FORCEINLINE FDecimalFixed128 operator-() const
+	{
+		return FromRaw(Raw == MinRaw ? MaxRaw : -Raw);
+	}
+
+	FORCEINLINE bool operator==(const FDecimalFixed128& Other) const { return Raw == Other.Raw; }
+	FORCEINLINE bool operator!=(const FDecimalFixed128& Other) const { return Raw != Other.Raw; }
+	FORCEINLINE bool operator<(const FDecimalFixed128& Other) const { return Raw < Other.Raw; }
+	FORCEINLINE bool operator<=(const FDecimalFixed128& Other) const { return Raw <= Other.Raw; }
+	FORCEINLINE bool operator>(const FDecimalFixed128& Other) const { return Raw > Other.Raw; }
+	FORCEINLINE bool operator>=(const FDecimalFixed128& Other) const { return Raw >= Other.Raw; }
+
+	/** @return -1, 0 or 1. */
+	FORCEINLINE int32 Compare(const FDecimalFixed128& Other) const
+	{
+		return int32(Raw > Other.Raw) - int32(Raw < Other.Raw);
+	}
+
+	/** @return -1, 0 or 1 comparing the magnitudes. */
+	FORCEINLINE int32 CompareAbs(const FDecimalFixed128& Other) const
+	{
+		const UnsignedRawType A = Magnitude(Raw);
+		const UnsignedRawType B = Magnitude(Other.Raw);
+		return int32(A > B) - int32(A < B);
+	}
+
+	/** Same contract as boost::multiprecision::number::str with std::ios::fixed: Digits decimal places, rounded. Flags are ignored, the result is always fixed. */
+	std::string str(std::streamsize Digits, std::ios_base::fmtflags Flags = std::ios_base::fixed) const;
+
+	double ToDouble() const;
+
+	static FDecimalFixed128 Floor(const FDecimalFixed128& Value);
+	static FDecimalFixed128 Ceil(const FDecimalFixed128& Value);
+	static FDecimalFixed128 Sqrt(const FDecimalFixed128& Value);
+	static FDecimalFixed128 Sin(const FDecimalFixed128& Value);
+	static FDecimalFixed128 Cos(const FDecimalFixed128& Value);
+	static FDecimalFixed128 Asin(const FDecimalFixed128& Value);
+	static FDecimalFixed128 Acos(const FDecimalFixed128& Value);
+	static FDecimalFixed128 Atan(const FDecimalFixed128& Value);
+	static FDecimalFixed128 Atan2(const FDecimalFixed128& Y, const FDecimalFixed128& X);
+	static FDecimalFixed128 Pow(const FDecimalFixed128& Base, const FDecimalFixed128& Exponent);
+
+	/** Exponentiation by squaring, negative exponents divide one by the result. */
+	static FDecimalFixed128 Pow(const FDecimalFixed128& Base, int64 Exponent);
+
+	static FDecimalFixed128 Pi();
+
+private:
+	static FORCEINLINE UnsignedRawType Magnitude(RawType Value)
+	{
+		return Value < 0 ? UnsignedRawType(0) - static_cast<UnsignedRawType>(Value) : static_cast<UnsignedRawType>(Value);
+	}
+
+	/** @return A * B / Scale, rounded and saturated. */
+	static RawType Multiply(RawType A, RawType B);
+
+	/** @return A * Scale / B, rounded and saturated. */
+	static RawType Divide(RawType A, RawType B);
+
+	RawType Raw;
+};
+
+#endif
@@ -0,0 +1,155 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalIntegrator.h"
+#include "DecimalMath.h"
+#include "DecimalMathBatch.h"
+
+namespace DecimalIntegrator
+{
+	/** Smallest number of vectors whose size is a whole number of cache lines, the chunk size unit of every pass. */
+	static constexpr int32 VectorAlignment = PLATFORM_CACHE_LINE_SIZE / std::gcd<int32, int32>(sizeof(FVector), PLATFORM_CACHE_LINE_SIZE);
+
+	/** Run Kernel(Index) for every body, in parallel chunks. */
+	template <typename KernelType>
+	static void ForEachBody(int32 Num, const KernelType& Kernel)
+	{
+		DecimalMathBatch::ForEachRange(Num, FDecimalMath::Batch::GetGrainSize(), VectorAlignment, [&Kernel](int32 Begin, int32 End)
+		{
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				Kernel(Index);
+			}
+		});
+	}
+}
+
+void FDecimalIntegrator::Step(EDecimalIntegrator Method, double TimeStep, int32 NumSteps, FAccelerationFunc ComputeAccelerations)
+{
+	check(Velocities.Num() == Positions.Num());
+
+	const int32 NumBodies = Positions.Num();
+	if (Accelerations.Num() != NumBodies)
+	{
+		bAccelerationsValid = false;
+	}
+	StagePositions.SetNumUninitialized(NumBodies);
+	StageVelocities.SetNumUninitialized(NumBodies);
+	Accelerations.SetNumUninitialized(NumBodies);
+	if (Method == EDecimalIntegrator::RungeKutta4)
+	{
+		StartPositions.SetNumUninitialized(NumBodies);
+		StartVelocities.SetNumUninitialized(NumBodies);
+		PositionDeltas.SetNumUninitialized(NumBodies);
+		VelocityDeltas.SetNumUninitialized(NumBodies);
+	}
+
+	for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+	{
+		switch (Method)
+		{
+		case EDecimalIntegrator::SymplecticEuler:
+			StepSymplecticEuler(TimeStep, ComputeAccelerations);
+			break;
+		case EDecimalIntegrator::VelocityVerlet:
+			StepVelocityVerlet(TimeStep, ComputeAccelerations);
+			break;
+		case EDecimalIntegrator::RungeKutta4:
+			StepRungeKutta4(TimeStep, ComputeAccelerations);
+			break;
+		}
+		Time += TimeStep;
+	}
+}
+
+void FDecimalIntegrator::ResetAccelerations()
+{
+	bAccelerationsValid = false;
+}
+
+void FDecimalIntegrator::Evaluate(FAccelerationFunc ComputeAccelerations, double EvaluationTime, TConstArrayView<FVector> InStagePositions, TConstArrayView<FVector> InStageVelocities)
+{
+	DecimalMathBatch::ForEachRange(Positions.Num(), FDecimalMath::Batch::GetGrainSize(), DecimalIntegrator::VectorAlignment, [this, &ComputeAccelerations, EvaluationTime, InStagePositions, InStageVelocities](int32 Begin, int32 End)
+	{
+		ComputeAccelerations(Begin, End, EvaluationTime, InStagePositions, InStageVelocities, Accelerations);
+	});
+}
+
+void FDecimalIntegrator::StepSymplecticEuler(double TimeStep, FAccelerationFunc ComputeAccelerations)
+{
+	FDecimalMath::Batch::ToRelative(Origin, Positions, StagePositions);
+	FDecimalMath::Batch::ToRelative(FDecimalVector::ZeroVector, Velocities, StageVelocities);
+	Evaluate(ComputeAccelerations, Time, StagePositions, StageVelocities);
+
+	DecimalIntegrator::ForEachBody(Positions.Num(), [this, TimeStep](int32 Index)
+	{
+		StageVelocities[Index] += Accelerations[Index] * TimeStep;
+	});
+	FDecimalMath::Batch::AddRelative(Accelerations, TimeStep, Velocities);
+	FDecimalMath::Batch::AddRelative(StageVelocities, TimeStep, Positions);
+	bAccelerationsValid = false;
+}
+
+void FDecimalIntegrator::StepVelocityVerlet(double TimeStep, FAccelerationFunc ComputeAccelerations)
+{
+	const double HalfStep = 0.5 * TimeStep;
+	if (!bAccelerationsValid)
+	{
+		FDecimalMath::Batch::ToRelative(Origin, Positions, StagePositions);
+		FDecimalMath::Batch::ToRelative(FDecimalVector::ZeroVector, Velocities, StageVelocities);
+		Evaluate(ComputeAccelerations, Time, StagePositions, StageVelocities);
+	}
+
+	// Kick half a step, drift a whole one with the velocities halfway through it.
+	FDecimalMath::Batch::AddRelative(Accelerations, HalfStep, Velocities);
+	FDecimalMath::Batch::ToRelative(FDecimalVector::ZeroVector, Velocities, StageVelocities);
+	FDecimalMath::Batch::AddRelative(StageVelocities, TimeStep, Positions);
+
+	// Kick the second half with the accelerations at the end of the step, which the next step starts with.
+	FDecimalMath::Batch::ToRelative(Origin, Positions, StagePositions);
+	Evaluate(ComputeAccelerations, Time + TimeStep, StagePositions, StageVelocities);
+	FDecimalMath::Batch::AddRelative(Accelerations, HalfStep, Velocities);
+	bAccelerationsValid = true;
+}
+
+void FDecimalIntegrator::StepRungeKutta4(double TimeStep, FAccelerationFunc ComputeAccelerations)
+{
+	const double HalfStep = 0.5 * TimeStep;
+	FDecimalMath::Batch::ToRelative(Origin, Positions, StartPositions);
+	FDecimalMath::Batch::ToRelative(FDecimalVector::ZeroVector, Velocities, StartVelocities);
+
+	// The derivative of a position is the velocity of its stage, so the stages only need the accelerations.
+	Evaluate(ComputeAccelerations, Time, StartPositions, StartVelocities);
+	DecimalIntegrator::ForEachBody(Positions.Num(), [this, HalfStep](int32 Index)
+	{
+		PositionDeltas[Index] = StartVelocities[Index];
+		VelocityDeltas[Index] = Accelerations[Index];
+		StagePositions[Index] = StartPositions[Index] + StartVelocities[Index] * HalfStep;
+		StageVelocities[Index] = StartVelocities[Index] + Accelerations[Index] * HalfStep;
+	});
+
+	for (const double StageStep : { HalfStep, TimeStep })
+	{
+		Evaluate(ComputeAccelerations, Time + HalfStep, StagePositions, StageVelocities);
+		DecimalIntegrator::ForEachBody(Positions.Num(), [this, StageStep](int32 Index)
+		{
+			const FVector Velocity = StageVelocities[Index];
+			PositionDeltas[Index] += Velocity * 2.0;
+			VelocityDeltas[Index] += Accelerations[Index] * 2.0;
+			StagePositions[Index] = StartPositions[Index] + Velocity * StageStep;
+			StageVelocities[Index] = StartVelocities[Index] + Accelerations[Index] * StageStep;
+		});
+	}
+
+	Evaluate(ComputeAccelerations, Time + TimeStep, StagePositions, StageVelocities);
+	DecimalIntegrator::ForEachBody(Positions.Num(), [this](int32 Index)
+	{
+		PositionDeltas[Index] += StageVelocities[Index];
+		VelocityDeltas[Index] += Accelerations[Index];
+	});
+
+	// Only the weighted sums reach the decimal state, each added at decimal precision.
+	FDecimalMath::Batch::AddRelative(PositionDeltas, TimeStep / 6.0, Positions);
+	FDecimalMath::Batch::AddRelative(VelocityDeltas, TimeStep / 6.0, Velocities);
+	bAccelerationsValid = false;
+}
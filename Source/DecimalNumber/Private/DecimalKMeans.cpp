@@ -0,0 +1,371 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalKMeans.h"
+#include "DecimalMath.h"
+#include "DecimalMathBatch.h"
+#include "DecimalDivisor.h"
+#include "DecimalShadow.h"
+#include <atomic>
+#include <limits>
+
+namespace DecimalKMeans
+{
+	static constexpr double Unbounded = std::numeric_limits<double>::infinity();
+
+	/** Smallest point count whose per point state is a whole number of cache lines. */
+	static constexpr int32 StateAlignment = PLATFORM_CACHE_LINE_SIZE / sizeof(int32);
+
+	/** Sum and number of the points of every cluster. */
+	struct FClusterSums
+	{
+		TArray<FDecimalVector> Sums;
+		TArray<int32> Counts;
+	};
+
+	static FORCEINLINE double DistSquared(const FVector& A, const FVector& B)
+	{
+		const double X = A.X - B.X;
+		const double Y = A.Y - B.Y;
+		const double Z = A.Z - B.Z;
+		return X * X + Y * Y + Z * Z;
+	}
+
+	/** State of one FDecimalKMeans::Run call. All distance bounds hold for the exact distances, not their doubles. */
+	struct FSolver
+	{
+		TArray<FDecimalVector>& Centers;
+		TConstArrayView<FDecimalVector> Points;
+
+		/** Points and centers relative to the first point. */
+		TArray<FVector> RelativePoints;
+		TArray<FVector> RelativeCenters;
+
+		/** Bound on the error of any distance computed between RelativePoints and RelativeCenters. */
+		double Slack = 0.0;
+
+		/** Cluster of every point, INDEX_NONE before the first assignment or for points not comparable to any center. */
+		TArray<int32> Assignments;
+
+		/** Clusters found by the assignment in progress. */
+		TArray<int32> NextAssignments;
+
+		/** Upper bound on the distance from every point to its center. */
+		TArray<double> Upper;
+
+		/** Lower bound on the distance from every point to any other center. */
+		TArray<double> Lower;
+
+		/** Lower bound on half the distance from every center to the nearest other one. */
+		TArray<double> HalfGaps;
+
+		/** Upper bound on how far every center moved in the last update, the largest two and the center of the largest. */
+		TArray<double> Moves;
+		double MaxMove = 0.0;
+		double SecondMaxMove = 0.0;
+		int32 MaxMoveIndex = INDEX_NONE;
+
+		FClusterSums Clusters;
+
+		/** Whether any point joined or left every cluster since the last update, as 0 or 1. */
+		TArray<uint8> Touched;
+
+		std::atomic<int64> NumBoundHits{ 0 };
+		std::atomic<int64> NumFullScans{ 0 };
+		std::atomic<int64> NumExactTieBreaks{ 0 };
+
+		FSolver(TArray<FDecimalVector>& InCenters, TConstArrayView<FDecimalVector> InPoints)
+			: Centers(InCenters)
+			, Points(InPoints)
+		{
+			const int32 NumPoints = Points.Num();
+			const int32 NumCenters = Centers.Num();
+			const FDecimalVector& Origin = Points[0];
+
+			RelativePoints.SetNumUninitialized(NumPoints);
+			FDecimalMath::Batch::ToRelative(Origin, Points, RelativePoints);
+			RelativeCenters.SetNumUninitialized(NumCenters);
+			FDecimalMath::Batch::ToRelative(Origin, Centers, RelativeCenters);
+
+			// Centers only ever move to means of points, so the starting centers and the points bound every coordinate.
+			double Extent = 0.0;
+			for (const FVector& V : RelativePoints)
+			{
+				Extent = FMath::Max(Extent, FMath::Max3(FMath::Abs(V.X), FMath::Abs(V.Y), FMath::Abs(V.Z)));
+			}
+			for (const FVector& V : RelativeCenters)
+			{
+				Extent = FMath::Max(Extent, FMath::Max3(FMath::Abs(V.X), FMath::Abs(V.Y), FMath::Abs(V.Z)));
+			}
+			// Each coordinate is off by at most GetShadowError, so the difference of two points by less than four times
+			// that in length. Computing a distance of up to 2 * sqrt(3) * Extent rounds it by less than 16 epsilons of Extent.
+			Slack = 4.0 * FDecimalShadowed::GetShadowError(Extent) + 16.0 * DBL_EPSILON * Extent;
+
+			Assignments.Init(INDEX_NONE, NumPoints);
+			NextAssignments.SetNumUninitialized(NumPoints);
+			Upper.Init(Unbounded, NumPoints);
+			Lower.Init(0.0, NumPoints);
+			HalfGaps.SetNumUninitialized(NumCenters);
+			Moves.Init(0.0, NumCenters);
+			Touched.Init(0, NumCenters);
+			UpdateHalfGaps();
+		}
+
+		/** Assign every point to its nearest center and update the cluster sums. @return Number of points that changed cluster. */
+		int32 Assign()
+		{
+			DecimalMathBatch::ForEachRange(Points.Num(), FDecimalMath::Batch::GetGrainSize(), StateAlignment, [this](int32 Begin, int32 End)
+			{
+				int64 BoundHits = 0;
+				int64 FullScans = 0;
+				int64 ExactTieBreaks = 0;
+				for (int32 Index = Begin; Index < End; ++Index)
+				{
+					const int32 Cluster = Assignments[Index];
+					if (Cluster != INDEX_NONE)
+					{
+						Upper[Index] += Moves[Cluster];
+						Lower[Index] -= Cluster == MaxMoveIndex ? SecondMaxMove : MaxMove;
+
+						// No other center is nearer than Lower, nor than twice HalfGaps minus Upper by the triangle inequality.
+						const double Bound = FMath::Max(HalfGaps[Cluster], Lower[Index]);
+						if (Upper[Index] >= Bound)
+						{
+							Upper[Index] = FMath::Sqrt(DistSquared(RelativePoints[Index], RelativeCenters[Cluster])) + Slack;
+						}
+						if (Upper[Index] < Bound)
+						{
+							NextAssignments[Index] = Cluster;
+							++BoundHits;
+							continue;
+						}
+					}
+					NextAssignments[Index] = FindNearest(Index, ExactTieBreaks);
+					++FullScans;
+				}
+				NumBoundHits += BoundHits;
+				NumFullScans += FullScans;
+				NumExactTieBreaks += ExactTieBreaks;
+			});
+
+			const bool bFirstAssignment = Clusters.Sums.Num() == 0;
+			if (bFirstAssignment)
+			{
+				Clusters = DecimalMathBatch::Reduce<FClusterSums>(Points.Num(), [this](int32 Begin, int32 End)
+				{
+					FClusterSums Partial;
+					Partial.Sums.Init(FDecimalVector::ZeroVector, Centers.Num());
+					Partial.Counts.Init(0, Centers.Num());
+					for (int32 Index = Begin; Index < End; ++Index)
+					{
+						const int32 Cluster = NextAssignments[Index];
+						if (Cluster != INDEX_NONE)
+						{
+							Partial.Sums[Cluster] += Points[Index];
+							++Partial.Counts[Cluster];
+						}
+					}
+					return Partial;
+				},
+				[](const FClusterSums& A, const FClusterSums& B)
+				{
+					FClusterSums Result(A);
+					for (int32 Cluster = 0; Cluster < Result.Sums.Num(); ++Cluster)
+					{
+						Result.Sums[Cluster] += B.Sums[Cluster];
+						Result.Counts[Cluster] += B.Counts[Cluster];
+					}
+					return Result;
+				});
+				Touched.Init(1, Centers.Num());
+			}
+
+			// Moving the points that changed cluster in point order keeps the sums independent of the thread count.
+			int32 NumChanged = 0;
+			for (int32 Index = 0; Index < Points.Num(); ++Index)
+			{
+				const int32 From = Assignments[Index];
+				const int32 To = NextAssignments[Index];
+				if (From == To)
+				{
+					continue;
+				}
+				++NumChanged;
+				if (bFirstAssignment)
+				{
+					continue;
+				}
+				if (From != INDEX_NONE)
+				{
+					Clusters.Sums[From] -= Points[Index];
+					--Clusters.Counts[From];
+					Touched[From] = 1;
+				}
+				if (To != INDEX_NONE)
+				{
+					Clusters.Sums[To] += Points[Index];
+					++Clusters.Counts[To];
+					Touched[To] = 1;
+				}
+			}
+			Swap(Assignments, NextAssignments);
+			return NumChanged;
+		}
+
+		/**
+		 * Compare a point to every center, in FDecimal when the nearest ones are within rounding error of each other,
+		 * and set its bounds.
+		 *
+		 * @return The nearest center, the lowest index among equally near ones, INDEX_NONE if no distance is a number.
+		 */
+		int32 FindNearest(int32 Index, int64& ExactTieBreaks)
+		{
+			const FVector& Point = RelativePoints[Index];
+			double Nearest = Unbounded;
+			double SecondNearest = Unbounded;
+			int32 NearestIndex = INDEX_NONE;
+			for (int32 Cluster = 0; Cluster < RelativeCenters.Num(); ++Cluster)
+			{
+				const double Distance = DistSquared(Point, RelativeCenters[Cluster]);
+				if (Distance < Nearest)
+				{
+					SecondNearest = Nearest;
+					Nearest = Distance;
+					NearestIndex = Cluster;
+				}
+				else if (Distance < SecondNearest)
+				{
+					SecondNearest = Distance;
+				}
+			}
+			Nearest = FMath::Sqrt(Nearest);
+			SecondNearest = FMath::Sqrt(SecondNearest);
+			if (SecondNearest - Nearest > 2.0 * Slack)
+			{
+				Upper[Index] = Nearest + Slack;
+				Lower[Index] = SecondNearest - Slack;
+				return NearestIndex;
+			}
+
+			++ExactTieBreaks;
+			const double Limit = Nearest + 2.0 * Slack;
+			NearestIndex = INDEX_NONE;
+			FDecimal NearestExact;
+			for (int32 Cluster = 0; Cluster < RelativeCenters.Num(); ++Cluster)
+			{
+				if (FMath::Sqrt(DistSquared(Point, RelativeCenters[Cluster])) <= Limit)
+				{
+					const FDecimal Exact = FDecimalVector::DistSquared(Points[Index], Centers[Cluster]);
+					if (NearestIndex == INDEX_NONE || Exact < NearestExact)
+					{
+						NearestExact = Exact;
+						NearestIndex = Cluster;
+					}
+				}
+			}
+			if (NearestIndex == INDEX_NONE)
+			{
+				Upper[Index] = Unbounded;
+				return INDEX_NONE;
+			}
+
+			double Other = Unbounded;
+			for (int32 Cluster = 0; Cluster < RelativeCenters.Num(); ++Cluster)
+			{
+				if (Cluster != NearestIndex)
+				{
+					Other = FMath::Min(Other, DistSquared(Point, RelativeCenters[Cluster]));
+				}
+			}
+			Upper[Index] = FMath::Sqrt(DistSquared(Point, RelativeCenters[NearestIndex])) + Slack;
+			Lower[Index] = FMath::Sqrt(Other) - Slack;
+			return NearestIndex;
+		}
+
+		/** Move every cluster that gained or lost points to their mean. */
+		void UpdateCenters()
+		{
+			const TArray<FVector> PreviousCenters = RelativeCenters;
+			for (int32 Cluster = 0; Cluster < Centers.Num(); ++Cluster)
+			{
+				if (Touched[Cluster] != 0 && Clusters.Counts[Cluster] > 0)
+				{
+					Centers[Cluster] = Clusters.Sums[Cluster] / FDecimalDivisor(FDecimal(Clusters.Counts[Cluster]));
+				}
+			}
+			FDecimalMath::Batch::ToRelative(Points[0], Centers, RelativeCenters);
+
+			MaxMove = 0.0;
+			SecondMaxMove = 0.0;
+			MaxMoveIndex = INDEX_NONE;
+			for (int32 Cluster = 0; Cluster < Centers.Num(); ++Cluster)
+			{
+				// A cluster nobody joined or left keeps its center bit for bit.
+				Moves[Cluster] = Touched[Cluster] != 0 ? FMath::Sqrt(DistSquared(PreviousCenters[Cluster], RelativeCenters[Cluster])) + Slack : 0.0;
+				Touched[Cluster] = 0;
+				if (Moves[Cluster] > MaxMove)
+				{
+					SecondMaxMove = MaxMove;
+					MaxMove = Moves[Cluster];
+					MaxMoveIndex = Cluster;
+				}
+				else if (Moves[Cluster] > SecondMaxMove)
+				{
+					SecondMaxMove = Moves[Cluster];
+				}
+			}
+			UpdateHalfGaps();
+		}
+
+		void UpdateHalfGaps()
+		{
+			for (int32 Cluster = 0; Cluster < RelativeCenters.Num(); ++Cluster)
+			{
+				double Nearest = Unbounded;
+				for (int32 Other = 0; Other < RelativeCenters.Num(); ++Other)
+				{
+					if (Other != Cluster)
+					{
+						Nearest = FMath::Min(Nearest, DistSquared(RelativeCenters[Cluster], RelativeCenters[Other]));
+					}
+				}
+				HalfGaps[Cluster] = 0.5 * (FMath::Sqrt(Nearest) - Slack);
+			}
+		}
+	};
+}
+
+FDecimalKMeansStats FDecimalKMeans::Run(TArray<FDecimalVector>& Centers, TConstArrayView<FDecimalVector> Points, int32 MaxIterations, TArray<int32>& OutAssignments, TArray<int32>& OutClusterSizes)
+{
+	FDecimalKMeansStats Stats;
+	if (Points.Num() == 0 || Centers.Num() == 0)
+	{
+		OutAssignments.Init(INDEX_NONE, Points.Num());
+		OutClusterSizes.Init(0, Centers.Num());
+		return Stats;
+	}
+
+	DecimalKMeans::FSolver Solver(Centers, Points);
+	for (;;)
+	{
+		const int32 NumChanged = Solver.Assign();
+		if (Stats.NumIterations > 0 && NumChanged == 0)
+		{
+			Stats.bConverged = true;
+			break;
+		}
+		if (Stats.NumIterations >= MaxIterations)
+		{
+			break;
+		}
+		Solver.UpdateCenters();
+		++Stats.NumIterations;
+	}
+
+	Stats.NumBoundHits = Solver.NumBoundHits;
+	Stats.NumFullScans = Solver.NumFullScans;
+	Stats.NumExactTieBreaks = Solver.NumExactTieBreaks;
+	OutAssignments = MoveTemp(Solver.Assignments);
+	OutClusterSizes = MoveTemp(Solver.Clusters.Counts);
+	return Stats;
+}
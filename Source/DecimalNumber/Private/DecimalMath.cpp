@@ -1,87 +1,144 @@
 #include "DecimalMath.h"
+#include "DecimalMathBatch.h"
+#include "DecimalBackend.h"
+#include "DecimalLiteral.h"
+#include "DecimalVectorArray.h"
+#include "DecimalStats.h"
+#include "HAL/IConsoleManager.h"
+
+namespace DecimalMathBatch
+{
+	static TAutoConsoleVariable<int32> CVarGrainSize(
+		TEXT("decimal.Batch.GrainSize"),
+		256,
+		TEXT("Minimum number of elements a FDecimalMath::Batch call hands to a single task. Smaller inputs run on the calling thread."),
+		ECVF_Default);
+
+	/** Partial result of a min or max search: the extreme value and the first index holding it. */
+	struct FExtreme
+	{
+		const FDecimal* Value = nullptr;
+		int32 Index = INDEX_NONE;
+	};
+
+	/** Partial result of a bounds search. */
+	struct FBounds
+	{
+		FDecimalVector Min;
+		FDecimalVector Max;
+	};
+}
 
 FDecimal FDecimalMath::InvSqrt(const FDecimal& InVal)
 {
-	return FDecimal(1) / InVal;
+	return FDecimal(1) / Sqrt(InVal);
 }
 
 FDecimal FDecimalMath::Abs(const FDecimal& InVal)
 {
-	return (InVal < 0) ? -InVal : InVal;
+	return InVal.IsNegative() ? -InVal : InVal;
 }
 
 FDecimal FDecimalMath::Floor(const FDecimal& InVal)
 {
 	FDecimal Result;
-	Result.InternalValue = boost::multiprecision::floor(InVal.InternalValue);
+	Result.GetValue() = DecimalBackend::Floor(InVal.GetValue());
 	return Result;
 }
 
 FDecimal FDecimalMath::Ceil(const FDecimal& InVal)
 {
 	FDecimal Result;
-	Result.InternalValue = boost::multiprecision::ceil(InVal.InternalValue);
+	Result.GetValue() = DecimalBackend::Ceil(InVal.GetValue());
 	return Result;
 }
 
 FDecimal FDecimalMath::Sqrt(const FDecimal& InVal)
 {
+	DECIMAL_SCOPE_COUNTER(Transcendental);
 	FDecimal Result;
-	Result.InternalValue = boost::multiprecision::sqrt(InVal.InternalValue);
+	Result.GetValue() = DecimalBackend::Sqrt(InVal.GetValue());
 	return Result;
 }
 
 FDecimal FDecimalMath::Sin(const FDecimal& InVal)
 {
+	DECIMAL_SCOPE_COUNTER(Transcendental);
 	FDecimal Result;
-	Result.InternalValue = boost::multiprecision::sin(InVal.InternalValue);
+	Result.GetValue() = DecimalBackend::Sin(InVal.GetValue());
 	return Result;
 }
 
 FDecimal FDecimalMath::Cos(const FDecimal& InVal)
 {
+	DECIMAL_SCOPE_COUNTER(Transcendental);
 	FDecimal Result;
-	Result.InternalValue = boost::multiprecision::cos(InVal.InternalValue);
+	Result.GetValue() = DecimalBackend::Cos(InVal.GetValue());
 	return Result;
 }
 
 FDecimal FDecimalMath::Acos(const FDecimal& InVal)
 {
+	DECIMAL_SCOPE_COUNTER(Transcendental);
 	FDecimal Result;
-	Result.InternalValue = boost::multiprecision::asin(InVal.InternalValue);
+	Result.GetValue() = DecimalBackend::Acos(InVal.GetValue());
 	return Result;
 }
 
 FDecimal FDecimalMath::Atan(const FDecimal& InVal)
 {
+	DECIMAL_SCOPE_COUNTER(Transcendental);
 	FDecimal Result;
-	Result.InternalValue = boost::multiprecision::atan(InVal.InternalValue);
+	Result.GetValue() = DecimalBackend::Atan(InVal.GetValue());
 	return Result;
 }
 
 FDecimal FDecimalMath::Atan2(const FDecimal& A, const FDecimal& B)
+{
+	DECIMAL_SCOPE_COUNTER(Transcendental);
+	FDecimal Result;
+	Result.GetValue() = DecimalBackend::Atan2(A.GetValue(), B.GetValue());
+	return Result;
+}
+
+FDecimal FDecimalMath::PowerDecimal(const FDecimal& InVal, const FDecimal& InPow)
 {
 	FDecimal Result;
-	Result.InternalValue = boost::multiprecision::atan2(A.InternalValue, B.InternalValue);
+	Result.GetValue() = DecimalBackend::Pow(InVal.GetValue(), InPow.GetValue());
+	return Result;
+}
+
+FDecimal FDecimalMath::PowerInteger(const FDecimal& InVal, int64 InPow)
+{
+	FDecimal Result;
+	Result.GetValue() = DecimalBackend::Pow(InVal.GetValue(), InPow);
+	return Result;
+}
+
+FDecimal FDecimalMath::PowerFloat(const FDecimal& InVal, double InPow)
+{
+	FDecimal Result;
+	Result.GetValue() = DecimalBackend::Pow(InVal.GetValue(), InPow);
 	return Result;
 }
 
 void FDecimalMath::SindCos(FDecimal& ScalarSin, FDecimal& ScalarCos, const FDecimal& Value)
 {
-	ScalarSin.InternalValue = boost::multiprecision::sin(Value.InternalValue);
-	ScalarCos.InternalValue = boost::multiprecision::cos(Value.InternalValue);
+	DECIMAL_SCOPE_COUNTER(Transcendental);
+	ScalarSin.GetValue() = DecimalBackend::Sin(Value.GetValue());
+	ScalarCos.GetValue() = DecimalBackend::Cos(Value.GetValue());
 }
 
 void FDecimalMath::SindCos(FDecimal& ScalarSin, FDecimal& ScalarCos, float Value)
 {
-	ScalarSin.InternalValue = FMath::Sin(Value);
-	ScalarSin.InternalValue = FMath::Cos(Value);
+	ScalarSin.GetValue() = FMath::Sin(Value);
+	ScalarCos.GetValue() = FMath::Cos(Value);
 }
 
 void FDecimalMath::SindCos(FDecimal& ScalarSin, FDecimal& ScalarCos, double Value)
 {
-	ScalarSin.InternalValue = FMath::Sin(Value);
-	ScalarSin.InternalValue = FMath::Cos(Value);
+	ScalarSin.GetValue() = FMath::Sin(Value);
+	ScalarCos.GetValue() = FMath::Cos(Value);
 }
 
 FDecimal FDecimalMath::UnwindDegrees(FDecimal A)
@@ -98,3 +155,475 @@ FDecimal FDecimalMath::UnwindDegrees(FDecimal A)
 
 	return A;
 }
+
+const FDecimal& FDecimalMath::RadiansPerDegree()
+{
+	static const FDecimal Value = FDecimal::ConstantPI / FDecimal(180);
+	return Value;
+}
+
+const FDecimal& FDecimalMath::DegreesPerRadian()
+{
+	static const FDecimal Value = FDecimal(180) / FDecimal::ConstantPI;
+	return Value;
+}
+
+FDecimal FDecimalMath::GridSnap(const FDecimal& Location, const FDecimalDivisor& Grid)
+{
+	const FDecimal& Size = Grid.GetDivisor();
+	if (Size.IsZero())
+	{
+		return Location;
+	}
+	// Halving is exact on every backend, the same value as Size / 2.
+	return Floor((Location + Size * 0.5_dec) / Grid) * Size;
+}
+
+bool FDecimalMath::IsFinite(const FDecimal& InVal)
+{
+	return DecimalBackend::IsFinite(InVal.GetValue());
+}
+
+void FDecimalMath::Batch::Add(TConstArrayView<FDecimal> A, TConstArrayView<FDecimal> B, TArrayView<FDecimal> Out)
+{
+	check(A.Num() == Out.Num() && B.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [A, B, Out](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Out[Index].GetValue() = A[Index].GetValue() + B[Index].GetValue();
+		}
+	});
+}
+
+void FDecimalMath::Batch::Mul(TConstArrayView<FDecimal> A, TConstArrayView<FDecimal> B, TArrayView<FDecimal> Out)
+{
+	check(A.Num() == Out.Num() && B.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [A, B, Out](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Out[Index].GetValue() = A[Index].GetValue() * B[Index].GetValue();
+		}
+	});
+}
+
+void FDecimalMath::Batch::Div(TConstArrayView<FDecimal> A, TConstArrayView<FDecimal> B, TArrayView<FDecimal> Out)
+{
+	check(A.Num() == Out.Num() && B.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [A, B, Out](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Out[Index].GetValue() = A[Index].GetValue() / B[Index].GetValue();
+		}
+	});
+}
+
+void FDecimalMath::Batch::Div(TConstArrayView<FDecimal> A, const FDecimalDivisor& B, TArrayView<FDecimal> Out)
+{
+	check(A.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [A, &B, Out](int32 Begin, int32 End)
+	{
+		const DecimalBackend::FValue& Divisor = B.Divisor.GetValue();
+		const DecimalBackend::FValue& Reciprocal = B.Reciprocal.GetValue();
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Out[Index].GetValue() = DecimalBackend::DivideBy(A[Index].GetValue(), Divisor, Reciprocal);
+		}
+	});
+}
+
+void FDecimalMath::Batch::Sqrt(TConstArrayView<FDecimal> In, TArrayView<FDecimal> Out)
+{
+	check(In.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [In, Out](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Out[Index].GetValue() = DecimalBackend::Sqrt(In[Index].GetValue());
+		}
+	});
+}
+
+void FDecimalMath::Batch::Sin(TConstArrayView<FDecimal> In, TArrayView<FDecimal> Out)
+{
+	check(In.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [In, Out](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Out[Index].GetValue() = DecimalBackend::Sin(In[Index].GetValue());
+		}
+	});
+}
+
+void FDecimalMath::Batch::Cos(TConstArrayView<FDecimal> In, TArrayView<FDecimal> Out)
+{
+	check(In.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [In, Out](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Out[Index].GetValue() = DecimalBackend::Cos(In[Index].GetValue());
+		}
+	});
+}
+
+void FDecimalMath::Batch::Power(TConstArrayView<FDecimal> In, const FDecimal& Exponent, TArrayView<FDecimal> Out)
+{
+	check(In.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [In, &Exponent, Out](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Out[Index].GetValue() = DecimalBackend::Pow(In[Index].GetValue(), Exponent.GetValue());
+		}
+	});
+}
+
+void FDecimalMath::Batch::Power(TConstArrayView<FDecimal> In, int32 Exponent, TArrayView<FDecimal> Out)
+{
+	check(In.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [In, Exponent, Out](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Out[Index].GetValue() = DecimalBackend::Pow(In[Index].GetValue(), Exponent);
+		}
+	});
+}
+
+void FDecimalMath::Batch::Floor(TConstArrayView<FDecimal> In, TArrayView<FDecimal> Out)
+{
+	check(In.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [In, Out](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			Out[Index].GetValue() = DecimalBackend::Floor(In[Index].GetValue());
+		}
+	});
+}
+
+void FDecimalMath::Batch::Clamp(TConstArrayView<FDecimal> In, const FDecimal& Min, const FDecimal& Max, TArrayView<FDecimal> Out)
+{
+	check(In.Num() == Out.Num());
+	DecimalMathBatch::ForEachChunk(Out.Num(), [In, &Min, &Max, Out](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const FDecimal& Value = In[Index];
+			Out[Index].GetValue() = ((Value.Compare(Min) < 0) ? Min : (Value.Compare(Max) < 0) ? Value : Max).GetValue();
+		}
+	});
+}
+
+int32 FDecimalMath::Batch::GetGrainSize()
+{
+	return FMath::Max(DecimalMathBatch::CVarGrainSize.GetValueOnAnyThread(), 1);
+}
+
+void FDecimalMath::Batch::SetMaxTasks(int32 InMaxTasks)
+{
+	DecimalMathBatch::MaxTasks.store(FMath::Max(InMaxTasks, 0), std::memory_order_relaxed);
+}
+
+FDecimal FDecimalMath::Batch::Sum(TConstArrayView<FDecimal> Values)
+{
+	if (Values.Num() == 0)
+	{
+		return FDecimal(0);
+	}
+
+	return DecimalMathBatch::Reduce<FDecimal>(Values.Num(),
+		[Values](int32 Begin, int32 End)
+		{
+			FDecimal Result(0);
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				Result.GetValue() += Values[Index].GetValue();
+			}
+			return Result;
+		},
+		[](const FDecimal& A, const FDecimal& B)
+		{
+			return FDecimal::FromValue(A.GetValue() + B.GetValue());
+		});
+}
+
+FDecimal FDecimalMath::Batch::Min(TConstArrayView<FDecimal> Values, int32* MinIndex)
+{
+	if (Values.Num() == 0)
+	{
+		if (MinIndex != nullptr)
+		{
+			*MinIndex = INDEX_NONE;
+		}
+		return FDecimal();
+	}
+
+	const DecimalMathBatch::FExtreme Result = DecimalMathBatch::Reduce<DecimalMathBatch::FExtreme>(Values.Num(),
+		[Values](int32 Begin, int32 End)
+		{
+			DecimalMathBatch::FExtreme Extreme{ &Values[Begin], Begin };
+			for (int32 Index = Begin + 1; Index < End; ++Index)
+			{
+				if (Values[Index].Compare(*Extreme.Value) < 0)
+				{
+					Extreme = { &Values[Index], Index };
+				}
+			}
+			return Extreme;
+		},
+		[](const DecimalMathBatch::FExtreme& A, const DecimalMathBatch::FExtreme& B)
+		{
+			return (B.Value->Compare(*A.Value) < 0) ? B : A;
+		});
+
+	if (MinIndex != nullptr)
+	{
+		*MinIndex = Result.Index;
+	}
+	return *Result.Value;
+}
+
+FDecimal FDecimalMath::Batch::Max(TConstArrayView<FDecimal> Values, int32* MaxIndex)
+{
+	if (Values.Num() == 0)
+	{
+		if (MaxIndex != nullptr)
+		{
+			*MaxIndex = INDEX_NONE;
+		}
+		return FDecimal();
+	}
+
+	const DecimalMathBatch::FExtreme Result = DecimalMathBatch::Reduce<DecimalMathBatch::FExtreme>(Values.Num(),
+		[Values](int32 Begin, int32 End)
+		{
+			DecimalMathBatch::FExtreme Extreme{ &Values[Begin], Begin };
+			for (int32 Index = Begin + 1; Index < End; ++Index)
+			{
+				if (Values[Index].Compare(*Extreme.Value) > 0)
+				{
+					Extreme = { &Values[Index], Index };
+				}
+			}
+			return Extreme;
+		},
+		[](const DecimalMathBatch::FExtreme& A, const DecimalMathBatch::FExtreme& B)
+		{
+			return (B.Value->Compare(*A.Value) > 0) ? B : A;
+		});
+
+	if (MaxIndex != nullptr)
+	{
+		*MaxIndex = Result.Index;
+	}
+	return *Result.Value;
+}
+
+FDecimal FDecimalMath::Batch::Mean(TConstArrayView<FDecimal> Values)
+{
+	if (Values.Num() == 0)
+	{
+		return FDecimal(0);
+	}
+
+	FDecimal Result = Sum(Values);
+	Result.GetValue() /= Values.Num();
+	return Result;
+}
+
+FDecimal FDecimalMath::Batch::Variance(TConstArrayView<FDecimal> Values)
+{
+	if (Values.Num() == 0)
+	{
+		return FDecimal(0);
+	}
+
+	const FDecimal Average = Mean(Values);
+	FDecimal Result = DecimalMathBatch::Reduce<FDecimal>(Values.Num(),
+		[Values, &Average](int32 Begin, int32 End)
+		{
+			FDecimal Partial(0);
+			DecimalBackend::FValue Delta;
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				Delta = Values[Index].GetValue() - Average.GetValue();
+				Partial.GetValue() += Delta * Delta;
+			}
+			return Partial;
+		},
+		[](const FDecimal& A, const FDecimal& B)
+		{
+			return FDecimal::FromValue(A.GetValue() + B.GetValue());
+		});
+
+	Result.GetValue() /= Values.Num();
+	return Result;
+}
+
+FDecimalVector FDecimalMath::Batch::Centroid(TConstArrayView<FDecimalVector> Points)
+{
+	if (Points.Num() == 0)
+	{
+		return FDecimalVector::ZeroVector;
+	}
+
+	FDecimalVector Result = DecimalMathBatch::Reduce<FDecimalVector>(Points.Num(),
+		[Points](int32 Begin, int32 End)
+		{
+			FDecimalVector Partial(ForceInit);
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				Partial.X.GetValue() += Points[Index].X.GetValue();
+				Partial.Y.GetValue() += Points[Index].Y.GetValue();
+				Partial.Z.GetValue() += Points[Index].Z.GetValue();
+			}
+			return Partial;
+		},
+		[](const FDecimalVector& A, const FDecimalVector& B)
+		{
+			return A + B;
+		});
+
+	Result.X.GetValue() /= Points.Num();
+	Result.Y.GetValue() /= Points.Num();
+	Result.Z.GetValue() /= Points.Num();
+	return Result;
+}
+
+FDecimalVector FDecimalMath::Batch::Centroid(const FDecimalVectorArray& Points)
+{
+	if (Points.IsEmpty())
+	{
+		return FDecimalVector::ZeroVector;
+	}
+
+	FDecimalVector Result(Sum(Points.X), Sum(Points.Y), Sum(Points.Z));
+	Result.X.GetValue() /= Points.Num();
+	Result.Y.GetValue() /= Points.Num();
+	Result.Z.GetValue() /= Points.Num();
+	return Result;
+}
+
+bool FDecimalMath::Batch::Bounds(TConstArrayView<FDecimalVector> Points, FDecimalVector& OutMin, FDecimalVector& OutMax)
+{
+	if (Points.Num() == 0)
+	{
+		return false;
+	}
+
+	const DecimalMathBatch::FBounds Result = DecimalMathBatch::Reduce<DecimalMathBatch::FBounds>(Points.Num(),
+		[Points](int32 Begin, int32 End)
+		{
+			DecimalMathBatch::FBounds Partial{ Points[Begin], Points[Begin] };
+			for (int32 Index = Begin + 1; Index < End; ++Index)
+			{
+				Partial.Min = FDecimalVector::Min(Partial.Min, Points[Index]);
+				Partial.Max = FDecimalVector::Max(Partial.Max, Points[Index]);
+			}
+			return Partial;
+		},
+		[](const DecimalMathBatch::FBounds& A, const DecimalMathBatch::FBounds& B)
+		{
+			return DecimalMathBatch::FBounds{ FDecimalVector::Min(A.Min, B.Min), FDecimalVector::Max(A.Max, B.Max) };
+		});
+
+	OutMin = Result.Min;
+	OutMax = Result.Max;
+	return true;
+}
+
+bool FDecimalMath::Batch::Bounds(const FDecimalVectorArray& Points, FDecimalVector& OutMin, FDecimalVector& OutMax)
+{
+	if (Points.IsEmpty())
+	{
+		return false;
+	}
+
+	OutMin.Set(Min(Points.X), Min(Points.Y), Min(Points.Z));
+	OutMax.Set(Max(Points.X), Max(Points.Y), Max(Points.Z));
+	return true;
+}
+
+void FDecimalMath::Batch::ToRelative(const FDecimalVector& Origin, TConstArrayView<FDecimalVector> Points, TArrayView<FVector> Out)
+{
+	check(Points.Num() == Out.Num());
+	DecimalMathBatch::WriteVectors(Out, [&Origin, Points](int32 Index)
+	{
+		return FVector(
+			DecimalMathBatch::RelativeToDouble(Points[Index].X.GetValue(), Origin.X.GetValue()),
+			DecimalMathBatch::RelativeToDouble(Points[Index].Y.GetValue(), Origin.Y.GetValue()),
+			DecimalMathBatch::RelativeToDouble(Points[Index].Z.GetValue(), Origin.Z.GetValue()));
+	});
+}
+
+void FDecimalMath::Batch::ToRelative(const FDecimalVector& Origin, TConstArrayView<FDecimalVector> Points, TArrayView<FVector3f> Out)
+{
+	check(Points.Num() == Out.Num());
+	DecimalMathBatch::WriteVectors(Out, [&Origin, Points](int32 Index)
+	{
+		return FVector(
+			DecimalMathBatch::RelativeToDouble(Points[Index].X.GetValue(), Origin.X.GetValue()),
+			DecimalMathBatch::RelativeToDouble(Points[Index].Y.GetValue(), Origin.Y.GetValue()),
+			DecimalMathBatch::RelativeToDouble(Points[Index].Z.GetValue(), Origin.Z.GetValue()));
+	});
+}
+
+void FDecimalMath::Batch::ToRelative(const FDecimalVector& Origin, const FDecimalVectorArray& Points, TArrayView<FVector> Out)
+{
+	check(Points.Num() == Out.Num());
+	DecimalMathBatch::WriteVectors(Out, [&Origin, &Points](int32 Index)
+	{
+		return FVector(
+			DecimalMathBatch::RelativeToDouble(Points.X[Index].GetValue(), Origin.X.GetValue()),
+			DecimalMathBatch::RelativeToDouble(Points.Y[Index].GetValue(), Origin.Y.GetValue()),
+			DecimalMathBatch::RelativeToDouble(Points.Z[Index].GetValue(), Origin.Z.GetValue()));
+	});
+}
+
+void FDecimalMath::Batch::ToRelative(const FDecimalVector& Origin, const FDecimalVectorArray& Points, TArrayView<FVector3f> Out)
+{
+	check(Points.Num() == Out.Num());
+	DecimalMathBatch::WriteVectors(Out, [&Origin, &Points](int32 Index)
+	{
+		return FVector(
+			DecimalMathBatch::RelativeToDouble(Points.X[Index].GetValue(), Origin.X.GetValue()),
+			DecimalMathBatch::RelativeToDouble(Points.Y[Index].GetValue(), Origin.Y.GetValue()),
+			DecimalMathBatch::RelativeToDouble(Points.Z[Index].GetValue(), Origin.Z.GetValue()));
+	});
+}
+
+void FDecimalMath::Batch::ToRelative(const FDecimalVector& Origin, TConstArrayView<FDecimalVector> Points, TConstArrayView<int32> Indices, TArrayView<FVector> Out)
+{
+	check(Points.Num() == Out.Num());
+	DecimalMathBatch::ForEachRange(Indices.Num(), GetGrainSize(), 1, [&Origin, Points, Indices, Out](int32 Begin, int32 End)
+	{
+		for (int32 Slot = Begin; Slot < End; ++Slot)
+		{
+			const int32 Index = Indices[Slot];
+			Out[Index] = FVector(
+				DecimalMathBatch::RelativeToDouble(Points[Index].X.GetValue(), Origin.X.GetValue()),
+				DecimalMathBatch::RelativeToDouble(Points[Index].Y.GetValue(), Origin.Y.GetValue()),
+				DecimalMathBatch::RelativeToDouble(Points[Index].Z.GetValue(), Origin.Z.GetValue()));
+		}
+	});
+}
+
+void FDecimalMath::Batch::AddRelative(TConstArrayView<FVector> Offsets, double Scale, FDecimalVectorArray& Points)
+{
+	check(Points.Num() == Offsets.Num());
+	DecimalMathBatch::ForEachChunk(Offsets.Num(), [Offsets, Scale, &Points](int32 Begin, int32 End)
+	{
+		for (int32 Index = Begin; Index < End; ++Index)
+		{
+			const FVector Offset = Offsets[Index] * Scale;
+			Points.X[Index].GetValue() += DecimalBackend::FValue(Offset.X);
+			Points.Y[Index].GetValue() += DecimalBackend::FValue(Offset.Y);
+			Points.Z[Index].GetValue() += DecimalBackend::FValue(Offset.Z);
+		}
+	});
+}
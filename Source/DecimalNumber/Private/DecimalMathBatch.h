@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalMath.h"
+#include "DecimalBackend.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
+#include <numeric>
+
+/**
+ * Chunking and deterministic reduction shared by FDecimalMath::Batch and the other parallel algorithms of the module.
+ * Chunks are sized from decimal.Batch.GrainSize and limited by FDecimalMath::Batch::SetMaxTasks.
+ */
+namespace DecimalMathBatch
+{
+	/** Upper bound on the tasks a batch call splits into, 0 for no limit, see FDecimalMath::Batch::SetMaxTasks. */
+	inline std::atomic<int32> MaxTasks(0);
+
+	/** Smallest element count whose size is a whole number of cache lines. Says nothing about where an array starts. */
+	inline constexpr int32 CacheLineElements = PLATFORM_CACHE_LINE_SIZE / std::gcd<int32, int32>(sizeof(FDecimal), PLATFORM_CACHE_LINE_SIZE);
+
+	/** Elements per reduction block. Fixed so the reduction tree only depends on the input size, never on the thread count. */
+	inline constexpr int32 ReductionBlockSize = 1024;
+
+	/** Run Kernel(Begin, End) over [0, Num), in parallel chunks of at least GrainSize once Num exceeds it. Chunk sizes are multiples of Alignment. */
+	template <typename KernelType>
+	void ForEachRange(int32 Num, int32 GrainSize, int32 Alignment, const KernelType& Kernel)
+	{
+		const int32 TaskLimit = MaxTasks.load(std::memory_order_relaxed);
+		if (Num <= GrainSize || TaskLimit == 1)
+		{
+			Kernel(0, Num);
+			return;
+		}
+
+		int32 ChunkSize = GrainSize;
+		if (TaskLimit > 0)
+		{
+			ChunkSize = FMath::Max(ChunkSize, FMath::DivideAndRoundUp(Num, TaskLimit));
+		}
+		ChunkSize = Align(ChunkSize, Alignment);
+
+		const int32 NumChunks = FMath::DivideAndRoundUp(Num, ChunkSize);
+		ParallelFor(NumChunks, [&Kernel, ChunkSize, Num](int32 ChunkIndex)
+		{
+			const int32 Begin = ChunkIndex * ChunkSize;
+			Kernel(Begin, FMath::Min(Begin + ChunkSize, Num));
+		});
+	}
+
+	/** Run Kernel(Begin, End) over [0, Num) of an element-wise operation. */
+	template <typename KernelType>
+	void ForEachChunk(int32 Num, const KernelType& Kernel)
+	{
+		ForEachRange(Num, FDecimalMath::Batch::GetGrainSize(), CacheLineElements, Kernel);
+	}
+
+	/** Out[i] = VectorType(Offset(i)), in chunks of whole cache lines of Out. */
+	template <typename VectorType, typename OffsetFuncType>
+	void WriteVectors(TArrayView<VectorType> Out, const OffsetFuncType& Offset)
+	{
+		typedef decltype(VectorType::X) RealType;
+		constexpr int32 Alignment = PLATFORM_CACHE_LINE_SIZE / std::gcd<int32, int32>(sizeof(VectorType), PLATFORM_CACHE_LINE_SIZE);
+		ForEachRange(Out.Num(), FDecimalMath::Batch::GetGrainSize(), Alignment, [Out, &Offset](int32 Begin, int32 End)
+		{
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				const FVector Value = Offset(Index);
+				Out[Index] = VectorType(static_cast<RealType>(Value.X), static_cast<RealType>(Value.Y), static_cast<RealType>(Value.Z));
+			}
+		});
+	}
+
+	/** @return Position - Origin, subtracted at full precision and rounded once to double. */
+	FORCEINLINE double RelativeToDouble(const DecimalBackend::FValue& Position, const DecimalBackend::FValue& Origin)
+	{
+		return DecimalBackend::ToDoubleDirect(DecimalBackend::FValue(Position - Origin));
+	}
+
+	/**
+	 * Reduce [0, Num) deterministically: each fixed-size block is reduced left to right with BlockFunc(Begin, End),
+	 * blocks may run on any thread, then block results are merged with a fixed pairwise tree using Combine(A, B).
+	 * The result is bit-identical for any number of worker threads. Num must be greater than zero.
+	 */
+	template <typename PartialType, typename BlockFuncType, typename CombineFuncType>
+	PartialType Reduce(int32 Num, const BlockFuncType& BlockFunc, const CombineFuncType& Combine)
+	{
+		check(Num > 0);
+
+		const int32 NumBlocks = FMath::DivideAndRoundUp(Num, ReductionBlockSize);
+		TArray<PartialType> Partials;
+		Partials.SetNum(NumBlocks);
+
+		const int32 BlockGrainSize = FMath::Max(FDecimalMath::Batch::GetGrainSize() / ReductionBlockSize, 1);
+		ForEachRange(NumBlocks, BlockGrainSize, 1, [&Partials, &BlockFunc, Num](int32 BeginBlock, int32 EndBlock)
+		{
+			for (int32 BlockIndex = BeginBlock; BlockIndex < EndBlock; ++BlockIndex)
+			{
+				const int32 Begin = BlockIndex * ReductionBlockSize;
+				Partials[BlockIndex] = BlockFunc(Begin, FMath::Min(Begin + ReductionBlockSize, Num));
+			}
+		});
+
+		for (int32 Count = NumBlocks; Count > 1; Count = (Count + 1) / 2)
+		{
+			for (int32 Index = 0; Index < Count / 2; ++Index)
+			{
+				Partials[Index] = Combine(Partials[2 * Index], Partials[2 * Index + 1]);
+			}
+			if (Count % 2 != 0)
+			{
+				Partials[Count / 2] = Partials[Count - 1];
+			}
+		}
+
+		return Partials[0];
+	}
+}
@@ -1,7 +1,8 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "DecimalNumber.h"
-#include "IPluginManager.h"
+#include "DecimalStats.h"
+#include "Misc/CoreDelegates.h"
 
 THIRD_PARTY_INCLUDES_START
 #include <boost/assert/source_location.hpp>
@@ -27,37 +28,15 @@ namespace boost
 
 void FDecimalNumberModule::StartupModule()
 {
-	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
-	TArray<FString> DllNames =
-		{
-			TEXT("boost_container-vc144-mt-x64-1_85.dll"),
-			TEXT("boost_random-vc144-mt-x64-1_85.dll"),
-			TEXT("boost_regex-vc144-mt-x64-1_85.dll"),
-			TEXT("boost_system-vc144-mt-x64-1_85.dll")
-		};
-
-	const FString PluginDir = IPluginManager::Get().FindPlugin("DecimalNumber")->GetBaseDir();
-	for (const FString& DllName : DllNames)
-	{
-		void* NewHandle = FPlatformProcess::GetDllHandle(*FPaths::Combine(PluginDir, "ThirdParty/boost_multiprecision_1.8.5/bin", DllName));
-		if (NewHandle == nullptr)
-		{
-			UE_LOG(LogTemp, Error, TEXT("%s - Failed to load dependency dll '%s'"), __FUNCTIONW__, *DllName);
-			continue;
-		}
-
-		Handles.Add(NewHandle);
-	}
+	// FDecimal only needs boost headers, there is nothing to load here.
+#if DECIMALNUMBER_CONVERSION_STATS
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FDecimalConversionStats::EndFrame);
+#endif
 }
 
 void FDecimalNumberModule::ShutdownModule()
 {
-	for (void* Handle : Handles)
-	{
-		FPlatformProcess::FreeDllHandle(Handle);
-	}
-
-	Handles.Empty();
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -2,7 +2,9 @@
 
 
 #include "DecimalNumberFunctionLibrary.h"
+#include "DecimalLiteral.h"
 #include "DecimalMath.h"
+#include "DecimalSort.h"
 #include "DecimalVector.h"
 
 void UDecimalNumberFunctionLibrary::TestDecimal()
@@ -41,6 +43,7 @@ void UDecimalNumberFunctionLibrary::TestDecimal()
 	UE_LOG(LogTemp, Warning, TEXT("TestDecimal step 4 - %s"), *(FDecimal(0.0001) * FDecimal(10000.0f)).ToString());
 	UE_LOG(LogTemp, Warning, TEXT("TestDecimal step 4 - %s"), *(FDecimal(0.33) / FDecimal(10.0f)).ToString());
 	UE_LOG(LogTemp, Warning, TEXT("TestDecimal step 4 - %s"), *(FDecimal("0.33") / FDecimal(10.0f)).ToString());
+	UE_LOG(LogTemp, Warning, TEXT("TestDecimal step 4 - %s"), *(0.33_dec / FDecimal(10.0f)).ToString());
 
 	UE_LOG(LogTemp, Warning, TEXT("TestDecimal step ceil 1/3	- %s"), *FDecimalMath::Ceil(FDecimal(1) / FDecimal(3)).ToString());
 	UE_LOG(LogTemp, Warning, TEXT("TestDecimal step ceil 0		- %s"), *FDecimalMath::Ceil(FDecimal(0)).ToString());
@@ -90,3 +93,97 @@ void UDecimalNumberFunctionLibrary::TestDecimal()
 	}
 
 }
+
+void UDecimalNumberFunctionLibrary::BenchmarkBatchScaling(int32 NumElements)
+{
+	NumElements = FMath::Max(NumElements, 1);
+
+	TArray<FDecimal> InputA, InputB, Output;
+	InputA.Reserve(NumElements);
+	InputB.Reserve(NumElements);
+	for (int32 Index = 0; Index < NumElements; ++Index)
+	{
+		InputA.Add(FDecimal(Index % 1000 + 1) / FDecimal(7));
+		InputB.Add(FDecimal(Index % 97 + 1) / FDecimal(3));
+	}
+	Output.SetNum(NumElements);
+
+	struct FBatchCase
+	{
+		const TCHAR* Name;
+		TFunction<void()> Run;
+	};
+
+	const TArray<FBatchCase> Cases =
+	{
+		{ TEXT("Add"),		[&]() { FDecimalMath::Batch::Add(InputA, InputB, Output); } },
+		{ TEXT("Mul"),		[&]() { FDecimalMath::Batch::Mul(InputA, InputB, Output); } },
+		{ TEXT("Div"),		[&]() { FDecimalMath::Batch::Div(InputA, InputB, Output); } },
+		{ TEXT("Sqrt"),		[&]() { FDecimalMath::Batch::Sqrt(InputA, Output); } },
+		{ TEXT("Sin"),		[&]() { FDecimalMath::Batch::Sin(InputA, Output); } },
+		{ TEXT("Cos"),		[&]() { FDecimalMath::Batch::Cos(InputA, Output); } },
+		{ TEXT("Power"),	[&]() { FDecimalMath::Batch::Power(InputA, 3, Output); } },
+		{ TEXT("Floor"),	[&]() { FDecimalMath::Batch::Floor(InputA, Output); } },
+		{ TEXT("Clamp"),	[&]() { FDecimalMath::Batch::Clamp(InputA, FDecimal(10), FDecimal(100), Output); } },
+	};
+
+	const int32 MaxTasks = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	UE_LOG(LogTemp, Display, TEXT("BenchmarkBatchScaling - %d elements, grain size %d, 1 to %d tasks"), NumElements, FDecimalMath::Batch::GetGrainSize(), MaxTasks);
+
+	for (const FBatchCase& Case : Cases)
+	{
+		double SingleTaskSeconds = 0.0;
+		for (int32 NumTasks = 1; NumTasks <= MaxTasks; ++NumTasks)
+		{
+			FDecimalMath::Batch::SetMaxTasks(NumTasks);
+
+			// Warm up once, then keep the best of three runs.
+			Case.Run();
+			double BestSeconds = DBL_MAX;
+			for (int32 Run = 0; Run < 3; ++Run)
+			{
+				const double StartTime = FPlatformTime::Seconds();
+				Case.Run();
+				BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartTime);
+			}
+
+			if (NumTasks == 1)
+			{
+				SingleTaskSeconds = BestSeconds;
+			}
+
+			UE_LOG(LogTemp, Display, TEXT("BenchmarkBatchScaling - %-6s tasks=%-3d %10.1f ns/element speedup=%.2fx"),
+				Case.Name, NumTasks, BestSeconds * 1.e9 / NumElements, SingleTaskSeconds / BestSeconds);
+		}
+	}
+
+	FDecimalMath::Batch::SetMaxTasks(0);
+}
+
+void UDecimalNumberFunctionLibrary::BenchmarkSort(int32 NumElements)
+{
+	NumElements = FMath::Max(NumElements, 1);
+
+	// Mix integers, short fractions and full precision quotients of both signs.
+	FRandomStream Random(NumElements);
+	TArray<FDecimal> Input;
+	Input.Reserve(NumElements);
+	for (int32 Index = 0; Index < NumElements; ++Index)
+	{
+		Input.Add(FDecimal(Random.RandRange(-1000000, 1000000)) / FDecimal(Random.RandRange(1, 1000)));
+	}
+
+	TArray<FDecimal> Sorted = Input;
+	double StartTime = FPlatformTime::Seconds();
+	Algo::Sort(Sorted);
+	const double ComparisonSeconds = FPlatformTime::Seconds() - StartTime;
+
+	TArray<FDecimal> RadixSorted = Input;
+	StartTime = FPlatformTime::Seconds();
+	FDecimalSort::Sort(RadixSorted);
+	const double RadixSeconds = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogTemp, Display, TEXT("BenchmarkSort - %d elements, Algo::Sort %.1f ms, FDecimalSort %.1f ms, speedup=%.2fx, results %s"),
+		NumElements, ComparisonSeconds * 1000.0, RadixSeconds * 1000.0, ComparisonSeconds / RadixSeconds,
+		Sorted == RadixSorted ? TEXT("match") : TEXT("DIFFER"));
+}
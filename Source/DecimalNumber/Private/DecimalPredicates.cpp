@@ -0,0 +1,185 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalPredicates.h"
+
+namespace DecimalPredicates
+{
+	/** Rounding of one double operation, relative to its result. */
+	static constexpr double HalfEpsilon = 0.5 * DBL_EPSILON;
+
+	/**
+	 * A double together with a bound on its distance from the exact value it stands for. Every operation adds the error
+	 * its operands carry into the result and the rounding of the operation itself.
+	 */
+	struct FBounded
+	{
+		double Value;
+		double Error;
+
+		FORCEINLINE FBounded operator+(const FBounded& Other) const
+		{
+			const double Result = Value + Other.Value;
+			return { Result, Error + Other.Error + HalfEpsilon * FMath::Abs(Result) };
+		}
+
+		FORCEINLINE FBounded operator-(const FBounded& Other) const
+		{
+			const double Result = Value - Other.Value;
+			return { Result, Error + Other.Error + HalfEpsilon * FMath::Abs(Result) };
+		}
+
+		FORCEINLINE FBounded operator*(const FBounded& Other) const
+		{
+			const double Result = Value * Other.Value;
+			return { Result, FMath::Abs(Value) * Other.Error + FMath::Abs(Other.Value) * Error + Error * Other.Error + HalfEpsilon * FMath::Abs(Result) };
+		}
+	};
+
+	struct FBoundedVector
+	{
+		FBounded X;
+		FBounded Y;
+		FBounded Z;
+
+		explicit FORCEINLINE FBoundedVector(const FVector& Shadow)
+			: X{ Shadow.X, FDecimalShadowed::GetShadowError(Shadow.X) }
+			, Y{ Shadow.Y, FDecimalShadowed::GetShadowError(Shadow.Y) }
+			, Z{ Shadow.Z, FDecimalShadowed::GetShadowError(Shadow.Z) }
+		{
+		}
+
+		explicit FORCEINLINE FBoundedVector(const FDecimalVector& V)
+			: FBoundedVector(FVector(FDecimalShadowed::MakeShadow(V.X), FDecimalShadowed::MakeShadow(V.Y), FDecimalShadowed::MakeShadow(V.Z)))
+		{
+		}
+	};
+
+	/**
+	 * @return The sign of Result if its bound proves it, 0 otherwise: a proven sign is never 0.
+	 * The errors are themselves computed in doubles, a relative margin covers their rounding and an absolute one the
+	 * underflow of products far below any coordinate.
+	 */
+	static FORCEINLINE int32 GetCertainSign(const FBounded& Result)
+	{
+		if (FMath::Abs(Result.Value) > Result.Error * (1.0 + 1e-12) + 1e-300)
+		{
+			DECIMAL_COUNT_SHADOW(Filtered);
+			return Result.Value < 0.0 ? -1 : 1;
+		}
+		return 0;
+	}
+
+	static FORCEINLINE int32 GetSign(const FDecimal& Result)
+	{
+		DECIMAL_COUNT_SHADOW(Exact);
+		return Result.Sign();
+	}
+
+	// Each predicate is written once, for FBounded on the filtered path and FDecimal on the exact one.
+
+	template <typename PointType>
+	static FORCEINLINE auto Orient2D(const PointType& A, const PointType& B, const PointType& C)
+	{
+		return (A.X - C.X) * (B.Y - C.Y) - (A.Y - C.Y) * (B.X - C.X);
+	}
+
+	template <typename PointType>
+	static FORCEINLINE auto Orient3D(const PointType& A, const PointType& B, const PointType& C, const PointType& D)
+	{
+		const auto ADX = A.X - D.X, ADY = A.Y - D.Y, ADZ = A.Z - D.Z;
+		const auto BDX = B.X - D.X, BDY = B.Y - D.Y, BDZ = B.Z - D.Z;
+		const auto CDX = C.X - D.X, CDY = C.Y - D.Y, CDZ = C.Z - D.Z;
+		return ADX * (BDY * CDZ - BDZ * CDY) + BDX * (CDY * ADZ - CDZ * ADY) + CDX * (ADY * BDZ - ADZ * BDY);
+	}
+
+	template <typename PointType>
+	static FORCEINLINE auto InSphere(const PointType& A, const PointType& B, const PointType& C, const PointType& D, const PointType& E)
+	{
+		const auto AEX = A.X - E.X, AEY = A.Y - E.Y, AEZ = A.Z - E.Z;
+		const auto BEX = B.X - E.X, BEY = B.Y - E.Y, BEZ = B.Z - E.Z;
+		const auto CEX = C.X - E.X, CEY = C.Y - E.Y, CEZ = C.Z - E.Z;
+		const auto DEX = D.X - E.X, DEY = D.Y - E.Y, DEZ = D.Z - E.Z;
+
+		const auto AB = AEX * BEY - BEX * AEY;
+		const auto BC = BEX * CEY - CEX * BEY;
+		const auto CD = CEX * DEY - DEX * CEY;
+		const auto DA = DEX * AEY - AEX * DEY;
+		const auto AC = AEX * CEY - CEX * AEY;
+		const auto BD = BEX * DEY - DEX * BEY;
+
+		const auto ABC = AEZ * BC - BEZ * AC + CEZ * AB;
+		const auto BCD = BEZ * CD - CEZ * BD + DEZ * BC;
+		const auto CDA = CEZ * DA + DEZ * AC + AEZ * CD;
+		const auto DAB = DEZ * AB + AEZ * BD + BEZ * DA;
+
+		const auto ALift = AEX * AEX + AEY * AEY + AEZ * AEZ;
+		const auto BLift = BEX * BEX + BEY * BEY + BEZ * BEZ;
+		const auto CLift = CEX * CEX + CEY * CEY + CEZ * CEZ;
+		const auto DLift = DEX * DEX + DEY * DEY + DEZ * DEZ;
+
+		return (DLift * ABC - CLift * DAB) + (BLift * CDA - ALift * BCD);
+	}
+
+	template <typename PointType>
+	static FORCEINLINE auto PlaneSide(const PointType& Point, const PointType& PlaneBase, const PointType& PlaneNormal)
+	{
+		return (Point.X - PlaneBase.X) * PlaneNormal.X + (Point.Y - PlaneBase.Y) * PlaneNormal.Y + (Point.Z - PlaneBase.Z) * PlaneNormal.Z;
+	}
+}
+
+int32 FDecimalPredicates::Orient2D(const FDecimalVector& A, const FDecimalVector& B, const FDecimalVector& C)
+{
+	using namespace DecimalPredicates;
+	const int32 Sign = GetCertainSign(DecimalPredicates::Orient2D(FBoundedVector(A), FBoundedVector(B), FBoundedVector(C)));
+	return Sign != 0 ? Sign : GetSign(DecimalPredicates::Orient2D(A, B, C));
+}
+
+int32 FDecimalPredicates::Orient2D(const FDecimalShadowedVector& A, const FDecimalShadowedVector& B, const FDecimalShadowedVector& C)
+{
+	using namespace DecimalPredicates;
+	const int32 Sign = GetCertainSign(DecimalPredicates::Orient2D(FBoundedVector(A.GetShadow()), FBoundedVector(B.GetShadow()), FBoundedVector(C.GetShadow())));
+	return Sign != 0 ? Sign : GetSign(DecimalPredicates::Orient2D(A.GetValue(), B.GetValue(), C.GetValue()));
+}
+
+int32 FDecimalPredicates::Orient3D(const FDecimalVector& A, const FDecimalVector& B, const FDecimalVector& C, const FDecimalVector& D)
+{
+	using namespace DecimalPredicates;
+	const int32 Sign = GetCertainSign(DecimalPredicates::Orient3D(FBoundedVector(A), FBoundedVector(B), FBoundedVector(C), FBoundedVector(D)));
+	return Sign != 0 ? Sign : GetSign(DecimalPredicates::Orient3D(A, B, C, D));
+}
+
+int32 FDecimalPredicates::Orient3D(const FDecimalShadowedVector& A, const FDecimalShadowedVector& B, const FDecimalShadowedVector& C, const FDecimalShadowedVector& D)
+{
+	using namespace DecimalPredicates;
+	const int32 Sign = GetCertainSign(DecimalPredicates::Orient3D(FBoundedVector(A.GetShadow()), FBoundedVector(B.GetShadow()), FBoundedVector(C.GetShadow()), FBoundedVector(D.GetShadow())));
+	return Sign != 0 ? Sign : GetSign(DecimalPredicates::Orient3D(A.GetValue(), B.GetValue(), C.GetValue(), D.GetValue()));
+}
+
+int32 FDecimalPredicates::InSphere(const FDecimalVector& A, const FDecimalVector& B, const FDecimalVector& C, const FDecimalVector& D, const FDecimalVector& E)
+{
+	using namespace DecimalPredicates;
+	const int32 Sign = GetCertainSign(DecimalPredicates::InSphere(FBoundedVector(A), FBoundedVector(B), FBoundedVector(C), FBoundedVector(D), FBoundedVector(E)));
+	return Sign != 0 ? Sign : GetSign(DecimalPredicates::InSphere(A, B, C, D, E));
+}
+
+int32 FDecimalPredicates::InSphere(const FDecimalShadowedVector& A, const FDecimalShadowedVector& B, const FDecimalShadowedVector& C, const FDecimalShadowedVector& D, const FDecimalShadowedVector& E)
+{
+	using namespace DecimalPredicates;
+	const int32 Sign = GetCertainSign(DecimalPredicates::InSphere(FBoundedVector(A.GetShadow()), FBoundedVector(B.GetShadow()), FBoundedVector(C.GetShadow()), FBoundedVector(D.GetShadow()), FBoundedVector(E.GetShadow())));
+	return Sign != 0 ? Sign : GetSign(DecimalPredicates::InSphere(A.GetValue(), B.GetValue(), C.GetValue(), D.GetValue(), E.GetValue()));
+}
+
+int32 FDecimalPredicates::PlaneSide(const FDecimalVector& Point, const FDecimalVector& PlaneBase, const FDecimalVector& PlaneNormal)
+{
+	using namespace DecimalPredicates;
+	const int32 Sign = GetCertainSign(DecimalPredicates::PlaneSide(FBoundedVector(Point), FBoundedVector(PlaneBase), FBoundedVector(PlaneNormal)));
+	return Sign != 0 ? Sign : GetSign(DecimalPredicates::PlaneSide(Point, PlaneBase, PlaneNormal));
+}
+
+int32 FDecimalPredicates::PlaneSide(const FDecimalShadowedVector& Point, const FDecimalShadowedVector& PlaneBase, const FDecimalShadowedVector& PlaneNormal)
+{
+	using namespace DecimalPredicates;
+	const int32 Sign = GetCertainSign(DecimalPredicates::PlaneSide(FBoundedVector(Point.GetShadow()), FBoundedVector(PlaneBase.GetShadow()), FBoundedVector(PlaneNormal.GetShadow())));
+	return Sign != 0 ? Sign : GetSign(DecimalPredicates::PlaneSide(Point.GetValue(), PlaneBase.GetValue(), PlaneNormal.GetValue()));
+}
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalRebase.h"
+#include "DecimalLiteral.h"
+#include "DecimalMath.h"
+#include "Misc/EngineVersionComparison.h"
+
+FDecimalRebaseSet::FDecimalRebaseSet()
+	: NumRegistered(0)
+	, bHasRenderOrigin(false)
+{
+	SetRebaseThreshold(100'000_dec);
+}
+
+int32 FDecimalRebaseSet::Add(const FDecimalVector& Position)
+{
+	int32 Id;
+	if (FreeIds.Num() > 0)
+	{
+#if UE_VERSION_OLDER_THAN(5, 4, 0)
+		Id = FreeIds.Pop(false);
+#else
+		Id = FreeIds.Pop(EAllowShrinking::No);
+#endif
+		Positions[Id] = Position;
+
+		// A removed id can still be queued in DirtyIds, keep its dirty bit so MarkDirty does not queue it twice.
+		Flags[Id] = (Flags[Id] & Flag_Dirty) | Flag_Registered;
+	}
+	else
+	{
+		Id = Positions.Add(Position);
+		RenderPositions.Add(FVector::ZeroVector);
+		Flags.Add(Flag_Registered);
+	}
+
+	++NumRegistered;
+	MarkDirty(Id);
+	return Id;
+}
+
+void FDecimalRebaseSet::Remove(int32 Id)
+{
+	check(IsValid(Id));
+
+	// A queued conversion of the id stays in DirtyIds, converting an unregistered slot is harmless.
+	Flags[Id] &= ~Flag_Registered;
+	FreeIds.Add(Id);
+	--NumRegistered;
+}
+
+void FDecimalRebaseSet::SetPosition(int32 Id, const FDecimalVector& Position)
+{
+	check(IsValid(Id));
+	Positions[Id] = Position;
+	MarkDirty(Id);
+}
+
+void FDecimalRebaseSet::MarkDirty(int32 Id)
+{
+	if ((Flags[Id] & Flag_Dirty) == 0)
+	{
+		Flags[Id] |= Flag_Dirty;
+		DirtyIds.Add(Id);
+	}
+}
+
+void FDecimalRebaseSet::SetRebaseThreshold(const FDecimal& InRebaseThreshold)
+{
+	RebaseThreshold = InRebaseThreshold;
+	RebaseThresholdSquared = InRebaseThreshold * InRebaseThreshold;
+}
+
+bool FDecimalRebaseSet::Update(const FDecimalVector& ViewOrigin)
+{
+	const bool bRebase = !bHasRenderOrigin || FDecimalVector::DistSquared(ViewOrigin, RenderOrigin) > RebaseThresholdSquared;
+	if (bRebase)
+	{
+		RenderOrigin = ViewOrigin;
+		bHasRenderOrigin = true;
+		FDecimalMath::Batch::ToRelative(RenderOrigin, Positions, RenderPositions);
+	}
+	else
+	{
+		FDecimalMath::Batch::ToRelative(RenderOrigin, Positions, DirtyIds, RenderPositions);
+	}
+
+	for (const int32 Id : DirtyIds)
+	{
+		Flags[Id] &= ~Flag_Dirty;
+	}
+	DirtyIds.Reset();
+	return bRebase;
+}
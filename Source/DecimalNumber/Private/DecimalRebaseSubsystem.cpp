@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalRebaseSubsystem.h"
+
+int32 UDecimalRebaseSubsystem::RegisterPosition(const FDecimalVector& Position)
+{
+	return Positions.Add(Position);
+}
+
+void UDecimalRebaseSubsystem::UnregisterPosition(int32 Id)
+{
+	Positions.Remove(Id);
+}
+
+void UDecimalRebaseSubsystem::SetPosition(int32 Id, const FDecimalVector& Position)
+{
+	Positions.SetPosition(Id, Position);
+}
+
+void UDecimalRebaseSubsystem::SetViewOrigin(const FDecimalVector& InViewOrigin)
+{
+	ViewOrigin = InViewOrigin;
+	bHasViewOrigin = true;
+}
+
+void UDecimalRebaseSubsystem::SetRebaseThreshold(const FDecimal& InRebaseThreshold)
+{
+	Positions.SetRebaseThreshold(InRebaseThreshold);
+}
+
+void UDecimalRebaseSubsystem::UpdateRenderPositions()
+{
+	if (!bHasViewOrigin)
+	{
+		return;
+	}
+
+	if (Positions.Update(ViewOrigin))
+	{
+		OnRebased.Broadcast(Positions.GetRenderOrigin());
+	}
+}
+
+void UDecimalRebaseSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	UpdateRenderPositions();
+}
+
+TStatId UDecimalRebaseSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDecimalRebaseSubsystem, STATGROUP_Tickables);
+}
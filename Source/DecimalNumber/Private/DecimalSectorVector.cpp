@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalSectorVector.h"
+#include "DecimalBackend.h"
+
+namespace DecimalSectorVector
+{
+	/**
+	 * SectorSize as a decimal, built once since constructing from a double goes through the backend's parser. The power
+	 * of two itself is exact in every backend, the products and sums built from it are only exact within its precision.
+	 */
+	static const DecimalBackend::FValue& GetSectorSize()
+	{
+		static const DecimalBackend::FValue SectorSize(FDecimalSectorVector::SectorSize);
+		return SectorSize;
+	}
+}
+
+FDecimalSectorVector::FDecimalSectorVector(const FDecimalVector& V)
+{
+	SplitAxis(V.X, Sector.X, Offset.X);
+	SplitAxis(V.Y, Sector.Y, Offset.Y);
+	SplitAxis(V.Z, Sector.Z, Offset.Z);
+}
+
+FDecimalVector FDecimalSectorVector::ToDecimalVector() const
+{
+	return FDecimalVector(JoinAxis(Sector.X, Offset.X), JoinAxis(Sector.Y, Offset.Y), JoinAxis(Sector.Z, Offset.Z));
+}
+
+double FDecimalSectorVector::DeltaAxisDecimal(int64 FromSector, double FromOffset, int64 ToSector, double ToOffset)
+{
+	const FDecimal Difference = JoinAxis(ToSector, ToOffset) - JoinAxis(FromSector, FromOffset);
+	return DecimalBackend::ToDoubleDirect(Difference.GetValue());
+}
+
+void FDecimalSectorVector::SplitAxis(const FDecimal& Value, int64& OutSector, double& OutOffset)
+{
+	using DecimalBackend::FValue;
+
+	const FValue& Exact = Value.GetValue();
+	OutSector = 0;
+	if (!DecimalBackend::IsFinite(Exact))
+	{
+		OutOffset = DecimalBackend::ToDouble(Exact);
+		return;
+	}
+
+	// The double estimate of the sector is off by at most a few sectors per 2^33, so every pass shrinks the remainder
+	// by that much, then a last exact step brings it into [0, SectorSize).
+	const FValue& Size = DecimalSectorVector::GetSectorSize();
+	FValue Remainder(Exact);
+	for (;;)
+	{
+		const double Estimate = FMath::FloorToDouble(DecimalBackend::ToDoubleDirect(Remainder) / SectorSize);
+		if (Estimate >= -1.0 && Estimate <= 1.0)
+		{
+			break;
+		}
+		check(FMath::Abs(Estimate) < 0x1p62);
+		OutSector += static_cast<int64>(Estimate);
+		Remainder -= FValue(static_cast<int64>(Estimate)) * Size;
+	}
+	if (DecimalBackend::IsNegative(Remainder))
+	{
+		--OutSector;
+		Remainder += Size;
+	}
+	else if (DecimalBackend::Compare(Remainder, Size) >= 0)
+	{
+		++OutSector;
+		Remainder -= Size;
+	}
+
+	OutOffset = DecimalBackend::ToDoubleNearest(Remainder);
+	NormalizeAxis(OutSector, OutOffset);
+}
+
+FDecimal FDecimalSectorVector::JoinAxis(int64 Sector, double Offset)
+{
+	return FDecimal::FromValue(DecimalBackend::FValue(Sector) * DecimalSectorVector::GetSectorSize() + DecimalBackend::FValue(Offset));
+}
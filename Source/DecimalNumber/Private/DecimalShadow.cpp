@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalShadow.h"
+#include "DecimalBackend.h"
+
+#if DECIMALNUMBER_SHADOW_STATS
+FDecimalShadowCounters GDecimalShadowCounters;
+#endif
+
+FDecimalShadowed::FDecimalShadowed(const FDecimal& InValue)
+	: Value(InValue)
+	, Shadow(MakeShadow(InValue))
+{
+}
+
+void FDecimalShadowed::SetValue(const FDecimal& InValue)
+{
+	Value = InValue;
+	Shadow = MakeShadow(Value);
+}
+
+FDecimalShadowed& FDecimalShadowed::operator+=(const FDecimal& Other)
+{
+	Value += Other;
+	Shadow = MakeShadow(Value);
+	return *this;
+}
+
+FDecimalShadowed& FDecimalShadowed::operator-=(const FDecimal& Other)
+{
+	Value -= Other;
+	Shadow = MakeShadow(Value);
+	return *this;
+}
+
+FDecimalShadowed& FDecimalShadowed::operator*=(const FDecimal& Other)
+{
+	Value *= Other;
+	Shadow = MakeShadow(Value);
+	return *this;
+}
+
+FDecimalShadowed& FDecimalShadowed::operator/=(const FDecimal& Other)
+{
+	Value /= Other;
+	Shadow = MakeShadow(Value);
+	return *this;
+}
+
+double FDecimalShadowed::MakeShadow(const FDecimal& Value)
+{
+	return DecimalBackend::ToDoubleDirect(Value.GetValue());
+}
+
+int32 FDecimalShadowed::CompareExact(const FDecimalShadowed& Other) const
+{
+	DECIMAL_COUNT_SHADOW(Exact);
+	return Value.Compare(Other.Value);
+}
+
+FDecimalShadowedVector::FDecimalShadowedVector(const FDecimalVector& InValue)
+	: Value(InValue)
+{
+	UpdateShadow();
+}
+
+void FDecimalShadowedVector::SetValue(const FDecimalVector& InValue)
+{
+	Value = InValue;
+	UpdateShadow();
+}
+
+FDecimalShadowedVector& FDecimalShadowedVector::operator+=(const FDecimalVector& Delta)
+{
+	Value += Delta;
+	UpdateShadow();
+	return *this;
+}
+
+FDecimalShadowedVector& FDecimalShadowedVector::operator-=(const FDecimalVector& Delta)
+{
+	Value -= Delta;
+	UpdateShadow();
+	return *this;
+}
+
+bool FDecimalShadowedVector::EqualsExact(const FDecimalShadowedVector& Other) const
+{
+	DECIMAL_COUNT_SHADOW(Exact);
+	return Value == Other.Value;
+}
+
+bool FDecimalShadowedVector::IsWithinDistanceExact(const FDecimalShadowedVector& A, const FDecimalShadowedVector& B, const FDecimalShadowed& Distance)
+{
+	DECIMAL_COUNT_SHADOW(Exact);
+	const FDecimal& Radius = Distance.GetValue();
+	if (Radius.IsNegative())
+	{
+		return false;
+	}
+	return FDecimalVector::DistSquared(A.Value, B.Value) <= Radius * Radius;
+}
+
+int32 FDecimalShadowedVector::CompareDistanceExact(const FDecimalShadowedVector& Origin, const FDecimalShadowedVector& A, const FDecimalShadowedVector& B)
+{
+	DECIMAL_COUNT_SHADOW(Exact);
+	return FDecimalVector::DistSquared(Origin.Value, A.Value).Compare(FDecimalVector::DistSquared(Origin.Value, B.Value));
+}
+
+void FDecimalShadowedVector::UpdateShadow()
+{
+	Shadow.X = FDecimalShadowed::MakeShadow(Value.X);
+	Shadow.Y = FDecimalShadowed::MakeShadow(Value.Y);
+	Shadow.Z = FDecimalShadowed::MakeShadow(Value.Z);
+}
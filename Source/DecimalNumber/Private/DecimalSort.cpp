@@ -0,0 +1,537 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalSort.h"
+#include "DecimalBackend.h"
+#include "Algo/StableSort.h"
+#include "Async/ParallelFor.h"
+
+namespace DecimalSortKey
+{
+	static constexpr int32 NumExponentBytes = 4;
+
+	/** Class bytes, in ascending order. */
+	enum EClass : uint8
+	{
+		NegativeInfinity	= 0,
+		Negative			= 1,
+		Zero				= 2,
+		Positive			= 3,
+		PositiveInfinity	= 4,
+		NaN					= 5,
+	};
+
+	/** Writes Value big endian into the NumBytes bytes at Cursor. @return The byte past the last one written. */
+	template <typename IntegerType>
+	static FORCEINLINE uint8* WriteBigEndian(uint8* Cursor, IntegerType Value, int32 NumBytes)
+	{
+		for (int32 Shift = (NumBytes - 1) * 8; Shift >= 0; Shift -= 8)
+		{
+			*Cursor++ = static_cast<uint8>(Value >> Shift);
+		}
+		return Cursor;
+	}
+
+#if DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_DEC_FLOAT
+	using DecimalBackend::NumLimbs;
+
+	static constexpr int32 NumLimbPairBytes = 7;
+
+	static_assert(FDecimalSortKey::NumBytes == 1 + NumExponentBytes + (NumLimbs + 1) / 2 * NumLimbPairBytes, "FDecimalSortKey::NumBytes does not match the backend layout");
+
+	/** Writes the exponent and mantissa limbs of a finite non-zero number. */
+	static void WriteMagnitude(const DecimalBackend::FValue& Value, uint8* Cursor)
+	{
+		const DecimalBackend::FFields Fields = DecimalBackend::ReadFields(Value);
+
+		Cursor = WriteBigEndian(Cursor, static_cast<uint32>(Fields.Exponent) ^ 0x80000000u, NumExponentBytes);
+
+		// Two base 10^8 limbs fit in 54 bits, so every pair is stored in 7 bytes.
+		for (int32 LimbIndex = 0; LimbIndex < NumLimbs; LimbIndex += 2)
+		{
+			const uint64 Low = LimbIndex + 1 < NumLimbs ? Fields.Limbs[LimbIndex + 1] : 0;
+			Cursor = WriteBigEndian(Cursor, static_cast<uint64>(Fields.Limbs[LimbIndex]) * 100000000ull + Low, NumLimbPairBytes);
+		}
+	}
+#elif DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_BIN_FLOAT
+	using FBackend = DecimalBackend::FValue::backend_type;
+
+	static constexpr int32 NumMantissaBytes = (FBackend::bit_count + 7) / 8;
+
+	static_assert(1 + NumExponentBytes + NumMantissaBytes <= FDecimalSortKey::NumBytes, "FDecimalSortKey::NumBytes is too small for the backend");
+
+	/** Writes the exponent and the normalized mantissa of a finite non-zero number. */
+	static void WriteMagnitude(const DecimalBackend::FValue& Value, uint8* Cursor)
+	{
+		const FBackend& Backend = Value.backend();
+		Cursor = WriteBigEndian(Cursor, static_cast<uint32>(Backend.exponent()) ^ 0x80000000u, NumExponentBytes);
+
+		const auto* Limbs = Backend.bits().limbs();
+		const int32 NumLimbs = static_cast<int32>(Backend.bits().size());
+		constexpr int32 LimbBits = sizeof(*Limbs) * 8;
+		for (int32 ByteIndex = NumMantissaBytes - 1; ByteIndex >= 0; --ByteIndex)
+		{
+			const int32 Bit = ByteIndex * 8;
+			const int32 LimbIndex = Bit / LimbBits;
+			*Cursor++ = LimbIndex < NumLimbs ? static_cast<uint8>(Limbs[LimbIndex] >> (Bit % LimbBits)) : 0;
+		}
+	}
+#else
+	static_assert(1 + sizeof(FDecimalFixed128::RawType) <= FDecimalSortKey::NumBytes, "FDecimalSortKey::NumBytes is too small for the backend");
+
+	/** Writes the magnitude of a non-zero number as a 128-bit integer. */
+	static void WriteMagnitude(const DecimalBackend::FValue& Value, uint8* Cursor)
+	{
+		const FDecimalFixed128::RawType Raw = Value.GetRaw();
+		const FDecimalFixed128::UnsignedRawType Magnitude = Raw < 0 ? 0 - static_cast<FDecimalFixed128::UnsignedRawType>(Raw) : static_cast<FDecimalFixed128::UnsignedRawType>(Raw);
+		WriteBigEndian(Cursor, Magnitude, sizeof(Magnitude));
+	}
+#endif
+
+	/** Elements per task when encoding keys or counting and scattering radix buckets. */
+	static constexpr int32 ParallelChunkSize = 16384;
+
+	/**
+	 * Inputs below this size are sorted by comparing the numbers directly: encoding the keys costs more than it saves.
+	 * Measured on one core with full precision values, the radix sort wins from about 2000 elements on.
+	 */
+	static constexpr int32 MinRadixSortSize = 2048;
+
+	/** Buckets at or below this size are finished with a comparison sort. */
+	static constexpr int32 SmallBucketSize = 64;
+
+	/** Key bytes cached in every entry, enough to settle most sorts without reading a key again. */
+	static constexpr int32 WindowSize = 2 * sizeof(uint64);
+
+	/** Small buckets with fewer key bytes left in their window are realigned before the comparison sort. */
+	static constexpr int32 MinWindowBytes = 4;
+
+	/**
+	 * What the radix passes move around: sixteen key bytes starting at the current window, as two big endian words so
+	 * comparing windows as integers compares the bytes, and the index of the number. Much smaller than a whole key.
+	 */
+	struct FEntry
+	{
+		uint64 Window[2];
+		int32 Index;
+
+		FORCEINLINE bool WindowLess(const FEntry& Other) const
+		{
+			return Window[0] != Other.Window[0] ? Window[0] < Other.Window[0] : Window[1] < Other.Window[1];
+		}
+
+		FORCEINLINE bool WindowEquals(const FEntry& Other) const
+		{
+			return Window[0] == Other.Window[0] && Window[1] == Other.Window[1];
+		}
+
+		/** @return Window byte Offset, 0 being the first. */
+		FORCEINLINE uint32 WindowByte(int32 Offset) const
+		{
+			return static_cast<uint32>(Window[Offset / 8] >> ((7 - Offset % 8) * 8)) & 0xff;
+		}
+	};
+
+	/** Accumulated XOR of windows against a reference window, finds the first byte at which a bucket differs. */
+	struct FWindowDifference
+	{
+		uint64 Words[2] = { 0, 0 };
+
+		FORCEINLINE void Add(const FEntry& Entry, const FEntry& Reference)
+		{
+			Words[0] |= Entry.Window[0] ^ Reference.Window[0];
+			Words[1] |= Entry.Window[1] ^ Reference.Window[1];
+		}
+
+		FORCEINLINE void Add(const FWindowDifference& Other)
+		{
+			Words[0] |= Other.Words[0];
+			Words[1] |= Other.Words[1];
+		}
+
+		/** @return Offset of the first differing byte in the window, INDEX_NONE when the windows are all equal. */
+		FORCEINLINE int32 FirstByte() const
+		{
+			if (Words[0] != 0)
+			{
+				return static_cast<int32>(FMath::CountLeadingZeros64(Words[0])) / 8;
+			}
+			if (Words[1] != 0)
+			{
+				return 8 + static_cast<int32>(FMath::CountLeadingZeros64(Words[1])) / 8;
+			}
+			return INDEX_NONE;
+		}
+	};
+
+	/** Stable MSD radix sort of FEntry buckets, reading full keys only to refill windows and break ties in small buckets. */
+	struct FRadixSorter
+	{
+		const FDecimalSortKey* Keys;
+
+		/** Load key bytes [WindowStart, WindowStart + WindowSize) of a number into Entry, zero past the end of the key. */
+		FORCEINLINE void LoadWindow(FEntry& Entry, int32 WindowStart) const
+		{
+			const uint8* Bytes = Keys[Entry.Index].Bytes;
+			for (int32 Word = 0; Word < 2; ++Word)
+			{
+				uint64 Window = 0;
+				for (int32 ByteIndex = WindowStart + Word * 8; ByteIndex < WindowStart + Word * 8 + 8; ++ByteIndex)
+				{
+					Window = (Window << 8) | (ByteIndex < FDecimalSortKey::NumBytes ? Bytes[ByteIndex] : 0);
+				}
+				Entry.Window[Word] = Window;
+			}
+		}
+
+		/** Order a bucket by window, then by the key bytes past the window, then by index so equal keys stay stable. */
+		void SortSmallBucket(FEntry* Entries, int32 Num, int32 WindowStart) const
+		{
+			const int32 WindowEnd = WindowStart + WindowSize;
+			Algo::Sort(MakeArrayView(Entries, Num), [this, WindowEnd](const FEntry& A, const FEntry& B)
+			{
+				if (!A.WindowEquals(B))
+				{
+					return A.WindowLess(B);
+				}
+				if (WindowEnd < FDecimalSortKey::NumBytes)
+				{
+					const int32 Result = FMemory::Memcmp(Keys[A.Index].Bytes + WindowEnd, Keys[B.Index].Bytes + WindowEnd, FDecimalSortKey::NumBytes - WindowEnd);
+					if (Result != 0)
+					{
+						return Result < 0;
+					}
+				}
+				return A.Index < B.Index;
+			});
+		}
+
+		/**
+		 * Find the first key byte at or after WindowStart that differs within a bucket. Every entry in the bucket shares
+		 * the key bytes before it, so XOR-ing windows against the first entry finds it in one pass. Windows that are
+		 * shared by the whole bucket are slid forward.
+		 *
+		 * @return The byte index, or INDEX_NONE when every key in the bucket is equal.
+		 */
+		int32 FindSplitByte(FEntry* Entries, int32 Num, int32& WindowStart) const
+		{
+			for (;;)
+			{
+				FWindowDifference Difference;
+				for (int32 Index = 1; Index < Num; ++Index)
+				{
+					Difference.Add(Entries[Index], Entries[0]);
+				}
+				const int32 FirstByte = Difference.FirstByte();
+				if (FirstByte != INDEX_NONE)
+				{
+					return WindowStart + FirstByte;
+				}
+
+				WindowStart += WindowSize;
+				if (WindowStart >= FDecimalSortKey::NumBytes)
+				{
+					return INDEX_NONE;
+				}
+				for (int32 Index = 0; Index < Num; ++Index)
+				{
+					LoadWindow(Entries[Index], WindowStart);
+				}
+			}
+		}
+
+		/**
+		 * Sort one bucket on the calling thread, Scratch must hold as many entries. Splits on the first differing byte
+		 * and recurses, counts live on the stack so small buckets cost no allocation.
+		 */
+		void SortBucket(FEntry* Entries, FEntry* Scratch, int32 Num, int32 WindowStart) const
+		{
+			const int32 ByteIndex = FindSplitByte(Entries, Num, WindowStart);
+			if (ByteIndex == INDEX_NONE)
+			{
+				// Every key is equal, and earlier passes were stable, so the entries are already in index order.
+				return;
+			}
+
+			if (Num <= SmallBucketSize)
+			{
+				// Realign a mostly consumed window on the first differing byte so most comparisons never touch the full keys.
+				if (WindowStart + WindowSize - ByteIndex < MinWindowBytes)
+				{
+					for (int32 Index = 0; Index < Num; ++Index)
+					{
+						LoadWindow(Entries[Index], ByteIndex);
+					}
+					WindowStart = ByteIndex;
+				}
+				SortSmallBucket(Entries, Num, WindowStart);
+				return;
+			}
+
+			const int32 Offset = ByteIndex - WindowStart;
+
+			int32 BucketStarts[257] = {};
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				++BucketStarts[Entries[Index].WindowByte(Offset) + 1];
+			}
+			for (int32 Bucket = 1; Bucket <= 256; ++Bucket)
+			{
+				BucketStarts[Bucket] += BucketStarts[Bucket - 1];
+			}
+
+			int32 Offsets[256];
+			FMemory::Memcpy(Offsets, BucketStarts, sizeof(Offsets));
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				Scratch[Offsets[Entries[Index].WindowByte(Offset)]++] = Entries[Index];
+			}
+			FMemory::Memcpy(Entries, Scratch, Num * sizeof(FEntry));
+
+			for (int32 Bucket = 0; Bucket < 256; ++Bucket)
+			{
+				const int32 Start = BucketStarts[Bucket];
+				const int32 Count = BucketStarts[Bucket + 1] - Start;
+				if (Count > 1)
+				{
+					SortBucket(Entries + Start, Scratch + Start, Count, WindowStart);
+				}
+			}
+		}
+
+		/**
+		 * Sort Entries, Scratch must hold as many entries. Like SortBucket, but the first split counts, scatters and
+		 * finds the split byte in chunks across tasks, and the resulting buckets are sorted concurrently.
+		 */
+		void Sort(FEntry* Entries, FEntry* Scratch, int32 Num) const
+		{
+			const int32 NumChunks = FMath::DivideAndRoundUp(Num, ParallelChunkSize);
+			if (NumChunks <= 1)
+			{
+				SortBucket(Entries, Scratch, Num, 0);
+				return;
+			}
+			const int32 ChunkSize = FMath::DivideAndRoundUp(Num, NumChunks);
+
+			int32 WindowStart = 0;
+			TArray<FWindowDifference> Differences;
+			int32 ByteIndex;
+			for (;;)
+			{
+				Differences.Reset();
+				Differences.SetNum(NumChunks);
+				ParallelFor(NumChunks, [Entries, &Differences, ChunkSize, Num](int32 ChunkIndex)
+				{
+					FWindowDifference Difference;
+					const int32 End = FMath::Min((ChunkIndex + 1) * ChunkSize, Num);
+					for (int32 Index = ChunkIndex * ChunkSize; Index < End; ++Index)
+					{
+						Difference.Add(Entries[Index], Entries[0]);
+					}
+					Differences[ChunkIndex] = Difference;
+				});
+
+				FWindowDifference Difference;
+				for (const FWindowDifference& ChunkDifference : Differences)
+				{
+					Difference.Add(ChunkDifference);
+				}
+				const int32 FirstByte = Difference.FirstByte();
+				if (FirstByte != INDEX_NONE)
+				{
+					ByteIndex = WindowStart + FirstByte;
+					break;
+				}
+
+				// The whole window is shared, slide it forward.
+				WindowStart += WindowSize;
+				if (WindowStart >= FDecimalSortKey::NumBytes)
+				{
+					return;
+				}
+				ParallelFor(NumChunks, [this, Entries, ChunkSize, Num, WindowStart](int32 ChunkIndex)
+				{
+					const int32 End = FMath::Min((ChunkIndex + 1) * ChunkSize, Num);
+					for (int32 Index = ChunkIndex * ChunkSize; Index < End; ++Index)
+					{
+						LoadWindow(Entries[Index], WindowStart);
+					}
+				});
+			}
+
+			const int32 Offset = ByteIndex - WindowStart;
+
+			// Count every chunk separately so the scatter below can run per chunk and stay stable.
+			TArray<int32> Counts;
+			Counts.Init(0, NumChunks * 256);
+			ParallelFor(NumChunks, [Entries, &Counts, ChunkSize, Num, Offset](int32 ChunkIndex)
+			{
+				int32* ChunkCounts = &Counts[ChunkIndex * 256];
+				const int32 End = FMath::Min((ChunkIndex + 1) * ChunkSize, Num);
+				for (int32 Index = ChunkIndex * ChunkSize; Index < End; ++Index)
+				{
+					++ChunkCounts[Entries[Index].WindowByte(Offset)];
+				}
+			});
+
+			// Turn the counts into exclusive start offsets per chunk within each bucket.
+			int32 BucketStarts[257];
+			int32 Start = 0;
+			for (int32 Bucket = 0; Bucket < 256; ++Bucket)
+			{
+				BucketStarts[Bucket] = Start;
+				for (int32 ChunkIndex = 0; ChunkIndex < NumChunks; ++ChunkIndex)
+				{
+					const int32 Count = Counts[ChunkIndex * 256 + Bucket];
+					Counts[ChunkIndex * 256 + Bucket] = Start;
+					Start += Count;
+				}
+			}
+			BucketStarts[256] = Start;
+
+			ParallelFor(NumChunks, [Entries, Scratch, &Counts, ChunkSize, Num, Offset](int32 ChunkIndex)
+			{
+				int32* ChunkOffsets = &Counts[ChunkIndex * 256];
+				const int32 End = FMath::Min((ChunkIndex + 1) * ChunkSize, Num);
+				for (int32 Index = ChunkIndex * ChunkSize; Index < End; ++Index)
+				{
+					Scratch[ChunkOffsets[Entries[Index].WindowByte(Offset)]++] = Entries[Index];
+				}
+			});
+			FMemory::Memcpy(Entries, Scratch, Num * sizeof(FEntry));
+
+			// Buckets are disjoint, so sorting them concurrently cannot change the result.
+			ParallelFor(256, [this, Entries, Scratch, &BucketStarts, WindowStart](int32 Bucket)
+			{
+				const int32 Start = BucketStarts[Bucket];
+				const int32 Count = BucketStarts[Bucket + 1] - Start;
+				if (Count > 1)
+				{
+					SortBucket(Entries + Start, Scratch + Start, Count, WindowStart);
+				}
+			}, EParallelForFlags::Unbalanced);
+		}
+	};
+}
+
+FDecimalSortKey::FDecimalSortKey()
+{
+	FMemory::Memzero(Bytes, NumBytes);
+	Bytes[0] = DecimalSortKey::Zero;
+}
+
+FDecimalSortKey::FDecimalSortKey(const FDecimal& Value)
+{
+	using namespace DecimalSortKey;
+
+	FMemory::Memzero(Bytes, NumBytes);
+
+	const DecimalBackend::FValue& Number = Value.GetValue();
+	if (DecimalBackend::IsNaN(Number))
+	{
+		Bytes[0] = NaN;
+		return;
+	}
+	if (DecimalBackend::IsInf(Number))
+	{
+		Bytes[0] = DecimalBackend::IsNegative(Number) ? NegativeInfinity : PositiveInfinity;
+		return;
+	}
+	if (DecimalBackend::IsZero(Number))
+	{
+		Bytes[0] = Zero;
+		return;
+	}
+
+	const bool bNegative = DecimalBackend::IsNegative(Number);
+	Bytes[0] = bNegative ? Negative : Positive;
+	WriteMagnitude(Number, Bytes + 1);
+
+	if (bNegative)
+	{
+		for (int32 Index = 1; Index < NumBytes; ++Index)
+		{
+			Bytes[Index] = ~Bytes[Index];
+		}
+	}
+}
+
+void FDecimalSortKey::Encode(TConstArrayView<FDecimal> Values, TArray<FDecimalSortKey>& OutKeys)
+{
+	const int32 Num = Values.Num();
+	OutKeys.SetNumUninitialized(Num);
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, DecimalSortKey::ParallelChunkSize);
+	ParallelFor(NumChunks, [Values, &OutKeys, Num](int32 ChunkIndex)
+	{
+		const int32 End = FMath::Min((ChunkIndex + 1) * DecimalSortKey::ParallelChunkSize, Num);
+		for (int32 Index = ChunkIndex * DecimalSortKey::ParallelChunkSize; Index < End; ++Index)
+		{
+			OutKeys[Index] = FDecimalSortKey(Values[Index]);
+		}
+	});
+}
+
+void FDecimalSort::Sort(TArrayView<FDecimal> Values)
+{
+	if (Values.Num() < DecimalSortKey::MinRadixSortSize)
+	{
+		Algo::StableSort(Values, [](const FDecimal& A, const FDecimal& B)
+		{
+			return A.Compare(B) < 0;
+		});
+		return;
+	}
+
+	TArray<int32> Order;
+	SortIndices(Values, Order);
+	ApplyOrder(Values, Order);
+}
+
+void FDecimalSort::SortIndices(TConstArrayView<FDecimal> Values, TArray<int32>& OutOrder)
+{
+	using namespace DecimalSortKey;
+
+	const int32 Num = Values.Num();
+	if (Num < MinRadixSortSize)
+	{
+		OutOrder.SetNumUninitialized(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			OutOrder[Index] = Index;
+		}
+		Algo::Sort(OutOrder, [Values](int32 A, int32 B)
+		{
+			const int32 Result = Values[A].Compare(Values[B]);
+			return Result != 0 ? Result < 0 : A < B;
+		});
+		return;
+	}
+
+	TArray<FDecimalSortKey> Keys;
+	FDecimalSortKey::Encode(Values, Keys);
+
+	const FRadixSorter Sorter{ Keys.GetData() };
+	TArray<FEntry> Entries, Scratch;
+	Entries.SetNumUninitialized(Num);
+	Scratch.SetNumUninitialized(Num);
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(Num, ParallelChunkSize);
+	ParallelFor(NumChunks, [&Sorter, &Entries, Num](int32 ChunkIndex)
+	{
+		const int32 End = FMath::Min((ChunkIndex + 1) * ParallelChunkSize, Num);
+		for (int32 Index = ChunkIndex * ParallelChunkSize; Index < End; ++Index)
+		{
+			Entries[Index].Index = Index;
+			Sorter.LoadWindow(Entries[Index], 0);
+		}
+	});
+
+	Sorter.Sort(Entries.GetData(), Scratch.GetData(), Num);
+
+	OutOrder.SetNumUninitialized(Num);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		OutOrder[Index] = Entries[Index].Index;
+	}
+}
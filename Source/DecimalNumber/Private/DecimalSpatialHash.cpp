@@ -0,0 +1,330 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalSpatialHash.h"
+#include "DecimalMath.h"
+#include <algorithm>
+
+namespace DecimalSpatialHash
+{
+	/** Largest cell coordinate, beyond any world, so cell coordinates and their neighbours stay exact in doubles. */
+	static constexpr double MaxCellAxis = 0x1p52;
+
+	/** Shared access to a hash, only granted once no update is waiting. */
+	struct FReadScope
+	{
+		FReadScope(FCriticalSection& Gate, FRWLock& InLock)
+			: Lock(InLock)
+		{
+			FScopeLock GateLock(&Gate);
+			Lock.ReadLock();
+		}
+
+		~FReadScope()
+		{
+			Lock.ReadUnlock();
+		}
+
+		FRWLock& Lock;
+	};
+
+	/** Exclusive access to a hash, closing the gate to new queries while running ones finish. */
+	struct FWriteScope
+	{
+		FWriteScope(FCriticalSection& Gate, FRWLock& InLock)
+			: Lock(InLock)
+		{
+			FScopeLock GateLock(&Gate);
+			Lock.WriteLock();
+		}
+
+		~FWriteScope()
+		{
+			Lock.WriteUnlock();
+		}
+
+		FRWLock& Lock;
+	};
+
+	/** @return The number of cells in the box from Min to Max. */
+	static FORCEINLINE double GetNumCells(const FInt64Vector& Min, const FInt64Vector& Max)
+	{
+		return (static_cast<double>(Max.X - Min.X) + 1.0) * (static_cast<double>(Max.Y - Min.Y) + 1.0) * (static_cast<double>(Max.Z - Min.Z) + 1.0);
+	}
+}
+
+FDecimalSpatialHash::FDecimalSpatialHash(const FDecimal& InCellSize)
+	: CellSize(InCellSize)
+{
+	check(InCellSize.Sign() > 0);
+}
+
+FInt64Vector FDecimalSpatialHash::GetCell(const FDecimalVector& Position) const
+{
+	return GetCell(FDecimalShadowedVector(Position));
+}
+
+FInt64Vector FDecimalSpatialHash::GetCell(const FDecimalShadowedVector& Position) const
+{
+	const FDecimalVector& Value = Position.GetValue();
+	const FVector& Shadow = Position.GetShadow();
+	return FInt64Vector(GetCellAxis(Value.X, Shadow.X), GetCellAxis(Value.Y, Shadow.Y), GetCellAxis(Value.Z, Shadow.Z));
+}
+
+int64 FDecimalSpatialHash::GetCellAxis(const FDecimal& Value, double Shadow) const
+{
+	const double Scaled = Shadow / CellSize.GetShadow();
+	check(FMath::Abs(Scaled) < DecimalSpatialHash::MaxCellAxis);
+
+	// Scaled is off by the shadow's error in cells, plus the relative errors of the cell size's shadow and the division.
+	const double Floor = FMath::FloorToDouble(Scaled);
+	const double Margin = FDecimalShadowed::GetShadowError(Shadow) / CellSize.GetShadow() + 8.0 * DBL_EPSILON * FMath::Abs(Scaled);
+	if (Scaled - Floor > Margin && Floor + 1.0 - Scaled > Margin)
+	{
+		return static_cast<int64>(Floor);
+	}
+
+	// Near a boundary the estimate is at most a cell off, unless cells are too small for doubles at this distance.
+	const FDecimal& Size = CellSize.GetValue();
+	int64 Cell = Margin < 0.25 ? static_cast<int64>(Floor) : static_cast<int64>(FDecimalMath::Floor(Value / Size).ToDouble());
+	while (Value < FDecimal(Cell) * Size)
+	{
+		--Cell;
+	}
+	while (Value >= FDecimal(Cell + 1) * Size)
+	{
+		++Cell;
+	}
+	return Cell;
+}
+
+int64 FDecimalSpatialHash::GetLowerCellAxis(double Shadow, double Reach) const
+{
+	const double Error = FDecimalShadowed::GetShadowError(Shadow) + 4.0 * DBL_EPSILON * (FMath::Abs(Shadow) + Reach);
+	const double Scaled = FMath::Max((Shadow - Reach - Error) / CellSize.GetShadow(), -DecimalSpatialHash::MaxCellAxis);
+	return static_cast<int64>(FMath::FloorToDouble(Scaled - 8.0 * DBL_EPSILON * FMath::Abs(Scaled))) - 1;
+}
+
+int64 FDecimalSpatialHash::GetUpperCellAxis(double Shadow, double Reach) const
+{
+	const double Error = FDecimalShadowed::GetShadowError(Shadow) + 4.0 * DBL_EPSILON * (FMath::Abs(Shadow) + Reach);
+	const double Scaled = FMath::Min((Shadow + Reach + Error) / CellSize.GetShadow(), DecimalSpatialHash::MaxCellAxis);
+	return static_cast<int64>(FMath::FloorToDouble(Scaled + 8.0 * DBL_EPSILON * FMath::Abs(Scaled))) + 1;
+}
+
+int32 FDecimalSpatialHash::Num() const
+{
+	DecimalSpatialHash::FReadScope ReadScope(UpdateGate, Lock);
+	return Points.Num() - FreeIds.Num();
+}
+
+void FDecimalSpatialHash::Reset()
+{
+	DecimalSpatialHash::FWriteScope WriteScope(UpdateGate, Lock);
+	Points.Reset();
+	FreeIds.Reset();
+	Cells.Reset();
+	CellIndices.Reset();
+}
+
+int32 FDecimalSpatialHash::Add(const FDecimalVector& Position)
+{
+	FDecimalShadowedVector Shadowed(Position);
+	const FInt64Vector Key = GetCell(Shadowed);
+
+	DecimalSpatialHash::FWriteScope WriteScope(UpdateGate, Lock);
+	const int32 Id = FreeIds.Num() > 0 ? FreeIds.Pop() : Points.AddDefaulted();
+	Points[Id].Position = MoveTemp(Shadowed);
+	AddToCell(Id, Key);
+	return Id;
+}
+
+void FDecimalSpatialHash::Move(int32 Id, const FDecimalVector& Position)
+{
+	FDecimalShadowedVector Shadowed(Position);
+	const FInt64Vector Key = GetCell(Shadowed);
+
+	DecimalSpatialHash::FWriteScope WriteScope(UpdateGate, Lock);
+	FPoint& Point = Points[Id];
+	check(Point.SlotInCell != INDEX_NONE);
+	Point.Position = MoveTemp(Shadowed);
+	if (Key != Point.Cell)
+	{
+		RemoveFromCell(Id);
+		AddToCell(Id, Key);
+	}
+}
+
+void FDecimalSpatialHash::Remove(int32 Id)
+{
+	DecimalSpatialHash::FWriteScope WriteScope(UpdateGate, Lock);
+	check(Points[Id].SlotInCell != INDEX_NONE);
+	RemoveFromCell(Id);
+	FreeIds.Add(Id);
+}
+
+FDecimalVector FDecimalSpatialHash::GetPosition(int32 Id) const
+{
+	DecimalSpatialHash::FReadScope ReadScope(UpdateGate, Lock);
+	check(Points[Id].SlotInCell != INDEX_NONE);
+	return Points[Id].Position.GetValue();
+}
+
+void FDecimalSpatialHash::AddToCell(int32 Id, const FInt64Vector& Key)
+{
+	int32 CellIndex;
+	if (const int32* Found = CellIndices.Find(Key))
+	{
+		CellIndex = *Found;
+	}
+	else
+	{
+		CellIndex = Cells.AddDefaulted();
+		Cells[CellIndex].Key = Key;
+		CellIndices.Add(Key, CellIndex);
+	}
+
+	FPoint& Point = Points[Id];
+	Point.Cell = Key;
+	Point.SlotInCell = Cells[CellIndex].Ids.Add(Id);
+}
+
+void FDecimalSpatialHash::RemoveFromCell(int32 Id)
+{
+	FPoint& Point = Points[Id];
+	const int32 CellIndex = CellIndices.FindChecked(Point.Cell);
+	TArray<int32>& Ids = Cells[CellIndex].Ids;
+	const int32 LastId = Ids.Pop();
+	if (LastId != Id)
+	{
+		Ids[Point.SlotInCell] = LastId;
+		Points[LastId].SlotInCell = Point.SlotInCell;
+	}
+	Point.SlotInCell = INDEX_NONE;
+
+	if (Ids.Num() == 0)
+	{
+		// Keep Cells dense by moving the last cell into the hole.
+		CellIndices.Remove(Point.Cell);
+		FCell LastCell = Cells.Pop();
+		if (CellIndex < Cells.Num())
+		{
+			CellIndices.Add(LastCell.Key, CellIndex);
+			Cells[CellIndex] = MoveTemp(LastCell);
+		}
+	}
+}
+
+void FDecimalSpatialHash::FindInRadius(const FDecimalVector& Center, const FDecimal& Radius, TArray<int32>& OutIds) const
+{
+	OutIds.Reset();
+	if (Radius.IsNegative())
+	{
+		return;
+	}
+	const FDecimalShadowedVector ShadowedCenter(Center);
+	const FDecimalShadowed ShadowedRadius(Radius);
+	const FVector& Shadow = ShadowedCenter.GetShadow();
+	const double Reach = ShadowedRadius.GetShadow() + FDecimalShadowed::GetShadowError(ShadowedRadius.GetShadow());
+
+	DecimalSpatialHash::FReadScope ReadScope(UpdateGate, Lock);
+	const auto GatherCell = [this, &ShadowedCenter, &ShadowedRadius, &OutIds](const FCell& Cell)
+	{
+		for (const int32 Id : Cell.Ids)
+		{
+			if (FDecimalShadowedVector::IsWithinDistance(ShadowedCenter, Points[Id].Position, ShadowedRadius))
+			{
+				OutIds.Add(Id);
+			}
+		}
+	};
+
+	const FInt64Vector Min(GetLowerCellAxis(Shadow.X, Reach), GetLowerCellAxis(Shadow.Y, Reach), GetLowerCellAxis(Shadow.Z, Reach));
+	const FInt64Vector Max(GetUpperCellAxis(Shadow.X, Reach), GetUpperCellAxis(Shadow.Y, Reach), GetUpperCellAxis(Shadow.Z, Reach));
+	if (DecimalSpatialHash::GetNumCells(Min, Max) > Cells.Num())
+	{
+		for (const FCell& Cell : Cells)
+		{
+			GatherCell(Cell);
+		}
+		return;
+	}
+	for (int64 Z = Min.Z; Z <= Max.Z; ++Z)
+	{
+		for (int64 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int64 X = Min.X; X <= Max.X; ++X)
+			{
+				if (const FCell* Cell = FindCell(FInt64Vector(X, Y, Z)))
+				{
+					GatherCell(*Cell);
+				}
+			}
+		}
+	}
+}
+
+void FDecimalSpatialHash::FindNearest(const FDecimalVector& Center, int32 NumNeighbors, TArray<int32>& OutIds) const
+{
+	OutIds.Reset();
+	const FDecimalShadowedVector ShadowedCenter(Center);
+	const FInt64Vector CenterCell = GetCell(ShadowedCenter);
+
+	DecimalSpatialHash::FReadScope ReadScope(UpdateGate, Lock);
+	const int32 Count = FMath::Min(NumNeighbors, Points.Num() - FreeIds.Num());
+	if (Count <= 0)
+	{
+		return;
+	}
+	const auto IsNearer = [this, &ShadowedCenter](int32 A, int32 B)
+	{
+		const int32 Order = FDecimalShadowedVector::CompareDistance(ShadowedCenter, Points[A].Position, Points[B].Position);
+		return Order != 0 ? Order < 0 : A < B;
+	};
+
+	// Search shells of cells around the center's cell. Points outside the cells searched so far are further than Ring
+	// cells from the center, so the search ends once Count points are at most that far.
+	TArray<int32> Candidates;
+	for (int64 Ring = 0; ; ++Ring)
+	{
+		const double Side = 2.0 * static_cast<double>(Ring) + 1.0;
+		if (Side * Side * Side >= Cells.Num())
+		{
+			Candidates.Reset();
+			for (const FCell& Cell : Cells)
+			{
+				Candidates.Append(Cell.Ids);
+			}
+			break;
+		}
+
+		for (int64 Z = -Ring; Z <= Ring; ++Z)
+		{
+			for (int64 Y = -Ring; Y <= Ring; ++Y)
+			{
+				// Inside the shell in Y and Z, only the two cells at the ends of the X row are on it.
+				const int64 Step = (FMath::Abs(Z) < Ring && FMath::Abs(Y) < Ring) ? 2 * Ring : 1;
+				for (int64 X = -Ring; X <= Ring; X += Step)
+				{
+					if (const FCell* Cell = FindCell(FInt64Vector(CenterCell.X + X, CenterCell.Y + Y, CenterCell.Z + Z)))
+					{
+						Candidates.Append(Cell->Ids);
+					}
+				}
+			}
+		}
+
+		if (Candidates.Num() >= Count)
+		{
+			std::nth_element(Candidates.GetData(), Candidates.GetData() + Count - 1, Candidates.GetData() + Candidates.Num(), IsNearer);
+			const FDecimalShadowed Reach(FDecimal(Ring) * CellSize.GetValue());
+			if (FDecimalShadowedVector::IsWithinDistance(ShadowedCenter, Points[Candidates[Count - 1]].Position, Reach))
+			{
+				break;
+			}
+		}
+	}
+
+	std::partial_sort(Candidates.GetData(), Candidates.GetData() + Count, Candidates.GetData() + Candidates.Num(), IsNearer);
+	OutIds.Append(Candidates.GetData(), Count);
+}
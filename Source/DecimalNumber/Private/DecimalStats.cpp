@@ -0,0 +1,286 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalStats.h"
+#include "HAL/IConsoleManager.h"
+
+#if DECIMALNUMBER_STATS
+DEFINE_STAT(STAT_DecimalConstruct);
+DEFINE_STAT(STAT_DecimalArithmetic);
+DEFINE_STAT(STAT_DecimalFromString);
+DEFINE_STAT(STAT_DecimalFromFloat);
+DEFINE_STAT(STAT_DecimalToString);
+DEFINE_STAT(STAT_DecimalToDouble);
+DEFINE_STAT(STAT_DecimalTranscendental);
+DEFINE_STAT(STAT_DecimalNormalize);
+
+DEFINE_STAT(STAT_DecimalConstructCalls);
+DEFINE_STAT(STAT_DecimalArithmeticCalls);
+DEFINE_STAT(STAT_DecimalFromStringCalls);
+DEFINE_STAT(STAT_DecimalFromFloatCalls);
+DEFINE_STAT(STAT_DecimalToStringCalls);
+DEFINE_STAT(STAT_DecimalToDoubleCalls);
+DEFINE_STAT(STAT_DecimalTranscendentalCalls);
+DEFINE_STAT(STAT_DecimalNormalizeCalls);
+#endif
+
+#if DECIMALNUMBER_TRACE
+UE_TRACE_CHANNEL_DEFINE(DecimalChannel);
+#endif
+
+#if DECIMALNUMBER_CONVERSION_STATS
+namespace DecimalConversionStats
+{
+	static constexpr int32 NumEntries = static_cast<int32>(EDecimalConversion::Num);
+
+	/** Fields of FDecimalConversionCounter, as stored per thread. */
+	enum EField { Conversions, Allocations, AllocatedBytes, NumFields };
+
+	/** Counters of every entry point. */
+	struct FTable
+	{
+		FDecimalConversionCounter Entries[NumEntries];
+
+		void Add(const FTable& Other)
+		{
+			for (int32 Index = 0; Index < NumEntries; ++Index)
+			{
+				Entries[Index].Conversions += Other.Entries[Index].Conversions;
+				Entries[Index].Allocations += Other.Entries[Index].Allocations;
+				Entries[Index].AllocatedBytes += Other.Entries[Index].AllocatedBytes;
+			}
+		}
+
+		FDecimalConversionCounter Delta(const FTable& Since, int32 Index) const
+		{
+			FDecimalConversionCounter Result;
+			Result.Conversions = Entries[Index].Conversions - Since.Entries[Index].Conversions;
+			Result.Allocations = Entries[Index].Allocations - Since.Entries[Index].Allocations;
+			Result.AllocatedBytes = Entries[Index].AllocatedBytes - Since.Entries[Index].AllocatedBytes;
+			return Result;
+		}
+	};
+
+	struct FThreadCounters;
+
+	/** Every live thread's counters, plus what exited threads left behind. */
+	struct FRegistry
+	{
+		FCriticalSection Lock;
+		TArray<FThreadCounters*> Threads;
+		FTable Retired;
+
+		/** Totals at the last Reset, at the end of the previous frame and during the last frame. */
+		FTable ResetMark;
+		FTable FrameMark;
+		FTable LastFrame;
+
+		FTable Sum();
+	};
+
+	static FRegistry& GetRegistry()
+	{
+		static FRegistry Registry;
+		return Registry;
+	}
+
+	/**
+	 * One thread's counters. Only the owning thread writes them, with relaxed loads and stores instead of read-modify-write,
+	 * so counting costs no more than a plain increment. Other threads only read them, under the registry lock.
+	 */
+	struct FThreadCounters
+	{
+		std::atomic<uint64> Values[NumEntries][NumFields];
+
+		/** Entry charged by the outermost open scope, INDEX_NONE outside any scope. */
+		int32 OpenEntry = INDEX_NONE;
+
+		FThreadCounters()
+		{
+			for (int32 Index = 0; Index < NumEntries; ++Index)
+			{
+				for (std::atomic<uint64>& Value : Values[Index])
+				{
+					Value.store(0, std::memory_order_relaxed);
+				}
+			}
+
+			FRegistry& Registry = GetRegistry();
+			FScopeLock ScopeLock(&Registry.Lock);
+			Registry.Threads.Add(this);
+		}
+
+		~FThreadCounters()
+		{
+			FRegistry& Registry = GetRegistry();
+			FScopeLock ScopeLock(&Registry.Lock);
+			Registry.Retired.Add(Read());
+			Registry.Threads.RemoveSwap(this);
+		}
+
+		FORCEINLINE void Add(int32 Entry, EField Field, uint64 Amount)
+		{
+			std::atomic<uint64>& Value = Values[Entry][Field];
+			Value.store(Value.load(std::memory_order_relaxed) + Amount, std::memory_order_relaxed);
+		}
+
+		FTable Read() const
+		{
+			FTable Result;
+			for (int32 Index = 0; Index < NumEntries; ++Index)
+			{
+				Result.Entries[Index].Conversions = Values[Index][Conversions].load(std::memory_order_relaxed);
+				Result.Entries[Index].Allocations = Values[Index][Allocations].load(std::memory_order_relaxed);
+				Result.Entries[Index].AllocatedBytes = Values[Index][AllocatedBytes].load(std::memory_order_relaxed);
+			}
+			return Result;
+		}
+	};
+
+	FTable FRegistry::Sum()
+	{
+		FTable Result = Retired;
+		for (const FThreadCounters* Thread : Threads)
+		{
+			Result.Add(Thread->Read());
+		}
+		return Result;
+	}
+
+	static thread_local FThreadCounters Counters;
+
+	static void PrintStats(const TArray<FString>& Args)
+	{
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			FDecimalConversionStats::Reset();
+			UE_LOG(LogTemp, Display, TEXT("decimal.stats: totals reset"));
+			return;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("decimal.stats: string conversions, allocations and bytes, last frame / since reset"));
+		for (int32 Index = 0; Index < NumEntries; ++Index)
+		{
+			const EDecimalConversion Entry = static_cast<EDecimalConversion>(Index);
+			const FDecimalConversionCounter Frame = FDecimalConversionStats::GetLastFrame(Entry);
+			const FDecimalConversionCounter Total = FDecimalConversionStats::GetTotal(Entry);
+			UE_LOG(LogTemp, Display, TEXT("  %-18s %8llu conversions %8llu allocs %10llu bytes / %10llu conversions %10llu allocs %12llu bytes"),
+				FDecimalConversionStats::GetName(Entry),
+				(unsigned long long)Frame.Conversions, (unsigned long long)Frame.Allocations, (unsigned long long)Frame.AllocatedBytes,
+				(unsigned long long)Total.Conversions, (unsigned long long)Total.Allocations, (unsigned long long)Total.AllocatedBytes);
+		}
+	}
+
+	static FAutoConsoleCommand CmdStats(
+		TEXT("decimal.stats"),
+		TEXT("Prints how many FDecimal conversions went through strings, and the heap allocations and bytes they cost, during the last frame and since the last reset, per entry point. 'decimal.stats reset' restarts the totals."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&PrintStats));
+}
+
+FDecimalConversionStats::FScope::FScope(EDecimalConversion Entry)
+{
+	DecimalConversionStats::FThreadCounters& Counters = DecimalConversionStats::Counters;
+	bOutermost = (Counters.OpenEntry == INDEX_NONE);
+	if (bOutermost)
+	{
+		Counters.OpenEntry = static_cast<int32>(Entry);
+		Counters.Add(Counters.OpenEntry, DecimalConversionStats::Conversions, 1);
+	}
+}
+
+FDecimalConversionStats::FScope::~FScope()
+{
+	if (bOutermost)
+	{
+		DecimalConversionStats::Counters.OpenEntry = INDEX_NONE;
+	}
+}
+
+void FDecimalConversionStats::AddAllocation(SIZE_T Bytes)
+{
+	DecimalConversionStats::FThreadCounters& Counters = DecimalConversionStats::Counters;
+	if (Bytes > 0 && Counters.OpenEntry != INDEX_NONE)
+	{
+		Counters.Add(Counters.OpenEntry, DecimalConversionStats::Allocations, 1);
+		Counters.Add(Counters.OpenEntry, DecimalConversionStats::AllocatedBytes, Bytes);
+	}
+}
+
+void FDecimalConversionStats::EndFrame()
+{
+	DecimalConversionStats::FRegistry& Registry = DecimalConversionStats::GetRegistry();
+	FScopeLock ScopeLock(&Registry.Lock);
+	const DecimalConversionStats::FTable Now = Registry.Sum();
+	for (int32 Index = 0; Index < DecimalConversionStats::NumEntries; ++Index)
+	{
+		Registry.LastFrame.Entries[Index] = Now.Delta(Registry.FrameMark, Index);
+	}
+	Registry.FrameMark = Now;
+}
+
+FDecimalConversionCounter FDecimalConversionStats::GetLastFrame(EDecimalConversion Entry)
+{
+	DecimalConversionStats::FRegistry& Registry = DecimalConversionStats::GetRegistry();
+	FScopeLock ScopeLock(&Registry.Lock);
+	return Registry.LastFrame.Entries[static_cast<int32>(Entry)];
+}
+
+FDecimalConversionCounter FDecimalConversionStats::GetTotal(EDecimalConversion Entry)
+{
+	DecimalConversionStats::FRegistry& Registry = DecimalConversionStats::GetRegistry();
+	FScopeLock ScopeLock(&Registry.Lock);
+	return Registry.Sum().Delta(Registry.ResetMark, static_cast<int32>(Entry));
+}
+
+void FDecimalConversionStats::Reset()
+{
+	DecimalConversionStats::FRegistry& Registry = DecimalConversionStats::GetRegistry();
+	FScopeLock ScopeLock(&Registry.Lock);
+	Registry.ResetMark = Registry.Sum();
+}
+#else
+FDecimalConversionStats::FScope::FScope(EDecimalConversion Entry)
+	: bOutermost(false)
+{
+}
+
+FDecimalConversionStats::FScope::~FScope()
+{
+}
+
+void FDecimalConversionStats::AddAllocation(SIZE_T Bytes)
+{
+}
+
+void FDecimalConversionStats::EndFrame()
+{
+}
+
+FDecimalConversionCounter FDecimalConversionStats::GetLastFrame(EDecimalConversion Entry)
+{
+	return FDecimalConversionCounter();
+}
+
+FDecimalConversionCounter FDecimalConversionStats::GetTotal(EDecimalConversion Entry)
+{
+	return FDecimalConversionCounter();
+}
+
+void FDecimalConversionStats::Reset()
+{
+}
+#endif
+
+const TCHAR* FDecimalConversionStats::GetName(EDecimalConversion Entry)
+{
+	switch (Entry)
+	{
+	case EDecimalConversion::FromFloat:			return TEXT("FromFloat");
+	case EDecimalConversion::FromString:		return TEXT("FromString");
+	case EDecimalConversion::ToString:			return TEXT("ToString");
+	case EDecimalConversion::ToDouble:			return TEXT("ToDouble");
+	case EDecimalConversion::VectorToString:	return TEXT("VectorToString");
+	case EDecimalConversion::VectorFromString:	return TEXT("VectorFromString");
+	case EDecimalConversion::VectorSerialize:	return TEXT("VectorSerialize");
+	default:									return TEXT("Unknown");
+	}
+}
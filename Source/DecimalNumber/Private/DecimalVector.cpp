@@ -4,6 +4,8 @@
 #include "DecimalVector.h"
 
 #include "DecimalMath.h"
+#include "DecimalStats.h"
+#include "DecimalKMeans.h"
 
 const FDecimalVector FDecimalVector::ZeroVector		= FDecimalVector(0);
 const FDecimalVector FDecimalVector::OneVector		= FDecimalVector(1);
@@ -160,33 +162,23 @@ FDecimalVector FDecimalVector::operator/=(const FDecimalVector& V)
 FDecimal& FDecimalVector::operator[](int32 Index)
 {
 	checkSlow(Index >= 0 && Index < 3);
-	
-PRAGMA_DISABLE_DEPRECATION_WARNINGS
-		return XYZ[Index];
-PRAGMA_ENABLE_DEPRECATION_WARNINGS
+	return Component(Index);
 }
 
 FDecimal FDecimalVector::operator[](int32 Index) const
 {
 	checkSlow(Index >= 0 && Index < 3);
-
-PRAGMA_DISABLE_DEPRECATION_WARNINGS
-		return XYZ[Index];
-PRAGMA_ENABLE_DEPRECATION_WARNINGS
+	return Component(Index);
 }
 
 FDecimal& FDecimalVector::Component(int32 Index)
 {
-PRAGMA_DISABLE_DEPRECATION_WARNINGS
-		return XYZ[Index];
-PRAGMA_ENABLE_DEPRECATION_WARNINGS
+	return (Index == 0) ? X : (Index == 1) ? Y : Z;
 }
 
 FDecimal FDecimalVector::Component(int32 Index) const
 {
-PRAGMA_DISABLE_DEPRECATION_WARNINGS
-		return XYZ[Index];
-PRAGMA_ENABLE_DEPRECATION_WARNINGS
+	return (Index == 0) ? X : (Index == 1) ? Y : Z;
 }
 
 FDecimal FDecimalVector::GetComponentForAxis(EAxis::Type Axis) const
@@ -295,9 +287,9 @@ FDecimal FDecimalVector::SizeSquared2D() const
 bool FDecimalVector::IsNearlyZero(const FDecimal& Tolerance) const
 {
 	return
-		FDecimalMath::Abs(X) <= Tolerance
-		&& FDecimalMath::Abs(Y) <= Tolerance
-		&& FDecimalMath::Abs(Z) <= Tolerance;
+		X.CompareAbs(Tolerance) <= 0
+		&& Y.CompareAbs(Tolerance) <= 0
+		&& Z.CompareAbs(Tolerance) <= 0;
 }
 
 bool FDecimalVector::IsZero() const
@@ -317,6 +309,7 @@ bool FDecimalVector::IsNormalized() const
 
 bool FDecimalVector::Normalize(const FDecimal& Tolerance)
 {
+	DECIMAL_SCOPE_COUNTER(Normalize);
 	const FDecimal SquareSum = X * X + Y * Y + Z * Z;
 	if (SquareSum > Tolerance)
 	{
@@ -329,12 +322,14 @@ bool FDecimalVector::Normalize(const FDecimal& Tolerance)
 
 FDecimalVector FDecimalVector::GetUnsafeNormal() const
 {
+	DECIMAL_SCOPE_COUNTER(Normalize);
 	const FDecimal Scale = FDecimalMath::InvSqrt(X * X + Y * Y + Z * Z);
 	return FDecimalVector(X * Scale, Y * Scale, Z * Scale);
 }
 
 FDecimalVector FDecimalVector::GetSafeNormal(const FDecimal& Tolerance, const FDecimalVector& ResultIfZero) const
 {
+	DECIMAL_SCOPE_COUNTER(Normalize);
 	const FDecimal SquareSum = X * X + Y * Y + Z * Z;
 
 	// Not sure if it's safe to add tolerance in there. Might introduce too many errors
@@ -352,6 +347,7 @@ FDecimalVector FDecimalVector::GetSafeNormal(const FDecimal& Tolerance, const FD
 
 FDecimalVector FDecimalVector::GetSafeNormal2D(const FDecimal& Tolerance, const FDecimalVector& ResultIfZero) const
 {
+	DECIMAL_SCOPE_COUNTER(Normalize);
 	const FDecimal SquareSum = X * X + Y * Y;
 
 	// Not sure if it's safe to add tolerance in there. Might introduce too many errors
@@ -421,13 +417,20 @@ FDecimalVector FDecimalVector::Projection() const
 
 FDecimalVector FDecimalVector::GetUnsafeNormal2D() const
 {
+	DECIMAL_SCOPE_COUNTER(Normalize);
 	const FDecimal Scale = FDecimalMath::InvSqrt(X * X + Y * Y);
 	return FDecimalVector(X * Scale, Y * Scale, 0);
 }
 
 FDecimalVector FDecimalVector::GridSnap(const FDecimal& GridSz) const
 {
-	return FDecimalVector(FDecimalMath::GridSnap(X, GridSz), FDecimalMath::GridSnap(Y, GridSz), FDecimalMath::GridSnap(Z, GridSz));
+	if (GridSz == 0)
+	{
+		return *this;
+	}
+
+	const FDecimalDivisor Grid(GridSz);
+	return FDecimalVector(FDecimalMath::GridSnap(X, Grid), FDecimalMath::GridSnap(Y, Grid), FDecimalMath::GridSnap(Z, Grid));
 }
 
 FDecimalVector FDecimalVector::BoundToCube(const FDecimal& Radius) const
@@ -605,7 +608,10 @@ bool FDecimalVector::ContainsNaN() const
 
 FString FDecimalVector::ToString(int32 Precision) const
 {
-	return FString::Printf(TEXT("X=%s Y=%s Z=%s"), *X.ToString(Precision), *Y.ToString(Precision), *Z.ToString(Precision));
+	DECIMAL_CONVERSION_SCOPE(VectorToString);
+	FString Result = FString::Printf(TEXT("X=%s Y=%s Z=%s"), *X.ToString(Precision), *Y.ToString(Precision), *Z.ToString(Precision));
+	DECIMAL_COUNT_ALLOCATION(Result);
+	return Result;
 }
 
 FText FDecimalVector::ToText() const
@@ -620,6 +626,7 @@ FText FDecimalVector::ToText() const
 
 FString FDecimalVector::ToCompactString() const
 {
+	DECIMAL_CONVERSION_SCOPE(VectorToString);
 	if (IsNearlyZero())
 	{
 		return FString::Printf(TEXT("V(0)"));
@@ -651,6 +658,7 @@ FString FDecimalVector::ToCompactString() const
 		bIsEmptyString = false;
 	}
 	ReturnString += FString(TEXT(")"));
+	DECIMAL_COUNT_ALLOCATION(ReturnString);
 	return ReturnString;
 }
 
@@ -708,11 +716,15 @@ FText FDecimalVector::ToCompactText() const
 
 bool FDecimalVector::InitFromString(const FString& InSourceString)
 {
+	DECIMAL_CONVERSION_SCOPE(VectorFromString);
 	X = Y = Z = 0;
 
 	FString TempX, TempY, TempZ;
 	// The initialization is only successful if the X, Y, and Z values can all be parsed from the string
 	bool bSuccessful = FParse::Value(*InSourceString, TEXT("X="), TempX) && FParse::Value(*InSourceString, TEXT("Y="), TempY) && FParse::Value(*InSourceString, TEXT("Z="), TempZ);
+	DECIMAL_COUNT_ALLOCATION(TempX);
+	DECIMAL_COUNT_ALLOCATION(TempY);
+	DECIMAL_COUNT_ALLOCATION(TempZ);
 	if (bSuccessful)
 	{
 		bSuccessful = FDecimal::FromString(TempX, X) && FDecimal::FromString(TempY, Y) && FDecimal::FromString(TempZ, Z);
@@ -723,6 +735,7 @@ bool FDecimalVector::InitFromString(const FString& InSourceString)
 
 bool FDecimalVector::InitFromCompactString(const FString& InSourceString)
 {
+	DECIMAL_CONVERSION_SCOPE(VectorFromString);
 	bool bAxisFound = false;
 
 	X = Y = Z = 0;
@@ -734,6 +747,9 @@ bool FDecimalVector::InitFromCompactString(const FString& InSourceString)
 
 	FString TempX, TempY, TempZ;
 	bool bSuccessful = FParse::Value(*InSourceString, TEXT("X="), TempX) | FParse::Value(*InSourceString, TEXT("Y="), TempY) | FParse::Value(*InSourceString, TEXT("Z="), TempZ);
+	DECIMAL_COUNT_ALLOCATION(TempX);
+	DECIMAL_COUNT_ALLOCATION(TempY);
+	DECIMAL_COUNT_ALLOCATION(TempZ);
 	if (bSuccessful)
 	{
 		bSuccessful = FDecimal::FromString(TempX, X) && FDecimal::FromString(TempY, Y) && FDecimal::FromString(TempZ, Z);
@@ -975,74 +991,30 @@ FDecimal FDecimalVector::EvaluateBezier(const FDecimalVector* ControlPoints, int
 
 FDecimalVector FDecimalVector::RadiansToDegrees(const FDecimalVector& RadVector)
 {
-	return RadVector * (180.f / FDecimal::ConstantPI);
+	return RadVector * FDecimalMath::DegreesPerRadian();
 }
 
 FDecimalVector FDecimalVector::DegreesToRadians(const FDecimalVector& DegVector)
 {
-	return DegVector * (FDecimal::ConstantPI / 180.f);
+	return DegVector * FDecimalMath::RadiansPerDegree();
 }
 
 void FDecimalVector::GenerateClusterCenters(TArray<FDecimalVector>& Clusters, const TArray<FDecimalVector>& Points, int32 NumIterations, int32 NumConnectionsToBeValid)
 {
-	struct FClusterMovedHereToMakeCompile
-	{
-		FDecimalVector ClusterPosAccum;
-		int32 ClusterSize;
-	};
-
 	// Check we have >0 points and clusters
 	if (Points.Num() == 0 || Clusters.Num() == 0)
 	{
 		return;
 	}
 
-	// Temp storage for each cluster that mirrors the order of the passed in Clusters array
-	TArray<FClusterMovedHereToMakeCompile> ClusterData;
-	ClusterData.AddZeroed(Clusters.Num());
-
-	// Then iterate
-	for (int32 ItCount = 0; ItCount < NumIterations; ItCount++)
-	{
-		// Classify each point - find closest cluster center
-		for (int32 i = 0; i < Points.Num(); i++)
-		{
-			const FDecimalVector& Pos = Points[i];
-
-			// Iterate over all clusters to find closes one
-			int32 NearestClusterIndex = INDEX_NONE;
-			FDecimal NearestClusterDistSqr = UE_BIG_NUMBER;
-			for (int32 j = 0; j < Clusters.Num(); j++)
-			{
-				const FDecimal DistSqr = (Pos - Clusters[j]).SizeSquared();
-				if (DistSqr < NearestClusterDistSqr)
-				{
-					NearestClusterDistSqr = DistSqr;
-					NearestClusterIndex = j;
-				}
-			}
-			// Update its info with this point
-			if (NearestClusterIndex != INDEX_NONE)
-			{
-				ClusterData[NearestClusterIndex].ClusterPosAccum += Pos;
-				ClusterData[NearestClusterIndex].ClusterSize++;
-			}
-		}
-
-		// All points classified - update cluster center as average of membership
-		for (int32 i = 0; i < Clusters.Num(); i++)
-		{
-			if (ClusterData[i].ClusterSize > 0)
-			{
-				Clusters[i] = ClusterData[i].ClusterPosAccum / (FDecimal)ClusterData[i].ClusterSize;
-			}
-		}
-	}
+	TArray<int32> Assignments;
+	TArray<int32> ClusterSizes;
+	FDecimalKMeans::Run(Clusters, Points, NumIterations, Assignments, ClusterSizes);
 
 	// so now after we have possible cluster centers we want to remove the ones that are outliers and not part of the main cluster
-	for (int32 i = 0; i < ClusterData.Num(); i++)
+	for (int32 i = ClusterSizes.Num() - 1; i >= 0; i--)
 	{
-		if (ClusterData[i].ClusterSize < NumConnectionsToBeValid)
+		if (ClusterSizes[i] < NumConnectionsToBeValid)
 		{
 			Clusters.RemoveAt(i);
 		}
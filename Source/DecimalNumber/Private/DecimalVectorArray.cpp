@@ -0,0 +1,383 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "DecimalVectorArray.h"
+#include "DecimalBackend.h"
+#include "DecimalStats.h"
+
+/**
+ * Column kernels shared by the batch operations.
+ * Every kernel is a contiguous loop over columns with no per-element dispatch, touching the backend values directly.
+ * The backend arithmetic itself still branches on sign, exponent and normalization.
+ */
+struct FDecimalVectorArray::FColumnKernels
+{
+	typedef DecimalBackend::FValue ValueType;
+
+	/** Out[i] = A[i] + B[i] */
+	static void Add(const FDecimal* A, const FDecimal* B, FDecimal* Out, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Out[Index].GetValue() = A[Index].GetValue() + B[Index].GetValue();
+		}
+	}
+
+	/** Out[i] = A[i] - B[i] */
+	static void Subtract(const FDecimal* A, const FDecimal* B, FDecimal* Out, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Out[Index].GetValue() = A[Index].GetValue() - B[Index].GetValue();
+		}
+	}
+
+	/** Out[i] = A[i] + S */
+	static void AddScalar(const FDecimal* A, const ValueType& S, FDecimal* Out, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Out[Index].GetValue() = A[Index].GetValue() + S;
+		}
+	}
+
+	/** Out[i] = A[i] * S */
+	static void MulScalar(const FDecimal* A, const ValueType& S, FDecimal* Out, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Out[Index].GetValue() = A[Index].GetValue() * S;
+		}
+	}
+
+	/** Out[i] = A[i] / Divisor, see DecimalBackend::DivideBy. */
+	static void DivScalar(const FDecimal* A, const ValueType& Divisor, const ValueType& Reciprocal, FDecimal* Out, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Out[Index].GetValue() = DecimalBackend::DivideBy(A[Index].GetValue(), Divisor, Reciprocal);
+		}
+	}
+
+	/** Out[i] = A[i] * B[i] */
+	static void Mul(const FDecimal* A, const FDecimal* B, FDecimal* Out, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Out[Index].GetValue() = A[Index].GetValue() * B[Index].GetValue();
+		}
+	}
+
+	/** Out[i] += A[i] * B[i] */
+	static void MulAdd(const FDecimal* A, const FDecimal* B, FDecimal* Out, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Out[Index].GetValue() += A[Index].GetValue() * B[Index].GetValue();
+		}
+	}
+
+	/** Out[i] = A[i] * B[i] - C[i] * D[i] */
+	static void MulSub(const FDecimal* A, const FDecimal* B, const FDecimal* C, const FDecimal* D, FDecimal* Out, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Out[Index].GetValue() = A[Index].GetValue() * B[Index].GetValue() - C[Index].GetValue() * D[Index].GetValue();
+		}
+	}
+
+	/** Out[i] += (A[i] - B[i])^2 */
+	static void AddSquaredDelta(const FDecimal* A, const FDecimal* B, FDecimal* Out, int32 Num)
+	{
+		ValueType Delta;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Delta = A[Index].GetValue() - B[Index].GetValue();
+			Out[Index].GetValue() += Delta * Delta;
+		}
+	}
+
+	/** Out[i] += (A[i] - S)^2 */
+	static void AddSquaredDeltaScalar(const FDecimal* A, const ValueType& S, FDecimal* Out, int32 Num)
+	{
+		ValueType Delta;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Delta = A[Index].GetValue() - S;
+			Out[Index].GetValue() += Delta * Delta;
+		}
+	}
+
+	/** Turns squared lengths into normalization scales, lengths below the tolerance get a scale of one. */
+	static void InvSqrtAboveTolerance(FDecimal* InOut, const ValueType& Tolerance, int32 Num)
+	{
+		static const ValueType One(1);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			ValueType& Value = InOut[Index].GetValue();
+			Value = (Value > Tolerance) ? ValueType(One / DecimalBackend::Sqrt(Value)) : One;
+		}
+	}
+
+	/** Min and max reduction over a non-empty column. */
+	static void MinMax(const FDecimal* A, int32 Num, ValueType& OutMin, ValueType& OutMax)
+	{
+		const FDecimal* MinValue = &A[0];
+		const FDecimal* MaxValue = &A[0];
+		for (int32 Index = 1; Index < Num; ++Index)
+		{
+			const FDecimal& Value = A[Index];
+			MinValue = (Value.Compare(*MinValue) < 0) ? &Value : MinValue;
+			MaxValue = (Value.Compare(*MaxValue) > 0) ? &Value : MaxValue;
+		}
+		OutMin = MinValue->GetValue();
+		OutMax = MaxValue->GetValue();
+	}
+
+	/** Out[i] = double(A[i]) */
+	static void ToDouble(const FDecimal* A, double* Out, int32 Stride, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Out[Index * Stride] = DecimalBackend::ToDouble(A[Index].GetValue());
+		}
+	}
+};
+
+FDecimalVectorArray::FDecimalVectorArray()
+{
+}
+
+FDecimalVectorArray::FDecimalVectorArray(int32 InNum)
+{
+	SetNum(InNum);
+}
+
+FDecimalVectorArray::FDecimalVectorArray(TConstArrayView<FDecimalVector> Vectors)
+{
+	FromVectors(Vectors);
+}
+
+FDecimalVectorArray::FDecimalVectorArray(TConstArrayView<FVector> Vectors)
+{
+	FromVectors(Vectors);
+}
+
+void FDecimalVectorArray::SetNum(int32 InNum)
+{
+	X.SetNum(InNum);
+	Y.SetNum(InNum);
+	Z.SetNum(InNum);
+}
+
+void FDecimalVectorArray::Reserve(int32 InNum)
+{
+	X.Reserve(InNum);
+	Y.Reserve(InNum);
+	Z.Reserve(InNum);
+}
+
+void FDecimalVectorArray::Empty(int32 Slack)
+{
+	X.Empty(Slack);
+	Y.Empty(Slack);
+	Z.Empty(Slack);
+}
+
+int32 FDecimalVectorArray::Add(const FDecimalVector& V)
+{
+	Y.Add(V.Y);
+	Z.Add(V.Z);
+	return X.Add(V.X);
+}
+
+FDecimalVector FDecimalVectorArray::Get(int32 Index) const
+{
+	return FDecimalVector(X[Index], Y[Index], Z[Index]);
+}
+
+void FDecimalVectorArray::Set(int32 Index, const FDecimalVector& V)
+{
+	X[Index] = V.X;
+	Y[Index] = V.Y;
+	Z[Index] = V.Z;
+}
+
+void FDecimalVectorArray::FromVectors(TConstArrayView<FDecimalVector> Vectors)
+{
+	SetNum(Vectors.Num());
+	for (int32 Index = 0; Index < Vectors.Num(); ++Index)
+	{
+		X[Index] = Vectors[Index].X;
+		Y[Index] = Vectors[Index].Y;
+		Z[Index] = Vectors[Index].Z;
+	}
+}
+
+void FDecimalVectorArray::FromVectors(TConstArrayView<FVector> Vectors)
+{
+	SetNum(Vectors.Num());
+	for (int32 Index = 0; Index < Vectors.Num(); ++Index)
+	{
+		X[Index] = Vectors[Index].X;
+		Y[Index] = Vectors[Index].Y;
+		Z[Index] = Vectors[Index].Z;
+	}
+}
+
+void FDecimalVectorArray::ToVectors(TArray<FDecimalVector>& OutVectors) const
+{
+	OutVectors.SetNum(Num());
+	for (int32 Index = 0; Index < Num(); ++Index)
+	{
+		OutVectors[Index].Set(X[Index], Y[Index], Z[Index]);
+	}
+}
+
+void FDecimalVectorArray::ToVectors(TArray<FVector>& OutVectors) const
+{
+	OutVectors.SetNumUninitialized(Num());
+	if (Num() == 0)
+	{
+		return;
+	}
+
+	FColumnKernels::ToDouble(X.GetData(), &OutVectors[0].X, 3, Num());
+	FColumnKernels::ToDouble(Y.GetData(), &OutVectors[0].Y, 3, Num());
+	FColumnKernels::ToDouble(Z.GetData(), &OutVectors[0].Z, 3, Num());
+}
+
+void FDecimalVectorArray::Add(const FDecimalVectorArray& A, const FDecimalVectorArray& B, FDecimalVectorArray& OutResult)
+{
+	check(A.Num() == B.Num());
+
+	const int32 Count = A.Num();
+	OutResult.SetNum(Count);
+	FColumnKernels::Add(A.X.GetData(), B.X.GetData(), OutResult.X.GetData(), Count);
+	FColumnKernels::Add(A.Y.GetData(), B.Y.GetData(), OutResult.Y.GetData(), Count);
+	FColumnKernels::Add(A.Z.GetData(), B.Z.GetData(), OutResult.Z.GetData(), Count);
+}
+
+void FDecimalVectorArray::Subtract(const FDecimalVectorArray& A, const FDecimalVectorArray& B, FDecimalVectorArray& OutResult)
+{
+	check(A.Num() == B.Num());
+
+	const int32 Count = A.Num();
+	OutResult.SetNum(Count);
+	FColumnKernels::Subtract(A.X.GetData(), B.X.GetData(), OutResult.X.GetData(), Count);
+	FColumnKernels::Subtract(A.Y.GetData(), B.Y.GetData(), OutResult.Y.GetData(), Count);
+	FColumnKernels::Subtract(A.Z.GetData(), B.Z.GetData(), OutResult.Z.GetData(), Count);
+}
+
+void FDecimalVectorArray::Translate(const FDecimalVector& Offset)
+{
+	const int32 Count = Num();
+	FColumnKernels::AddScalar(X.GetData(), Offset.X.GetValue(), X.GetData(), Count);
+	FColumnKernels::AddScalar(Y.GetData(), Offset.Y.GetValue(), Y.GetData(), Count);
+	FColumnKernels::AddScalar(Z.GetData(), Offset.Z.GetValue(), Z.GetData(), Count);
+}
+
+void FDecimalVectorArray::Scale(const FDecimalVectorArray& A, const FDecimal& Scale, FDecimalVectorArray& OutResult)
+{
+	const int32 Count = A.Num();
+	OutResult.SetNum(Count);
+	FColumnKernels::MulScalar(A.X.GetData(), Scale.GetValue(), OutResult.X.GetData(), Count);
+	FColumnKernels::MulScalar(A.Y.GetData(), Scale.GetValue(), OutResult.Y.GetData(), Count);
+	FColumnKernels::MulScalar(A.Z.GetData(), Scale.GetValue(), OutResult.Z.GetData(), Count);
+}
+
+void FDecimalVectorArray::Scale(const FDecimal& Scale)
+{
+	FDecimalVectorArray::Scale(*this, Scale, *this);
+}
+
+void FDecimalVectorArray::Divide(const FDecimalVectorArray& A, const FDecimalDivisor& Divisor, FDecimalVectorArray& OutResult)
+{
+	const int32 Count = A.Num();
+	OutResult.SetNum(Count);
+	const DecimalBackend::FValue& Value = Divisor.Divisor.GetValue();
+	const DecimalBackend::FValue& Reciprocal = Divisor.Reciprocal.GetValue();
+	FColumnKernels::DivScalar(A.X.GetData(), Value, Reciprocal, OutResult.X.GetData(), Count);
+	FColumnKernels::DivScalar(A.Y.GetData(), Value, Reciprocal, OutResult.Y.GetData(), Count);
+	FColumnKernels::DivScalar(A.Z.GetData(), Value, Reciprocal, OutResult.Z.GetData(), Count);
+}
+
+void FDecimalVectorArray::Divide(const FDecimalDivisor& Divisor)
+{
+	FDecimalVectorArray::Divide(*this, Divisor, *this);
+}
+
+void FDecimalVectorArray::Dot(const FDecimalVectorArray& A, const FDecimalVectorArray& B, TArray<FDecimal>& OutResult)
+{
+	check(A.Num() == B.Num());
+
+	const int32 Count = A.Num();
+	OutResult.SetNum(Count);
+	FColumnKernels::Mul(A.X.GetData(), B.X.GetData(), OutResult.GetData(), Count);
+	FColumnKernels::MulAdd(A.Y.GetData(), B.Y.GetData(), OutResult.GetData(), Count);
+	FColumnKernels::MulAdd(A.Z.GetData(), B.Z.GetData(), OutResult.GetData(), Count);
+}
+
+void FDecimalVectorArray::Cross(const FDecimalVectorArray& A, const FDecimalVectorArray& B, FDecimalVectorArray& OutResult)
+{
+	check(A.Num() == B.Num());
+	check(&OutResult != &A && &OutResult != &B);
+
+	const int32 Count = A.Num();
+	OutResult.SetNum(Count);
+	FColumnKernels::MulSub(A.Y.GetData(), B.Z.GetData(), A.Z.GetData(), B.Y.GetData(), OutResult.X.GetData(), Count);
+	FColumnKernels::MulSub(A.Z.GetData(), B.X.GetData(), A.X.GetData(), B.Z.GetData(), OutResult.Y.GetData(), Count);
+	FColumnKernels::MulSub(A.X.GetData(), B.Y.GetData(), A.Y.GetData(), B.X.GetData(), OutResult.Z.GetData(), Count);
+}
+
+void FDecimalVectorArray::DistSquared(const FDecimalVectorArray& A, const FDecimalVectorArray& B, TArray<FDecimal>& OutResult)
+{
+	check(A.Num() == B.Num());
+
+	const int32 Count = A.Num();
+	OutResult.Reset(Count);
+	OutResult.SetNum(Count);
+	FColumnKernels::AddSquaredDelta(A.X.GetData(), B.X.GetData(), OutResult.GetData(), Count);
+	FColumnKernels::AddSquaredDelta(A.Y.GetData(), B.Y.GetData(), OutResult.GetData(), Count);
+	FColumnKernels::AddSquaredDelta(A.Z.GetData(), B.Z.GetData(), OutResult.GetData(), Count);
+}
+
+void FDecimalVectorArray::DistSquared(const FDecimalVectorArray& A, const FDecimalVector& Point, TArray<FDecimal>& OutResult)
+{
+	const int32 Count = A.Num();
+	OutResult.Reset(Count);
+	OutResult.SetNum(Count);
+	FColumnKernels::AddSquaredDeltaScalar(A.X.GetData(), Point.X.GetValue(), OutResult.GetData(), Count);
+	FColumnKernels::AddSquaredDeltaScalar(A.Y.GetData(), Point.Y.GetValue(), OutResult.GetData(), Count);
+	FColumnKernels::AddSquaredDeltaScalar(A.Z.GetData(), Point.Z.GetValue(), OutResult.GetData(), Count);
+}
+
+void FDecimalVectorArray::Normalize(const FDecimal& Tolerance)
+{
+	DECIMAL_SCOPE_COUNTER(Normalize);
+	const int32 Count = Num();
+
+	TArray<FDecimal> Scales;
+	Scales.SetNum(Count);
+	FColumnKernels::Mul(X.GetData(), X.GetData(), Scales.GetData(), Count);
+	FColumnKernels::MulAdd(Y.GetData(), Y.GetData(), Scales.GetData(), Count);
+	FColumnKernels::MulAdd(Z.GetData(), Z.GetData(), Scales.GetData(), Count);
+	FColumnKernels::InvSqrtAboveTolerance(Scales.GetData(), Tolerance.GetValue(), Count);
+
+	FColumnKernels::Mul(X.GetData(), Scales.GetData(), X.GetData(), Count);
+	FColumnKernels::Mul(Y.GetData(), Scales.GetData(), Y.GetData(), Count);
+	FColumnKernels::Mul(Z.GetData(), Scales.GetData(), Z.GetData(), Count);
+}
+
+bool FDecimalVectorArray::GetBounds(FDecimalVector& OutMin, FDecimalVector& OutMax) const
+{
+	if (IsEmpty())
+	{
+		return false;
+	}
+
+	FColumnKernels::MinMax(X.GetData(), Num(), OutMin.X.GetValue(), OutMax.X.GetValue());
+	FColumnKernels::MinMax(Y.GetData(), Num(), OutMin.Y.GetValue(), OutMax.Y.GetValue());
+	FColumnKernels::MinMax(Z.GetData(), Num(), OutMin.Z.GetValue(), OutMax.Z.GetValue());
+	return true;
+}
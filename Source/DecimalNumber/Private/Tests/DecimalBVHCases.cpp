@@ -0,0 +1,177 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "DecimalBVH.h"
+
+namespace DecimalTestCases
+{
+	static bool CheckQueryBox(FContext& Context, const TCHAR* Stage, const FDecimalBVH& BVH, const TArray<FDecimalBox>& Boxes, const FDecimalBox& QueryBox)
+	{
+		TArray<int32> Found;
+		TArray<int32> Expected;
+		BVH.QueryBox(QueryBox, Found);
+		for (int32 Index = 0; Index < Boxes.Num(); ++Index)
+		{
+			if (Boxes[Index].Intersect(QueryBox))
+			{
+				Expected.Add(Index);
+			}
+		}
+		if (Found != Expected)
+		{
+			Context.AddError(FString::Printf(TEXT("%s: QueryBox found %d boxes, brute force %d"), Stage, Found.Num(), Expected.Num()));
+			return false;
+		}
+		return true;
+	}
+
+	static bool CheckQuerySphere(FContext& Context, const TCHAR* Stage, const FDecimalBVH& BVH, const TArray<FDecimalBox>& Boxes, const FDecimalVector& Center, const FDecimal& Radius)
+	{
+		TArray<int32> Found;
+		TArray<int32> Expected;
+		BVH.QuerySphere(Center, Radius, Found);
+		for (int32 Index = 0; Index < Boxes.Num(); ++Index)
+		{
+			if (Boxes[Index].IntersectSphere(Center, Radius))
+			{
+				Expected.Add(Index);
+			}
+		}
+		if (Found != Expected)
+		{
+			Context.AddError(FString::Printf(TEXT("%s: QuerySphere found %d boxes, brute force %d"), Stage, Found.Num(), Expected.Num()));
+			return false;
+		}
+		return true;
+	}
+
+	static bool CheckRayCast(FContext& Context, const TCHAR* Stage, const FDecimalBVH& BVH, const TArray<FDecimalBox>& Boxes, const FDecimalVector& RayOrigin, const FDecimalVector& Direction, const FDecimal& MaxTime)
+	{
+		int32 HitIndex = INDEX_NONE;
+		FDecimal HitTime;
+		const bool bHit = BVH.RayCast(RayOrigin, Direction, MaxTime, HitIndex, HitTime);
+		int32 ExpectedIndex = INDEX_NONE;
+		FDecimal ExpectedTime;
+		for (int32 Index = 0; Index < Boxes.Num(); ++Index)
+		{
+			FDecimal Time;
+			if (Boxes[Index].IntersectRay(RayOrigin, Direction, MaxTime, Time) && (ExpectedIndex == INDEX_NONE || Time < ExpectedTime))
+			{
+				ExpectedIndex = Index;
+				ExpectedTime = Time;
+			}
+		}
+		if (bHit != (ExpectedIndex != INDEX_NONE) || (bHit && (HitIndex != ExpectedIndex || HitTime != ExpectedTime)))
+		{
+			Context.AddError(FString::Printf(TEXT("%s: RayCast hit box %d at %s, brute force box %d at %s"), Stage,
+				bHit ? HitIndex : INDEX_NONE, bHit ? *HitTime.ToString(20) : TEXT("-"), ExpectedIndex, ExpectedIndex != INDEX_NONE ? *ExpectedTime.ToString(20) : TEXT("-")));
+			return false;
+		}
+		return true;
+	}
+
+	/** Compare box, sphere and ray queries on the tree against the exact FDecimalBox tests on every box. */
+	static void CheckBVHQueries(FContext& Context, const TCHAR* Stage, const FDecimalBVH& BVH, const TArray<FDecimalBox>& Boxes, FRandomStream& Random, const FDecimalVector& Origin)
+	{
+		const FDecimal Tenth(FString(TEXT("0.1")));
+		const auto MakePoint = [&Random, &Origin, &Tenth](int32 Extent)
+		{
+			return Origin + FDecimalVector(FDecimal(Random.RandRange(-Extent, Extent)), FDecimal(Random.RandRange(-Extent, Extent)), FDecimal(Random.RandRange(-Extent, Extent))) * Tenth;
+		};
+
+		// Query shapes on the same lattice as the boxes, so many of them only touch. Axis-aligned rays graze faces and
+		// edges, the others cross the set at small integer slopes.
+		for (int32 Query = 0; Query < 100; ++Query)
+		{
+			const FDecimalVector Corner = MakePoint(2000);
+			const FDecimalVector Size = FDecimalVector(FDecimal(Random.RandRange(0, 100)), FDecimal(Random.RandRange(0, 100)), FDecimal(Random.RandRange(0, 100))) * Tenth;
+			const FDecimalVector Center = MakePoint(2000);
+			const FDecimal Radius = FDecimal(Random.RandRange(0, 100)) * Tenth;
+			const FDecimalVector RayOrigin = MakePoint(2500);
+			const int32 Slope = Query % 2 == 0 ? 1 : 3;
+			const FDecimalVector Direction(FDecimal(Random.RandRange(-Slope, Slope)), FDecimal(Random.RandRange(-Slope, Slope)), FDecimal(Random.RandRange(-Slope, Slope)));
+			const FDecimal MaxTime = FDecimal(Random.RandRange(0, 1000));
+			if (!CheckQueryBox(Context, Stage, BVH, Boxes, FDecimalBox(Corner, Corner + Size))
+				|| !CheckQuerySphere(Context, Stage, BVH, Boxes, Center, Radius)
+				|| !CheckRayCast(Context, Stage, BVH, Boxes, RayOrigin, Direction, MaxTime))
+			{
+				return;
+			}
+		}
+
+		// Queries that miss a box, touch it or reach into it by less than the shadows of the coordinates resolve.
+		const FDecimal Tiny(FString(TEXT("0.000000000000001")));
+		const FDecimal Half = FDecimal(1) / FDecimal(2);
+		for (int32 Query = 0; Query < 200; ++Query)
+		{
+			const FDecimalBox& Box = Boxes[Random.RandRange(0, Boxes.Num() - 1)];
+			if (!Box.IsValid)
+			{
+				continue;
+			}
+			const FDecimal Gap = Tiny * FDecimal(Random.RandRange(-1, 1));
+			const FDecimal Radius = FDecimal(Random.RandRange(1, 50)) * Tenth;
+			const FDecimal MidY = (Box.Min.Y + Box.Max.Y) * Half;
+			const FDecimal MidZ = (Box.Min.Z + Box.Max.Z) * Half;
+
+			const FDecimalVector QueryMin(Box.Max.X + Gap, Box.Min.Y, Box.Min.Z);
+			const FDecimalVector Center(Box.Max.X + Radius + Gap, MidY, MidZ);
+			const FDecimalVector RayOrigin(Box.Max.X + Radius, Box.Max.Y + Gap, MidZ);
+			if (!CheckQueryBox(Context, Stage, BVH, Boxes, FDecimalBox(QueryMin, QueryMin + FDecimalVector(Radius, Radius, Radius)))
+				|| !CheckQuerySphere(Context, Stage, BVH, Boxes, Center, Radius)
+				|| !CheckRayCast(Context, Stage, BVH, Boxes, RayOrigin, -FDecimalVector::XAxisVector, Radius + Gap))
+			{
+				return;
+			}
+		}
+	}
+
+	void RunBVH(FContext& Context)
+	{
+		// Boxes on a lattice of tenths far from the origin, duplicates and invalid boxes among them.
+		FRandomStream Random(48);
+		const FDecimalVector Origin(FDecimal(FString(TEXT("-5555555555.5"))), FDecimal(FString(TEXT("123456789.000000001"))), FDecimal(42));
+		const FDecimal Tenth(FString(TEXT("0.1")));
+		const auto MakeBox = [&Random, &Origin, &Tenth]()
+		{
+			const FDecimalVector Min = Origin + FDecimalVector(FDecimal(Random.RandRange(-2000, 2000)), FDecimal(Random.RandRange(-2000, 2000)), FDecimal(Random.RandRange(-2000, 2000))) * Tenth;
+			return FDecimalBox(Min, Min + FDecimalVector(FDecimal(Random.RandRange(0, 50)), FDecimal(Random.RandRange(0, 50)), FDecimal(Random.RandRange(0, 50))) * Tenth);
+		};
+
+		TArray<FDecimalBox> Boxes;
+		for (int32 Index = 0; Index < 3000; ++Index)
+		{
+			switch (Random.RandRange(0, 40))
+			{
+			case 0: Boxes.Add(FDecimalBox()); break;
+			case 1: Boxes.Add(Boxes.Num() > 0 ? Boxes[Boxes.Num() - 1] : MakeBox()); break;
+			default: Boxes.Add(MakeBox()); break;
+			}
+		}
+
+		FDecimalBVH BVH;
+		BVH.Build(Boxes);
+		Context.Check(BVH.Num() == Boxes.Num(), TEXT("Build stores every box"));
+		CheckBVHQueries(Context, TEXT("After Build"), BVH, Boxes, Random, Origin);
+
+		// Small moves keep the tree tight, the far ones stretch it across the whole set.
+		for (int32 Index = 0; Index < Boxes.Num(); ++Index)
+		{
+			if (Boxes[Index].IsValid)
+			{
+				const int32 Step = Index % 10 == 0 ? 3000 : 5;
+				const FDecimalVector Delta = FDecimalVector(FDecimal(Random.RandRange(-Step, Step)), FDecimal(Random.RandRange(-Step, Step)), FDecimal(0)) * Tenth;
+				Boxes[Index] = FDecimalBox(Boxes[Index].Min + Delta, Boxes[Index].Max + Delta);
+			}
+		}
+		BVH.Refit(Boxes);
+		CheckBVHQueries(Context, TEXT("After Refit"), BVH, Boxes, Random, Origin);
+
+		BVH.Build(TConstArrayView<FDecimalBox>());
+		TArray<int32> Found;
+		BVH.QuerySphere(Origin, FDecimal(1000000), Found);
+		int32 HitIndex;
+		FDecimal HitTime;
+		Context.Check(BVH.Num() == 0 && Found.Num() == 0 && !BVH.RayCast(Origin, FDecimalVector::XAxisVector, FDecimal(1000000), HitIndex, HitTime), TEXT("An empty tree finds nothing"));
+	}
+}
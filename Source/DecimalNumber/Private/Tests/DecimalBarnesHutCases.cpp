@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "DecimalBarnesHut.h"
+#include "DecimalMath.h"
+#include "DecimalShadow.h"
+
+namespace DecimalTestCases
+{
+	/**
+	 * Direct summation over every pair in FDecimal. Also returns, per body, the sum of the magnitudes of the
+	 * accelerations and potentials it adds up, the scale of the rounding error of any double evaluation.
+	 */
+	static void SumDirect(TConstArrayView<FDecimalVector> Positions, TConstArrayView<int32> Masses, const FDecimal& GravitationalConstant, const FDecimal& Softening,
+		TArray<FVector>& OutAccelerations, TArray<double>& OutPotentials, TArray<double>& OutScales)
+	{
+		OutAccelerations.SetNum(Positions.Num());
+		OutPotentials.SetNum(Positions.Num());
+		OutScales.SetNum(Positions.Num());
+		for (int32 Body = 0; Body < Positions.Num(); ++Body)
+		{
+			FDecimalVector Acceleration = FDecimalVector::ZeroVector;
+			FDecimal Potential(0);
+			FDecimal Scale(0);
+			for (int32 Other = 0; Other < Positions.Num(); ++Other)
+			{
+				if (Other == Body)
+				{
+					continue;
+				}
+				const FDecimalVector Delta = Positions[Other] - Positions[Body];
+				const FDecimal InvDistance = FDecimalMath::InvSqrt(Delta.SizeSquared() + Softening * Softening);
+				const FDecimal Pull = GravitationalConstant * FDecimal(Masses[Other]) * InvDistance;
+				Acceleration += Delta * (Pull * InvDistance * InvDistance);
+				Potential -= Pull;
+				Scale += Pull * InvDistance;
+			}
+			OutAccelerations[Body] = FVector(FDecimalShadowed::MakeShadow(Acceleration.X), FDecimalShadowed::MakeShadow(Acceleration.Y), FDecimalShadowed::MakeShadow(Acceleration.Z));
+			OutPotentials[Body] = FDecimalShadowed::MakeShadow(Potential);
+			OutScales[Body] = FDecimalShadowed::MakeShadow(Scale);
+		}
+	}
+
+	static void CheckBarnesHut(FContext& Context, const TCHAR* What, TConstArrayView<FDecimalVector> Positions, TConstArrayView<int32> Masses, double GravitationalConstant, double Softening)
+	{
+		TArray<double> Masses64;
+		for (const int32 Mass : Masses)
+		{
+			Masses64.Add(Mass);
+		}
+		FDecimalBarnesHut Solver;
+		Solver.Theta = 0.0;
+		Solver.GravitationalConstant = GravitationalConstant;
+		Solver.Softening = Softening;
+		Solver.Build(Positions, Masses64);
+
+		TArray<FVector> Accelerations;
+		TArray<double> Potentials;
+		Accelerations.SetNum(Positions.Num());
+		Potentials.SetNum(Positions.Num());
+		Solver.ComputeAccelerations(Accelerations, Potentials);
+
+		TArray<FVector> ExpectedAccelerations;
+		TArray<double> ExpectedPotentials;
+		TArray<double> Scales;
+		const FDecimal ExactConstant(FString::Printf(TEXT("%.17g"), GravitationalConstant));
+		const FDecimal ExactSoftening(FString::Printf(TEXT("%.17g"), Softening));
+		SumDirect(Positions, Masses, ExactConstant, ExactSoftening, ExpectedAccelerations, ExpectedPotentials, Scales);
+
+		// Far better than doubles relative to one origin could do: the bodies are 1e15 from it and 1e-3 apart.
+		const double Tolerance = 1e-12;
+		for (int32 Body = 0; Body < Positions.Num(); ++Body)
+		{
+			const double Error = (Accelerations[Body] - ExpectedAccelerations[Body]).Size();
+			const double PotentialError = FMath::Abs(Potentials[Body] - ExpectedPotentials[Body]);
+			if (!(Error <= Tolerance * Scales[Body]) || !(PotentialError <= Tolerance * FMath::Abs(ExpectedPotentials[Body])))
+			{
+				Context.AddError(FString::Printf(TEXT("%s: body %d is off by %g in acceleration and %g in potential, for a scale of %g"), What, Body, Error, PotentialError, Scales[Body]));
+				return;
+			}
+		}
+	}
+
+	void RunBarnesHut(FContext& Context)
+	{
+		// Clumps of bodies a long way from the origin, some close enough to share the finest cells.
+		FRandomStream Random(49);
+		const FDecimalVector Origin(FDecimal(FString(TEXT("1000000000000000.5"))), FDecimal(FString(TEXT("-300000000000000"))), FDecimal(7));
+		const FDecimal Milli(FString(TEXT("0.001")));
+		TArray<FDecimalVector> Positions;
+		TArray<int32> Masses;
+		for (int32 Clump = 0; Clump < 4; ++Clump)
+		{
+			const FDecimalVector Center = Origin + FDecimalVector(FDecimal(Random.RandRange(-100, 100)), FDecimal(Random.RandRange(-100, 100)), FDecimal(Random.RandRange(-100, 100)));
+			const int32 Extent = Clump == 0 ? 3 : 5000;
+			for (int32 Index = 0; Index < 60; ++Index)
+			{
+				Positions.Add(Center + FDecimalVector(FDecimal(Random.RandRange(-Extent, Extent)), FDecimal(Random.RandRange(-Extent, Extent)), FDecimal(Random.RandRange(-Extent, Extent))) * Milli);
+				Masses.Add(Random.RandRange(1, 100));
+			}
+		}
+
+		// Softening keeps bodies sharing a position finite, the unsoftened run drops the duplicates.
+		CheckBarnesHut(Context, TEXT("Softened"), Positions, Masses, 0.5, 0.25);
+		TArray<FDecimalVector> Distinct;
+		TArray<int32> DistinctMasses;
+		for (int32 Index = 0; Index < Positions.Num(); ++Index)
+		{
+			if (!Distinct.Contains(Positions[Index]))
+			{
+				Distinct.Add(Positions[Index]);
+				DistinctMasses.Add(Masses[Index]);
+			}
+		}
+		CheckBarnesHut(Context, TEXT("Unsoftened"), Distinct, DistinctMasses, 1.0, 0.0);
+	}
+}
@@ -0,0 +1,213 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalDeterminism.h"
+#include "DecimalMath.h"
+#include "DecimalSort.h"
+#include "DecimalVector.h"
+
+namespace DecimalDeterminism
+{
+	struct FReference
+	{
+		const TCHAR* Name;
+		uint64 Hash;
+	};
+
+	/**
+	 * Recorded for every backend on Linux x86-64 by Benchmarks/DeterminismTest --print, configured with the matching
+	 * DECIMALNUMBER_BACKEND.
+	 * Every number is hashed through its sort key, which is the exact value, so any platform difference in a single
+	 * limb changes the hash.
+	 */
+	static const FReference References[] =
+	{
+#if DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_DEC_FLOAT
+		{ TEXT("Pi"), 0x9adfbd3f5c929dcaull },
+		{ TEXT("Add"), 0xf652ad5da73f76dbull },
+		{ TEXT("Subtract"), 0x8979e4c78f49eb1aull },
+		{ TEXT("Multiply"), 0x3fdffea576ef9751ull },
+		{ TEXT("Divide"), 0xf7a694bc6b50da9dull },
+		{ TEXT("Negate"), 0x89ec4bf173ea06ecull },
+		{ TEXT("Floor"), 0x324491c851d22288ull },
+		{ TEXT("Ceil"), 0xe35da32e39a2f474ull },
+		{ TEXT("Sqrt"), 0x607a49101c4ef550ull },
+		{ TEXT("InvSqrt"), 0x0406a473dee357ffull },
+		{ TEXT("Sin"), 0x9eb61aed3bb76b6eull },
+		{ TEXT("Cos"), 0xf78cf97d1afb38f5ull },
+		{ TEXT("Acos"), 0x353a28ed03d7c8a4ull },
+		{ TEXT("Atan"), 0x50868b0b27495345ull },
+		{ TEXT("Atan2"), 0x391b92079871467eull },
+		{ TEXT("PowerInt"), 0x5d0d812c13b0bdceull },
+		{ TEXT("PowerDecimal"), 0x1fc9b16c5cec7b77ull },
+		{ TEXT("SinCos"), 0x3515cf0599aa0d75ull },
+		{ TEXT("VectorSize"), 0xa85287cf22bf8526ull },
+		{ TEXT("VectorDot"), 0xabfac4123138062cull },
+		{ TEXT("VectorCross"), 0x4326750770bfe98aull },
+		{ TEXT("VectorSafeNormal"), 0xccfe9fa22c240a57ull },
+		{ TEXT("VectorUnsafeNormal"), 0x445c4d8ebc5b20f7ull },
+		{ TEXT("BatchSumSerial"), 0x308dc4bd34b488eeull },
+		{ TEXT("BatchSumParallel"), 0x308dc4bd34b488eeull },
+#elif DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_BIN_FLOAT
+		{ TEXT("Pi"), 0x1c11749a38391401ull },
+		{ TEXT("Add"), 0xd07c807be2b95664ull },
+		{ TEXT("Subtract"), 0x2883a8785ea28cf3ull },
+		{ TEXT("Multiply"), 0xd0ca0e7ab06708f0ull },
+		{ TEXT("Divide"), 0xc254ae4a702b78b5ull },
+		{ TEXT("Negate"), 0x984053d399b1b2efull },
+		{ TEXT("Floor"), 0xf09546d4c63e4e0dull },
+		{ TEXT("Ceil"), 0x52e4837c7b2f5478ull },
+		{ TEXT("Sqrt"), 0x20199efc88b1ac88ull },
+		{ TEXT("InvSqrt"), 0x56e0787115f7720aull },
+		{ TEXT("Sin"), 0x9661a4718e0c5024ull },
+		{ TEXT("Cos"), 0xaf1126475130e181ull },
+		{ TEXT("Acos"), 0x18cfbddaf8e30b7aull },
+		{ TEXT("Atan"), 0xb271a5561b019b3dull },
+		{ TEXT("Atan2"), 0xd4925e303d28cf22ull },
+		{ TEXT("PowerInt"), 0xe5b36a6bed09cef6ull },
+		{ TEXT("PowerDecimal"), 0xd13970e8aa85f13bull },
+		{ TEXT("SinCos"), 0x1d8bc55bd0ffdddeull },
+		{ TEXT("VectorSize"), 0x863f89d8d6a254ceull },
+		{ TEXT("VectorDot"), 0x068b1354a589f5d6ull },
+		{ TEXT("VectorCross"), 0x7a5f02c03165b498ull },
+		{ TEXT("VectorSafeNormal"), 0x58c772adb73d949eull },
+		{ TEXT("VectorUnsafeNormal"), 0xc548fe3d7d1140baull },
+		{ TEXT("BatchSumSerial"), 0x8e86556e26f0b308ull },
+		{ TEXT("BatchSumParallel"), 0x8e86556e26f0b308ull },
+#elif DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_FIXED128
+		{ TEXT("Pi"), 0xf323528b6ca5ece3ull },
+		{ TEXT("Add"), 0x12816da00bb06b6full },
+		{ TEXT("Subtract"), 0x4bc5d8c41d01ca39ull },
+		{ TEXT("Multiply"), 0xfc5d5caa6cd43066ull },
+		{ TEXT("Divide"), 0x9c116fb37d51aa26ull },
+		{ TEXT("Negate"), 0xc4f783d371af3778ull },
+		{ TEXT("Floor"), 0xe9705575bfc86cd1ull },
+		{ TEXT("Ceil"), 0xfabc0a0a22cc4a03ull },
+		{ TEXT("Sqrt"), 0x5b78fed4daf49c42ull },
+		{ TEXT("InvSqrt"), 0x9ec78f09a5ac85d7ull },
+		{ TEXT("Sin"), 0x59e5d418211c2e31ull },
+		{ TEXT("Cos"), 0xc4f25c2d9e0c75a4ull },
+		{ TEXT("Acos"), 0x6453f3e30aeeff40ull },
+		{ TEXT("Atan"), 0x17a294f504945dd6ull },
+		{ TEXT("Atan2"), 0xa12513945fad87e5ull },
+		{ TEXT("PowerInt"), 0x5c70e2969909399dull },
+		{ TEXT("PowerDecimal"), 0x4ac1cb190f3fed78ull },
+		{ TEXT("SinCos"), 0x5d35dd1ad9d408f0ull },
+		{ TEXT("VectorSize"), 0xb77122f575d5f247ull },
+		{ TEXT("VectorDot"), 0xd1efeb0ab348b3d3ull },
+		{ TEXT("VectorCross"), 0x32115e261920845aull },
+		{ TEXT("VectorSafeNormal"), 0x1e474a555ffff1eaull },
+		{ TEXT("VectorUnsafeNormal"), 0x325d913d90b8afe2ull },
+		{ TEXT("BatchSumSerial"), 0x0ac8827cd4939e35ull },
+		{ TEXT("BatchSumParallel"), 0x0ac8827cd4939e35ull },
+#else
+		{ nullptr, 0 },
+#endif
+	};
+
+	static uint64 HashBytes(uint64 Hash, const uint8* Bytes, int32 Num)
+	{
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Hash = (Hash ^ Bytes[Index]) * 0x100000001b3ull;
+		}
+		return Hash;
+	}
+
+	static uint64 FindReference(const FString& Name)
+	{
+		for (const FReference& Reference : References)
+		{
+			if (Reference.Name != nullptr && Name == Reference.Name)
+			{
+				return Reference.Hash;
+			}
+		}
+		return 0;
+	}
+
+	static void AddResult(TArray<FResult>& OutResults, const TCHAR* Name, std::initializer_list<FDecimal> Numbers)
+	{
+		FResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Name = Name;
+		Result.Hash = 0xcbf29ce484222325ull;
+		for (const FDecimal& Number : Numbers)
+		{
+			const FDecimalSortKey Key(Number);
+			Result.Hash = HashBytes(Result.Hash, Key.Bytes, FDecimalSortKey::NumBytes);
+			if (!Result.Value.IsEmpty())
+			{
+				Result.Value += TEXT(" ");
+			}
+			Result.Value += Number.ToString(40);
+		}
+		Result.ReferenceHash = FindReference(Result.Name);
+	}
+
+	static void AddResult(TArray<FResult>& OutResults, const TCHAR* Name, const FDecimalVector& Vector)
+	{
+		AddResult(OutResults, Name, { Vector.X, Vector.Y, Vector.Z });
+	}
+
+	bool HasReference()
+	{
+		return References[0].Name != nullptr;
+	}
+
+	void Evaluate(TArray<FResult>& OutResults)
+	{
+		OutResults.Reset();
+
+		// Inputs come from strings and integers only, never from float or double.
+		const FDecimal Third = FDecimal(1) / FDecimal(3);
+		const FDecimal A(FString(TEXT("2.5")));
+		const FDecimal B(FString(TEXT("-7.25")));
+		const FDecimal C(FString(TEXT("1234567.890123456789012345678901234567")));
+		const FDecimal Small(FString(TEXT("0.000000000123456789")));
+		const FDecimal Half = FDecimal(1) / FDecimal(2);
+
+		AddResult(OutResults, TEXT("Pi"), { FDecimal::ConstantPI });
+		AddResult(OutResults, TEXT("Add"), { C + Third, B + Small });
+		AddResult(OutResults, TEXT("Subtract"), { Third - C, Small - B });
+		AddResult(OutResults, TEXT("Multiply"), { C * Third, B * Small, C * C });
+		AddResult(OutResults, TEXT("Divide"), { C / B, Small / Third, FDecimal(22) / FDecimal(7) });
+		AddResult(OutResults, TEXT("Negate"), { -C, -Third });
+		AddResult(OutResults, TEXT("Floor"), { FDecimalMath::Floor(B), FDecimalMath::Floor(C) });
+		AddResult(OutResults, TEXT("Ceil"), { FDecimalMath::Ceil(B), FDecimalMath::Ceil(C) });
+		AddResult(OutResults, TEXT("Sqrt"), { FDecimalMath::Sqrt(FDecimal(2)), FDecimalMath::Sqrt(C), FDecimalMath::Sqrt(Small) });
+		AddResult(OutResults, TEXT("InvSqrt"), { FDecimalMath::InvSqrt(FDecimal(3)), FDecimalMath::InvSqrt(C) });
+		AddResult(OutResults, TEXT("Sin"), { FDecimalMath::Sin(Third), FDecimalMath::Sin(A), FDecimalMath::Sin(C) });
+		AddResult(OutResults, TEXT("Cos"), { FDecimalMath::Cos(Third), FDecimalMath::Cos(B), FDecimalMath::Cos(C) });
+		AddResult(OutResults, TEXT("Acos"), { FDecimalMath::Acos(Half), FDecimalMath::Acos(-Third) });
+		AddResult(OutResults, TEXT("Atan"), { FDecimalMath::Atan(Third), FDecimalMath::Atan(C) });
+		AddResult(OutResults, TEXT("Atan2"), { FDecimalMath::Atan2(A, B), FDecimalMath::Atan2(B, -Third) });
+		AddResult(OutResults, TEXT("PowerInt"), { FDecimalMath::Power(Third, 7), FDecimalMath::Power(B, 5) });
+		AddResult(OutResults, TEXT("PowerDecimal"), { FDecimalMath::Power(A, Third), FDecimalMath::Power(C, Half) });
+
+		FDecimal SinValue, CosValue;
+		FDecimalMath::SinCos(SinValue, CosValue, A);
+		AddResult(OutResults, TEXT("SinCos"), { SinValue, CosValue });
+
+		const FDecimalVector V(Third, A, B);
+		const FDecimalVector W(C, Small, Half);
+		AddResult(OutResults, TEXT("VectorSize"), { V.Size(), W.Size() });
+		AddResult(OutResults, TEXT("VectorDot"), { V | W });
+		AddResult(OutResults, TEXT("VectorCross"), V ^ W);
+		AddResult(OutResults, TEXT("VectorSafeNormal"), V.GetSafeNormal());
+		AddResult(OutResults, TEXT("VectorUnsafeNormal"), W.GetUnsafeNormal());
+
+		// The batch reductions must not depend on the thread count either.
+		TArray<FDecimal> Values;
+		for (int32 Index = 1; Index <= 10000; ++Index)
+		{
+			Values.Add(FDecimal(Index) / FDecimal(7));
+		}
+		FDecimalMath::Batch::SetMaxTasks(1);
+		const FDecimal SerialSum = FDecimalMath::Batch::Sum(Values);
+		const FDecimal SerialVariance = FDecimalMath::Batch::Variance(Values);
+		FDecimalMath::Batch::SetMaxTasks(0);
+		const FDecimal ParallelSum = FDecimalMath::Batch::Sum(Values);
+		const FDecimal ParallelVariance = FDecimalMath::Batch::Variance(Values);
+		AddResult(OutResults, TEXT("BatchSumSerial"), { SerialSum, SerialVariance });
+		AddResult(OutResults, TEXT("BatchSumParallel"), { ParallelSum, ParallelVariance });
+	}
+}
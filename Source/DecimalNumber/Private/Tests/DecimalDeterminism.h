@@ -0,0 +1,38 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed set of FDecimal math results whose exact bits are compared against reference hashes recorded on the
+ * reference platform, so a client and a server on different platforms can be checked to compute identical numbers.
+ * Run by the DecimalNumber.Determinism automation test and by Benchmarks/DeterminismTest on Linux.
+ */
+namespace DecimalDeterminism
+{
+	struct FResult
+	{
+		/** Case name, stable across versions. */
+		FString Name;
+
+		/** The result printed with 40 decimal places, for diagnostics. */
+		FString Value;
+
+		/** FNV-1a hash of the FDecimalSortKey bytes of every number in the result. */
+		uint64 Hash;
+
+		/** Hash recorded on the reference platform, 0 when there is none. */
+		uint64 ReferenceHash;
+	};
+
+	/**
+	 * Evaluate every case.
+	 *
+	 * @param OutResults Receives one result per case, in a fixed order.
+	 */
+	void Evaluate(TArray<FResult>& OutResults);
+
+	/** @return Whether reference hashes are recorded for the backend this build uses. */
+	bool HasReference();
+}
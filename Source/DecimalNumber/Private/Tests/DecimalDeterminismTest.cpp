@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalDeterminism.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDecimalDeterminismTest, "DecimalNumber.Determinism",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDecimalDeterminismTest::RunTest(const FString& Parameters)
+{
+	TArray<DecimalDeterminism::FResult> Results;
+	DecimalDeterminism::Evaluate(Results);
+
+	const bool bHasReference = DecimalDeterminism::HasReference();
+	if (!bHasReference)
+	{
+		AddWarning(TEXT("No reference hashes for this FDecimal backend, only checking that batch results do not depend on the thread count."));
+	}
+
+	TMap<FString, uint64> HashesByName;
+	for (const DecimalDeterminism::FResult& Result : Results)
+	{
+		HashesByName.Add(Result.Name, Result.Hash);
+		if (bHasReference && Result.Hash != Result.ReferenceHash)
+		{
+			AddError(FString::Printf(TEXT("%s differs from the reference platform: 0x%016llx, expected 0x%016llx (%s)"),
+				*Result.Name, Result.Hash, Result.ReferenceHash, *Result.Value));
+		}
+	}
+
+	TestEqual(TEXT("Batch results with one task and with many"), HashesByName.FindRef(TEXT("BatchSumParallel")), HashesByName.FindRef(TEXT("BatchSumSerial")));
+	return true;
+}
+
+#endif
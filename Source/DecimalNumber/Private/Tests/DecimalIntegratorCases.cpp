@@ -0,0 +1,419 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "DecimalIntegrator.h"
+#include "DecimalMath.h"
+#include "DecimalSort.h"
+
+namespace DecimalTestCases
+{
+	/** Spring to a circling anchor, damping, and a weak pull towards the previous body, so it depends on everything. */
+	static FVector GetIntegratorAcceleration(int32 Index, double Time, TConstArrayView<FVector> Positions, TConstArrayView<FVector> Velocities)
+	{
+		const FVector Anchor(3.0 * FMath::Sin(Time), 3.0 * FMath::Cos(Time), 0.25 * Index);
+		FVector Acceleration = (Anchor - Positions[Index]) * 4.0 - Velocities[Index] * 0.1;
+		if (Index > 0)
+		{
+			Acceleration += (Positions[Index - 1] - Positions[Index]) * 0.01;
+		}
+		return Acceleration;
+	}
+
+	/**
+	 * The integrator written as plain loops over one body at a time, on an array of FDecimalVector, converting each body
+	 * on its own: offsets from Origin rounded once, changes scaled in doubles and added at decimal precision. Only the
+	 * reference for chunking and thread counts, it repeats the schemes, CheckOscillators checks them against physics.
+	 */
+	struct FScalarIntegrator
+	{
+		TArray<FDecimalVector> Positions;
+		TArray<FDecimalVector> Velocities;
+		FDecimalVector Origin = FDecimalVector::ZeroVector;
+		double Time = 0.0;
+
+		TArray<FVector> Accelerations;
+		bool bAccelerationsValid = false;
+
+		static FVector ToRelative(const FDecimalVector& Value, const FDecimalVector& Origin)
+		{
+			FVector Offset;
+			FDecimalMath::Batch::ToRelative(Origin, MakeArrayView(&Value, 1), MakeArrayView(&Offset, 1));
+			return Offset;
+		}
+
+		static void AddRelative(FDecimalVector& Value, const FVector& Offset, double Scale)
+		{
+			FDecimalVectorArray Single;
+			Single.Add(Value);
+			FDecimalMath::Batch::AddRelative(MakeArrayView(&Offset, 1), Scale, Single);
+			Value = Single.Get(0);
+		}
+
+		void GetRelative(TArray<FVector>& OutPositions, TArray<FVector>& OutVelocities) const
+		{
+			OutPositions.SetNum(Positions.Num());
+			OutVelocities.SetNum(Positions.Num());
+			for (int32 Index = 0; Index < Positions.Num(); ++Index)
+			{
+				OutPositions[Index] = ToRelative(Positions[Index], Origin);
+				OutVelocities[Index] = ToRelative(Velocities[Index], FDecimalVector::ZeroVector);
+			}
+		}
+
+		void Evaluate(double EvaluationTime, const TArray<FVector>& StagePositions, const TArray<FVector>& StageVelocities)
+		{
+			Accelerations.SetNum(Positions.Num());
+			for (int32 Index = 0; Index < Positions.Num(); ++Index)
+			{
+				Accelerations[Index] = GetIntegratorAcceleration(Index, EvaluationTime, StagePositions, StageVelocities);
+			}
+		}
+
+		void Step(EDecimalIntegrator Method, double TimeStep, int32 NumSteps)
+		{
+			if (Accelerations.Num() != Positions.Num())
+			{
+				bAccelerationsValid = false;
+			}
+			const double HalfStep = 0.5 * TimeStep;
+			TArray<FVector> StagePositions, StageVelocities;
+			for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+			{
+				switch (Method)
+				{
+				case EDecimalIntegrator::SymplecticEuler:
+					GetRelative(StagePositions, StageVelocities);
+					Evaluate(Time, StagePositions, StageVelocities);
+					for (int32 Index = 0; Index < Positions.Num(); ++Index)
+					{
+						const FVector Velocity = StageVelocities[Index] + Accelerations[Index] * TimeStep;
+						AddRelative(Velocities[Index], Accelerations[Index], TimeStep);
+						AddRelative(Positions[Index], Velocity, TimeStep);
+					}
+					bAccelerationsValid = false;
+					break;
+
+				case EDecimalIntegrator::VelocityVerlet:
+					if (!bAccelerationsValid)
+					{
+						GetRelative(StagePositions, StageVelocities);
+						Evaluate(Time, StagePositions, StageVelocities);
+					}
+					StagePositions.SetNum(Positions.Num());
+					StageVelocities.SetNum(Positions.Num());
+					for (int32 Index = 0; Index < Positions.Num(); ++Index)
+					{
+						AddRelative(Velocities[Index], Accelerations[Index], HalfStep);
+						StageVelocities[Index] = ToRelative(Velocities[Index], FDecimalVector::ZeroVector);
+						AddRelative(Positions[Index], StageVelocities[Index], TimeStep);
+						StagePositions[Index] = ToRelative(Positions[Index], Origin);
+					}
+					Evaluate(Time + TimeStep, StagePositions, StageVelocities);
+					for (int32 Index = 0; Index < Positions.Num(); ++Index)
+					{
+						AddRelative(Velocities[Index], Accelerations[Index], HalfStep);
+					}
+					bAccelerationsValid = true;
+					break;
+
+				case EDecimalIntegrator::RungeKutta4:
+					{
+						TArray<FVector> StartPositions, StartVelocities;
+						GetRelative(StartPositions, StartVelocities);
+						Evaluate(Time, StartPositions, StartVelocities);
+						TArray<FVector> PositionDeltas = StartVelocities;
+						TArray<FVector> VelocityDeltas = Accelerations;
+						StagePositions.SetNum(Positions.Num());
+						StageVelocities.SetNum(Positions.Num());
+						for (int32 Index = 0; Index < Positions.Num(); ++Index)
+						{
+							StagePositions[Index] = StartPositions[Index] + StartVelocities[Index] * HalfStep;
+							StageVelocities[Index] = StartVelocities[Index] + Accelerations[Index] * HalfStep;
+						}
+						for (const double StageStep : { HalfStep, TimeStep })
+						{
+							Evaluate(Time + HalfStep, StagePositions, StageVelocities);
+							for (int32 Index = 0; Index < Positions.Num(); ++Index)
+							{
+								const FVector Velocity = StageVelocities[Index];
+								PositionDeltas[Index] += Velocity * 2.0;
+								VelocityDeltas[Index] += Accelerations[Index] * 2.0;
+								StagePositions[Index] = StartPositions[Index] + Velocity * StageStep;
+								StageVelocities[Index] = StartVelocities[Index] + Accelerations[Index] * StageStep;
+							}
+						}
+						Evaluate(Time + TimeStep, StagePositions, StageVelocities);
+						for (int32 Index = 0; Index < Positions.Num(); ++Index)
+						{
+							AddRelative(Positions[Index], PositionDeltas[Index] + StageVelocities[Index], TimeStep / 6.0);
+							AddRelative(Velocities[Index], VelocityDeltas[Index] + Accelerations[Index], TimeStep / 6.0);
+						}
+						bAccelerationsValid = false;
+					}
+					break;
+				}
+				Time += TimeStep;
+			}
+		}
+	};
+
+	static bool IsSameDecimal(const FDecimal& A, const FDecimal& B)
+	{
+		return FDecimalSortKey(A) == FDecimalSortKey(B);
+	}
+
+	static bool IsSameState(const FDecimalIntegrator& Batch, const FScalarIntegrator& Scalar)
+	{
+		if (Batch.Positions.Num() != Scalar.Positions.Num() || Batch.Time != Scalar.Time)
+		{
+			return false;
+		}
+		for (int32 Index = 0; Index < Scalar.Positions.Num(); ++Index)
+		{
+			const FDecimalVector& Position = Scalar.Positions[Index];
+			const FDecimalVector& Velocity = Scalar.Velocities[Index];
+			if (!IsSameDecimal(Batch.Positions.X[Index], Position.X) || !IsSameDecimal(Batch.Positions.Y[Index], Position.Y) || !IsSameDecimal(Batch.Positions.Z[Index], Position.Z)
+				|| !IsSameDecimal(Batch.Velocities.X[Index], Velocity.X) || !IsSameDecimal(Batch.Velocities.Y[Index], Velocity.Y) || !IsSameDecimal(Batch.Velocities.Z[Index], Velocity.Z))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Run a mix of schemes, with body counts changing in between, on the integrator and the scalar loops side by side. */
+	static void CheckIntegrator(FContext& Context, int32 MaxTasks)
+	{
+		FRandomStream Random(50);
+		const FDecimalVector Center(FDecimal(FString(TEXT("1000000000000.25"))), FDecimal(-7), FDecimal(FString(TEXT("-20000000000.5"))));
+		const FDecimal Milli(FString(TEXT("0.001")));
+		const auto MakeBody = [&Random, &Center, &Milli](FDecimalVector& OutPosition, FDecimalVector& OutVelocity)
+		{
+			OutPosition = Center + FDecimalVector(FDecimal(Random.RandRange(-5000, 5000)), FDecimal(Random.RandRange(-5000, 5000)), FDecimal(Random.RandRange(-5000, 5000))) * Milli;
+			OutVelocity = FDecimalVector(FDecimal(Random.RandRange(-1000, 1000)), FDecimal(Random.RandRange(-1000, 1000)), FDecimal(Random.RandRange(-1000, 1000))) * Milli;
+		};
+
+		FDecimalIntegrator Batch;
+		FScalarIntegrator Scalar;
+		const auto AddBodies = [&Batch, &Scalar, &MakeBody](int32 Count)
+		{
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				FDecimalVector Position, Velocity;
+				MakeBody(Position, Velocity);
+				Batch.Positions.Add(Position);
+				Batch.Velocities.Add(Velocity);
+				Scalar.Positions.Add(Position);
+				Scalar.Velocities.Add(Velocity);
+			}
+		};
+		AddBodies(1000);
+		Batch.Origin = Center;
+		Scalar.Origin = Center;
+
+		const FDecimalIntegrator::FAccelerationFunc Accelerations = [](int32 Begin, int32 End, double Time, TConstArrayView<FVector> Positions, TConstArrayView<FVector> Velocities, TArrayView<FVector> OutAccelerations)
+		{
+			for (int32 Index = Begin; Index < End; ++Index)
+			{
+				OutAccelerations[Index] = GetIntegratorAcceleration(Index, Time, Positions, Velocities);
+			}
+		};
+
+		struct FPhase
+		{
+			EDecimalIntegrator Method;
+			int32 NumSteps;
+			int32 NumAddedBodies;
+			const TCHAR* Name;
+		};
+		static const FPhase Phases[] =
+		{
+			{ EDecimalIntegrator::SymplecticEuler, 3, 0, TEXT("Symplectic Euler") },
+			{ EDecimalIntegrator::VelocityVerlet, 4, 0, TEXT("Velocity Verlet") },
+			{ EDecimalIntegrator::VelocityVerlet, 2, 0, TEXT("Velocity Verlet with carried accelerations") },
+			{ EDecimalIntegrator::RungeKutta4, 3, 0, TEXT("Runge-Kutta 4") },
+			{ EDecimalIntegrator::VelocityVerlet, 2, 37, TEXT("Velocity Verlet after adding bodies") },
+			{ EDecimalIntegrator::RungeKutta4, 2, 300, TEXT("Runge-Kutta 4 after adding bodies") },
+			{ EDecimalIntegrator::SymplecticEuler, 2, 0, TEXT("Symplectic Euler after Runge-Kutta 4") },
+		};
+
+		FDecimalMath::Batch::SetMaxTasks(MaxTasks);
+		for (const FPhase& Phase : Phases)
+		{
+			AddBodies(Phase.NumAddedBodies);
+			Batch.Step(Phase.Method, 0.01, Phase.NumSteps, Accelerations);
+			Scalar.Step(Phase.Method, 0.01, Phase.NumSteps);
+			if (!IsSameState(Batch, Scalar))
+			{
+				Context.AddError(FString::Printf(TEXT("%s with at most %d tasks differs from the scalar loops"), Phase.Name, MaxTasks));
+				break;
+			}
+		}
+		FDecimalMath::Batch::SetMaxTasks(0);
+	}
+
+	/**
+	 * Undamped oscillators a = -Omega^2 * x + Force * cos(ForceOmega * t) about a far origin, one per body, each axis on
+	 * its own, with known solutions. The forcing makes evaluation times matter.
+	 */
+	struct FOscillators
+	{
+		FDecimalVector Origin = FDecimalVector(FDecimal(FString(TEXT("-3000000000000.125"))), FDecimal(FString(TEXT("123456789.5"))), FDecimal(42));
+		TArray<double> Omegas;
+		TArray<FVector> StartPositions;
+		TArray<FVector> StartVelocities;
+		FVector Force = FVector::ZeroVector;
+		double ForceOmega = 0.8;
+
+		explicit FOscillators(const FVector& InForce)
+			: Force(InForce)
+		{
+			// Dyadic starting values, exact in doubles and in decimals.
+			for (int32 Body = 0; Body < 6; ++Body)
+			{
+				Omegas.Add(1.0 + 0.5 * Body);
+				StartPositions.Add(FVector(1.0, -0.5, 0.25 * (Body + 1)));
+				StartVelocities.Add(FVector(0.375, 0.75, -0.125 * Body));
+			}
+		}
+
+		void Start(FDecimalIntegrator& Integrator) const
+		{
+			Integrator = FDecimalIntegrator();
+			Integrator.Origin = Origin;
+			for (int32 Body = 0; Body < Omegas.Num(); ++Body)
+			{
+				const FVector& Position = StartPositions[Body];
+				const FVector& Velocity = StartVelocities[Body];
+				Integrator.Positions.Add(Origin + FDecimalVector(FDecimal(Position.X), FDecimal(Position.Y), FDecimal(Position.Z)));
+				Integrator.Velocities.Add(FDecimalVector(FDecimal(Velocity.X), FDecimal(Velocity.Y), FDecimal(Velocity.Z)));
+			}
+		}
+
+		void GetState(const FDecimalIntegrator& Integrator, TArray<FVector>& OutPositions, TArray<FVector>& OutVelocities) const
+		{
+			OutPositions.SetNum(Omegas.Num());
+			OutVelocities.SetNum(Omegas.Num());
+			FDecimalMath::Batch::ToRelative(Origin, Integrator.Positions, OutPositions);
+			FDecimalMath::Batch::ToRelative(FDecimalVector::ZeroVector, Integrator.Velocities, OutVelocities);
+		}
+
+		/** @return The largest distance from the analytic solution, in position and in velocity over Omega. */
+		double GetError(const FDecimalIntegrator& Integrator) const
+		{
+			TArray<FVector> Positions, Velocities;
+			GetState(Integrator, Positions, Velocities);
+			double Error = 0.0;
+			for (int32 Body = 0; Body < Omegas.Num(); ++Body)
+			{
+				const double Omega = Omegas[Body];
+				const double Cos = FMath::Cos(Omega * Integrator.Time);
+				const double Sin = FMath::Sin(Omega * Integrator.Time);
+				const FVector Forced = Force * (1.0 / (FMath::Square(Omega) - FMath::Square(ForceOmega)));
+				const FVector Free = StartPositions[Body] - Forced;
+				const FVector Position = Free * Cos + StartVelocities[Body] * (Sin / Omega) + Forced * FMath::Cos(ForceOmega * Integrator.Time);
+				const FVector Velocity = StartVelocities[Body] * Cos - Free * (Omega * Sin) - Forced * (ForceOmega * FMath::Sin(ForceOmega * Integrator.Time));
+				Error = FMath::Max(Error, FMath::Max((Positions[Body] - Position).Size(), (Velocities[Body] - Velocity).Size() / Omega));
+			}
+			return Error;
+		}
+
+		/** @return Kinetic plus potential energy, conserved without forcing. */
+		double GetEnergy(const FDecimalIntegrator& Integrator) const
+		{
+			TArray<FVector> Positions, Velocities;
+			GetState(Integrator, Positions, Velocities);
+			double Energy = 0.0;
+			for (int32 Body = 0; Body < Omegas.Num(); ++Body)
+			{
+				Energy += 0.5 * (Velocities[Body].SizeSquared() + FMath::Square(Omegas[Body]) * Positions[Body].SizeSquared());
+			}
+			return Energy;
+		}
+	};
+
+	/** Check every scheme against the analytic solution, its order of convergence and, for Verlet, the energy over a long run. */
+	static void CheckOscillators(FContext& Context)
+	{
+		const FOscillators Forced(FVector(0.75, -0.375, 0.5));
+		const FOscillators Free(FVector::ZeroVector);
+		const auto MakeAccelerations = [](const FOscillators& Oscillators)
+		{
+			return [&Oscillators](int32 Begin, int32 End, double Time, TConstArrayView<FVector> Positions, TConstArrayView<FVector>, TArrayView<FVector> OutAccelerations)
+			{
+				for (int32 Index = Begin; Index < End; ++Index)
+				{
+					OutAccelerations[Index] = Positions[Index] * -FMath::Square(Oscillators.Omegas[Index]) + Oscillators.Force * FMath::Cos(Oscillators.ForceOmega * Time);
+				}
+			};
+		};
+		const auto ForcedAccelerations = MakeAccelerations(Forced);
+		const auto FreeAccelerations = MakeAccelerations(Free);
+
+		struct FScheme
+		{
+			EDecimalIntegrator Method;
+			int32 Order;
+			double MaxError;
+			const TCHAR* Name;
+		};
+		static const FScheme Schemes[] =
+		{
+			{ EDecimalIntegrator::SymplecticEuler, 1, 0.2, TEXT("Symplectic Euler") },
+			{ EDecimalIntegrator::VelocityVerlet, 2, 0.02, TEXT("Velocity Verlet") },
+			{ EDecimalIntegrator::RungeKutta4, 4, 2e-4, TEXT("Runge-Kutta 4") },
+		};
+
+		// Two seconds in 40, 80 and 160 steps: halving the step divides the error by about 2^Order.
+		FDecimalIntegrator Integrator;
+		for (const FScheme& Scheme : Schemes)
+		{
+			double Errors[3];
+			for (int32 Level = 0; Level < 3; ++Level)
+			{
+				const int32 NumSteps = 40 << Level;
+				Forced.Start(Integrator);
+				Integrator.Step(Scheme.Method, 2.0 / NumSteps, NumSteps, ForcedAccelerations);
+				Errors[Level] = Forced.GetError(Integrator);
+			}
+			if (!(Errors[0] <= Scheme.MaxError))
+			{
+				Context.AddError(FString::Printf(TEXT("%s is %g from the analytic solution after 40 steps"), Scheme.Name, Errors[0]));
+			}
+			for (int32 Level = 1; Level < 3; ++Level)
+			{
+				const double Ratio = Errors[Level - 1] / Errors[Level];
+				const double Expected = double(1 << Scheme.Order);
+				if (!(Ratio >= 0.8 * Expected && Ratio <= 1.25 * Expected))
+				{
+					Context.AddError(FString::Printf(TEXT("%s: halving the step divides the error by %g, expected about %g"), Scheme.Name, Ratio, Expected));
+				}
+			}
+		}
+
+		// Verlet is symplectic: the energy oscillates within a band set by the step, about (Omega * TimeStep)^2 / 4 for the
+		// fastest oscillator, and does not drift over hundreds of periods.
+		Free.Start(Integrator);
+		const double StartEnergy = Free.GetEnergy(Integrator);
+		double EarlyDeviation = 0.0;
+		double LateDeviation = 0.0;
+		const int32 NumSteps = 20000;
+		for (int32 StepIndex = 0; StepIndex < NumSteps; ++StepIndex)
+		{
+			Integrator.Step(EDecimalIntegrator::VelocityVerlet, 0.1, 1, FreeAccelerations);
+			const double Deviation = FMath::Abs(Free.GetEnergy(Integrator) - StartEnergy) / StartEnergy;
+			double& MaxDeviation = StepIndex < NumSteps / 10 ? EarlyDeviation : LateDeviation;
+			MaxDeviation = FMath::Max(MaxDeviation, Deviation);
+		}
+		Context.Check(EarlyDeviation <= 0.03 && LateDeviation <= 0.03, TEXT("Velocity Verlet keeps the energy within its band"));
+		Context.Check(LateDeviation <= 1.05 * EarlyDeviation, TEXT("Velocity Verlet energy does not drift"));
+	}
+
+	void RunIntegrator(FContext& Context)
+	{
+		CheckIntegrator(Context, 1);
+		CheckIntegrator(Context, 0);
+		CheckIntegrator(Context, 3);
+		CheckOscillators(Context);
+	}
+}
@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "DecimalKMeans.h"
+#include "DecimalMath.h"
+#include "DecimalSort.h"
+
+namespace DecimalTestCases
+{
+	/** Everything a FDecimalKMeans::Run call returns. */
+	struct FKMeansResult
+	{
+		TArray<FDecimalVector> Centers;
+		TArray<int32> Assignments;
+		TArray<int32> ClusterSizes;
+		FDecimalKMeansStats Stats;
+	};
+
+	static FKMeansResult ClusterPoints(const TArray<FDecimalVector>& Centers, const TArray<FDecimalVector>& Points, int32 MaxIterations, int32 MaxTasks)
+	{
+		FDecimalMath::Batch::SetMaxTasks(MaxTasks);
+		FKMeansResult Result;
+		Result.Centers = Centers;
+		Result.Stats = FDecimalKMeans::Run(Result.Centers, Points, MaxIterations, Result.Assignments, Result.ClusterSizes);
+		FDecimalMath::Batch::SetMaxTasks(0);
+		return Result;
+	}
+
+	static bool IsSameVector(const FDecimalVector& A, const FDecimalVector& B)
+	{
+		return FDecimalSortKey(A.X) == FDecimalSortKey(B.X) && FDecimalSortKey(A.Y) == FDecimalSortKey(B.Y) && FDecimalSortKey(A.Z) == FDecimalSortKey(B.Z);
+	}
+
+	/** Every point is in the cluster of its nearest center, the lowest index among equally near ones, by exact distances. */
+	static void CheckAssignments(FContext& Context, const TCHAR* What, const FKMeansResult& Result, const TArray<FDecimalVector>& Points)
+	{
+		TArray<int32> Sizes;
+		Sizes.SetNumZeroed(Result.Centers.Num());
+		for (int32 PointIndex = 0; PointIndex < Points.Num(); ++PointIndex)
+		{
+			int32 Nearest = 0;
+			FDecimal NearestDistSquared = FDecimalVector::DistSquared(Points[PointIndex], Result.Centers[0]);
+			for (int32 CenterIndex = 1; CenterIndex < Result.Centers.Num(); ++CenterIndex)
+			{
+				const FDecimal DistSquared = FDecimalVector::DistSquared(Points[PointIndex], Result.Centers[CenterIndex]);
+				if (DistSquared < NearestDistSquared)
+				{
+					Nearest = CenterIndex;
+					NearestDistSquared = DistSquared;
+				}
+			}
+			if (Result.Assignments[PointIndex] != Nearest)
+			{
+				Context.AddError(FString::Printf(TEXT("%s: point %d is assigned to center %d, the nearest is %d"), What, PointIndex, Result.Assignments[PointIndex], Nearest));
+				return;
+			}
+			++Sizes[Nearest];
+		}
+		Context.Check(Sizes == Result.ClusterSizes, What);
+	}
+
+	void RunKMeans(FContext& Context)
+	{
+		// Blobs around six centers far from the origin, with coordinates doubles cannot hold.
+		FRandomStream Random(46);
+		const FDecimalVector Origin(FDecimal(FString(TEXT("123456789.000000001"))), FDecimal(-987654321), FDecimal(FString(TEXT("0.5"))));
+		TArray<FDecimalVector> Blobs;
+		for (int32 Index = 0; Index < 6; ++Index)
+		{
+			Blobs.Add(Origin + FDecimalVector(FDecimal(Random.RandRange(-1000, 1000)), FDecimal(Random.RandRange(-1000, 1000)), FDecimal(Random.RandRange(-1000, 1000))));
+		}
+		const FDecimal Spread(FString(TEXT("0.001")));
+		TArray<FDecimalVector> Points;
+		for (int32 Index = 0; Index < 6000; ++Index)
+		{
+			const FDecimalVector Offset(FDecimal(Random.RandRange(-300000, 300000)), FDecimal(Random.RandRange(-300000, 300000)), FDecimal(Random.RandRange(-300000, 300000)));
+			Points.Add(Blobs[Random.RandRange(0, Blobs.Num() - 1)] + Offset * Spread);
+		}
+		TArray<FDecimalVector> Centers;
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			Centers.Add(Points[Random.RandRange(0, Points.Num() - 1)]);
+		}
+
+		// One task, as many as there are workers and a count that splits the points unevenly give the same clustering.
+		const FKMeansResult Serial = ClusterPoints(Centers, Points, 50, 1);
+		Context.Check(Serial.Stats.bConverged, TEXT("K-means converges on separated blobs"));
+		CheckAssignments(Context, TEXT("Converged assignments are to the nearest centers"), Serial, Points);
+		for (const int32 MaxTasks : { 0, 3 })
+		{
+			const FKMeansResult Parallel = ClusterPoints(Centers, Points, 50, MaxTasks);
+			bool bSame = Parallel.Assignments == Serial.Assignments && Parallel.ClusterSizes == Serial.ClusterSizes
+				&& Parallel.Stats.NumIterations == Serial.Stats.NumIterations && Parallel.Stats.bConverged == Serial.Stats.bConverged
+				&& Parallel.Centers.Num() == Serial.Centers.Num();
+			for (int32 Index = 0; bSame && Index < Serial.Centers.Num(); ++Index)
+			{
+				bSame = IsSameVector(Parallel.Centers[Index], Serial.Centers[Index]);
+			}
+			if (!bSame)
+			{
+				Context.AddError(FString::Printf(TEXT("K-means with at most %d tasks differs from one task"), MaxTasks));
+			}
+		}
+
+		// Points exactly between two centers, and a hair off it, go to the lowest index or the nearer one.
+		const FDecimal Tiny(FString(TEXT("0.000000001")));
+		TArray<FDecimalVector> TieCenters = { Origin + FDecimalVector(FDecimal(2), FDecimal(0), FDecimal(0)), Origin, Origin + FDecimalVector(FDecimal(-2), FDecimal(0), FDecimal(0)) };
+		TArray<FDecimalVector> TiePoints;
+		for (int32 Index = 0; Index < 1000; ++Index)
+		{
+			const FDecimal X = FDecimal(Random.RandRange(0, 1) * 2 - 1) + Tiny * FDecimal(Random.RandRange(-1, 1));
+			TiePoints.Add(Origin + FDecimalVector(X, FDecimal(Random.RandRange(-50, 50)), FDecimal(Random.RandRange(-50, 50))));
+		}
+		CheckAssignments(Context, TEXT("Ties go to the lowest index on one task"), ClusterPoints(TieCenters, TiePoints, 0, 1), TiePoints);
+		CheckAssignments(Context, TEXT("Ties go to the lowest index on many tasks"), ClusterPoints(TieCenters, TiePoints, 0, 0), TiePoints);
+	}
+}
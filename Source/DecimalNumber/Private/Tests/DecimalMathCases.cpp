@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "DecimalMath.h"
+
+namespace DecimalTestCases
+{
+	void RunMath(FContext& Context)
+	{
+		const FDecimal Tolerance(FString(TEXT("0.000000000001")));
+		const FDecimal Half = FDecimal(1) / FDecimal(2);
+
+		// acos(1/2) = pi/3 and acos(-1/2) = 2pi/3, cos(acos(x)) = x.
+		Context.Check(FDecimalMath::IsNearlyZero(FDecimalMath::Acos(Half) - FDecimal::ConstantPI / FDecimal(3), Tolerance), TEXT("Acos(0.5) is pi/3"));
+		Context.Check(FDecimalMath::IsNearlyZero(FDecimalMath::Acos(-Half) - FDecimal::ConstantPI * FDecimal(2) / FDecimal(3), Tolerance), TEXT("Acos(-0.5) is 2pi/3"));
+		Context.Check(FDecimalMath::IsNearlyZero(FDecimalMath::Acos(FDecimal(1)), Tolerance), TEXT("Acos(1) is 0"));
+		for (int32 Step = -9; Step <= 9; ++Step)
+		{
+			const FDecimal Value = FDecimal(Step) / FDecimal(10);
+			if (!FDecimalMath::IsNearlyZero(FDecimalMath::Cos(FDecimalMath::Acos(Value)) - Value, Tolerance))
+			{
+				Context.AddError(FString::Printf(TEXT("Cos(Acos(%s)) is %s"), *Value.ToString(1), *FDecimalMath::Cos(FDecimalMath::Acos(Value)).ToString(20)));
+			}
+		}
+
+		// The float and double overloads set both outputs. FDecimal(double) rounds, so references are parsed from %.17g.
+		const auto Exact = [](double Value)
+		{
+			return FDecimal(FString::Printf(TEXT("%.17g"), Value));
+		};
+		FDecimal Sin(7), Cos(7);
+		FDecimalMath::SindCos(Sin, Cos, 0.5);
+		Context.Check(FDecimalMath::IsNearlyZero(Sin - Exact(FMath::Sin(0.5)), Tolerance) && FDecimalMath::IsNearlyZero(Cos - Exact(FMath::Cos(0.5)), Tolerance), TEXT("SindCos(double) sets sine and cosine"));
+		Sin = FDecimal(7);
+		Cos = FDecimal(7);
+		FDecimalMath::SindCos(Sin, Cos, 0.5f);
+		Context.Check(FDecimalMath::IsNearlyZero(Sin - Exact(FMath::Sin(0.5f)), Tolerance) && FDecimalMath::IsNearlyZero(Cos - Exact(FMath::Cos(0.5f)), Tolerance), TEXT("SindCos(float) sets sine and cosine"));
+
+#if DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_FIXED128
+		// Overflow saturates at the ends of the range, also where rounding the last place up would wrap around.
+		const FDecimal Max(FString(TEXT("170141183460469231731.687303715884105727")));
+		const FDecimal Min = -Max - FDecimal(FString(TEXT("0.000000000000000001")));
+		const FDecimal AllOnesFactor(FString(TEXT("2.000000000000012345")));
+		const FDecimal AllOnesOther(FString(TEXT("170141183460468181535.232393976033579506")));
+		Context.Check(AllOnesFactor * AllOnesOther == Max && AllOnesFactor * -AllOnesOther == Min, TEXT("A product just below 2^128 in last places saturates"));
+		Context.Check(Max * FDecimal(2) == Max && Min * FDecimal(2) == Min, TEXT("Products past the range saturate"));
+		Context.Check(FDecimalMath::Floor(Min) == Min && FDecimalMath::Ceil(Max) == Max, TEXT("Floor and Ceil saturate at the ends of the range"));
+		Context.Check(FDecimalMath::Floor(Max) == FDecimal(FString(TEXT("170141183460469231731"))) && FDecimalMath::Ceil(Min) == FDecimal(FString(TEXT("-170141183460469231731"))),
+			TEXT("Floor and Ceil towards zero stay in range"));
+#endif
+	}
+}
@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "DecimalPredicates.h"
+
+namespace DecimalTestCases
+{
+	static FDecimalVector MakeIntegerPoint(FRandomStream& Random, int32 Extent)
+	{
+		return FDecimalVector(FDecimal(Random.RandRange(-Extent, Extent)), FDecimal(Random.RandRange(-Extent, Extent)), FDecimal(Random.RandRange(-Extent, Extent)));
+	}
+
+	/** Both overloads of a predicate must give Expected, the sign of the exact evaluation. */
+	static bool CheckSign(FContext& Context, const TCHAR* Name, int32 Expected, int32 Result, int32 ShadowedResult)
+	{
+		if (Result != Expected || ShadowedResult != Expected)
+		{
+			Context.AddError(FString::Printf(TEXT("%s gave %d and %d for shadowed points, the exact sign is %d"), Name, Result, ShadowedResult, Expected));
+			return false;
+		}
+		return true;
+	}
+
+	void RunPredicates(FContext& Context)
+	{
+		FRandomStream Random(45);
+		// Nudges at or below what the shadows of the coordinates resolve, yet exact in decimal. Coordinates stay small
+		// enough for Fixed128 to hold every product.
+		const FDecimal Tiny(FString(TEXT("0.000000001")));
+
+		// Three points on a line far from the origin, the last one nudged off it, or not, by a few Tiny.
+		for (int32 Index = 0; Index < 500; ++Index)
+		{
+			const FDecimalVector A = MakeIntegerPoint(Random, 100000000);
+			const FDecimalVector B = MakeIntegerPoint(Random, 100000000);
+			const FDecimalVector Nudge = FDecimalVector(FDecimal(0), Tiny * FDecimal(Random.RandRange(-2, 2)), FDecimal(0));
+			const FDecimalVector C = A + (B - A) * FDecimal(Random.RandRange(-3, 3)) + Nudge;
+			const int32 Expected = ((A - C) ^ (B - C)).Z.Sign();
+			if (!CheckSign(Context, TEXT("Orient2D"), Expected, FDecimalPredicates::Orient2D(A, B, C),
+				FDecimalPredicates::Orient2D(FDecimalShadowedVector(A), FDecimalShadowedVector(B), FDecimalShadowedVector(C))))
+			{
+				break;
+			}
+		}
+
+		// A fourth point in the plane of three others, nudged off it, or not, along Z.
+		for (int32 Index = 0; Index < 500; ++Index)
+		{
+			const FDecimalVector A = MakeIntegerPoint(Random, 100000);
+			const FDecimalVector B = MakeIntegerPoint(Random, 100000);
+			const FDecimalVector C = MakeIntegerPoint(Random, 100000);
+			const FDecimalVector Nudge = FDecimalVector(FDecimal(0), FDecimal(0), Tiny * FDecimal(Random.RandRange(-2, 2)));
+			const FDecimalVector D = A + (B - A) * FDecimal(Random.RandRange(-3, 3)) + (C - A) * FDecimal(Random.RandRange(-3, 3)) + Nudge;
+			const int32 Expected = FDecimalVector::Triple(A - D, B - D, C - D).Sign();
+			if (!CheckSign(Context, TEXT("Orient3D"), Expected, FDecimalPredicates::Orient3D(A, B, C, D),
+				FDecimalPredicates::Orient3D(FDecimalShadowedVector(A), FDecimalShadowedVector(B), FDecimalShadowedVector(C), FDecimalShadowedVector(D))))
+			{
+				break;
+			}
+		}
+
+		// A point in a plane, moved off it, or not, along the normal.
+		for (int32 Index = 0; Index < 500; ++Index)
+		{
+			const FDecimalVector Base = MakeIntegerPoint(Random, 1000000000);
+			const FDecimalVector Normal = MakeIntegerPoint(Random, 1000);
+			const FDecimalVector Point = Base + (Normal ^ MakeIntegerPoint(Random, 1000)) + Normal * (Tiny * FDecimal(Random.RandRange(-2, 2)));
+			const int32 Expected = ((Point - Base) | Normal).Sign();
+			if (!CheckSign(Context, TEXT("PlaneSide"), Expected, FDecimalPredicates::PlaneSide(Point, Base, Normal),
+				FDecimalPredicates::PlaneSide(FDecimalShadowedVector(Point), FDecimalShadowedVector(Base), FDecimalShadowedVector(Normal))))
+			{
+				break;
+			}
+		}
+
+		// Points of the sphere of radius 7 around a far away center, the fifth one scaled a few Tiny in or out, or not.
+		TArray<FDecimalVector> SpherePoints;
+		for (int32 Sign = -1; Sign <= 1; Sign += 2)
+		{
+			SpherePoints.Add(FDecimalVector(FDecimal(7 * Sign), FDecimal(0), FDecimal(0)));
+			SpherePoints.Add(FDecimalVector(FDecimal(0), FDecimal(7 * Sign), FDecimal(0)));
+			SpherePoints.Add(FDecimalVector(FDecimal(0), FDecimal(0), FDecimal(7 * Sign)));
+			SpherePoints.Add(FDecimalVector(FDecimal(2 * Sign), FDecimal(3), FDecimal(-6)));
+			SpherePoints.Add(FDecimalVector(FDecimal(6), FDecimal(2 * Sign), FDecimal(3)));
+			SpherePoints.Add(FDecimalVector(FDecimal(-3), FDecimal(6), FDecimal(2 * Sign)));
+		}
+		for (int32 Index = 0; Index < 500; ++Index)
+		{
+			int32 Picked[5];
+			for (int32 Slot = 0; Slot < 5; ++Slot)
+			{
+				bool bTaken;
+				do
+				{
+					Picked[Slot] = Random.RandRange(0, SpherePoints.Num() - 1);
+					bTaken = false;
+					for (int32 Other = 0; Other < Slot; ++Other)
+					{
+						bTaken |= Picked[Other] == Picked[Slot];
+					}
+				}
+				while (bTaken);
+			}
+
+			const FDecimalVector Center = MakeIntegerPoint(Random, 100000000);
+			const FDecimalVector A = Center + SpherePoints[Picked[0]];
+			const FDecimalVector B = Center + SpherePoints[Picked[1]];
+			const FDecimalVector C = Center + SpherePoints[Picked[2]];
+			const FDecimalVector D = Center + SpherePoints[Picked[3]];
+			const int32 Orientation = FDecimalVector::Triple(A - D, B - D, C - D).Sign();
+			if (Orientation == 0)
+			{
+				// Four points on one circle of the sphere do not define it, the sign is 0 for every E.
+				continue;
+			}
+			const int32 Offset = Random.RandRange(-2, 2);
+			const FDecimalVector E = Center + SpherePoints[Picked[4]] * (FDecimal(1) + Tiny * FDecimal(Offset));
+			const int32 Expected = Offset < 0 ? Orientation : (Offset > 0 ? -Orientation : 0);
+			if (!CheckSign(Context, TEXT("InSphere"), Expected, FDecimalPredicates::InSphere(A, B, C, D, E),
+				FDecimalPredicates::InSphere(FDecimalShadowedVector(A), FDecimalShadowedVector(B), FDecimalShadowedVector(C), FDecimalShadowedVector(D), FDecimalShadowedVector(E))))
+			{
+				break;
+			}
+		}
+	}
+}
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "DecimalMath.h"
+#include "DecimalRebase.h"
+
+namespace DecimalTestCases
+{
+	/** Every registered render position against a single-point ToRelative from the current render origin. */
+	static void CheckRenderPositions(FContext& Context, const FDecimalRebaseSet& Set, const TArray<int32>& Ids, const TCHAR* When)
+	{
+		for (const int32 Id : Ids)
+		{
+			FVector Expected;
+			FDecimalMath::Batch::ToRelative(Set.GetRenderOrigin(), MakeArrayView(&Set.GetPosition(Id), 1), MakeArrayView(&Expected, 1));
+			if (Set.GetRenderPosition(Id) != Expected)
+			{
+				Context.AddError(FString::Printf(TEXT("%s: render position of id %d is stale"), When, Id));
+				return;
+			}
+		}
+	}
+
+	void RunRebase(FContext& Context)
+	{
+		const FDecimalVector Far(FDecimal(FString(TEXT("123456789012.5"))), FDecimal(-987654321), FDecimal(42));
+		const FDecimalVector Step(FDecimal(10), FDecimal(0), FDecimal(-3));
+
+		FDecimalRebaseSet Set;
+		TArray<int32> Ids;
+		for (int32 Index = 0; Index < 8; ++Index)
+		{
+			Ids.Add(Set.Add(Far + Step * FDecimal(Index)));
+		}
+		Context.Check(Set.GetNumDirty() == 8, TEXT("Added positions are queued once each"));
+		Context.Check(Set.Update(Far), TEXT("The first update places the render origin"));
+		CheckRenderPositions(Context, Set, Ids, TEXT("First update"));
+
+		// Removing a queued id and adding again reuses it while it is still queued, it must not be queued twice.
+		Set.SetPosition(Ids[3], Far + Step);
+		Set.Remove(Ids[3]);
+		const int32 Reused = Set.Add(Far - Step);
+		Context.Check(Reused == Ids[3], TEXT("Add reuses the removed id"));
+		Set.SetPosition(Reused, Far - Step * FDecimal(2));
+		Context.Check(Set.GetNumDirty() == 1, TEXT("Remove, Add and SetPosition queue a reused id once"));
+
+		// The same without the id being queued at removal.
+		Context.Check(!Set.Update(Far + Step), TEXT("A view within the threshold keeps the render origin"));
+		Set.Remove(Ids[5]);
+		Context.Check(Set.Add(Far) == Ids[5], TEXT("Add reuses the removed id"));
+		Set.SetPosition(Ids[5], Far + Step * FDecimal(3));
+		Context.Check(Set.GetNumDirty() == 1, TEXT("Remove, Add and SetPosition of an idle id queue it once"));
+
+		Context.Check(!Set.Update(Far), TEXT("A view within the threshold keeps the render origin"));
+		Context.Check(Set.GetNumDirty() == 0, TEXT("Update drains the queue"));
+		CheckRenderPositions(Context, Set, Ids, TEXT("Incremental update"));
+
+		const FDecimalVector Beyond = Far + FDecimalVector(Set.GetRebaseThreshold() * FDecimal(2), FDecimal(0), FDecimal(0));
+		Context.Check(Set.Update(Beyond), TEXT("A view beyond the threshold moves the render origin"));
+		CheckRenderPositions(Context, Set, Ids, TEXT("Rebase"));
+		Context.Check(Set.Num() == 8, TEXT("Reused ids keep the count"));
+	}
+}
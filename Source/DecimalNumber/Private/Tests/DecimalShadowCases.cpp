@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "DecimalShadow.h"
+#include "DecimalMath.h"
+
+namespace DecimalTestCases
+{
+	/** Exact value of a double. FDecimal(double) rounds and strings with exponents do not parse, so print every digit. */
+	static FDecimal ExactDouble(double Value)
+	{
+		return FDecimal(FString::Printf(TEXT("%.40f"), Value));
+	}
+
+	/** Numbers of both signs between 1e-6 and 1e9, the range every backend holds to more digits than a double. */
+	static FDecimal MakeShadowInput(FRandomStream& Random)
+	{
+		static const TCHAR* const Scales[] = { TEXT("0.000001"), TEXT("0.001"), TEXT("1"), TEXT("1000"), TEXT("1000000") };
+		const FDecimal Scale(FString(Scales[Random.RandRange(0, UE_ARRAY_COUNT(Scales) - 1)]));
+		return FDecimal(Random.RandRange(-1000000, 1000000)) / FDecimal(Random.RandRange(1, 999)) * Scale;
+	}
+
+	/** @return Whether Shadow is within FDecimalShadowed::GetShadowError of Value. */
+	static bool IsWithinShadowError(const FDecimal& Value, double Shadow)
+	{
+		return FDecimalMath::Abs(Value - ExactDouble(Shadow)) <= ExactDouble(FDecimalShadowed::GetShadowError(Shadow));
+	}
+
+	void RunShadow(FContext& Context)
+	{
+		FRandomStream Random(44);
+
+		// Every shadow, converted or left by arithmetic, is within its error bound of the exact value.
+		for (int32 Index = 0; Index < 2000; ++Index)
+		{
+			const FDecimal Value = MakeShadowInput(Random);
+			if (!IsWithinShadowError(Value, FDecimalShadowed::MakeShadow(Value)))
+			{
+				Context.AddError(FString::Printf(TEXT("Shadow %.17g of %s is outside its error bound"), FDecimalShadowed::MakeShadow(Value), *Value.ToString(30)));
+				break;
+			}
+		}
+		FDecimalShadowed Running(FDecimal(1) / FDecimal(3));
+		for (int32 Step = 0; Step < 200; ++Step)
+		{
+			const FDecimal Operand = MakeShadowInput(Random);
+			switch (Step % 4)
+			{
+			case 0: Running += Operand; break;
+			case 1: Running -= Operand; break;
+			case 2: Running *= Operand / FDecimal(1000); break;
+			default: Running /= Operand.IsZero() ? FDecimal(7) : Operand / FDecimal(1000); break;
+			}
+			if (!IsWithinShadowError(Running.GetValue(), Running.GetShadow()))
+			{
+				Context.AddError(FString::Printf(TEXT("Shadow %.17g of %s is outside its error bound after step %d"), Running.GetShadow(), *Running.GetValue().ToString(30), Step));
+				break;
+			}
+		}
+
+		// Values closer than a double can tell apart compare the way FDecimal does, whichever side decides.
+		const FDecimal Tiny(FString(TEXT("0.00000000000001")));
+		for (int32 Index = 0; Index < 500; ++Index)
+		{
+			const FDecimal A = MakeShadowInput(Random);
+			const FDecimal B = A + Tiny * FDecimal(Random.RandRange(-2, 2));
+			const int32 Expected = A.Compare(B);
+			if (FDecimalShadowed(A).Compare(FDecimalShadowed(B)) != Expected || FDecimalShadowed(B).Compare(FDecimalShadowed(A)) != -Expected)
+			{
+				Context.AddError(FString::Printf(TEXT("Shadowed Compare of %s and %s differs from FDecimal::Compare"), *A.ToString(30), *B.ToString(30)));
+				break;
+			}
+		}
+
+		// Points right at, just inside and just outside the threshold distance, and pairs of almost equally far points.
+		for (int32 Index = 0; Index < 500; ++Index)
+		{
+			const FDecimalVector Origin(MakeShadowInput(Random), MakeShadowInput(Random), MakeShadowInput(Random));
+			const FDecimal Radius = FDecimalMath::Abs(MakeShadowInput(Random)) + FDecimal(1);
+			const FDecimalVector Axis = Random.RandRange(0, 1) == 0 ? FDecimalVector::XAxisVector : FDecimalVector::ZAxisVector;
+			const FDecimalVector Near = Origin + Axis * (Radius + Tiny * FDecimal(Random.RandRange(-2, 2)));
+			const FDecimalVector Other = Origin - Axis * (Radius + Tiny * FDecimal(Random.RandRange(-2, 2)));
+
+			const bool bExpected = FDecimalVector::DistSquared(Origin, Near) <= Radius * Radius;
+			if (FDecimalShadowedVector::IsWithinDistance(FDecimalShadowedVector(Origin), FDecimalShadowedVector(Near), FDecimalShadowed(Radius)) != bExpected)
+			{
+				Context.AddError(FString::Printf(TEXT("IsWithinDistance of points %s apart differs from the exact test"), *FDecimalVector::Dist(Origin, Near).ToString(30)));
+				break;
+			}
+
+			const int32 Expected = FDecimalVector::DistSquared(Origin, Near).Compare(FDecimalVector::DistSquared(Origin, Other));
+			if (FDecimalShadowedVector::CompareDistance(FDecimalShadowedVector(Origin), FDecimalShadowedVector(Near), FDecimalShadowedVector(Other)) != Expected)
+			{
+				Context.AddError(TEXT("CompareDistance of almost equally far points differs from the exact comparison"));
+				break;
+			}
+		}
+	}
+}
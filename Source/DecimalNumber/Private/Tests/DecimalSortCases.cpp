@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "DecimalSort.h"
+
+namespace DecimalTestCases
+{
+	/**
+	 * Numbers of both signs spread over many exponents, with repeated values, zeros of both signs and, on backends
+	 * that have them, infinities and NaNs scattered in.
+	 */
+	static TArray<FDecimal> MakeSortInput(int32 Num, int32 Seed)
+	{
+		static const TCHAR* const Scales[] =
+		{
+#if DECIMALNUMBER_BACKEND != DECIMALNUMBER_BACKEND_FIXED128
+			TEXT("0.000000000000000000000000000001"),
+			TEXT("1000000000000000000000000000000000000000"),
+#endif
+			TEXT("0.000001"),
+			TEXT("1"),
+			TEXT("1000000000"),
+		};
+
+		FRandomStream Random(Seed);
+		const FDecimal Zero(0);
+		TArray<FDecimal> Values;
+		Values.Reserve(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			switch (Random.RandRange(0, 15))
+			{
+			case 0:
+				Values.Add(FDecimal(Random.RandRange(-5, 5)));
+				break;
+			case 1:
+				Values.Add(Random.RandRange(0, 1) == 0 ? Zero : -Zero);
+				break;
+#if DECIMALNUMBER_BACKEND != DECIMALNUMBER_BACKEND_FIXED128
+			case 2:
+				Values.Add(FDecimal(Random.RandRange(-1, 1)) / Zero);
+				break;
+#endif
+			default:
+				{
+					const FDecimal Scale(FString(Scales[Random.RandRange(0, UE_ARRAY_COUNT(Scales) - 1)]));
+					Values.Add(FDecimal(Random.RandRange(-1000000, 1000000)) / FDecimal(Random.RandRange(1, 1000)) * Scale);
+				}
+				break;
+			}
+		}
+		return Values;
+	}
+
+	/** Algo::Sort over indices, by FDecimal::Compare and then by index: the order a stable sort must produce. */
+	static TArray<int32> ReferenceOrder(const TArray<FDecimal>& Values)
+	{
+		TArray<int32> Order;
+		for (int32 Index = 0; Index < Values.Num(); ++Index)
+		{
+			Order.Add(Index);
+		}
+		Algo::Sort(Order, [&Values](int32 A, int32 B)
+		{
+			const int32 Result = Values[A].Compare(Values[B]);
+			return Result != 0 ? Result < 0 : A < B;
+		});
+		return Order;
+	}
+
+	/** Both sides of FDecimalSort::MinRadixSortSize, so the comparison and the radix path are both covered. */
+	static void CheckSort(FContext& Context, int32 Num, int32 Seed)
+	{
+		const TArray<FDecimal> Input = MakeSortInput(Num, Seed);
+		const TArray<int32> Expected = ReferenceOrder(Input);
+
+		TArray<int32> Order;
+		FDecimalSort::SortIndices(Input, Order);
+		if (Order != Expected)
+		{
+			Context.AddError(FString::Printf(TEXT("SortIndices of %d numbers differs from the stable Algo::Sort order"), Num));
+		}
+
+		TArray<FDecimal> Sorted = Input;
+		FDecimalSort::Sort(Sorted);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			if (FDecimalSortKey(Sorted[Index]) != FDecimalSortKey(Input[Expected[Index]]))
+			{
+				Context.AddError(FString::Printf(TEXT("Sort of %d numbers: element %d is %s, expected %s"), Num, Index,
+					*Sorted[Index].ToString(20), *Input[Expected[Index]].ToString(20)));
+				break;
+			}
+		}
+
+		TArray<FDecimal> Keys = Input;
+		TArray<int32> Payload;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Payload.Add(Index);
+		}
+		FDecimalSort::SortPairs<int32>(Keys, Payload);
+		if (Payload != Expected)
+		{
+			Context.AddError(FString::Printf(TEXT("SortPairs of %d numbers moved values out of the stable order"), Num));
+		}
+
+		for (int32 Index = 1; Index < Num; ++Index)
+		{
+			const FDecimal& Previous = Input[Expected[Index - 1]];
+			const FDecimal& Current = Input[Expected[Index]];
+			if (FDecimalSortKey(Previous).Compare(FDecimalSortKey(Current)) > 0 || (FDecimalSortKey(Previous) == FDecimalSortKey(Current)) != (Previous.Compare(Current) == 0))
+			{
+				Context.AddError(FString::Printf(TEXT("Sort keys of %s and %s disagree with Compare"), *Previous.ToString(20), *Current.ToString(20)));
+				break;
+			}
+		}
+	}
+
+	void RunSort(FContext& Context)
+	{
+		CheckSort(Context, 0, 1);
+		CheckSort(Context, 1, 2);
+		CheckSort(Context, 200, 3);
+		CheckSort(Context, 50000, 4);
+
+		// Zeros of either sign are equal and keep their order, infinities bound everything, NaN sorts last.
+		const FDecimal Zero(0);
+#if DECIMALNUMBER_BACKEND != DECIMALNUMBER_BACKEND_FIXED128
+		const FDecimal NaN = Zero / Zero;
+		const FDecimal Infinity = FDecimal(1) / Zero;
+		TArray<FDecimal> Specials = { NaN, FDecimal(3), -Zero, Infinity, Zero, -Infinity, NaN, FDecimal(-3), -Zero };
+		const TArray<int32> Expected = { 5, 7, 2, 4, 8, 1, 3, 0, 6 };
+#else
+		TArray<FDecimal> Specials = { FDecimal(3), -Zero, Zero, FDecimal(-3), -Zero };
+		const TArray<int32> Expected = { 3, 1, 2, 4, 0 };
+#endif
+		TArray<int32> Order;
+		FDecimalSort::SortIndices(Specials, Order);
+		Context.Check(Order == Expected, TEXT("Signed zeros, infinities and NaN sort in the documented order"));
+	}
+}
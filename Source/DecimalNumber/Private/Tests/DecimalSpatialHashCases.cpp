@@ -0,0 +1,399 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "DecimalSpatialHash.h"
+#include "Async/ParallelFor.h"
+#include <atomic>
+
+namespace DecimalTestCases
+{
+	/** The points of a FDecimalSpatialHash by id, searched by brute force. */
+	struct FSpatialHashMirror
+	{
+		TArray<FDecimalVector> Positions;
+
+		/** 1 for the ids in use, 0 for those of removed points. */
+		TArray<uint8> Live;
+
+		void Set(int32 Id, const FDecimalVector& Position)
+		{
+			if (Id >= Positions.Num())
+			{
+				Positions.SetNum(Id + 1);
+				Live.SetNumZeroed(Id + 1);
+			}
+			Positions[Id] = Position;
+			Live[Id] = 1;
+		}
+
+		int32 Num() const
+		{
+			int32 Count = 0;
+			for (const uint8 bLive : Live)
+			{
+				Count += bLive;
+			}
+			return Count;
+		}
+
+		TArray<int32> FindInRadius(const FDecimalVector& Center, const FDecimal& Radius) const
+		{
+			TArray<int32> Ids;
+			for (int32 Id = 0; Id < Positions.Num(); ++Id)
+			{
+				if (Live[Id] && FDecimalVector::DistSquared(Positions[Id], Center) <= Radius * Radius)
+				{
+					Ids.Add(Id);
+				}
+			}
+			return Ids;
+		}
+
+		TArray<int32> FindNearest(const FDecimalVector& Center, int32 NumNeighbors) const
+		{
+			TArray<TPair<FDecimal, int32>> Distances;
+			for (int32 Id = 0; Id < Positions.Num(); ++Id)
+			{
+				if (Live[Id])
+				{
+					Distances.Add(TPair<FDecimal, int32>(FDecimalVector::DistSquared(Positions[Id], Center), Id));
+				}
+			}
+			Algo::Sort(Distances, [](const TPair<FDecimal, int32>& A, const TPair<FDecimal, int32>& B)
+			{
+				const int32 Result = A.Key.Compare(B.Key);
+				return Result != 0 ? Result < 0 : A.Value < B.Value;
+			});
+			TArray<int32> Ids;
+			for (int32 Index = 0; Index < FMath::Min(NumNeighbors, Distances.Num()); ++Index)
+			{
+				Ids.Add(Distances[Index].Value);
+			}
+			return Ids;
+		}
+	};
+
+	/** Compare every kind of query on the hash against the mirror, around points of the hash and in between. */
+	static void CheckSpatialHashQueries(FContext& Context, const TCHAR* Stage, const FDecimalSpatialHash& Hash, const FSpatialHashMirror& Mirror, FRandomStream& Random, const FDecimalVector& Origin)
+	{
+		if (Hash.Num() != Mirror.Num())
+		{
+			Context.AddError(FString::Printf(TEXT("%s: the hash holds %d points, expected %d"), Stage, Hash.Num(), Mirror.Num()));
+			return;
+		}
+		for (int32 Id = 0; Id < Mirror.Positions.Num(); ++Id)
+		{
+			if (Mirror.Live[Id] && Hash.GetPosition(Id) != Mirror.Positions[Id])
+			{
+				Context.AddError(FString::Printf(TEXT("%s: point %d is not where it was put"), Stage, Id));
+				return;
+			}
+		}
+
+		const FDecimal Tenth(FString(TEXT("0.1")));
+		for (int32 Query = 0; Query < 40; ++Query)
+		{
+			const int32 Id = Random.RandRange(0, Mirror.Positions.Num() - 1);
+			const FDecimalVector Center = (Query % 2 == 0 && Mirror.Live[Id]) ? Mirror.Positions[Id]
+				: Origin + FDecimalVector(FDecimal(Random.RandRange(-600, 600)), FDecimal(Random.RandRange(-600, 600)), FDecimal(Random.RandRange(-600, 600))) * Tenth;
+			const FDecimal Radius = FDecimal(Random.RandRange(0, 300)) * Tenth;
+
+			TArray<int32> Found;
+			Hash.FindInRadius(Center, Radius, Found);
+			Found.Sort();
+			if (Found != Mirror.FindInRadius(Center, Radius))
+			{
+				Context.AddError(FString::Printf(TEXT("%s: FindInRadius with radius %s found %d points, brute force %d"), Stage, *Radius.ToString(1), Found.Num(), Mirror.FindInRadius(Center, Radius).Num()));
+				return;
+			}
+
+			const int32 NumNeighbors = Query % 5 == 0 ? Mirror.Positions.Num() + 1 : Random.RandRange(0, 30);
+			Hash.FindNearest(Center, NumNeighbors, Found);
+			if (Found != Mirror.FindNearest(Center, NumNeighbors))
+			{
+				Context.AddError(FString::Printf(TEXT("%s: FindNearest of %d points differs from brute force"), Stage, NumNeighbors));
+				return;
+			}
+		}
+	}
+
+	/**
+	 * Queries on ParallelFor workers while one task moves, replaces and removes points. Every result must fit some
+	 * committed state: points that never change are always found, moving points are found at one of their two
+	 * positions, positions are never torn, and once the removal of a group is published no query finds it.
+	 */
+	static void CheckConcurrentQueries(FContext& Context)
+	{
+		const FDecimalVector Origin(FDecimal(FString(TEXT("-9876543210.987654321"))), FDecimal(FString(TEXT("555555555.5"))), FDecimal(3));
+		const FDecimal Tenth(FString(TEXT("0.1")));
+		FRandomStream Random(147);
+		const auto MakePosition = [&Random, &Origin, &Tenth](const FDecimalVector& Center, int32 Extent)
+		{
+			return Origin + Center + FDecimalVector(FDecimal(Random.RandRange(-Extent, Extent)), FDecimal(Random.RandRange(-Extent, Extent)), FDecimal(Random.RandRange(-Extent, Extent))) * Tenth;
+		};
+
+		// Fixed points, points moving between two positions that differ on every axis and cross cells, replaced points
+		// on a small set of positions, and a group far from the rest that is removed halfway through.
+		FDecimalSpatialHash Hash(FDecimal(FString(TEXT("2.5"))));
+		TArray<int32> FixedIds;
+		TArray<FDecimalVector> FixedPositions;
+		for (int32 Index = 0; Index < 1000; ++Index)
+		{
+			FixedPositions.Add(MakePosition(FDecimalVector::ZeroVector, 300));
+			FixedIds.Add(Hash.Add(FixedPositions[Index]));
+		}
+		const FDecimalVector MoveOffset(FDecimal(FString(TEXT("3.7"))), FDecimal(FString(TEXT("-2.1"))), FDecimal(FString(TEXT("1.3"))));
+		TArray<int32> MovingIds;
+		TArray<FDecimalVector> MovingFrom;
+		for (int32 Index = 0; Index < 200; ++Index)
+		{
+			MovingFrom.Add(MakePosition(FDecimalVector::ZeroVector, 300));
+			MovingIds.Add(Hash.Add(MovingFrom[Index]));
+		}
+		TArray<FDecimalVector> ReplacedPositions;
+		for (int32 Index = 0; Index < 40; ++Index)
+		{
+			ReplacedPositions.Add(MakePosition(FDecimalVector::ZeroVector, 300));
+		}
+		TArray<int32> ReplacedIds;
+		for (int32 Index = 0; Index < 200; ++Index)
+		{
+			ReplacedIds.Add(Hash.Add(ReplacedPositions[Random.RandRange(0, ReplacedPositions.Num() - 1)]));
+		}
+		const FDecimalVector GoneCenter = Origin + FDecimalVector(FDecimal(500), FDecimal(500), FDecimal(500));
+		TArray<int32> GoneIds;
+		for (int32 Index = 0; Index < 100; ++Index)
+		{
+			GoneIds.Add(Hash.Add(MakePosition(FDecimalVector(FDecimal(500), FDecimal(500), FDecimal(500)), 50)));
+		}
+		const int32 NumFixed = FixedIds.Num();
+		const int32 FirstMoving = MovingIds[0];
+		if (FixedIds[NumFixed - 1] != NumFixed - 1 || FirstMoving != NumFixed)
+		{
+			Context.AddError(TEXT("Add on a new hash returns consecutive ids"));
+			return;
+		}
+
+		std::atomic<bool> bGoneRemoved(false);
+		const int32 NumReaders = 6;
+		TArray<TArray<FString>> Errors;
+		Errors.SetNum(NumReaders + 1);
+
+		ParallelFor(NumReaders + 1, [&](int32 Task)
+		{
+			if (Task == 0)
+			{
+				// The only writer: moves, replacements, and once the removal of the far group is published.
+				FRandomStream WriterRandom(148);
+				TArray<int32> Replaced = ReplacedIds;
+				for (int32 Round = 0; Round < 60; ++Round)
+				{
+					for (int32 Index = 0; Index < MovingIds.Num(); ++Index)
+					{
+						Hash.Move(MovingIds[Index], (Round + Index) % 2 == 0 ? MovingFrom[Index] + MoveOffset : MovingFrom[Index]);
+					}
+					for (int32 Index = 0; Index < 20; ++Index)
+					{
+						const int32 Slot = WriterRandom.RandRange(0, Replaced.Num() - 1);
+						Hash.Remove(Replaced[Slot]);
+						Replaced[Slot] = Hash.Add(ReplacedPositions[WriterRandom.RandRange(0, ReplacedPositions.Num() - 1)]);
+					}
+					if (Round == 30)
+					{
+						for (const int32 Id : GoneIds)
+						{
+							Hash.Remove(Id);
+						}
+						bGoneRemoved.store(true, std::memory_order_release);
+					}
+				}
+				return;
+			}
+
+			TArray<FString>& TaskErrors = Errors[Task];
+			FRandomStream ReaderRandom(148 + Task);
+			TArray<int32> Found;
+			TArray<uint8> Seen;
+			for (int32 Query = 0; Query < 60 && TaskErrors.Num() == 0; ++Query)
+			{
+				const bool bGoneBefore = bGoneRemoved.load(std::memory_order_acquire);
+				const int32 Moving = ReaderRandom.RandRange(0, MovingIds.Num() - 1);
+				const FDecimalVector Position = Hash.GetPosition(MovingIds[Moving]);
+				if (Position != MovingFrom[Moving] && Position != MovingFrom[Moving] + MoveOffset)
+				{
+					TaskErrors.Add(FString::Printf(TEXT("Moving point %d read at a position it never had"), MovingIds[Moving]));
+					break;
+				}
+
+				const FDecimalVector Center = Origin + FDecimalVector(FDecimal(ReaderRandom.RandRange(-300, 300)), FDecimal(ReaderRandom.RandRange(-300, 300)), FDecimal(ReaderRandom.RandRange(-300, 300))) * Tenth;
+				const FDecimal Radius = FDecimal(ReaderRandom.RandRange(0, 80)) * Tenth;
+				const FDecimal RadiusSquared = Radius * Radius;
+				Hash.FindInRadius(Center, Radius, Found);
+				Seen.Reset();
+				Seen.SetNumZeroed(FirstMoving + MovingIds.Num() + ReplacedIds.Num() + GoneIds.Num());
+				for (const int32 Id : Found)
+				{
+					if (!Seen.IsValidIndex(Id) || Seen[Id])
+					{
+						TaskErrors.Add(FString::Printf(TEXT("FindInRadius returned id %d twice or out of range"), Id));
+						break;
+					}
+					Seen[Id] = 1;
+					bool bFits = false;
+					if (Id < NumFixed)
+					{
+						bFits = FDecimalVector::DistSquared(FixedPositions[Id], Center) <= RadiusSquared;
+					}
+					else if (Id < FirstMoving + MovingIds.Num())
+					{
+						const FDecimalVector& From = MovingFrom[Id - FirstMoving];
+						bFits = FDecimalVector::DistSquared(From, Center) <= RadiusSquared || FDecimalVector::DistSquared(From + MoveOffset, Center) <= RadiusSquared;
+					}
+					else
+					{
+						for (const FDecimalVector& Replacement : ReplacedPositions)
+						{
+							bFits |= FDecimalVector::DistSquared(Replacement, Center) <= RadiusSquared;
+						}
+					}
+					if (!bFits)
+					{
+						TaskErrors.Add(FString::Printf(TEXT("FindInRadius returned point %d, which is out of range in every committed state"), Id));
+						break;
+					}
+				}
+				for (int32 Id = 0; Id < FirstMoving + MovingIds.Num() && TaskErrors.Num() == 0; ++Id)
+				{
+					const bool bAlwaysIn = Id < NumFixed ? FDecimalVector::DistSquared(FixedPositions[Id], Center) <= RadiusSquared
+						: FDecimalVector::DistSquared(MovingFrom[Id - FirstMoving], Center) <= RadiusSquared && FDecimalVector::DistSquared(MovingFrom[Id - FirstMoving] + MoveOffset, Center) <= RadiusSquared;
+					if (bAlwaysIn && !Seen[Id])
+					{
+						TaskErrors.Add(FString::Printf(TEXT("FindInRadius missed point %d, which is in range in every committed state"), Id));
+					}
+				}
+
+				// The nearest points are never further than the nearest fixed ones, which are always there.
+				const int32 NumNeighbors = 8;
+				TArray<FDecimal> FixedDistances;
+				for (const FDecimalVector& Fixed : FixedPositions)
+				{
+					FixedDistances.Add(FDecimalVector::DistSquared(Fixed, Center));
+				}
+				Algo::Sort(FixedDistances, [](const FDecimal& A, const FDecimal& B) { return A < B; });
+				Hash.FindNearest(Center, NumNeighbors, Found);
+				if (Found.Num() != NumNeighbors)
+				{
+					TaskErrors.Add(FString::Printf(TEXT("FindNearest returned %d points, expected %d"), Found.Num(), NumNeighbors));
+					break;
+				}
+				for (const int32 Id : Found)
+				{
+					if (Id < NumFixed && FDecimalVector::DistSquared(FixedPositions[Id], Center) > FixedDistances[NumNeighbors - 1])
+					{
+						TaskErrors.Add(FString::Printf(TEXT("FindNearest returned point %d, further than %d fixed points"), Id, NumNeighbors));
+						break;
+					}
+				}
+
+				if (bGoneBefore)
+				{
+					Hash.FindInRadius(GoneCenter, FDecimal(20), Found);
+					if (Found.Num() != 0)
+					{
+						TaskErrors.Add(FString::Printf(TEXT("FindInRadius found %d removed points after their removal was published"), Found.Num()));
+					}
+				}
+			}
+		});
+
+		for (const TArray<FString>& TaskErrors : Errors)
+		{
+			for (const FString& Error : TaskErrors)
+			{
+				Context.AddError(FString::Printf(TEXT("Concurrent queries: %s"), *Error));
+			}
+		}
+		Context.Check(Hash.Num() == NumFixed + MovingIds.Num() + ReplacedIds.Num(), TEXT("Concurrent updates keep every point but the removed group"));
+	}
+
+	void RunSpatialHash(FContext& Context)
+	{
+		// Points on a coarse lattice of tenths, so many lie exactly on cell boundaries and at equal distances, far
+		// enough from the origin that their shadows round.
+		FRandomStream Random(47);
+		const FDecimalVector Origin(FDecimal(FString(TEXT("1234567890.123456789"))), FDecimal(-98765432), FDecimal(FString(TEXT("0.000000001"))));
+		const FDecimal Tenth(FString(TEXT("0.1")));
+		const auto MakePosition = [&Random, &Origin, &Tenth]()
+		{
+			return Origin + FDecimalVector(FDecimal(Random.RandRange(-500, 500)), FDecimal(Random.RandRange(-500, 500)), FDecimal(Random.RandRange(-500, 500))) * Tenth;
+		};
+
+		FDecimalSpatialHash Hash(FDecimal(FString(TEXT("2.5"))));
+		FSpatialHashMirror Mirror;
+		for (int32 Index = 0; Index < 3000; ++Index)
+		{
+			const FDecimalVector Position = MakePosition();
+			Mirror.Set(Hash.Add(Position), Position);
+		}
+
+		// Every point is in the cell that holds it: CellSize * Cell <= Position < CellSize * (Cell + 1) on every axis.
+		for (int32 Id = 0; Id < Mirror.Positions.Num(); ++Id)
+		{
+			const FDecimalVector& Position = Mirror.Positions[Id];
+			const FInt64Vector Cell = Hash.GetCell(Position);
+			const FDecimal& CellSize = Hash.GetCellSize();
+			const bool bInCell = CellSize * FDecimal(Cell.X) <= Position.X && Position.X < CellSize * FDecimal(Cell.X + 1)
+				&& CellSize * FDecimal(Cell.Y) <= Position.Y && Position.Y < CellSize * FDecimal(Cell.Y + 1)
+				&& CellSize * FDecimal(Cell.Z) <= Position.Z && Position.Z < CellSize * FDecimal(Cell.Z + 1);
+			if (!bInCell)
+			{
+				Context.AddError(FString::Printf(TEXT("GetCell of point %d is not the cell that holds it"), Id));
+				break;
+			}
+		}
+		CheckSpatialHashQueries(Context, TEXT("After Add"), Hash, Mirror, Random, Origin);
+
+		// Moves within and across cells, removals, then additions that reuse the removed ids.
+		for (int32 Index = 0; Index < 1000; ++Index)
+		{
+			const int32 Id = Random.RandRange(0, Mirror.Positions.Num() - 1);
+			if (Mirror.Live[Id])
+			{
+				const FDecimalVector Position = Index % 2 == 0 ? MakePosition() : Mirror.Positions[Id] + FDecimalVector(Tenth, FDecimal(0), -Tenth);
+				Hash.Move(Id, Position);
+				Mirror.Set(Id, Position);
+			}
+		}
+		CheckSpatialHashQueries(Context, TEXT("After Move"), Hash, Mirror, Random, Origin);
+
+		for (int32 Index = 0; Index < 800; ++Index)
+		{
+			const int32 Id = Random.RandRange(0, Mirror.Positions.Num() - 1);
+			if (Mirror.Live[Id])
+			{
+				Hash.Remove(Id);
+				Mirror.Live[Id] = 0;
+			}
+		}
+		CheckSpatialHashQueries(Context, TEXT("After Remove"), Hash, Mirror, Random, Origin);
+
+		for (int32 Index = 0; Index < 500; ++Index)
+		{
+			const FDecimalVector Position = MakePosition();
+			const int32 Id = Hash.Add(Position);
+			if (Mirror.Live.IsValidIndex(Id) && Mirror.Live[Id])
+			{
+				Context.AddError(FString::Printf(TEXT("Add returned id %d, which is still in use"), Id));
+				break;
+			}
+			Mirror.Set(Id, Position);
+		}
+		Context.Check(Mirror.Positions.Num() <= 3000, TEXT("Add reuses the ids of removed points"));
+		CheckSpatialHashQueries(Context, TEXT("After reusing ids"), Hash, Mirror, Random, Origin);
+
+		Hash.Reset();
+		Context.Check(Hash.Num() == 0 && Hash.Add(Origin) == 0, TEXT("Reset removes every point and starts ids over"));
+
+		CheckConcurrentQueries(Context);
+	}
+}
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+
+namespace DecimalTestCases
+{
+	// Defined in Decimal<Name>Cases.cpp next to this file.
+	void RunSort(FContext& Context);
+	void RunMath(FContext& Context);
+	void RunRebase(FContext& Context);
+	void RunShadow(FContext& Context);
+	void RunPredicates(FContext& Context);
+	void RunKMeans(FContext& Context);
+	void RunSpatialHash(FContext& Context);
+	void RunBVH(FContext& Context);
+	void RunBarnesHut(FContext& Context);
+	void RunIntegrator(FContext& Context);
+
+	static const FCase Cases[] =
+	{
+		{ TEXT("Sort"), &RunSort },
+		{ TEXT("Math"), &RunMath },
+		{ TEXT("Rebase"), &RunRebase },
+		{ TEXT("Shadow"), &RunShadow },
+		{ TEXT("Predicates"), &RunPredicates },
+		{ TEXT("KMeans"), &RunKMeans },
+		{ TEXT("SpatialHash"), &RunSpatialHash },
+		{ TEXT("BVH"), &RunBVH },
+		{ TEXT("BarnesHut"), &RunBarnesHut },
+		{ TEXT("Integrator"), &RunIntegrator },
+	};
+
+	TConstArrayView<FCase> GetCases()
+	{
+		return MakeArrayView(Cases, UE_ARRAY_COUNT(Cases));
+	}
+}
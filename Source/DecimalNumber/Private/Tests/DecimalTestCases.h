@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Behavior checks of the module's algorithms against simple reference implementations: brute-force scans, exact
+ * FDecimal evaluation or a serial loop. Run by the DecimalNumber.Cases automation tests and by Benchmarks/TestCases
+ * on Linux, one ctest per case.
+ */
+namespace DecimalTestCases
+{
+	/** Failures of the case being run. */
+	struct FContext
+	{
+		TArray<FString> Errors;
+
+		void AddError(const FString& Error)
+		{
+			Errors.Add(Error);
+		}
+
+		/**
+		 * Record a failure unless bCondition holds.
+		 *
+		 * @param bCondition What should hold.
+		 * @param What Description of the check, reported on failure.
+		 * @return bCondition
+		 */
+		bool Check(bool bCondition, const TCHAR* What)
+		{
+			if (!bCondition)
+			{
+				AddError(What);
+			}
+			return bCondition;
+		}
+	};
+
+	struct FCase
+	{
+		/** Case name, stable across versions. */
+		const TCHAR* Name;
+
+		void (*Run)(FContext& Context);
+	};
+
+	/** @return Every case, in a fixed order. */
+	TConstArrayView<FCase> GetCases();
+}
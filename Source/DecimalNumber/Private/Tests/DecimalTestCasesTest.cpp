@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "DecimalTestCases.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FDecimalTestCasesTest, "DecimalNumber.Cases",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+void FDecimalTestCasesTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const DecimalTestCases::FCase& Case : DecimalTestCases::GetCases())
+	{
+		OutBeautifiedNames.Add(Case.Name);
+		OutTestCommands.Add(Case.Name);
+	}
+}
+
+bool FDecimalTestCasesTest::RunTest(const FString& Parameters)
+{
+	for (const DecimalTestCases::FCase& Case : DecimalTestCases::GetCases())
+	{
+		if (Parameters == Case.Name)
+		{
+			DecimalTestCases::FContext Context;
+			Case.Run(Context);
+			for (const FString& Error : Context.Errors)
+			{
+				AddError(Error);
+			}
+			return true;
+		}
+	}
+
+	AddError(FString::Printf(TEXT("Unknown case %s"), *Parameters));
+	return false;
+}
+
+#endif
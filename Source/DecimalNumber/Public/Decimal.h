@@ -1,14 +1,25 @@
 #pragma once
 #include "CoreMinimal.h"
-THIRD_PARTY_INCLUDES_START
-#pragma push_macro("check")
-#undef check
-#include <boost/multiprecision/cpp_dec_float.hpp>
-#pragma pop_macro("check")
-THIRD_PARTY_INCLUDES_END
+#include "DecimalStorage.h"
+#if defined(__cpp_impl_three_way_comparison)
+#include <compare>
+#endif
 #include "Decimal.generated.h"
 
-#define ARITHMETIC_WITH_DECIMAL_CONDITION(Type) std::conditional_t<std::is_arithmetic<##Type>::value || std::is_same<##Type, FDecimal>::value, std::true_type, std::false_type>::value
+// Benchmark builds set DECIMALNUMBER_COUNT_COPIES to 1 to count the bytes of decimal values copied, on all threads.
+#ifndef DECIMALNUMBER_COUNT_COPIES
+#define DECIMALNUMBER_COUNT_COPIES 0
+#endif
+
+#if DECIMALNUMBER_COUNT_COPIES
+#include <atomic>
+extern DECIMALNUMBER_API std::atomic<uint64> GDecimalBytesCopied;
+#define DECIMAL_COUNT_COPY() (GDecimalBytesCopied.fetch_add(sizeof(FDecimal), std::memory_order_relaxed))
+#else
+#define DECIMAL_COUNT_COPY()
+#endif
+
+#define ARITHMETIC_WITH_DECIMAL_CONDITION(Type) std::conditional_t<std::is_arithmetic<Type>::value || std::is_same<Type, FDecimal>::value, std::true_type, std::false_type>::value
 
 #define DEFINE_DECIMAL_OPERATOR_ADD(Type)	\
 FORCEINLINE FDecimal operator+(Type InVal)				\
@@ -21,15 +32,17 @@ struct DECIMALNUMBER_API FDecimal
 {
 	GENERATED_BODY()
 
-	typedef boost::multiprecision::cpp_dec_float_50 InternalValueType;
-	
 public:
 	static FDecimal ConstantPI;
 
 	friend class FDecimalMath;
+	friend struct FDecimalVectorArray;
+	friend struct FDecimalSortKey;
+	friend struct FDecimalDivisor;
+	friend struct FDecimalSectorVector;
+	friend struct FDecimalShadowed;
 public:
 	FDecimal();
-	FDecimal(const InternalValueType& InVal);
 	FDecimal(const FDecimal& InVal);
 	FDecimal(const FString& InVal);
 	FDecimal(int32 InVal);
@@ -120,37 +133,149 @@ public:
 	FDecimal operator/(float Other)  const;
 	FDecimal operator/(double Other)  const;
 
-	bool operator==(const FDecimal& Other)  const;
-	bool operator!=(const FDecimal& Other)  const;
-	bool operator>(const FDecimal& Other)  const;
-	bool operator>=(const FDecimal& Other) const;
-	bool operator<(const FDecimal& Other)  const;
-	bool operator<=(const FDecimal& Other) const;
+	FORCEINLINE bool operator==(const FDecimal& Other)  const
+	{
+		return CompareOrdered(Other) == 0;
+	}
+
+	FORCEINLINE bool operator!=(const FDecimal& Other)  const
+	{
+		return !(*this == Other);
+	}
+
+	FORCEINLINE bool operator>(const FDecimal& Other)  const
+	{
+		return CompareOrdered(Other) == 1;
+	}
+
+	FORCEINLINE bool operator>=(const FDecimal& Other) const
+	{
+		const int32 Result = CompareOrdered(Other);
+		return Result == 0 || Result == 1;
+	}
+
+	FORCEINLINE bool operator<(const FDecimal& Other)  const
+	{
+		return CompareOrdered(Other) == -1;
+	}
+
+	FORCEINLINE bool operator<=(const FDecimal& Other) const
+	{
+		return CompareOrdered(Other) <= 0;
+	}
+
+#if defined(__cpp_impl_three_way_comparison)
+	FORCEINLINE std::partial_ordering operator<=>(const FDecimal& Other) const
+	{
+		const int32 Result = CompareOrdered(Other);
+		return (Result == Unordered) ? std::partial_ordering::unordered : (Result < 0) ? std::partial_ordering::less : (Result > 0) ? std::partial_ordering::greater : std::partial_ordering::equivalent;
+	}
+#endif
+
+	/**
+	 * Three-way comparison. Sign and zero are read straight from the backend, and only numbers of the same sign
+	 * reach the backend comparison.
+	 * NaN orders after every other value and equal to itself, the same total order as FDecimalSortKey.
+	 *
+	 * @param Other The number to compare against.
+	 * @return -1, 0 or 1 if this number is less than, equal to or greater than Other.
+	 */
+	int32 Compare(const FDecimal& Other) const;
+
+	/**
+	 * Three-way comparison of magnitudes, without building absolute values.
+	 *
+	 * @param Other The number to compare against.
+	 * @return -1, 0 or 1 if |this| is less than, equal to or greater than |Other|.
+	 */
+	int32 CompareAbs(const FDecimal& Other) const;
+
+	/** @return -1, 0 or 1 for negative numbers, zero and positive numbers, 0 for NaN. */
+	int32 Sign() const;
+
+	/** @return true if the number is exactly zero. */
+	bool IsZero() const;
+
+	/** @return true if the number is less than zero. */
+	FORCEINLINE bool IsNegative() const
+	{
+		return Sign() < 0;
+	}
 
 	FDecimal operator-() const;
 
 	static bool FromString(const FString& InValue, FDecimal& OutValue);
+
+	/**
+	 * Parses a literal checked by the _dec suffix (DecimalLiteral.h), which calls this once per literal.
+	 *
+	 * @param Text [digits][.digits], not checked again.
+	 * @return The same value as FDecimal(FString(Text)).
+	 */
+	static FDecimal FromLiteral(const ANSICHAR* Text);
 	
 	FString ToString(int32 Precision = 2) const;
 	double ToDouble() const;
 
 private:
-	InternalValueType InternalValue;
+	/**
+	 * Backend value, only usable where DecimalBackend.h is included: the module's own sources.
+	 * Templates so that Decimal.h compiles without the backend's definition.
+	 */
+	template <typename Dummy = void>
+	FORCEINLINE typename TDecimalBackendValue<Dummy>::Type& GetValue()
+	{
+		return *reinterpret_cast<typename TDecimalBackendValue<Dummy>::Type*>(Storage);
+	}
+
+	template <typename Dummy = void>
+	FORCEINLINE const typename TDecimalBackendValue<Dummy>::Type& GetValue() const
+	{
+		return *reinterpret_cast<const typename TDecimalBackendValue<Dummy>::Type*>(Storage);
+	}
+
+	/** @return A decimal holding a copy of Value. Needs DecimalBackend.h, like GetValue. */
+	template <typename Dummy = void>
+	static FORCEINLINE FDecimal FromValue(const typename TDecimalBackendValue<Dummy>::Type& Value)
+	{
+		FDecimal Result(NoInit);
+		new (Result.Storage) typename TDecimalBackendValue<Dummy>::Type(Value);
+		DECIMAL_COUNT_COPY();
+		return Result;
+	}
+
+	/** CompareOrdered result when either number is NaN, in which case the comparison operators are false, like for floats. */
+	static constexpr int32 Unordered = 2;
+
+	/** @return Compare, or Unordered if either number is NaN. The comparison operators are one call into the module. */
+	int32 CompareOrdered(const FDecimal& Other) const;
+
+	/** Leaves the storage uninitialized, for FromValue. */
+	explicit FDecimal(ENoInit)
+	{
+	}
+
+	/**
+	 * The backend value, DecimalBackend::FValue, held inline so FDecimal stays a value type with no allocation.
+	 * Decimal.h only knows its size (DecimalStorage.h), which keeps boost out of every translation unit that uses
+	 * FDecimal. Backend values are trivially destructible, so FDecimal needs no destructor.
+	 */
+	alignas(DECIMALNUMBER_STORAGE_ALIGNMENT) uint8 Storage[DECIMALNUMBER_STORAGE_SIZE];
 };
 
 #define DEFINE_BASIC_DECIMAL_ARITHMETIC(Operator, Type)							\
-static FORCEINLINE FDecimal operator##Operator(Type A, const FDecimal& B)		\
+static FORCEINLINE FDecimal operator Operator(Type A, const FDecimal& B)		\
 {																				\
-	return FDecimal(A) ##Operator B;											\
+	return FDecimal(A) Operator B;											\
 }
 
 #define DEFINE_STRING_DECIMAL_ARITHMETIC(Operator)								\
-static FDecimal operator##Operator(const FString& A, const FDecimal& B)			\
+static FDecimal operator Operator(const FString& A, const FDecimal& B)			\
 {																				\
 	FDecimal Result;															\
 	if (FDecimal::FromString(A, Result))										\
 	{																			\
-		return Result ##Operator B;												\
+		return Result Operator B;												\
 	}																			\
 	return FDecimal();															\
 }
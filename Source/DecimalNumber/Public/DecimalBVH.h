@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+#include "DecimalBox.h"
+
+/**
+ * Bounding volume hierarchy over decimal boxes for box, sphere and ray queries anywhere in the world.
+ *
+ * Nodes store their bounds as doubles relative to the center of the root, the subtraction done at full precision, and
+ * widened by their rounding error so they always contain the exact boxes. Traversal runs entirely in doubles and the
+ * boxes of the leaves it reaches are tested with the exact FDecimalBox tests, so results are those of a brute-force
+ * scan over the boxes however far they are from the origin.
+ *
+ * Build splits the boxes at the median of their centers along the longest axis, building large subtrees in parallel.
+ * The layout of the nodes only depends on the boxes, never on the thread count. Refit updates the bounds after the boxes
+ * move while keeping the tree, which stays correct however far they move but slows down once they are far from where
+ * they were built, at which point building again pays off. Queries may run concurrently, but not with Build or Refit.
+ */
+struct DECIMALNUMBER_API FDecimalBVH
+{
+public:
+	/** Largest number of boxes in a leaf. */
+	static constexpr int32 MaxLeafSize = 4;
+
+	/**
+	 * Build the tree over a set of boxes, replacing the previous one.
+	 *
+	 * @param Boxes Boxes to store, referred to by their index in this array. Invalid boxes are never found by queries.
+	 */
+	void Build(TConstArrayView<FDecimalBox> Boxes);
+
+	/**
+	 * Update the bounds of the tree after the boxes moved, keeping its structure.
+	 *
+	 * @param Boxes New boxes, as many as given to Build and in the same order.
+	 */
+	void Refit(TConstArrayView<FDecimalBox> Boxes);
+
+	/** @return The number of boxes in the tree. */
+	FORCEINLINE int32 Num() const
+	{
+		return Boxes.Num();
+	}
+
+	/** @return A stored box. */
+	FORCEINLINE const FDecimalBox& GetBox(int32 Index) const
+	{
+		return Boxes[Index];
+	}
+
+	/** @return The point node bounds are relative to, the center of all boxes at the last Build. */
+	FORCEINLINE const FDecimalVector& GetOrigin() const
+	{
+		return Origin;
+	}
+
+	/**
+	 * Find the boxes overlapping or touching a box, see FDecimalBox::Intersect.
+	 *
+	 * @param Box Box to test.
+	 * @param OutIndices Receives the indices of the intersecting boxes, in increasing order.
+	 */
+	void QueryBox(const FDecimalBox& Box, TArray<int32>& OutIndices) const;
+
+	/**
+	 * Find the boxes overlapping or touching a sphere, see FDecimalBox::IntersectSphere.
+	 *
+	 * @param Center Center of the sphere.
+	 * @param Radius Radius of the sphere.
+	 * @param OutIndices Receives the indices of the intersecting boxes, in increasing order.
+	 */
+	void QuerySphere(const FDecimalVector& Center, const FDecimal& Radius, TArray<int32>& OutIndices) const;
+
+	/**
+	 * Find the first box a ray enters, see FDecimalBox::IntersectRay.
+	 *
+	 * @param RayOrigin Start of the ray.
+	 * @param Direction Direction of the ray, the hit time is measured in multiples of it.
+	 * @param MaxTime Largest time to consider.
+	 * @param OutIndex Receives the index of the box with the earliest hit time, the lowest index among equal ones.
+	 * @param OutTime Receives the hit time.
+	 * @return true if the ray meets a box within MaxTime.
+	 */
+	bool RayCast(const FDecimalVector& RayOrigin, const FDecimalVector& Direction, const FDecimal& MaxTime, int32& OutIndex, FDecimal& OutTime) const;
+
+private:
+	struct FNode
+	{
+		/** Bounds of the subtree relative to Origin, containing every exact box in it. */
+		FVector Min;
+		FVector Max;
+
+		/** For leaves the first slot of their boxes in Items, otherwise the index of the second child, the first one following the node. */
+		int32 First = 0;
+
+		/** Number of boxes of a leaf, 0 for inner nodes. */
+		int32 Count = 0;
+
+		FORCEINLINE bool IsLeaf() const
+		{
+			return Count > 0;
+		}
+	};
+
+	/** Box of a leaf slot, relative to Origin, with the index it was given at. */
+	struct FItem
+	{
+		FVector Min;
+		FVector Max;
+		int32 Index = INDEX_NONE;
+	};
+
+	/** Split the items in [Begin, End) below a node, in parallel for large ranges. */
+	void BuildNode(int32 NodeIndex, int32 Begin, int32 End);
+
+	/** Recompute the bounds of every item from its box. */
+	void UpdateItems();
+
+	/** Recompute the bounds of every node from its items. */
+	void UpdateNodeBounds();
+
+	/** @return The number of nodes of a subtree over Count boxes. */
+	static int32 GetNumNodes(int32 Count);
+
+	TArray<FDecimalBox> Boxes;
+	FDecimalVector Origin = FDecimalVector::ZeroVector;
+
+	/** Nodes in depth-first order, the root first. */
+	TArray<FNode> Nodes;
+
+	/** Boxes in leaf order, so leaves are contiguous. */
+	TArray<FItem> Items;
+};
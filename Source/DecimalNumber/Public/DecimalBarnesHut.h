@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+
+/**
+ * Barnes-Hut gravity solver over decimal positions.
+ *
+ * Bodies are sorted into an octree whose root corner is a decimal position and whose cells are a decimal size. Every
+ * node is anchored on the integer cell coordinates of its corner, and bodies and centers of mass are double offsets from
+ * the anchor of their cell or node, taken at full precision. The offset between two bodies or nodes is the difference of
+ * their integer anchors, exact in doubles, plus the difference of their small offsets, so nearby bodies keep the
+ * precision of their own cell wherever the system is, where doubles relative to a single origin would not.
+ *
+ * Each body walks the tree on its own and approximates a node by its center of mass when the node is smaller than Theta
+ * times its distance, and never a node containing it. Walks run in parallel and every body sums its forces in the same
+ * order, so results do not depend on the thread count.
+ */
+struct DECIMALNUMBER_API FDecimalBarnesHut
+{
+public:
+	/** Largest number of bodies in a leaf, unless they share a cell of the finest level. */
+	static constexpr int32 MaxLeafSize = 8;
+
+	/** Number of times the root can be halved. The root is 2^MaxDepth cells across, so differences of cell coordinates are exact in doubles. */
+	static constexpr int32 MaxDepth = 52;
+
+	/** Opening angle, nodes are approximated by their center of mass when their size is less than Theta times their distance. 0 sums every pair. */
+	double Theta = 0.5;
+
+	/** Gravitational constant in engine units. */
+	double GravitationalConstant = 1.0;
+
+	/** Plummer softening length, added to every distance in quadrature. */
+	double Softening = 0.0;
+
+	/**
+	 * Build the tree, replacing the previous one.
+	 *
+	 * @param Positions Position of every body.
+	 * @param Masses Mass of every body.
+	 */
+	void Build(TConstArrayView<FDecimalVector> Positions, TConstArrayView<double> Masses);
+
+	/** @return The number of bodies in the tree. */
+	FORCEINLINE int32 Num() const
+	{
+		return Bodies.Num();
+	}
+
+	/** @return The corner of the root of the tree. */
+	FORCEINLINE const FDecimalVector& GetOrigin() const
+	{
+		return Origin;
+	}
+
+	/**
+	 * Compute the gravitational pull of the other bodies on every body.
+	 *
+	 * @param OutAccelerations Receives the acceleration of every body, in the order of Build.
+	 * @param OutPotentials If not empty, receives the gravitational potential at every body, whose total weighted by
+	 * half the masses is the potential energy of the system.
+	 */
+	void ComputeAccelerations(TArrayView<FVector> OutAccelerations, TArrayView<double> OutPotentials = TArrayView<double>()) const;
+
+private:
+	struct FBody
+	{
+		/** Offset from the corner of Cell. */
+		FVector Offset;
+
+		/** Cell of the body, bodies are sorted by it along a Z-order curve. */
+		FInt64Vector Cell;
+		double Mass = 0.0;
+
+		/** Index of the body in Build. */
+		int32 Index = INDEX_NONE;
+	};
+
+	struct FNode
+	{
+		/** Center of mass, offset from the corner of Anchor. */
+		FVector CenterOfMass = FVector::ZeroVector;
+		double Mass = 0.0;
+
+		/** Cell of the corner of the node, which spans 2^Level cells along every axis. */
+		FInt64Vector Anchor;
+		int32 Level = 0;
+
+		/** Range of the node's bodies in Bodies. */
+		int32 First = 0;
+		int32 Count = 0;
+
+		/** Index of the node following the subtree, children follow their parent. */
+		int32 Next = 0;
+
+		bool bLeaf = false;
+	};
+
+	/** Add the subtree over Bodies[Begin, End), the cells within 2^Level of Anchor. */
+	void BuildNode(int32 Begin, int32 End, const FInt64Vector& Anchor, int32 Level);
+
+	/** @return The offset between the corners of two cells. */
+	FORCEINLINE FVector GetCellOffset(const FInt64Vector& To, const FInt64Vector& From) const
+	{
+		return FVector(static_cast<double>(To.X - From.X) * CellSize, static_cast<double>(To.Y - From.Y) * CellSize, static_cast<double>(To.Z - From.Z) * CellSize);
+	}
+
+	/** Corner of cell 0. */
+	FDecimalVector Origin = FDecimalVector::ZeroVector;
+
+	/** Edge length of the cells of the finest level. */
+	double CellSize = 1.0;
+
+	/** Bodies in the order of their cells along a Z-order curve, so every node holds a contiguous range. */
+	TArray<FBody> Bodies;
+
+	/** Nodes in depth-first order, the root first. */
+	TArray<FNode> Nodes;
+};
@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+
+/**
+ * Axis-aligned bounding box with decimal corners, the FBox of FDecimalVector.
+ *
+ * The batch tests compare coordinate shadows first (see FDecimalShadowed) and only compare decimals when two
+ * coordinates are within rounding error of each other, so their results are exact.
+ */
+struct DECIMALNUMBER_API FDecimalBox
+{
+public:
+	/** Holds the box's minimum point. */
+	FDecimalVector Min;
+
+	/** Holds the box's maximum point. */
+	FDecimalVector Max;
+
+	/** Holds a flag indicating whether this box is valid. */
+	bool IsValid;
+
+public:
+	/** Default constructor (invalid, empty box) */
+	FORCEINLINE FDecimalBox()
+		: Min(0)
+		, Max(0)
+		, IsValid(false)
+	{
+	}
+
+	/**
+	 * Creates and initializes a new box from the specified extents.
+	 *
+	 * @param InMin The box's minimum point.
+	 * @param InMax The box's maximum point.
+	 */
+	FORCEINLINE FDecimalBox(const FDecimalVector& InMin, const FDecimalVector& InMax)
+		: Min(InMin)
+		, Max(InMax)
+		, IsValid(true)
+	{
+	}
+
+	/**
+	 * Creates and initializes a new box from the given set of points.
+	 *
+	 * @param Points Points to bound, the box is invalid if there are none.
+	 */
+	explicit FDecimalBox(TConstArrayView<FDecimalVector> Points);
+
+	/** Creates a box centered on Origin, reaching Extent from it along every axis. */
+	static FDecimalBox BuildAABB(const FDecimalVector& Origin, const FDecimalVector& Extent);
+
+	/** Grow the box to contain a point. */
+	FDecimalBox& operator+=(const FDecimalVector& Other);
+
+	/** Grow the box to contain another box, invalid boxes are ignored. */
+	FDecimalBox& operator+=(const FDecimalBox& Other);
+
+	FORCEINLINE FDecimalBox operator+(const FDecimalVector& Other) const
+	{
+		return FDecimalBox(*this) += Other;
+	}
+
+	FORCEINLINE FDecimalBox operator+(const FDecimalBox& Other) const
+	{
+		return FDecimalBox(*this) += Other;
+	}
+
+	bool operator==(const FDecimalBox& Other) const;
+
+	FORCEINLINE bool operator!=(const FDecimalBox& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	/** @return The center of the box. */
+	FDecimalVector GetCenter() const;
+
+	/** @return Half the size of the box along every axis. */
+	FDecimalVector GetExtent() const;
+
+	/** @return The size of the box along every axis. */
+	FORCEINLINE FDecimalVector GetSize() const
+	{
+		return Max - Min;
+	}
+
+	/** @return A box grown by W along every axis, shrunk if W is negative. */
+	FDecimalBox ExpandBy(const FDecimal& W) const;
+
+	/** @return true if Point lies strictly inside the box. */
+	bool IsInside(const FDecimalVector& Point) const;
+
+	/** @return true if Point lies inside the box or on its faces. */
+	bool IsInsideOrOn(const FDecimalVector& Point) const;
+
+	/** @return true if the boxes overlap or touch. */
+	bool Intersect(const FDecimalBox& Other) const;
+
+	/** @return The squared distance from Point to the nearest point of the box, zero inside it. */
+	FDecimal ComputeSquaredDistanceToPoint(const FDecimalVector& Point) const;
+
+	/** @return true if the box and the sphere overlap or touch. */
+	FORCEINLINE bool IntersectSphere(const FDecimalVector& Center, const FDecimal& Radius) const
+	{
+		return !Radius.IsNegative() && ComputeSquaredDistanceToPoint(Center) <= Radius * Radius;
+	}
+
+	/**
+	 * Find where a ray enters the box.
+	 *
+	 * @param Origin Start of the ray.
+	 * @param Direction Direction of the ray, the hit time is measured in multiples of it.
+	 * @param MaxTime Largest time to consider.
+	 * @param OutTime Receives the time in [0, MaxTime] at which the ray enters the box, 0 if it starts inside.
+	 * @return true if the ray meets the box within MaxTime.
+	 */
+	bool IntersectRay(const FDecimalVector& Origin, const FDecimalVector& Direction, const FDecimal& MaxTime, FDecimal& OutTime) const;
+
+	// Batch tests, processed in parallel above the batch grain size (decimal.Batch.GrainSize).
+
+	/**
+	 * Find the points inside the box or on its faces, see IsInsideOrOn.
+	 *
+	 * @param Points Points to test.
+	 * @param OutIndices Receives the indices of the points inside, in increasing order.
+	 */
+	void FindPointsInside(TConstArrayView<FDecimalVector> Points, TArray<int32>& OutIndices) const;
+
+	/**
+	 * Find the boxes overlapping or touching this one, see Intersect.
+	 *
+	 * @param Boxes Boxes to test.
+	 * @param OutIndices Receives the indices of the intersecting boxes, in increasing order.
+	 */
+	void FindIntersecting(TConstArrayView<FDecimalBox> Boxes, TArray<int32>& OutIndices) const;
+};
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+
+struct FDecimalVector;
+
+/**
+ * A divisor prepared once for dividing many numbers by it: a grid size, a scale factor, a count.
+ * Results are bit-identical to operator/ on every backend. cpp_dec_float_50 divides by computing the divisor's reciprocal
+ * and multiplying with it, so the divisor keeps that reciprocal and every division is a single multiplication, about a
+ * fifth of the cost. The other backends divide faster than a reciprocal with an exact correction step would, and keep dividing.
+ */
+struct DECIMALNUMBER_API FDecimalDivisor
+{
+	friend class FDecimalMath;
+	friend struct FDecimalVectorArray;
+
+	/** Divides by one. */
+	FDecimalDivisor();
+
+	explicit FDecimalDivisor(const FDecimal& InDivisor);
+
+	FORCEINLINE const FDecimal& GetDivisor() const
+	{
+		return Divisor;
+	}
+
+	/** @return Value / GetDivisor() */
+	FDecimal Divide(const FDecimal& Value) const;
+
+	/** @return Each component of Value divided by GetDivisor(). */
+	FDecimalVector Divide(const FDecimalVector& Value) const;
+
+private:
+	FDecimal Divisor;
+
+	/** Whatever the backend divides with, see DecimalBackend::Reciprocal. */
+	FDecimal Reciprocal;
+};
+
+FORCEINLINE FDecimal operator/(const FDecimal& A, const FDecimalDivisor& B)
+{
+	return B.Divide(A);
+}
+
+DECIMALNUMBER_API FDecimalVector operator/(const FDecimalVector& A, const FDecimalDivisor& B);
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+#include "DecimalVectorArray.h"
+
+/** Fixed-step schemes of FDecimalIntegrator. */
+enum class EDecimalIntegrator : uint8
+{
+	SymplecticEuler,	// Semi-implicit Euler: velocities first, then positions with the new velocities. One evaluation per step.
+	VelocityVerlet,		// Kick, drift, kick. Second order and symplectic for forces of the positions alone, one evaluation per step.
+	RungeKutta4,		// Classical fourth order Runge-Kutta. Four evaluations per step, for forces that depend on velocities or time.
+};
+
+/**
+ * Fixed-step integrator of second order motion for many bodies at once, with decimal positions and velocities.
+ *
+ * The state lives in structure-of-arrays columns. Accelerations are evaluated in doubles: positions are handed to the
+ * acceleration function relative to Origin, subtracted at full precision, and velocities are rounded to double. The
+ * stages within a step are double offsets from the state at its start, and the decimal state only ever receives the
+ * change of each step, added with FDecimalMath::Batch::AddRelative at decimal precision. Rounding errors are those of
+ * the changes, and do not grow with the distance from the world origin as they would for positions kept in doubles.
+ *
+ * Every pass over the bodies runs in parallel chunks, including the calls to the acceleration function, and scratch
+ * buffers are kept between steps so stepping does not allocate once the number of bodies is stable. Results do not
+ * depend on the thread count as long as the acceleration function does not.
+ */
+struct DECIMALNUMBER_API FDecimalIntegrator
+{
+public:
+	/**
+	 * Computes the acceleration of the bodies in [Begin, End). Called concurrently for disjoint ranges.
+	 *
+	 * @param Begin First body of the range.
+	 * @param End Body following the range.
+	 * @param Time Time of the evaluation, see FDecimalIntegrator::Time.
+	 * @param Positions Position of every body relative to Origin, so forces between bodies can read all of them.
+	 * @param Velocities Velocity of every body.
+	 * @param OutAccelerations Receives the acceleration of the bodies in the range, at the same indices.
+	 */
+	typedef TFunctionRef<void(int32 Begin, int32 End, double Time, TConstArrayView<FVector> Positions, TConstArrayView<FVector> Velocities, TArrayView<FVector> OutAccelerations)> FAccelerationFunc;
+
+	/** Position of every body. */
+	FDecimalVectorArray Positions;
+
+	/** Velocity of every body, as many as Positions. */
+	FDecimalVectorArray Velocities;
+
+	/** Point positions are relative to when they are handed to the acceleration function, e.g. the center of the system. */
+	FDecimalVector Origin = FDecimalVector::ZeroVector;
+
+	/** Time of the state, advanced by every step. */
+	double Time = 0.0;
+
+	/**
+	 * Advance every body by a number of steps of the same length.
+	 *
+	 * @param Method Scheme to step with.
+	 * @param TimeStep Length of every step.
+	 * @param NumSteps Number of steps.
+	 * @param ComputeAccelerations Acceleration of the bodies. Velocity Verlet hands it the velocities half a step ahead.
+	 */
+	void Step(EDecimalIntegrator Method, double TimeStep, int32 NumSteps, FAccelerationFunc ComputeAccelerations);
+
+	/**
+	 * Forget the accelerations Velocity Verlet carries from the end of a step to the start of the next one. Needed after
+	 * changing Positions, Velocities, Origin or Time, or switching to another acceleration function, between two steps.
+	 */
+	void ResetAccelerations();
+
+private:
+	/** Call ComputeAccelerations over every body, in parallel ranges, writing Accelerations. */
+	void Evaluate(FAccelerationFunc ComputeAccelerations, double EvaluationTime, TConstArrayView<FVector> InStagePositions, TConstArrayView<FVector> InStageVelocities);
+
+	void StepSymplecticEuler(double TimeStep, FAccelerationFunc ComputeAccelerations);
+	void StepVelocityVerlet(double TimeStep, FAccelerationFunc ComputeAccelerations);
+	void StepRungeKutta4(double TimeStep, FAccelerationFunc ComputeAccelerations);
+
+	/** Positions relative to Origin and velocities in doubles, at the start of the step. */
+	TArray<FVector> StartPositions;
+	TArray<FVector> StartVelocities;
+
+	/** Positions and velocities of the current stage. */
+	TArray<FVector> StagePositions;
+	TArray<FVector> StageVelocities;
+
+	/** Result of the last evaluation. */
+	TArray<FVector> Accelerations;
+
+	/** Weighted sums of the stage derivatives of Runge-Kutta, the displacement and velocity change of the step. */
+	TArray<FVector> PositionDeltas;
+	TArray<FVector> VelocityDeltas;
+
+	/** Whether Accelerations hold those of the current state, left by the previous Velocity Verlet step. */
+	bool bAccelerationsValid = false;
+};
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+
+/** What a FDecimalKMeans::Run call did, for tuning and benchmarks. */
+struct FDecimalKMeansStats
+{
+	/** Number of times the centers were moved. */
+	int32 NumIterations = 0;
+
+	/** Whether the last assignment left every point with its center, so the centers are a fixed point. */
+	bool bConverged = false;
+
+	/** Point assignments confirmed by the distance bounds, without comparing the point to every center. */
+	int64 NumBoundHits = 0;
+
+	/** Point assignments that compared the point to every center in doubles. */
+	int64 NumFullScans = 0;
+
+	/** Full scans whose nearest centers were too close to tell apart in doubles, and were compared in FDecimal. */
+	int64 NumExactTieBreaks = 0;
+};
+
+/**
+ * Lloyd's k-means clustering of decimal points.
+ *
+ * Points are assigned in parallel on doubles relative to the first point, and every distance carries a bound on its
+ * rounding error. When the nearest two centers are closer than that error, the point is compared to them in FDecimal,
+ * so every point gets the center nearest at full precision, the lowest index among equally near ones. Hamerly's
+ * bounds on the distances to the nearest and second nearest center, kept across iterations with the triangle
+ * inequality, skip the comparison to every center for the points whose center cannot have changed.
+ *
+ * Center sums are accumulated in FDecimal with a fixed reduction tree, then updated in point order as points change
+ * clusters, so the results are bit-identical for identical inputs whatever the number of threads.
+ */
+struct DECIMALNUMBER_API FDecimalKMeans
+{
+public:
+	/**
+	 * Move centers to the mean of the points nearest to them until no point changes cluster.
+	 *
+	 * @param Centers Starting centers, receives the final ones. A center no point is nearest to stays where it is.
+	 * @param Points Points to cluster.
+	 * @param MaxIterations Maximum number of times the centers are moved, 0 only assigns the points.
+	 * @param OutAssignments Receives the index of the center nearest to each point, that is of its cluster.
+	 * @param OutClusterSizes Receives the number of points in each cluster.
+	 * @return What the clustering did. With no points or no centers nothing moves, and points are assigned INDEX_NONE.
+	 */
+	static FDecimalKMeansStats Run(TArray<FDecimalVector>& Centers, TConstArrayView<FDecimalVector> Points, int32 MaxIterations, TArray<int32>& OutAssignments, TArray<int32>& OutClusterSizes);
+};
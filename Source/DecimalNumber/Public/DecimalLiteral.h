@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+
+/**
+ * FDecimal literals: 0.0001_dec, 12'345.678_dec, 1e-3_dec.
+ * The literal is checked and rewritten to plain digits at compile time, and parsed into the backend once, on first use,
+ * into a function-local static. Later uses only read that static, so a literal costs no string conversion on the hot path
+ * and, unlike a global FDecimal, does not depend on static initialization order.
+ * The value is the one FDecimal(TEXT("...")) gives for the same digits. Put a minus in front for negative numbers.
+ */
+namespace DecimalLiteral
+{
+	/** Longest literal after the exponent is expanded, leading zeros included. */
+	static constexpr int32 MaxLength = 128;
+
+	/** A literal rewritten as [digits][.digits], which every backend parses. */
+	struct FCanonicalText
+	{
+		ANSICHAR Chars[MaxLength + 1] = {};
+		int32 Length = 0;
+		bool bValid = false;
+	};
+
+	constexpr bool IsDigit(ANSICHAR Char)
+	{
+		return Char >= '0' && Char <= '9';
+	}
+
+	/**
+	 * Expands the exponent of a decimal literal and drops its digit separators.
+	 *
+	 * @param In The literal as written, without suffix.
+	 * @param InLength Number of characters in In.
+	 * @return The plain literal, bValid is false for hexadecimal, binary and octal literals, or a result over MaxLength.
+	 */
+	constexpr FCanonicalText Canonicalize(const ANSICHAR* In, int32 InLength)
+	{
+		FCanonicalText Result;
+		ANSICHAR Digits[MaxLength] = {};
+		int32 NumDigits = 0;
+		int32 NumIntegerDigits = -1;
+		int32 Index = 0;
+
+		if (InLength > 1 && In[0] == '0' && IsDigit(In[1]))
+		{
+			// Only floating literals may start with 0, for integers it means octal.
+			bool bFloating = false;
+			for (int32 Scan = 0; Scan < InLength; ++Scan)
+			{
+				bFloating |= (In[Scan] == '.' || In[Scan] == 'e' || In[Scan] == 'E');
+			}
+			if (!bFloating)
+			{
+				return Result;
+			}
+		}
+
+		for (; Index < InLength && In[Index] != 'e' && In[Index] != 'E'; ++Index)
+		{
+			if (In[Index] == '.')
+			{
+				if (NumIntegerDigits >= 0)
+				{
+					return Result;
+				}
+				NumIntegerDigits = NumDigits;
+			}
+			else if (IsDigit(In[Index]))
+			{
+				if (NumDigits == MaxLength)
+				{
+					return Result;
+				}
+				Digits[NumDigits++] = In[Index];
+			}
+			else if (In[Index] != '\'')
+			{
+				return Result;
+			}
+		}
+		if (NumDigits == 0)
+		{
+			return Result;
+		}
+		if (NumIntegerDigits < 0)
+		{
+			NumIntegerDigits = NumDigits;
+		}
+
+		if (Index < InLength)
+		{
+			bool bNegativeExponent = false;
+			++Index;
+			if (Index < InLength && (In[Index] == '+' || In[Index] == '-'))
+			{
+				bNegativeExponent = (In[Index] == '-');
+				++Index;
+			}
+			if (Index == InLength)
+			{
+				return Result;
+			}
+
+			int32 Exponent = 0;
+			for (; Index < InLength; ++Index)
+			{
+				if (!IsDigit(In[Index]) || Exponent > MaxLength)
+				{
+					return Result;
+				}
+				Exponent = Exponent * 10 + (In[Index] - '0');
+			}
+			NumIntegerDigits += bNegativeExponent ? -Exponent : Exponent;
+		}
+
+		if (NumIntegerDigits <= 0)
+		{
+			if (2 - NumIntegerDigits + NumDigits > MaxLength)
+			{
+				return Result;
+			}
+			Result.Chars[Result.Length++] = '0';
+			Result.Chars[Result.Length++] = '.';
+			for (int32 Zero = 0; Zero < -NumIntegerDigits; ++Zero)
+			{
+				Result.Chars[Result.Length++] = '0';
+			}
+			for (int32 Digit = 0; Digit < NumDigits; ++Digit)
+			{
+				Result.Chars[Result.Length++] = Digits[Digit];
+			}
+		}
+		else
+		{
+			if (NumIntegerDigits + 1 + NumDigits > MaxLength)
+			{
+				return Result;
+			}
+			for (int32 Digit = 0; Digit < NumIntegerDigits; ++Digit)
+			{
+				Result.Chars[Result.Length++] = (Digit < NumDigits) ? Digits[Digit] : '0';
+			}
+			if (NumIntegerDigits < NumDigits)
+			{
+				Result.Chars[Result.Length++] = '.';
+				for (int32 Digit = NumIntegerDigits; Digit < NumDigits; ++Digit)
+				{
+					Result.Chars[Result.Length++] = Digits[Digit];
+				}
+			}
+		}
+
+		Result.bValid = true;
+		return Result;
+	}
+
+	template <ANSICHAR... Chars>
+	struct TLiteral
+	{
+		static constexpr ANSICHAR Source[] = { Chars... };
+		static constexpr FCanonicalText Text = Canonicalize(Source, sizeof...(Chars));
+
+		static const FDecimal& Get()
+		{
+			static const FDecimal Value = FDecimal::FromLiteral(Text.Chars);
+			return Value;
+		}
+	};
+}
+
+template <ANSICHAR... Chars>
+FORCEINLINE const FDecimal& operator""_dec()
+{
+	static_assert(DecimalLiteral::TLiteral<Chars...>::Text.bValid, "_dec needs a decimal literal, like 0.25_dec, 12'000_dec or 1e-3_dec, of at most DecimalLiteral::MaxLength digits once the exponent is expanded");
+	return DecimalLiteral::TLiteral<Chars...>::Get();
+}
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "Decimal.h"
-#include "DecimalVector.h"
+#include "DecimalDivisor.h"
+
+struct FDecimalVector;
+struct FDecimalVectorArray;
 
 class DECIMALNUMBER_API FDecimalMath
 {
@@ -32,54 +35,87 @@ public:
 	static FDecimal Atan2(const FDecimal& A, const FDecimal& B);
 
 	template <typename Type, TEMPLATE_REQUIRES(ARITHMETIC_WITH_DECIMAL_CONDITION(Type))>
-	static FDecimal Power(const FDecimal& InVal, Type InPow)
+	static FORCEINLINE FDecimal Power(const FDecimal& InVal, Type InPow)
 	{
-		FDecimal Result;
-		Result.InternalValue = boost::multiprecision::pow(InVal.InternalValue, InPow);
-		return Result;
+		if constexpr (std::is_same_v<Type, FDecimal>)
+		{
+			return PowerDecimal(InVal, InPow);
+		}
+		else if constexpr (std::is_integral_v<Type>)
+		{
+			return PowerInteger(InVal, static_cast<int64>(InPow));
+		}
+		else
+		{
+			// Every float is exactly a double, so this is the same power as with the float.
+			return PowerFloat(InVal, static_cast<double>(InPow));
+		}
 	}
 
+	/** Power for a decimal exponent. */
+	static FDecimal PowerDecimal(const FDecimal& InVal, const FDecimal& InPow);
+
+	/** Power for an integer exponent, by repeated multiplication. */
+	static FDecimal PowerInteger(const FDecimal& InVal, int64 InPow);
+
+	/** Power for a floating-point exponent, converted exactly to a decimal. */
+	static FDecimal PowerFloat(const FDecimal& InVal, double InPow);
+
 	static void SindCos(FDecimal& ScalarSin, FDecimal& ScalarCos, const FDecimal& Value);
 
+	static FORCEINLINE void SinCos(FDecimal& ScalarSin, FDecimal& ScalarCos, const FDecimal& Value)
+	{
+		SindCos(ScalarSin, ScalarCos, Value);
+	}
+
 	static void SindCos(FDecimal& ScalarSin, FDecimal& ScalarCos, float Value);
 	static void SindCos(FDecimal& ScalarSin, FDecimal& ScalarCos, double Value);
 
 	static FDecimal UnwindDegrees(FDecimal A);
 
-	static FORCEINLINE bool IsFinite(const FDecimal& InVal)
-	{
-		return 	boost::multiprecision::isfinite(InVal.InternalValue);
-	}
+	static bool IsFinite(const FDecimal& InVal);
 
 	static FORCEINLINE bool IsNearlyZero(const FDecimal& Value, const FDecimal& ErrorTolerance = FDecimal(UE_DOUBLE_SMALL_NUMBER))
 	{
-		return Abs(Value) <= ErrorTolerance;
+		return Value.CompareAbs(ErrorTolerance) <= 0;
 	}
 
 	static FORCEINLINE FDecimal DegreesToRadians(FDecimal const& DegVal)
 	{
-		return DegVal * (FDecimal::ConstantPI / 180.0f);
+		return DegVal * RadiansPerDegree();
 	}
 
-	template <typename T, TEMPLATE_REQUIRES(std::is_arithmetic<T>::value)>
-	static FORCEINLINE FDecimal PlaneDot(const UE::Math::TPlane<T>& Plane, const FDecimalVector& Point)
+	static FORCEINLINE FDecimal RadiansToDegrees(FDecimal const& RadVal)
 	{
-		return Plane.X * Point.X + Plane.Y * Point.Y + Plane.Z * Point.Z - Plane.W;
+		return RadVal * DegreesPerRadian();
 	}
 
+	/** @return Pi / 180, divided once on first use. */
+	static const FDecimal& RadiansPerDegree();
+
+	/** @return 180 / Pi, divided once on first use. */
+	static const FDecimal& DegreesPerRadian();
+
+	/** Defined at the end of DecimalVector.h, TPlane<T> already restricts T to floating point types. */
+	template <typename T>
+	static FORCEINLINE FDecimal PlaneDot(const UE::Math::TPlane<T>& Plane, const FDecimalVector& Point);
+
 	static FORCEINLINE FDecimal GridSnap(const FDecimal& Location, const FDecimal& Grid)
 	{
-		return (Grid == 0) ? Location : (Floor((Location + (Grid / 2)) / Grid) * Grid);
+		return (Grid == 0) ? Location : GridSnap(Location, FDecimalDivisor(Grid));
 	}
 
+	/** GridSnap for snapping many locations to the same grid, the grid size is only inverted once. */
+	static FDecimal GridSnap(const FDecimal& Location, const FDecimalDivisor& Grid);
+
 	static FORCEINLINE FDecimal Min(const FDecimal& A, const FDecimal& B)
 	{
-		return (A <= B) ? A : B;
+		return (A.Compare(B) <= 0) ? A : B;
 	}
 
 	static FORCEINLINE FDecimal Max(const FDecimal& A, const FDecimal& B)
 	{
-		return (A >= B) ? A : B;
+		return (A.Compare(B) >= 0) ? A : B;
 	}
 
 	static FORCEINLINE FDecimal Min3(const FDecimal& A, const FDecimal& B, const FDecimal& C)
@@ -94,6 +130,161 @@ public:
 
 	static FORCEINLINE FDecimal Clamp(const FDecimal& InVal, const FDecimal& Min, const FDecimal& Max)
 	{
-		return (InVal < Min) ? Min : (InVal < Max) ? InVal : Max;
+		return (InVal.Compare(Min) < 0) ? Min : (InVal.Compare(Max) < 0) ? InVal : Max;
 	}
-};
\ No newline at end of file
+
+public:
+	/**
+	 * Element-wise versions of the scalar functions over spans of decimals.
+	 * Inputs above the grain size (decimal.Batch.GrainSize) are split into chunks and processed with ParallelFor.
+	 * Chunk sizes are whole cache lines of elements. Arrays are not aligned to cache lines, so neighboring chunks may still
+	 * share the one line at their boundary.
+	 * Outputs must have the same number of elements as the inputs, and may alias an input.
+	 */
+	struct DECIMALNUMBER_API Batch
+	{
+		/** Out[i] = A[i] + B[i] */
+		static void Add(TConstArrayView<FDecimal> A, TConstArrayView<FDecimal> B, TArrayView<FDecimal> Out);
+
+		/** Out[i] = A[i] * B[i] */
+		static void Mul(TConstArrayView<FDecimal> A, TConstArrayView<FDecimal> B, TArrayView<FDecimal> Out);
+
+		/** Out[i] = A[i] / B[i] */
+		static void Div(TConstArrayView<FDecimal> A, TConstArrayView<FDecimal> B, TArrayView<FDecimal> Out);
+
+		/** Out[i] = A[i] / B, see FDecimalDivisor. */
+		static void Div(TConstArrayView<FDecimal> A, const FDecimalDivisor& B, TArrayView<FDecimal> Out);
+
+		/** Out[i] = Sqrt(In[i]) */
+		static void Sqrt(TConstArrayView<FDecimal> In, TArrayView<FDecimal> Out);
+
+		/** Out[i] = Sin(In[i]) */
+		static void Sin(TConstArrayView<FDecimal> In, TArrayView<FDecimal> Out);
+
+		/** Out[i] = Cos(In[i]) */
+		static void Cos(TConstArrayView<FDecimal> In, TArrayView<FDecimal> Out);
+
+		/** Out[i] = Power(In[i], Exponent) */
+		static void Power(TConstArrayView<FDecimal> In, const FDecimal& Exponent, TArrayView<FDecimal> Out);
+
+		/** Out[i] = Power(In[i], Exponent), using repeated multiplication for the integral exponent. */
+		static void Power(TConstArrayView<FDecimal> In, int32 Exponent, TArrayView<FDecimal> Out);
+
+		/** Out[i] = Floor(In[i]) */
+		static void Floor(TConstArrayView<FDecimal> In, TArrayView<FDecimal> Out);
+
+		/** Out[i] = Clamp(In[i], Min, Max) */
+		static void Clamp(TConstArrayView<FDecimal> In, const FDecimal& Min, const FDecimal& Max, TArrayView<FDecimal> Out);
+
+		// Reductions. The reduction tree only depends on the number of elements, so results are bit-identical for any thread count.
+
+		/** @return Sum of all values, zero when empty. */
+		static FDecimal Sum(TConstArrayView<FDecimal> Values);
+
+		/**
+		 * Find the smallest value.
+		 *
+		 * @param Values Values to search.
+		 * @param MinIndex Optionally receives the first index holding the smallest value, INDEX_NONE when empty.
+		 * @return The smallest value, zero when empty.
+		 */
+		static FDecimal Min(TConstArrayView<FDecimal> Values, int32* MinIndex = nullptr);
+
+		/**
+		 * Find the largest value.
+		 *
+		 * @param Values Values to search.
+		 * @param MaxIndex Optionally receives the first index holding the largest value, INDEX_NONE when empty.
+		 * @return The largest value, zero when empty.
+		 */
+		static FDecimal Max(TConstArrayView<FDecimal> Values, int32* MaxIndex = nullptr);
+
+		/** @return Arithmetic mean of all values, zero when empty. */
+		static FDecimal Mean(TConstArrayView<FDecimal> Values);
+
+		/** @return Population variance of all values, zero when empty. */
+		static FDecimal Variance(TConstArrayView<FDecimal> Values);
+
+		/** @return Average position of all points, zero vector when empty. */
+		static FDecimalVector Centroid(TConstArrayView<FDecimalVector> Points);
+
+		/** @return Average position of all points, zero vector when empty. */
+		static FDecimalVector Centroid(const FDecimalVectorArray& Points);
+
+		/**
+		 * Compute the axis aligned bounds of a set of points.
+		 *
+		 * @param Points Points to bound.
+		 * @param OutMin Receives the component-wise minimum.
+		 * @param OutMax Receives the component-wise maximum.
+		 * @return false if there are no points, in which case the outputs are untouched.
+		 */
+		static bool Bounds(TConstArrayView<FDecimalVector> Points, FDecimalVector& OutMin, FDecimalVector& OutMax);
+
+		/**
+		 * Compute the axis aligned bounds of a set of points.
+		 *
+		 * @param Points Points to bound.
+		 * @param OutMin Receives the component-wise minimum.
+		 * @param OutMax Receives the component-wise maximum.
+		 * @return false if there are no points, in which case the outputs are untouched.
+		 */
+		static bool Bounds(const FDecimalVectorArray& Points, FDecimalVector& OutMin, FDecimalVector& OutMax);
+
+		// Origin-relative conversion, for handing positions far from the world origin to the engine, e.g. around the camera.
+
+		/**
+		 * Write every point relative to an origin as an engine vector.
+		 * Each difference is taken at full precision and then converted directly to double, so only the offset is rounded.
+		 *
+		 * @param Origin Position subtracted from every point.
+		 * @param Points Positions to convert.
+		 * @param Out Receives Points[i] - Origin, must have as many elements as Points.
+		 */
+		static void ToRelative(const FDecimalVector& Origin, TConstArrayView<FDecimalVector> Points, TArrayView<FVector> Out);
+
+		/** Single precision version of ToRelative, each offset is rounded to float from its double. */
+		static void ToRelative(const FDecimalVector& Origin, TConstArrayView<FDecimalVector> Points, TArrayView<FVector3f> Out);
+
+		/** Version of ToRelative reading the points from a structure-of-arrays container. */
+		static void ToRelative(const FDecimalVector& Origin, const FDecimalVectorArray& Points, TArrayView<FVector> Out);
+
+		/** Single precision version of ToRelative reading the points from a structure-of-arrays container. */
+		static void ToRelative(const FDecimalVector& Origin, const FDecimalVectorArray& Points, TArrayView<FVector3f> Out);
+
+		/**
+		 * Version of ToRelative that only converts some of the points, e.g. the ones that moved since the last conversion.
+		 *
+		 * @param Origin Position subtracted from every point.
+		 * @param Points Positions to convert.
+		 * @param Indices Distinct indices of the points to convert.
+		 * @param Out Receives Points[Indices[i]] - Origin at Indices[i], must have as many elements as Points.
+		 */
+		static void ToRelative(const FDecimalVector& Origin, TConstArrayView<FDecimalVector> Points, TConstArrayView<int32> Indices, TArrayView<FVector> Out);
+
+		/**
+		 * Move every point by an engine vector, the inverse of ToRelative.
+		 * Each offset is scaled in doubles, converted to a decimal and added. The conversion is exact with BinFloat, rounds to
+		 * the backend's 50 significant digits by default (a double can need up to 767) and to the 1e-18 grid with Fixed128.
+		 * The sum then rounds to the decimal precision, except with Fixed128 where it is exact within range.
+		 *
+		 * @param Offsets Offset of every point.
+		 * @param Scale What to multiply each offset by, e.g. a time step when the offsets are velocities.
+		 * @param Points Positions to move by Offsets[i] * Scale, must have as many elements as Offsets.
+		 */
+		static void AddRelative(TConstArrayView<FVector> Offsets, double Scale, FDecimalVectorArray& Points);
+
+		/** @return Minimum number of elements handed to a single task. */
+		static int32 GetGrainSize();
+
+		/**
+		 * Limit the number of tasks a single batch call is split into, mainly for measuring scaling.
+		 *
+		 * @param InMaxTasks Maximum number of tasks, 0 for no limit.
+		 */
+		static void SetMaxTasks(int32 InMaxTasks);
+	};
+};
+
+// FDecimalVector includes this header for its own inline math, so it is pulled in last.
+#include "DecimalVector.h"
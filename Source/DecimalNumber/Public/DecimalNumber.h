@@ -14,5 +14,6 @@ public:
 	virtual void ShutdownModule() override;
 
 private:
-	TArray<void*> Handles;
+	/** Closes a frame of the decimal.stats conversion counters at the end of every engine frame. */
+	FDelegateHandle EndFrameHandle;
 };
@@ -17,4 +17,20 @@ class DECIMALNUMBER_API UDecimalNumberFunctionLibrary : public UBlueprintFunctio
 public:
 	UFUNCTION(BlueprintCallable)
 	static void TestDecimal();
+
+	/**
+	 * Measure how FDecimalMath::Batch operations scale from one task up to one task per logical core, and log the results.
+	 *
+	 * @param NumElements Number of elements in each input span.
+	 */
+	UFUNCTION(BlueprintCallable)
+	static void BenchmarkBatchScaling(int32 NumElements = 100000);
+
+	/**
+	 * Compare FDecimalSort against Algo::Sort on the same random numbers, and log the results.
+	 *
+	 * @param NumElements Number of numbers to sort.
+	 */
+	UFUNCTION(BlueprintCallable)
+	static void BenchmarkSort(int32 NumElements = 1000000);
 };
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+#include "DecimalShadow.h"
+
+/**
+ * Geometric predicates over decimal points: orientation, in-sphere and side-of-plane tests.
+ *
+ * Every predicate is first evaluated in doubles on the points' shadows (see FDecimalShadowed), carrying a bound on the
+ * error of every intermediate, from the conversion of the coordinates on. When the result is further from zero than
+ * its bound, its sign is the exact one and is returned, otherwise the predicate is evaluated again in FDecimal.
+ * Only nearly degenerate inputs, points within rounding error of the line, plane or sphere, pay for decimal math.
+ * Benchmark builds count both outcomes with the shadow counters (DECIMALNUMBER_SHADOW_STATS).
+ *
+ * The decimal evaluation is exact as long as its products fit the backend's digits: coordinate differences of up to
+ * 25 significant digits for PlaneSide and Orient2D, 16 for Orient3D and 10 for InSphere. Beyond that it is as precise
+ * as any FDecimal computation.
+ *
+ * Overloads taking FDecimalShadowedVector skip converting the coordinates, the cheapest way to run many queries over
+ * the same points.
+ */
+struct DECIMALNUMBER_API FDecimalPredicates
+{
+public:
+	/**
+	 * Orientation of three points in the XY plane, Z is ignored.
+	 *
+	 * @return Sign of the Z component of (A - C) ^ (B - C): 1 if A, B and C turn counterclockwise with X to the right
+	 * and Y up, -1 if clockwise, 0 if they are collinear.
+	 */
+	static int32 Orient2D(const FDecimalVector& A, const FDecimalVector& B, const FDecimalVector& C);
+	static int32 Orient2D(const FDecimalShadowedVector& A, const FDecimalShadowedVector& B, const FDecimalShadowedVector& C);
+
+	/**
+	 * Orientation of a point relative to the plane through three others.
+	 *
+	 * @return Sign of (A - D) | ((B - D) ^ (C - D)), the triple product FDecimalVector::Triple computes: 1 if D lies
+	 * on the side of the plane ABC from which A, B and C appear clockwise, -1 on the other side, 0 if the four points
+	 * are coplanar.
+	 */
+	static int32 Orient3D(const FDecimalVector& A, const FDecimalVector& B, const FDecimalVector& C, const FDecimalVector& D);
+	static int32 Orient3D(const FDecimalShadowedVector& A, const FDecimalShadowedVector& B, const FDecimalShadowedVector& C, const FDecimalShadowedVector& D);
+
+	/**
+	 * Position of a point relative to the sphere through four others.
+	 *
+	 * @return For A, B, C and D with Orient3D(A, B, C, D) > 0: 1 if E lies inside their circumsphere, -1 if outside,
+	 * 0 if on it. The sign flips when Orient3D is negative, and is 0 for coplanar A, B, C and D.
+	 */
+	static int32 InSphere(const FDecimalVector& A, const FDecimalVector& B, const FDecimalVector& C, const FDecimalVector& D, const FDecimalVector& E);
+	static int32 InSphere(const FDecimalShadowedVector& A, const FDecimalShadowedVector& B, const FDecimalShadowedVector& C, const FDecimalShadowedVector& D, const FDecimalShadowedVector& E);
+
+	/**
+	 * Side of a plane a point lies on, the sign of FDecimalVector::PointPlaneDist.
+	 *
+	 * @param Point The point to classify.
+	 * @param PlaneBase Any point on the plane.
+	 * @param PlaneNormal Normal of the plane, need not be normalized.
+	 * @return 1 if Point is on the side PlaneNormal points to, -1 if on the other side, 0 if on the plane.
+	 */
+	static int32 PlaneSide(const FDecimalVector& Point, const FDecimalVector& PlaneBase, const FDecimalVector& PlaneNormal);
+	static int32 PlaneSide(const FDecimalShadowedVector& Point, const FDecimalShadowedVector& PlaneBase, const FDecimalShadowedVector& PlaneNormal);
+};
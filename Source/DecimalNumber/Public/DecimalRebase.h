@@ -0,0 +1,143 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+
+/**
+ * Decimal positions and their render-space offsets from a rebasing origin, kept up to date incrementally.
+ *
+ * The render origin follows the view, but only jumps once the view is more than the rebase threshold away from it.
+ * Until then Update only converts the positions that changed since the last update, and when the origin jumps it
+ * converts all of them in one batch. Render positions are Position - GetRenderOrigin(), subtracted at full precision
+ * and rounded once (see FDecimalMath::Batch::ToRelative).
+ *
+ * Positions are addressed by the id Add returns. Ids of removed positions are reused by later calls to Add.
+ */
+struct DECIMALNUMBER_API FDecimalRebaseSet
+{
+public:
+	/** Empty set with a rebase threshold of one kilometre. */
+	FDecimalRebaseSet();
+
+	/**
+	 * Register a position. Its render position is valid after the next Update.
+	 *
+	 * @param Position Position in decimal world space.
+	 * @return Id of the position.
+	 */
+	int32 Add(const FDecimalVector& Position);
+
+	/**
+	 * Unregister a position, its id may be handed out again.
+	 *
+	 * @param Id Id returned by Add.
+	 */
+	void Remove(int32 Id);
+
+	/**
+	 * Move a position. Its render position is updated by the next Update.
+	 *
+	 * @param Id Id returned by Add.
+	 * @param Position New position in decimal world space.
+	 */
+	void SetPosition(int32 Id, const FDecimalVector& Position);
+
+	/** @return Whether Id refers to a registered position. */
+	FORCEINLINE bool IsValid(int32 Id) const
+	{
+		return Flags.IsValidIndex(Id) && (Flags[Id] & Flag_Registered) != 0;
+	}
+
+	FORCEINLINE const FDecimalVector& GetPosition(int32 Id) const
+	{
+		check(IsValid(Id));
+		return Positions[Id];
+	}
+
+	/** @return Position of Id relative to GetRenderOrigin(), as of the last Update. */
+	FORCEINLINE const FVector& GetRenderPosition(int32 Id) const
+	{
+		check(IsValid(Id));
+		return RenderPositions[Id];
+	}
+
+	/** @return Render positions indexed by id, entries of unregistered ids are meaningless. */
+	FORCEINLINE TConstArrayView<FVector> GetRenderPositions() const
+	{
+		return RenderPositions;
+	}
+
+	/** @return Origin the render positions are relative to. */
+	FORCEINLINE const FDecimalVector& GetRenderOrigin() const
+	{
+		return RenderOrigin;
+	}
+
+	/** @return Number of registered positions. */
+	FORCEINLINE int32 Num() const
+	{
+		return NumRegistered;
+	}
+
+	/** @return Number of positions added or moved since the last Update. */
+	FORCEINLINE int32 GetNumDirty() const
+	{
+		return DirtyIds.Num();
+	}
+
+	FORCEINLINE const FDecimal& GetRebaseThreshold() const
+	{
+		return RebaseThreshold;
+	}
+
+	/**
+	 * Set how far the view may get from the render origin before the origin is moved to the view.
+	 * Larger thresholds mean fewer full updates but larger render-space coordinates around the view.
+	 *
+	 * @param InRebaseThreshold Distance in engine units.
+	 */
+	void SetRebaseThreshold(const FDecimal& InRebaseThreshold);
+
+	/**
+	 * Bring the render positions up to date for a view at ViewOrigin.
+	 * The first update, and every update with the view beyond the rebase threshold, moves the render origin to the
+	 * view and converts every position. Other updates convert only the positions added or moved since the last one.
+	 *
+	 * @param ViewOrigin Position of the view in decimal world space.
+	 * @return true if the render origin moved, in which case every render position changed.
+	 */
+	bool Update(const FDecimalVector& ViewOrigin);
+
+private:
+	enum EFlags : uint8
+	{
+		Flag_Registered = 1 << 0,
+		Flag_Dirty = 1 << 1,
+	};
+
+	/** Queue Id for the next Update. */
+	void MarkDirty(int32 Id);
+
+	TArray<FDecimalVector> Positions;
+	TArray<FVector> RenderPositions;
+
+	/** EFlags per id. */
+	TArray<uint8> Flags;
+
+	/** Ids added or moved since the last Update, each listed once. */
+	TArray<int32> DirtyIds;
+
+	/** Unregistered ids, reused last in first out. */
+	TArray<int32> FreeIds;
+
+	FDecimalVector RenderOrigin;
+	FDecimal RebaseThreshold;
+	FDecimal RebaseThresholdSquared;
+	int32 NumRegistered;
+
+	/** Whether Update has placed the render origin yet. */
+	bool bHasRenderOrigin;
+};
@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DecimalRebase.h"
+#include "DecimalRebaseSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDecimalRebased, const FDecimalVector& /*NewRenderOrigin*/);
+
+/**
+ * Owns the decimal positions of a world and their render-space FVectors, so systems no longer convert their own
+ * positions every tick. Systems register positions and move them through the subsystem, the owner of the view sets
+ * the view origin, and every tick only the positions that moved are converted, or all of them once the view has
+ * moved beyond the rebase threshold (see FDecimalRebaseSet).
+ */
+UCLASS()
+class DECIMALNUMBER_API UDecimalRebaseSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** @return Id of the new position, its render position is valid after the next tick. */
+	int32 RegisterPosition(const FDecimalVector& Position);
+
+	void UnregisterPosition(int32 Id);
+
+	/** Move a registered position, its render position is updated on the next tick. */
+	void SetPosition(int32 Id, const FDecimalVector& Position);
+
+	/** Set the position of the view in decimal world space, render positions follow it from the next tick on. */
+	void SetViewOrigin(const FDecimalVector& InViewOrigin);
+
+	/** @return Position of Id relative to GetRenderOrigin(), as of the last tick. */
+	FORCEINLINE const FVector& GetRenderPosition(int32 Id) const
+	{
+		return Positions.GetRenderPosition(Id);
+	}
+
+	FORCEINLINE const FDecimalVector& GetRenderOrigin() const
+	{
+		return Positions.GetRenderOrigin();
+	}
+
+	/** @return All positions, for reading render positions in bulk. */
+	FORCEINLINE const FDecimalRebaseSet& GetPositions() const
+	{
+		return Positions;
+	}
+
+	/** See FDecimalRebaseSet::SetRebaseThreshold. */
+	void SetRebaseThreshold(const FDecimal& InRebaseThreshold);
+
+	/** Bring render positions up to date right away instead of on the next tick. */
+	void UpdateRenderPositions();
+
+	/** Broadcast after the render origin moved, every render position changed. */
+	FOnDecimalRebased OnRebased;
+
+	// UTickableWorldSubsystem
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	FDecimalRebaseSet Positions;
+
+	FDecimalVector ViewOrigin;
+
+	/** Whether SetViewOrigin was called, nothing is converted before. */
+	bool bHasViewOrigin = false;
+};
@@ -0,0 +1,187 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+
+/**
+ * Large-world position stored as an integer sector coordinate plus a double offset inside the sector.
+ *
+ * Sectors are cubes of SectorSize engine units, a power of two, so sector corners are exact in doubles and in decimals.
+ * Moving a position and measuring between positions runs in doubles: the difference of two positions is the sector
+ * difference times SectorSize, which is exact, plus the difference of the offsets, so it is accurate to about one unit
+ * in the last place of the result however far apart the sectors are. Only sector differences beyond 2^32, where the
+ * sector term stops being exact in a double, escalate to FDecimal.
+ *
+ * Converting to FDecimalVector is exact while Sector * SectorSize + Offset fits the backend: 50 significant digits for
+ * the default backend and about 166 bits for BinFloat, which far sectors with finely resolved offsets can exceed.
+ * With Fixed128 it must also lie within about 1.7e20 units (sectors below 2^47) and on its grid of 18 fractional
+ * digits. Beyond that the conversion rounds to the backend's precision, and past the Fixed128 range it saturates.
+ * Converting from FDecimalVector rounds each offset to the nearest double, a resolution of 2^-33 units at the far end
+ * of a sector, so the round trip gives the same sector vector bit for bit as long as any rounding on the way to
+ * FDecimalVector stays below half a unit in the last place of the offset.
+ */
+struct DECIMALNUMBER_API FDecimalSectorVector
+{
+public:
+	/** Edge length of a sector in engine units, about 10.5 km. */
+	static constexpr double SectorSize = 1048576.0;
+
+	/** Sector coordinate, the position is Sector * SectorSize + Offset. */
+	FInt64Vector Sector;
+
+	/** Offset inside the sector, every component in [0, SectorSize). */
+	FVector Offset;
+
+public:
+	/** Default constructor (origin) */
+	FORCEINLINE FDecimalSectorVector()
+		: Sector(0, 0, 0)
+		, Offset(0.0, 0.0, 0.0)
+	{
+	}
+
+	/**
+	 * Constructor from a sector and an offset, which may lie outside the sector.
+	 *
+	 * @param InSector Sector coordinate.
+	 * @param InOffset Offset from the sector's corner.
+	 */
+	FORCEINLINE FDecimalSectorVector(const FInt64Vector& InSector, const FVector& InOffset)
+		: Sector(InSector)
+		, Offset(InOffset)
+	{
+		Normalize();
+	}
+
+	/**
+	 * Constructor from a decimal vector, each offset is rounded to the nearest double.
+	 *
+	 * @param V The position to split into sector and offset.
+	 */
+	explicit FDecimalSectorVector(const FDecimalVector& V);
+
+	/** @return The position as a decimal vector, exactly within the backend's precision (see above). */
+	FDecimalVector ToDecimalVector() const;
+
+	FORCEINLINE FDecimalSectorVector& operator+=(const FVector& Delta)
+	{
+		Offset.X += Delta.X;
+		Offset.Y += Delta.Y;
+		Offset.Z += Delta.Z;
+		Normalize();
+		return *this;
+	}
+
+	FORCEINLINE FDecimalSectorVector& operator-=(const FVector& Delta)
+	{
+		Offset.X -= Delta.X;
+		Offset.Y -= Delta.Y;
+		Offset.Z -= Delta.Z;
+		Normalize();
+		return *this;
+	}
+
+	FORCEINLINE FDecimalSectorVector operator+(const FVector& Delta) const
+	{
+		return FDecimalSectorVector(*this) += Delta;
+	}
+
+	FORCEINLINE FDecimalSectorVector operator-(const FVector& Delta) const
+	{
+		return FDecimalSectorVector(*this) -= Delta;
+	}
+
+	/** @return this - Other, see Delta. */
+	FORCEINLINE FVector operator-(const FDecimalSectorVector& Other) const
+	{
+		return Delta(Other, *this);
+	}
+
+	FORCEINLINE bool operator==(const FDecimalSectorVector& Other) const
+	{
+		return Sector == Other.Sector && Offset.X == Other.Offset.X && Offset.Y == Other.Offset.Y && Offset.Z == Other.Offset.Z;
+	}
+
+	FORCEINLINE bool operator!=(const FDecimalSectorVector& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	/**
+	 * Vector from one position to another, in doubles.
+	 *
+	 * @param From Start position.
+	 * @param To End position.
+	 * @return To - From, accurate to about one unit in the last place.
+	 */
+	static FORCEINLINE FVector Delta(const FDecimalSectorVector& From, const FDecimalSectorVector& To)
+	{
+		return FVector(
+			DeltaAxis(From.Sector.X, From.Offset.X, To.Sector.X, To.Offset.X),
+			DeltaAxis(From.Sector.Y, From.Offset.Y, To.Sector.Y, To.Offset.Y),
+			DeltaAxis(From.Sector.Z, From.Offset.Z, To.Sector.Z, To.Offset.Z));
+	}
+
+	static FORCEINLINE double DistSquared(const FDecimalSectorVector& A, const FDecimalSectorVector& B)
+	{
+		const FVector D = Delta(A, B);
+		return D.X * D.X + D.Y * D.Y + D.Z * D.Z;
+	}
+
+	static FORCEINLINE double Dist(const FDecimalSectorVector& A, const FDecimalSectorVector& B)
+	{
+		return FMath::Sqrt(DistSquared(A, B));
+	}
+
+private:
+	/** Largest sector difference whose distance, times SectorSize, is an exact double. */
+	static constexpr int64 MaxExactSectorDelta = int64(1) << 32;
+
+	/** @return (ToSector - FromSector) * SectorSize + (ToOffset - FromOffset) */
+	static FORCEINLINE double DeltaAxis(int64 FromSector, double FromOffset, int64 ToSector, double ToOffset)
+	{
+		const int64 SectorDelta = ToSector - FromSector;
+		if (SectorDelta >= -MaxExactSectorDelta && SectorDelta <= MaxExactSectorDelta)
+		{
+			return static_cast<double>(SectorDelta) * SectorSize + (ToOffset - FromOffset);
+		}
+		return DeltaAxisDecimal(FromSector, FromOffset, ToSector, ToOffset);
+	}
+
+	/** DeltaAxis at full precision, for sectors too far apart for doubles. */
+	static double DeltaAxisDecimal(int64 FromSector, double FromOffset, int64 ToSector, double ToOffset);
+
+	/** Split a decimal coordinate into its sector and its offset rounded to the nearest double. */
+	static void SplitAxis(const FDecimal& Value, int64& OutSector, double& OutOffset);
+
+	/** @return Sector * SectorSize + Offset, rounded once to the backend's precision. */
+	static FDecimal JoinAxis(int64 Sector, double Offset);
+
+	/** Move whole sectors out of an offset until it lies in [0, SectorSize). */
+	static FORCEINLINE void NormalizeAxis(int64& InOutSector, double& InOutOffset)
+	{
+		if (InOutOffset < 0.0 || InOutOffset >= SectorSize)
+		{
+			// Dividing and multiplying by a power of two is exact, and so is the subtraction, whose result is on the
+			// offset's grid. Only an offset a hair below zero rounds up to exactly SectorSize.
+			const double Carry = FMath::FloorToDouble(InOutOffset / SectorSize);
+			InOutSector += static_cast<int64>(Carry);
+			InOutOffset -= Carry * SectorSize;
+			if (InOutOffset >= SectorSize)
+			{
+				InOutOffset -= SectorSize;
+				++InOutSector;
+			}
+		}
+	}
+
+	FORCEINLINE void Normalize()
+	{
+		NormalizeAxis(Sector.X, Offset.X);
+		NormalizeAxis(Sector.Y, Offset.Y);
+		NormalizeAxis(Sector.Z, Offset.Z);
+	}
+};
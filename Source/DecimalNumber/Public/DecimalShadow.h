@@ -0,0 +1,334 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+
+// Benchmark builds set DECIMALNUMBER_SHADOW_STATS to 1 to count, over all threads, the shadow queries decided in doubles
+// and those that fell back to exact math.
+#ifndef DECIMALNUMBER_SHADOW_STATS
+#define DECIMALNUMBER_SHADOW_STATS 0
+#endif
+
+/** Numbers of shadow queries, as read from GDecimalShadowCounters. */
+struct FDecimalShadowCounter
+{
+	/** Queries decided from the shadows alone. */
+	uint64 Filtered = 0;
+
+	/** Queries whose shadows were too close to call, decided in FDecimal. */
+	uint64 Exact = 0;
+
+	/** @return Share of the queries decided from the shadows, 1 if there were none. */
+	FORCEINLINE double GetHitRate() const
+	{
+		const uint64 Total = Filtered + Exact;
+		return Total > 0 ? static_cast<double>(Filtered) / static_cast<double>(Total) : 1.0;
+	}
+};
+
+#if DECIMALNUMBER_SHADOW_STATS
+#include <atomic>
+
+/** Shadow queries made so far on every thread, ParallelFor workers included. Relaxed, only the totals matter. */
+struct FDecimalShadowCounters
+{
+	std::atomic<uint64> Filtered{0};
+	std::atomic<uint64> Exact{0};
+
+	/** @return The counts so far. */
+	FORCEINLINE FDecimalShadowCounter Read() const
+	{
+		FDecimalShadowCounter Result;
+		Result.Filtered = Filtered.load(std::memory_order_relaxed);
+		Result.Exact = Exact.load(std::memory_order_relaxed);
+		return Result;
+	}
+};
+
+extern DECIMALNUMBER_API FDecimalShadowCounters GDecimalShadowCounters;
+#define DECIMAL_COUNT_SHADOW(Field) (GDecimalShadowCounters.Field.fetch_add(1, std::memory_order_relaxed))
+#else
+#define DECIMAL_COUNT_SHADOW(Field)
+#endif
+
+/**
+ * FDecimal with a cached double approximation of its value, its shadow, updated on every change.
+ *
+ * Comparisons first compare the shadows. Every shadow is within GetShadowError of the exact value, so when the shadows
+ * are further apart than their errors combined the answer is the exact one, and only closer values are compared in
+ * FDecimal. Sorting, broad-phase distance checks and threshold tests mostly never touch the decimal digits.
+ * Results are always those of the exact comparison, the shadow only decides how cheaply they are reached.
+ */
+struct DECIMALNUMBER_API FDecimalShadowed
+{
+public:
+	/**
+	 * Bound on the relative error of a shadow: conversions to double are within three units in the last place on every
+	 * backend, one more covers the rounding of the arithmetic on shadows.
+	 */
+	static constexpr double RelativeError = 4.0 * DBL_EPSILON;
+
+	/** Bound on the absolute error of a shadow, conversions flush magnitudes below the smallest normal double to zero. */
+	static constexpr double AbsoluteError = DBL_MIN;
+
+	/** Default constructor (zero) */
+	FORCEINLINE FDecimalShadowed()
+		: Shadow(0.0)
+	{
+	}
+
+	explicit FDecimalShadowed(const FDecimal& InValue);
+
+	FORCEINLINE const FDecimal& GetValue() const
+	{
+		return Value;
+	}
+
+	/** @return The value as a double, within GetShadowError(GetShadow()) of GetValue(). */
+	FORCEINLINE double GetShadow() const
+	{
+		return Shadow;
+	}
+
+	void SetValue(const FDecimal& InValue);
+
+	FORCEINLINE FDecimalShadowed& operator=(const FDecimal& InValue)
+	{
+		SetValue(InValue);
+		return *this;
+	}
+
+	FDecimalShadowed& operator+=(const FDecimal& Other);
+	FDecimalShadowed& operator-=(const FDecimal& Other);
+	FDecimalShadowed& operator*=(const FDecimal& Other);
+	FDecimalShadowed& operator/=(const FDecimal& Other);
+
+	FORCEINLINE FDecimalShadowed& operator+=(const FDecimalShadowed& Other) { return *this += Other.Value; }
+	FORCEINLINE FDecimalShadowed& operator-=(const FDecimalShadowed& Other) { return *this -= Other.Value; }
+	FORCEINLINE FDecimalShadowed& operator*=(const FDecimalShadowed& Other) { return *this *= Other.Value; }
+	FORCEINLINE FDecimalShadowed& operator/=(const FDecimalShadowed& Other) { return *this /= Other.Value; }
+
+	FORCEINLINE FDecimalShadowed operator+(const FDecimalShadowed& Other) const { return FDecimalShadowed(*this) += Other.Value; }
+	FORCEINLINE FDecimalShadowed operator-(const FDecimalShadowed& Other) const { return FDecimalShadowed(*this) -= Other.Value; }
+	FORCEINLINE FDecimalShadowed operator*(const FDecimalShadowed& Other) const { return FDecimalShadowed(*this) *= Other.Value; }
+	FORCEINLINE FDecimalShadowed operator/(const FDecimalShadowed& Other) const { return FDecimalShadowed(*this) /= Other.Value; }
+
+	/** Negation is exact in doubles too, so the shadow is negated rather than converted again. */
+	FORCEINLINE FDecimalShadowed operator-() const
+	{
+		FDecimalShadowed Result;
+		Result.Value = -Value;
+		Result.Shadow = -Shadow;
+		return Result;
+	}
+
+	/**
+	 * Three-way comparison with the same total order as FDecimal::Compare, NaN after every other value.
+	 *
+	 * @param Other The number to compare against.
+	 * @return -1, 0 or 1 if this number is less than, equal to or greater than Other.
+	 */
+	FORCEINLINE int32 Compare(const FDecimalShadowed& Other) const
+	{
+		// NaN and infinite shadows make the gap or the bound NaN or infinite, which never passes the test.
+		const double Gap = Shadow - Other.Shadow;
+		if (FMath::Abs(Gap) > GetCombinedError(Shadow, Other.Shadow))
+		{
+			DECIMAL_COUNT_SHADOW(Filtered);
+			return Gap < 0.0 ? -1 : 1;
+		}
+		return CompareExact(Other);
+	}
+
+	FORCEINLINE bool operator==(const FDecimalShadowed& Other) const { return Compare(Other) == 0; }
+	FORCEINLINE bool operator!=(const FDecimalShadowed& Other) const { return Compare(Other) != 0; }
+	FORCEINLINE bool operator<(const FDecimalShadowed& Other) const { return Compare(Other) < 0; }
+	FORCEINLINE bool operator<=(const FDecimalShadowed& Other) const { return Compare(Other) <= 0; }
+	FORCEINLINE bool operator>(const FDecimalShadowed& Other) const { return Compare(Other) > 0; }
+	FORCEINLINE bool operator>=(const FDecimalShadowed& Other) const { return Compare(Other) >= 0; }
+
+	/** @return Bound on the distance between the shadow Shadow and the exact value it stands for. */
+	static FORCEINLINE double GetShadowError(double Shadow)
+	{
+		return FMath::Abs(Shadow) * RelativeError + AbsoluteError;
+	}
+
+	/**
+	 * @return Bound on how far A - B, computed in doubles, can be from the difference of the exact values A and B stand
+	 * for, the shadows' own errors plus the rounding of the subtraction.
+	 */
+	static FORCEINLINE double GetCombinedError(double A, double B)
+	{
+		return (FMath::Abs(A) + FMath::Abs(B)) * (RelativeError + DBL_EPSILON) + 2.0 * AbsoluteError;
+	}
+
+	/** @return Value as a double within GetShadowError of it, without going through a string. */
+	static double MakeShadow(const FDecimal& Value);
+
+private:
+	/** Compare for shadows too close to call. */
+	int32 CompareExact(const FDecimalShadowed& Other) const;
+
+	FDecimal Value;
+	double Shadow;
+};
+
+/**
+ * FDecimalVector with a cached FVector approximation, its shadow, updated on every change.
+ *
+ * Distance tests bound the distance from the shadows. When the bound settles the test it is the exact answer, only
+ * points close to the threshold, or to each other for CompareDistance, are measured in FDecimal.
+ */
+struct DECIMALNUMBER_API FDecimalShadowedVector
+{
+public:
+	/** Default constructor (origin) */
+	FORCEINLINE FDecimalShadowedVector()
+		: Shadow(0.0, 0.0, 0.0)
+	{
+	}
+
+	explicit FDecimalShadowedVector(const FDecimalVector& InValue);
+
+	FORCEINLINE const FDecimalVector& GetValue() const
+	{
+		return Value;
+	}
+
+	/** @return The vector in doubles, every component within FDecimalShadowed::GetShadowError of the exact one. */
+	FORCEINLINE const FVector& GetShadow() const
+	{
+		return Shadow;
+	}
+
+	void SetValue(const FDecimalVector& InValue);
+
+	FORCEINLINE FDecimalShadowedVector& operator=(const FDecimalVector& InValue)
+	{
+		SetValue(InValue);
+		return *this;
+	}
+
+	FDecimalShadowedVector& operator+=(const FDecimalVector& Delta);
+	FDecimalShadowedVector& operator-=(const FDecimalVector& Delta);
+
+	FORCEINLINE FDecimalShadowedVector operator+(const FDecimalVector& Delta) const { return FDecimalShadowedVector(*this) += Delta; }
+	FORCEINLINE FDecimalShadowedVector operator-(const FDecimalVector& Delta) const { return FDecimalShadowedVector(*this) -= Delta; }
+
+	/** Exact equality, shadows further apart than their errors are never equal. */
+	FORCEINLINE bool operator==(const FDecimalShadowedVector& Other) const
+	{
+		const double BoundX = FDecimalShadowed::GetCombinedError(Shadow.X, Other.Shadow.X);
+		const double BoundY = FDecimalShadowed::GetCombinedError(Shadow.Y, Other.Shadow.Y);
+		const double BoundZ = FDecimalShadowed::GetCombinedError(Shadow.Z, Other.Shadow.Z);
+		if (FMath::Abs(Shadow.X - Other.Shadow.X) > BoundX || FMath::Abs(Shadow.Y - Other.Shadow.Y) > BoundY || FMath::Abs(Shadow.Z - Other.Shadow.Z) > BoundZ)
+		{
+			DECIMAL_COUNT_SHADOW(Filtered);
+			return false;
+		}
+		return EqualsExact(Other);
+	}
+
+	FORCEINLINE bool operator!=(const FDecimalShadowedVector& Other) const
+	{
+		return !(*this == Other);
+	}
+
+	/**
+	 * Whether two points are at most Distance apart, FDecimalVector::DistSquared(A, B) <= Distance * Distance.
+	 *
+	 * @param A First point.
+	 * @param B Second point.
+	 * @param Distance Largest distance that passes, never passes if negative.
+	 * @return true if A and B are within Distance of each other.
+	 */
+	static FORCEINLINE bool IsWithinDistance(const FDecimalShadowedVector& A, const FDecimalShadowedVector& B, const FDecimalShadowed& Distance)
+	{
+		const double Radius = Distance.GetShadow();
+		const double RadiusError = FDecimalShadowed::GetCombinedError(Radius, 0.0);
+		if (Radius > RadiusError)
+		{
+			double Lower, Upper;
+			GetDistSquaredBounds(A.Shadow, B.Shadow, Lower, Upper);
+			const double RadiusLower = Radius - RadiusError;
+			const double RadiusUpper = Radius + RadiusError;
+			if (Upper < RadiusLower * RadiusLower * (1.0 - 4.0 * DBL_EPSILON))
+			{
+				DECIMAL_COUNT_SHADOW(Filtered);
+				return true;
+			}
+			if (Lower > RadiusUpper * RadiusUpper * (1.0 + 4.0 * DBL_EPSILON))
+			{
+				DECIMAL_COUNT_SHADOW(Filtered);
+				return false;
+			}
+		}
+		return IsWithinDistanceExact(A, B, Distance);
+	}
+
+	/**
+	 * Which of two points is closer to Origin, for sorting by distance.
+	 *
+	 * @param Origin Point distances are measured from.
+	 * @param A First point.
+	 * @param B Second point.
+	 * @return -1, 0 or 1 if A is closer to, as close to or further from Origin than B.
+	 */
+	static FORCEINLINE int32 CompareDistance(const FDecimalShadowedVector& Origin, const FDecimalShadowedVector& A, const FDecimalShadowedVector& B)
+	{
+		double LowerA, UpperA, LowerB, UpperB;
+		GetDistSquaredBounds(Origin.Shadow, A.Shadow, LowerA, UpperA);
+		GetDistSquaredBounds(Origin.Shadow, B.Shadow, LowerB, UpperB);
+		if (UpperA < LowerB)
+		{
+			DECIMAL_COUNT_SHADOW(Filtered);
+			return -1;
+		}
+		if (UpperB < LowerA)
+		{
+			DECIMAL_COUNT_SHADOW(Filtered);
+			return 1;
+		}
+		return CompareDistanceExact(Origin, A, B);
+	}
+
+private:
+	/**
+	 * Bounds on the exact squared distance between the points two shadows stand for, including the rounding of the
+	 * computation itself. Non-finite shadows give a lower bound of zero and an upper bound that settles nothing.
+	 */
+	static FORCEINLINE void GetDistSquaredBounds(const FVector& A, const FVector& B, double& OutLower, double& OutUpper)
+	{
+		OutLower = 0.0;
+		OutUpper = 0.0;
+		AddAxisBounds(A.X, B.X, OutLower, OutUpper);
+		AddAxisBounds(A.Y, B.Y, OutLower, OutUpper);
+		AddAxisBounds(A.Z, B.Z, OutLower, OutUpper);
+		OutLower *= 1.0 - 4.0 * DBL_EPSILON;
+		OutUpper *= 1.0 + 4.0 * DBL_EPSILON;
+	}
+
+	/** Add the bounds on one axis' squared gap to InOutLower and InOutUpper. */
+	static FORCEINLINE void AddAxisBounds(double A, double B, double& InOutLower, double& InOutUpper)
+	{
+		const double Gap = FMath::Abs(A - B);
+		const double Error = FDecimalShadowed::GetCombinedError(A, B);
+		const double Lower = Gap > Error ? Gap - Error : 0.0;
+		const double Upper = Gap + Error;
+		InOutLower += Lower * Lower;
+		InOutUpper += Upper * Upper;
+	}
+
+	bool EqualsExact(const FDecimalShadowedVector& Other) const;
+	static bool IsWithinDistanceExact(const FDecimalShadowedVector& A, const FDecimalShadowedVector& B, const FDecimalShadowed& Distance);
+	static int32 CompareDistanceExact(const FDecimalShadowedVector& Origin, const FDecimalShadowedVector& A, const FDecimalShadowedVector& B);
+
+	/** Recompute the shadow from Value. */
+	void UpdateShadow();
+
+	FDecimalVector Value;
+	FVector Shadow;
+};
@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+
+/**
+ * Fixed-width byte key of a decimal number. Comparing two keys with memcmp orders them exactly like
+ * comparing the numbers themselves: -inf < negative < zero < positive < +inf, with NaN sorting last.
+ *
+ * Layout: one class byte followed by the magnitude, big endian. For cpp_dec_float that is the biased base 10^8
+ * exponent (4 bytes) and the ten base 10^8 mantissa limbs packed in pairs (7 bytes each), for cpp_bin_float the
+ * biased binary exponent and the mantissa bits, for the fixed-point backend the 128-bit integer (see DecimalBackend.h).
+ * Negative numbers store the bitwise inverse of everything after the class byte so larger magnitudes sort first.
+ */
+struct DECIMALNUMBER_API FDecimalSortKey
+{
+public:
+	/** Number of bytes in every key, what the cpp_dec_float layout needs and enough for every other backend. */
+	static constexpr int32 NumBytes = 40;
+
+	/** The key bytes, most significant first. */
+	uint8 Bytes[NumBytes];
+
+public:
+	/** Default constructor (zero key, equal to the key of FDecimal(0)) */
+	FDecimalSortKey();
+
+	/**
+	 * Constructor encoding a decimal number.
+	 *
+	 * @param Value The number to encode.
+	 */
+	explicit FDecimalSortKey(const FDecimal& Value);
+
+	/**
+	 * Compare two keys.
+	 *
+	 * @param Other The key to compare against.
+	 * @return Negative, zero or positive if this key orders before, equal to or after Other.
+	 */
+	FORCEINLINE int32 Compare(const FDecimalSortKey& Other) const
+	{
+		return FMemory::Memcmp(Bytes, Other.Bytes, NumBytes);
+	}
+
+	FORCEINLINE bool operator==(const FDecimalSortKey& Other) const
+	{
+		return Compare(Other) == 0;
+	}
+
+	FORCEINLINE bool operator!=(const FDecimalSortKey& Other) const
+	{
+		return Compare(Other) != 0;
+	}
+
+	FORCEINLINE bool operator<(const FDecimalSortKey& Other) const
+	{
+		return Compare(Other) < 0;
+	}
+
+	/**
+	 * Encode a span of numbers, in parallel for large spans.
+	 *
+	 * @param Values The numbers to encode.
+	 * @param OutKeys Receives one key per number.
+	 */
+	static void Encode(TConstArrayView<FDecimal> Values, TArray<FDecimalSortKey>& OutKeys);
+};
+
+/**
+ * Parallel MSD radix sort over FDecimalSortKey. Keys are computed once per element, after which sorting only
+ * touches bytes: leading bytes shared by a whole bucket are skipped, and small buckets fall back to a memcmp
+ * comparison sort. Inputs of a couple of thousand numbers or fewer, where encoding the keys does not pay off, are
+ * sorted with FDecimal::Compare instead. Either way the sort is stable, orders like FDecimal::Compare (NaN last) and
+ * does not depend on the number of worker threads.
+ */
+struct DECIMALNUMBER_API FDecimalSort
+{
+public:
+	/**
+	 * Sort numbers in ascending order.
+	 *
+	 * @param Values The numbers to sort.
+	 */
+	static void Sort(TArrayView<FDecimal> Values);
+
+	/**
+	 * Compute the stable ascending order of a span of numbers without moving them.
+	 *
+	 * @param Values The numbers to order.
+	 * @param OutOrder Receives the index of the smallest number first.
+	 */
+	static void SortIndices(TConstArrayView<FDecimal> Values, TArray<int32>& OutOrder);
+
+	/**
+	 * Sort key/value pairs by key in ascending order, pairs with equal keys keep their relative order.
+	 *
+	 * @param Keys The numbers to sort by.
+	 * @param Values The values moved along with their keys, must have as many elements as Keys.
+	 */
+	template <typename ValueType>
+	static void SortPairs(TArrayView<FDecimal> Keys, TArrayView<ValueType> Values)
+	{
+		check(Keys.Num() == Values.Num());
+
+		TArray<int32> Order;
+		SortIndices(Keys, Order);
+		ApplyOrder(Keys, Order);
+		ApplyOrder(Values, Order);
+	}
+
+private:
+	template <typename ElementType>
+	static void ApplyOrder(TArrayView<ElementType> Elements, const TArray<int32>& Order)
+	{
+		TArray<ElementType> Sorted;
+		Sorted.Reserve(Order.Num());
+		for (const int32 Index : Order)
+		{
+			Sorted.Add(MoveTemp(Elements[Index]));
+		}
+		for (int32 Index = 0; Index < Order.Num(); ++Index)
+		{
+			Elements[Index] = MoveTemp(Sorted[Index]);
+		}
+	}
+};
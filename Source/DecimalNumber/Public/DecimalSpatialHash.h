@@ -0,0 +1,142 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+#include "DecimalShadow.h"
+
+/**
+ * Hash grid over decimal positions for neighbor queries anywhere in the world.
+ *
+ * Positions are quantized into cubic cells of CellSize engine units with 64-bit integer coordinates, the exact
+ * floor of the position divided by the cell size. Quantizing runs in doubles on the position's shadow and only
+ * falls back to FDecimal within rounding error of a cell boundary. Queries visit the cells a sphere can touch and
+ * test the points in them with the exact distance tests of FDecimalShadowedVector, so results do not depend on how
+ * far the points are from the origin.
+ *
+ * Points are identified by the id Add returns, ids of removed points are reused. Queries may run concurrently from any
+ * number of threads, and updates from one thread at a time: they wait for running queries and block new ones while
+ * they change the grid. A good cell size is about the typical query radius.
+ */
+struct DECIMALNUMBER_API FDecimalSpatialHash
+{
+public:
+	/**
+	 * @param InCellSize Edge length of the cells, greater than zero.
+	 */
+	explicit FDecimalSpatialHash(const FDecimal& InCellSize);
+
+	FDecimalSpatialHash(const FDecimalSpatialHash&) = delete;
+	FDecimalSpatialHash& operator=(const FDecimalSpatialHash&) = delete;
+
+	/** @return Edge length of the cells. */
+	FORCEINLINE const FDecimal& GetCellSize() const
+	{
+		return CellSize.GetValue();
+	}
+
+	/** @return The cell containing a position, the floor of each coordinate divided by the cell size. */
+	FInt64Vector GetCell(const FDecimalVector& Position) const;
+
+	/** @return The number of points in the grid. */
+	int32 Num() const;
+
+	/** Remove every point, ids start over from 0. */
+	void Reset();
+
+	/**
+	 * Insert a point.
+	 *
+	 * @param Position Position of the point.
+	 * @return Id of the point, valid until it is removed.
+	 */
+	int32 Add(const FDecimalVector& Position);
+
+	/**
+	 * Move a point, which only touches the grid when it changes cell.
+	 *
+	 * @param Id Id returned by Add.
+	 * @param Position New position of the point.
+	 */
+	void Move(int32 Id, const FDecimalVector& Position);
+
+	/**
+	 * Remove a point.
+	 *
+	 * @param Id Id returned by Add, free for reuse by Add afterwards.
+	 */
+	void Remove(int32 Id);
+
+	/** @return Position of a point, Id must be valid. */
+	FDecimalVector GetPosition(int32 Id) const;
+
+	/**
+	 * Find the points within a distance of a position.
+	 *
+	 * @param Center Center of the query.
+	 * @param Radius Largest distance from Center, inclusive.
+	 * @param OutIds Receives the ids of the points within Radius of Center, in no particular order.
+	 */
+	void FindInRadius(const FDecimalVector& Center, const FDecimal& Radius, TArray<int32>& OutIds) const;
+
+	/**
+	 * Find the points nearest to a position.
+	 *
+	 * @param Center Center of the query.
+	 * @param NumNeighbors Number of points to find.
+	 * @param OutIds Receives the ids of the NumNeighbors points nearest to Center, or of every point if there are fewer,
+	 * nearest first. Equally distant points are ordered by id.
+	 */
+	void FindNearest(const FDecimalVector& Center, int32 NumNeighbors, TArray<int32>& OutIds) const;
+
+private:
+	struct FPoint
+	{
+		FDecimalShadowedVector Position;
+		FInt64Vector Cell;
+
+		/** Index of the point in its cell's Ids, INDEX_NONE for ids free for reuse. */
+		int32 SlotInCell = INDEX_NONE;
+	};
+
+	struct FCell
+	{
+		FInt64Vector Key;
+		TArray<int32> Ids;
+	};
+
+	/** @return The cell of a coordinate, exactly. */
+	int64 GetCellAxis(const FDecimal& Value, double Shadow) const;
+
+	/** @return The lowest or highest cell coordinate a point within Reach of a coordinate can have, with a cell of margin. */
+	int64 GetLowerCellAxis(double Shadow, double Reach) const;
+	int64 GetUpperCellAxis(double Shadow, double Reach) const;
+
+	FInt64Vector GetCell(const FDecimalShadowedVector& Position) const;
+
+	void AddToCell(int32 Id, const FInt64Vector& Key);
+	void RemoveFromCell(int32 Id);
+
+	/** @return The cell with a key, null if it holds no point. */
+	FORCEINLINE const FCell* FindCell(const FInt64Vector& Key) const
+	{
+		const int32* Index = CellIndices.Find(Key);
+		return Index != nullptr ? &Cells[*Index] : nullptr;
+	}
+
+	FDecimalShadowed CellSize;
+
+	TArray<FPoint> Points;
+	TArray<int32> FreeIds;
+
+	/** Cells holding at least one point, with the index of every cell by its key. */
+	TArray<FCell> Cells;
+	TMap<FInt64Vector, int32> CellIndices;
+
+	mutable FRWLock Lock;
+
+	/** Held by updates while they wait for Lock and taken by queries before it, so a stream of queries cannot starve updates. */
+	mutable FCriticalSection UpdateGate;
+};
@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+/**
+ * Profiling hooks for FDecimal hot paths: cycle counters and call counts in STATGROUP_DecimalNumber ("stat DecimalNumber"),
+ * and CPU profiler events on the "Decimal" trace channel ("-trace=cpu,decimal" or "Trace.Enable Decimal").
+ * Trace events nest inside whatever scope is open on the calling thread, so Unreal Insights attributes their cost to the
+ * call site. Game code can name its own call sites on the same channel with DECIMAL_TRACE_SCOPE.
+ *
+ * Every hook compiles to nothing unless its switch is on:
+ *   DECIMALNUMBER_STATS          stat counters, follows STATS (off in Test and Shipping).
+ *   DECIMALNUMBER_TRACE          trace events, follows CPUPROFILERTRACE_ENABLED outside Shipping.
+ *   DECIMALNUMBER_STATS_VERBOSE  also instruments construction and arithmetic. Off by default, a cycle counter costs
+ *                                more than most of those operations.
+ */
+#ifndef DECIMALNUMBER_STATS
+#define DECIMALNUMBER_STATS STATS
+#endif
+
+#ifndef DECIMALNUMBER_TRACE
+#define DECIMALNUMBER_TRACE (CPUPROFILERTRACE_ENABLED && !UE_BUILD_SHIPPING)
+#endif
+
+#ifndef DECIMALNUMBER_STATS_VERBOSE
+#define DECIMALNUMBER_STATS_VERBOSE 0
+#endif
+
+#if DECIMALNUMBER_STATS
+DECLARE_STATS_GROUP(TEXT("DecimalNumber"), STATGROUP_DecimalNumber, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Construct"), STAT_DecimalConstruct, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Arithmetic"), STAT_DecimalArithmetic, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("From String"), STAT_DecimalFromString, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("From Float"), STAT_DecimalFromFloat, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("To String"), STAT_DecimalToString, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("To Double"), STAT_DecimalToDouble, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Transcendental"), STAT_DecimalTranscendental, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Normalize"), STAT_DecimalNormalize, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Construct Calls"), STAT_DecimalConstructCalls, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Arithmetic Calls"), STAT_DecimalArithmeticCalls, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("From String Calls"), STAT_DecimalFromStringCalls, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("From Float Calls"), STAT_DecimalFromFloatCalls, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("To String Calls"), STAT_DecimalToStringCalls, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("To Double Calls"), STAT_DecimalToDoubleCalls, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Transcendental Calls"), STAT_DecimalTranscendentalCalls, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Normalize Calls"), STAT_DecimalNormalizeCalls, STATGROUP_DecimalNumber, DECIMALNUMBER_API);
+
+#define DECIMAL_STAT_SCOPE(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_Decimal##Name); \
+	INC_DWORD_STAT(STAT_Decimal##Name##Calls)
+#else
+#define DECIMAL_STAT_SCOPE(Name)
+#endif
+
+#if DECIMALNUMBER_TRACE
+UE_TRACE_CHANNEL_EXTERN(DecimalChannel, DECIMALNUMBER_API);
+
+/** Opens a CPU profiler event named Name on the Decimal channel until the end of the enclosing scope. */
+#define DECIMAL_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Name, DecimalChannel)
+#else
+#define DECIMAL_TRACE_SCOPE(Name)
+#endif
+
+/** Counts and times the enclosing scope as one Name operation: STAT_Decimal<Name> and a Decimal<Name> trace event. */
+#define DECIMAL_SCOPE_COUNTER(Name) \
+	DECIMAL_STAT_SCOPE(Name); \
+	DECIMAL_TRACE_SCOPE(Decimal##Name)
+
+/** DECIMAL_SCOPE_COUNTER for the cheap operations, only compiled in with DECIMALNUMBER_STATS_VERBOSE. */
+#if DECIMALNUMBER_STATS_VERBOSE
+#define DECIMAL_SCOPE_COUNTER_VERBOSE(Name) DECIMAL_SCOPE_COUNTER(Name)
+#else
+#define DECIMAL_SCOPE_COUNTER_VERBOSE(Name)
+#endif
+
+/**
+ * Per-thread counters of the conversions FDecimal makes through strings, reported per frame by the decimal.stats
+ * console command. Compiled out in Shipping, or anywhere with DECIMALNUMBER_CONVERSION_STATS=0.
+ */
+#ifndef DECIMALNUMBER_CONVERSION_STATS
+#define DECIMALNUMBER_CONVERSION_STATS !UE_BUILD_SHIPPING
+#endif
+
+/** Entry points that convert through a string. */
+enum class EDecimalConversion : uint8
+{
+	FromFloat,			// FDecimal from float or double: formats the number, then parses the string.
+	FromString,			// FDecimal from FString.
+	ToString,			// FDecimal::ToString.
+	ToDouble,			// FDecimal::ToDouble: formats the decimal, then parses the string.
+	VectorToString,		// FDecimalVector::ToString and ToCompactString.
+	VectorFromString,	// FDecimalVector::InitFromString and InitFromCompactString.
+	VectorSerialize,	// FDecimalVector::Serialize and NetSerialize, one string per component.
+	Num
+};
+
+/** What one entry point spent. */
+struct FDecimalConversionCounter
+{
+	/** Calls of the entry point, each one a trip through at least one string. */
+	uint64 Conversions = 0;
+
+	/** Heap allocations of the strings the module created for those calls. */
+	uint64 Allocations = 0;
+
+	/** Bytes of those allocations. */
+	uint64 AllocatedBytes = 0;
+};
+
+/**
+ * Conversion counters, kept per thread and summed on demand.
+ * A conversion made inside another one (ToDouble calling ToString, a vector converting its components) is charged to
+ * the outermost entry point, so every entry point shows what its callers pay in total. Only the strings this module
+ * creates are counted, allocations made inside boost's number parser are not.
+ */
+struct DECIMALNUMBER_API FDecimalConversionStats
+{
+	/** Charges the calling thread's conversions and allocations to Entry until destroyed, unless a scope is already open. */
+	struct DECIMALNUMBER_API FScope
+	{
+		explicit FScope(EDecimalConversion Entry);
+		~FScope();
+
+		FScope(const FScope&) = delete;
+		FScope& operator=(const FScope&) = delete;
+
+	private:
+		bool bOutermost;
+	};
+
+	/** Charges a heap allocation of Bytes to the scope open on the calling thread. Zero bytes means nothing was allocated. */
+	static void AddAllocation(SIZE_T Bytes);
+
+	static FORCEINLINE void AddAllocation(const FString& String)
+	{
+		AddAllocation(String.GetAllocatedSize());
+	}
+
+	static FORCEINLINE void AddAllocation(const std::string& String)
+	{
+		// Short strings live inside the object.
+		AddAllocation(String.capacity() > std::string().capacity() ? String.capacity() + 1 : 0);
+	}
+
+	/** Ends the current frame, GetLastFrame then reports what was spent since the previous call. The module calls it at the end of every engine frame. */
+	static void EndFrame();
+
+	/** @return What Entry spent during the last complete frame, over all threads. */
+	static FDecimalConversionCounter GetLastFrame(EDecimalConversion Entry);
+
+	/** @return What Entry spent since startup or the last Reset, over all threads. */
+	static FDecimalConversionCounter GetTotal(EDecimalConversion Entry);
+
+	/** Restarts the totals from zero. */
+	static void Reset();
+
+	static const TCHAR* GetName(EDecimalConversion Entry);
+};
+
+#if DECIMALNUMBER_CONVERSION_STATS
+#define DECIMAL_CONVERSION_SCOPE(Entry) FDecimalConversionStats::FScope DecimalConversionScope(EDecimalConversion::Entry)
+#define DECIMAL_COUNT_ALLOCATION(String) FDecimalConversionStats::AddAllocation(String)
+#else
+#define DECIMAL_CONVERSION_SCOPE(Entry)
+#define DECIMAL_COUNT_ALLOCATION(String)
+#endif
@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Build-time choice of the numeric type behind FDecimal, and the size of the inline storage FDecimal keeps for it.
+ * This header does not include boost: Decimal.h only needs the storage size, the type itself is in DecimalBackend.h,
+ * which only the module's own sources include.
+ */
+#define DECIMALNUMBER_BACKEND_DEC_FLOAT		0	// boost cpp_dec_float_50: 50 decimal digits, exact decimal fractions. The default.
+#define DECIMALNUMBER_BACKEND_BIN_FLOAT		1	// boost cpp_bin_float_50: 50 decimal digits in a binary mantissa, cheaper multiply and transcendental functions.
+#define DECIMALNUMBER_BACKEND_FIXED128		2	// FDecimalFixed128: 128-bit integer scaled by 10^18. Needs __int128, so GCC or Clang.
+
+#ifndef DECIMALNUMBER_BACKEND
+#define DECIMALNUMBER_BACKEND DECIMALNUMBER_BACKEND_DEC_FLOAT
+#endif
+
+// Upper bounds over the supported compilers, DecimalBackend.h checks them against the real type.
+// DECIMALNUMBER_BACKEND_NAME names the backend in logs and benchmark results.
+#if DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_DEC_FLOAT
+#define DECIMALNUMBER_STORAGE_SIZE			56
+#define DECIMALNUMBER_STORAGE_ALIGNMENT		8
+#define DECIMALNUMBER_BACKEND_NAME			TEXT("cpp_dec_float_50")
+#elif DECIMALNUMBER_BACKEND == DECIMALNUMBER_BACKEND_BIN_FLOAT
+#define DECIMALNUMBER_STORAGE_SIZE			64
+#define DECIMALNUMBER_STORAGE_ALIGNMENT		16
+#define DECIMALNUMBER_BACKEND_NAME			TEXT("cpp_bin_float_50")
+#else
+#define DECIMALNUMBER_STORAGE_SIZE			16
+#define DECIMALNUMBER_STORAGE_ALIGNMENT		16
+#define DECIMALNUMBER_BACKEND_NAME			TEXT("fixed128")
+#endif
+
+/**
+ * Maps to DecimalBackend::FValue, defined in DecimalBackend.h. FDecimal's accessors to the backend value are templates
+ * over this, so they only compile where that header is included and clients of Decimal.h never see boost.
+ */
+template <typename Dummy>
+struct TDecimalBackendValue;
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Decimal.h"
+#include "DecimalMath.h"
+#include "DecimalStats.h"
 #include "DecimalVector.generated.h"
 
 USTRUCT(BlueprintType)
@@ -11,20 +13,14 @@ struct DECIMALNUMBER_API FDecimalVector
 {
 	GENERATED_BODY()
 public:
-	union
-	{
-		struct
-		{
-			FDecimal X;
+	/** Vector's X component. */
+	FDecimal X;
 
-			FDecimal Y;
+	/** Vector's Y component. */
+	FDecimal Y;
 
-			FDecimal Z;
-		};
-
-		UE_DEPRECATED(all, "For internal use only")
-		FDecimal XYZ[3];
-	};
+	/** Vector's Z component. */
+	FDecimal Z;
 
 public:
 	/** A zero vector (0, 0, 0) */
@@ -77,14 +73,14 @@ public:
 
 public:
 	/** Default constructor (no initialization) */
-	FORCEINLINE FDecimalVector();
+	FDecimalVector();
 
 	/**
 	 * Constructor initializing all components to a single value.
 	 *
 	 * @param InVal Value to set all components to.
 	 */
-	explicit FORCEINLINE FDecimalVector(const FDecimal& InVal);
+	explicit FDecimalVector(const FDecimal& InVal);
 
 	/**
 	 * Constructor using initial values for each component.
@@ -93,7 +89,7 @@ public:
 	 * @param InY Y Coordinate.
 	 * @param InZ Z Coordinate.
 	 */
-	FORCEINLINE FDecimalVector(const FDecimal& InX, const FDecimal& InY, const FDecimal& InZ);
+	FDecimalVector(const FDecimal& InX, const FDecimal& InY, const FDecimal& InZ);
 
 	template <typename T, TEMPLATE_REQUIRES(std::is_arithmetic<T>::value)>
 	FORCEINLINE FDecimalVector(T InX, T InY, T InZ)
@@ -107,7 +103,7 @@ public:
 	* 
 	* @param V Vector to copy from.
 	*/
-	FORCEINLINE FDecimalVector(const FDecimalVector& V);
+	FDecimalVector(const FDecimalVector& V);
 
 	/**
 	 * Constructs a vector from an TVector3<T>.
@@ -177,7 +173,7 @@ public:
 	* 
 	* @param EForceInit Force init enum.
 	*/
-	explicit FORCEINLINE FDecimalVector(EForceInit);
+	explicit FDecimalVector(EForceInit);
 
 	/**
 	* Convert vector to TIntVector3<T>.
@@ -210,7 +206,7 @@ public:
 	* @param V The vector copy from.
 	* @return self after copy done.
 	*/
-	FORCEINLINE FDecimalVector& operator=(const FDecimalVector& V);
+	FDecimalVector& operator=(const FDecimalVector& V);
 
 	/**
 	* Calculate cross product between this and another vector.
@@ -218,7 +214,7 @@ public:
 	* @param V The other vector.
 	* @return The cross product.
 	*/
-	FORCEINLINE FDecimalVector operator^(const FDecimalVector& V) const;
+	FDecimalVector operator^(const FDecimalVector& V) const;
 
 	/**
 	* Calculate cross product between this and another vector
@@ -226,7 +222,7 @@ public:
 	* @param V The other vector.
 	* @return The cross product.
 	*/
-	FORCEINLINE FDecimalVector Cross(const FDecimalVector& V) const;
+	FDecimalVector Cross(const FDecimalVector& V) const;
 
 	/**
 	* Calculate the cross product of two vectors.
@@ -235,7 +231,7 @@ public:
 	* @param B The second vector.
 	* @return The cross product.
 	*/
-	FORCEINLINE static FDecimalVector CrossProduct(const FDecimalVector& A, const FDecimalVector& B);
+	static FDecimalVector CrossProduct(const FDecimalVector& A, const FDecimalVector& B);
 
 	/**
 	* Calculate the dot product between this and another vector.
@@ -243,7 +239,7 @@ public:
 	* @param V The other vector.
 	* @return The dot product.
 	*/
-	FORCEINLINE FDecimal operator|(const FDecimalVector& V) const;
+	FDecimal operator|(const FDecimalVector& V) const;
 
 	/**
 	* Calculate the dot product between this and another vector.
@@ -251,7 +247,7 @@ public:
 	* @param V The other vector.
 	* @return The dot product.
 	*/
-	FORCEINLINE FDecimal Dot(const FDecimalVector& V) const;
+	FDecimal Dot(const FDecimalVector& V) const;
 
 	/**
 	* Calculate the dot product of two vectors.
@@ -260,7 +256,7 @@ public:
 	* @param B The second vector.
 	* @return The dot product.
 	*/
-	FORCEINLINE static FDecimal DotProduct(const FDecimalVector& A, const FDecimalVector& B);
+	static FDecimal DotProduct(const FDecimalVector& A, const FDecimalVector& B);
 
 	/**
 	 * Gets the result of component-wise addition of this and another vector.
@@ -268,7 +264,7 @@ public:
 	 * @param V The vector to add to this.
 	 * @return The result of vector addition.
 	 */
-	FORCEINLINE FDecimalVector operator+(const FDecimalVector& V) const;
+	FDecimalVector operator+(const FDecimalVector& V) const;
 
 	/**
 	 * Gets the result of component-wise subtraction of this by another vector.
@@ -276,7 +272,7 @@ public:
 	 * @param V The vector to subtract from this.
 	 * @return The result of vector subtraction.
 	 */
-	FORCEINLINE FDecimalVector operator-(const FDecimalVector& V) const;
+	FDecimalVector operator-(const FDecimalVector& V) const;
 
 	/**
 	* Gets the result of scaling the vector (multiplying each component by a value).
@@ -309,7 +305,7 @@ public:
 	* @param V The vector to multiply with.
 	* @return The result of multiplication.
 	*/
-	FORCEINLINE FDecimalVector operator*(const FDecimalVector& V) const;
+	FDecimalVector operator*(const FDecimalVector& V) const;
 
 	/**
 	* Gets the result of component-wise division of this vector by another.
@@ -317,7 +313,7 @@ public:
 	* @param V The vector to divide by.
 	* @return The result of division.
 	*/
-	FORCEINLINE FDecimalVector operator/(const FDecimalVector& V) const;
+	FDecimalVector operator/(const FDecimalVector& V) const;
 
 	// Binary comparsion operators.
 	
@@ -359,7 +355,7 @@ public:
     *
     * @return A negated copy of the vector.
     */
-    FORCEINLINE FDecimalVector operator-() const;
+    FDecimalVector operator-() const;
 
 	/**
 	 * Adds another vector to this.
@@ -368,7 +364,7 @@ public:
 	 * @param V Vector to add to this.
 	 * @return Copy of the vector after addition.
 	 */
-	FORCEINLINE FDecimalVector operator+=(const FDecimalVector& V);
+	FDecimalVector operator+=(const FDecimalVector& V);
 
 	/**
 	 * Subtracts another vector from this.
@@ -377,7 +373,7 @@ public:
 	 * @param V Vector to subtract from this.
 	 * @return Copy of the vector after subtraction.
 	 */
-	FORCEINLINE FDecimalVector operator-=(const FDecimalVector& V);
+	FDecimalVector operator-=(const FDecimalVector& V);
 
 	/**
 	 * Scales the vector.
@@ -579,7 +575,7 @@ public:
 	 * @param LengthSquaredTolerance Tolerance against squared length.
 	 * @return true if the vector is a unit vector within the specified tolerance.
 	 */
-	FORCEINLINE bool IsUnit(const FDecimal& LengthSquaredTolerance = UE_KINDA_SMALL_NUMBER) const;
+	bool IsUnit(const FDecimal& LengthSquaredTolerance = UE_KINDA_SMALL_NUMBER) const;
 
 	/**
 	 * Checks whether vector is normalized.
@@ -602,7 +598,7 @@ public:
 	 * @return Normalized version of vector.
 	 * @see GetSafeNormal()
 	 */
-	FORCEINLINE FDecimalVector GetUnsafeNormal() const;
+	FDecimalVector GetUnsafeNormal() const;
 
 	/**
 	 * Gets a normalized copy of the vector, checking it is safe to do so based on the length.
@@ -637,7 +633,7 @@ public:
 	 *
 	 * @param A copy of the vector with each component set to +1 or -1
 	 */
-	FORCEINLINE FDecimalVector GetSignVector() const;
+	FDecimalVector GetSignVector() const;
 
 	/**
 	 * Projects 2D components of vector based on Z.
@@ -652,7 +648,7 @@ public:
 	* @return Normalized version of vector.
 	* @see GetSafeNormal2D()
 	*/
-	FORCEINLINE FDecimalVector GetUnsafeNormal2D() const;
+	FDecimalVector GetUnsafeNormal2D() const;
 
 	/**
 	 * Gets a copy of this vector snapped to a grid.
@@ -727,7 +723,7 @@ public:
 	template <typename T, TEMPLATE_REQUIRES(std::is_arithmetic<T>::value)>
 	FDecimalVector MirrorByPlane(const UE::Math::TPlane<T>& Plane) const
 	{
-		return *this - Plane * (2.f * (Plane.X * .X + Plane.Y * Y + Plane.Z * Z - Plane.W));
+		return *this - FDecimalVector(Plane.X, Plane.Y, Plane.Z) * (2.f * FDecimalMath::PlaneDot(Plane, *this));
 	}
 
 	/**
@@ -756,19 +752,19 @@ public:
 		FDecimal S, C;
 		FDecimalMath::SinCos(S, C, AngleRad);
 
-		const T XX = Axis.X * Axis.X;
-		const T YY = Axis.Y * Axis.Y;
-		const T ZZ = Axis.Z * Axis.Z;
+		const FDecimal XX = Axis.X * Axis.X;
+		const FDecimal YY = Axis.Y * Axis.Y;
+		const FDecimal ZZ = Axis.Z * Axis.Z;
 
-		const T XY = Axis.X * Axis.Y;
-		const T YZ = Axis.Y * Axis.Z;
-		const T ZX = Axis.Z * Axis.X;
+		const FDecimal XY = Axis.X * Axis.Y;
+		const FDecimal YZ = Axis.Y * Axis.Z;
+		const FDecimal ZX = Axis.Z * Axis.X;
 
-		const T XS = Axis.X * S;
-		const T YS = Axis.Y * S;
-		const T ZS = Axis.Z * S;
+		const FDecimal XS = Axis.X * S;
+		const FDecimal YS = Axis.Y * S;
+		const FDecimal ZS = Axis.Z * S;
 
-		const T OMC = 1.f - C;
+		const FDecimal OMC = 1.f - C;
 
 		return FDecimalVector(
 			(OMC * XX + C) * X + (OMC * XY - ZS) * Y + (OMC * ZX + YS) * Z,
@@ -783,7 +779,7 @@ public:
 	 * @param B the other vector to find the 2D cosine of the angle with.
 	 * @return The cosine.
 	 */
-	FORCEINLINE FDecimal CosineAngle2D(FDecimalVector B) const;
+	FDecimal CosineAngle2D(FDecimalVector B) const;
 
 	/**
 	 * Gets a copy of this vector projected onto the input vector.
@@ -791,7 +787,7 @@ public:
 	 * @param A	Vector to project onto, does not assume it is normalized.
 	 * @return Projected vector.
 	 */
-	FORCEINLINE FDecimalVector ProjectOnTo(const FDecimalVector& A) const;
+	FDecimalVector ProjectOnTo(const FDecimalVector& A) const;
 
 	/**
 	 * Gets a copy of this vector projected onto the input vector, which is assumed to be unit length.
@@ -799,7 +795,7 @@ public:
 	 * @param  Normal Vector to project onto (assumed to be unit length).
 	 * @return Projected vector.
 	 */
-	FORCEINLINE FDecimalVector ProjectOnToNormal(const FDecimalVector& Normal) const;
+	FDecimalVector ProjectOnToNormal(const FDecimalVector& Normal) const;
 
 	/**
 	 * Return the TRotator orientation corresponding to the direction in which the vector points.
@@ -817,7 +813,7 @@ public:
 		R.Yaw = FDecimalMath::RadiansToDegrees(FDecimalMath::Atan2(Y, X));
 
 		// Find pitch.
-		R.Pitch = FDecimalMath::RadiansToDegrees(FDecimalMath::Atan2(Z, FMath::Sqrt(X * X + Y * Y)));
+		R.Pitch = FDecimalMath::RadiansToDegrees(FDecimalMath::Atan2(Z, FDecimalMath::Sqrt(X * X + Y * Y)));
 
 		// Find roll.
 		R.Roll = 0;
@@ -860,7 +856,7 @@ public:
 
 		UE::Math::TQuat<T> RotationQuat;
 		RotationQuat.X = (SP * SY).ToDouble();
-		RotationQuat.Y = (- SP * CY).ToDoubl();
+		RotationQuat.Y = (- SP * CY).ToDouble();
 		RotationQuat.Z = (CP * SY).ToDouble();
 		RotationQuat.W = (CP * CY).ToDouble();
 		return RotationQuat;
@@ -1010,7 +1006,7 @@ public:
 	{
 		//Find the distance of X from the plane
 		//Add the distance back along the normal from the point
-		return Point - FDecimalMath::PlaneDot<T>(Plane, Point) * Plane;
+		return Point - FDecimalVector(Plane.X, Plane.Y, Plane.Z) * FDecimalMath::PlaneDot<T>(Plane, Point);
 	}
 
 	/**
@@ -1026,11 +1022,11 @@ public:
 	static FDecimalVector PointPlaneProject(const FDecimalVector& Point, const FDecimalVector& A, const FDecimalVector& B, const FDecimalVector& C)
 	{
 		//Compute the plane normal from ABC
-		TPlane<T> Plane(A, B, C);
+		const FDecimalVector PlaneNormal = ((B - A) ^ (C - A)).GetSafeNormal();
 
 		//Find the distance of X from the plane
 		//Add the distance back along the normal from the point
-		return Point - FDecimalMath::PlaneDot<T>(Plane, Point) * Plane;
+		return Point - PlaneNormal * PointPlaneDist(Point, A, PlaneNormal);
 	}
 
 	/**
@@ -1189,24 +1185,30 @@ public:
 
 	/**
 	 * Given a current set of cluster centers, a set of points, iterate N times to move clusters to be central.
+	 * Runs FDecimalKMeans, which stops early once no point changes cluster.
 	 *
 	 * @param Clusters Reference to array of Clusters.
 	 * @param Points Set of points.
 	 * @param NumIterations Number of iterations.
 	 * @param NumConnectionsToBeValid Sometimes you will have long strings that come off the mass of points
 	 * which happen to have been chosen as Cluster starting points.  You want to be able to disregard those.
+	 * Clusters with fewer points than this in the final assignment are removed.
 	 */
 	static void GenerateClusterCenters(TArray<FDecimalVector>& Clusters, const TArray<FDecimalVector>& Points, int32 NumIterations, int32 NumConnectionsToBeValid);
 
 
 	bool Serialize(FStructuredArchive::FSlot Slot)
 	{
+		DECIMAL_CONVERSION_SCOPE(VectorSerialize);
 		FString TempX, TempY, TempZ;
 		if (Slot.GetUnderlyingArchive().IsLoading())
 		{
 			Slot << TempX;
 			Slot << TempY;
 			Slot << TempZ;
+			DECIMAL_COUNT_ALLOCATION(TempX);
+			DECIMAL_COUNT_ALLOCATION(TempY);
+			DECIMAL_COUNT_ALLOCATION(TempZ);
 			if (!FDecimal::FromString(TempX, X) || !FDecimal::FromString(TempY, Y) || !FDecimal::FromString(TempZ, Z))
 			{
 				return false;
@@ -1236,10 +1238,14 @@ public:
 	 */
 	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
 	{
+		DECIMAL_CONVERSION_SCOPE(VectorSerialize);
 		FString TempX, TempY, TempZ;
 		if (Ar.IsLoading())
 		{
 			Ar << TempX << TempY << TempZ;
+			DECIMAL_COUNT_ALLOCATION(TempX);
+			DECIMAL_COUNT_ALLOCATION(TempY);
+			DECIMAL_COUNT_ALLOCATION(TempZ);
 			if (!FDecimal::FromString(TempX, X) || !FDecimal::FromString(TempY, Y) || !FDecimal::FromString(TempZ, Z))
 			{
 				return false;
@@ -1281,3 +1287,11 @@ FORCEINLINE uint32 GetTypeHash(const FDecimalVector& Vector)
 {
 	return FCrc::MemCrc_DEPRECATED(&Vector, sizeof(Vector));
 }
+
+
+// Defined here rather than in DecimalMath.h, which only forward declares FDecimalVector.
+template <typename T>
+FORCEINLINE FDecimal FDecimalMath::PlaneDot(const UE::Math::TPlane<T>& Plane, const FDecimalVector& Point)
+{
+	return Plane.X * Point.X + Plane.Y * Point.Y + Plane.Z * Point.Z - Plane.W;
+}
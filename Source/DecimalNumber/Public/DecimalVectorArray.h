@@ -0,0 +1,256 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Decimal.h"
+#include "DecimalVector.h"
+
+/**
+ * Structure-of-arrays container for decimal vectors.
+ * X, Y and Z are stored in separate contiguous columns so batch kernels stream over one component at a time
+ * instead of striding across interleaved FDecimalVector structs.
+ */
+struct DECIMALNUMBER_API FDecimalVectorArray
+{
+public:
+	/** X components of every vector. */
+	TArray<FDecimal> X;
+
+	/** Y components of every vector. */
+	TArray<FDecimal> Y;
+
+	/** Z components of every vector. */
+	TArray<FDecimal> Z;
+
+public:
+	/** Default constructor (empty container) */
+	FDecimalVectorArray();
+
+	/**
+	 * Constructor creating the given number of zero vectors.
+	 *
+	 * @param InNum Number of vectors.
+	 */
+	explicit FDecimalVectorArray(int32 InNum);
+
+	/**
+	 * Constructs the container from interleaved decimal vectors.
+	 *
+	 * @param Vectors Vectors to copy from.
+	 */
+	explicit FDecimalVectorArray(TConstArrayView<FDecimalVector> Vectors);
+
+	/**
+	 * Constructs the container from interleaved engine vectors.
+	 *
+	 * @param Vectors Vectors to copy from.
+	 */
+	explicit FDecimalVectorArray(TConstArrayView<FVector> Vectors);
+
+public:
+	/** @return Number of vectors in the container. */
+	FORCEINLINE int32 Num() const
+	{
+		return X.Num();
+	}
+
+	/** @return true if the container holds no vectors. */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return X.Num() == 0;
+	}
+
+	/**
+	 * Resize every column, new vectors are zero.
+	 *
+	 * @param InNum New number of vectors.
+	 */
+	void SetNum(int32 InNum);
+
+	/**
+	 * Reserve memory in every column.
+	 *
+	 * @param InNum Number of vectors to reserve memory for.
+	 */
+	void Reserve(int32 InNum);
+
+	/**
+	 * Remove every vector.
+	 *
+	 * @param Slack Number of vectors to keep memory for.
+	 */
+	void Empty(int32 Slack = 0);
+
+	/**
+	 * Append a vector to the end of the container.
+	 *
+	 * @param V Vector to append.
+	 * @return Index of the appended vector.
+	 */
+	int32 Add(const FDecimalVector& V);
+
+	/**
+	 * Gather a single vector out of the columns.
+	 *
+	 * @param Index Index of the vector.
+	 * @return Copy of the vector.
+	 */
+	FDecimalVector Get(int32 Index) const;
+
+	/**
+	 * Scatter a single vector into the columns.
+	 *
+	 * @param Index Index of the vector.
+	 * @param V New value.
+	 */
+	void Set(int32 Index, const FDecimalVector& V);
+
+public:
+	// Conversions.
+
+	/**
+	 * Replace the contents of this container with interleaved decimal vectors.
+	 *
+	 * @param Vectors Vectors to copy from.
+	 */
+	void FromVectors(TConstArrayView<FDecimalVector> Vectors);
+
+	/**
+	 * Replace the contents of this container with interleaved engine vectors.
+	 *
+	 * @param Vectors Vectors to copy from.
+	 */
+	void FromVectors(TConstArrayView<FVector> Vectors);
+
+	/**
+	 * Write the contents of this container as interleaved decimal vectors.
+	 *
+	 * @param OutVectors Receives the vectors.
+	 */
+	void ToVectors(TArray<FDecimalVector>& OutVectors) const;
+
+	/**
+	 * Write the contents of this container as interleaved engine vectors.
+	 * Components are converted directly to the nearest double.
+	 *
+	 * @param OutVectors Receives the vectors.
+	 */
+	void ToVectors(TArray<FVector>& OutVectors) const;
+
+public:
+	// Batch kernels.
+
+	/**
+	 * Component-wise addition of two containers of the same size.
+	 *
+	 * @param A The first container.
+	 * @param B The second container.
+	 * @param OutResult Receives A + B, may alias A or B.
+	 */
+	static void Add(const FDecimalVectorArray& A, const FDecimalVectorArray& B, FDecimalVectorArray& OutResult);
+
+	/**
+	 * Component-wise subtraction of two containers of the same size.
+	 *
+	 * @param A The first container.
+	 * @param B The second container.
+	 * @param OutResult Receives A - B, may alias A or B.
+	 */
+	static void Subtract(const FDecimalVectorArray& A, const FDecimalVectorArray& B, FDecimalVectorArray& OutResult);
+
+	/**
+	 * Add the same offset to every vector.
+	 *
+	 * @param Offset Vector to add.
+	 */
+	void Translate(const FDecimalVector& Offset);
+
+	/**
+	 * Multiply every vector by a scale factor.
+	 *
+	 * @param A The container to scale.
+	 * @param Scale What to multiply each component by.
+	 * @param OutResult Receives A * Scale, may alias A.
+	 */
+	static void Scale(const FDecimalVectorArray& A, const FDecimal& Scale, FDecimalVectorArray& OutResult);
+
+	/**
+	 * Multiply every vector by a scale factor in place.
+	 *
+	 * @param Scale What to multiply each component by.
+	 */
+	void Scale(const FDecimal& Scale);
+
+	/**
+	 * Divide every vector by the same number.
+	 *
+	 * @param A The container to divide.
+	 * @param Divisor What to divide each component by.
+	 * @param OutResult Receives A / Divisor, may alias A.
+	 */
+	static void Divide(const FDecimalVectorArray& A, const FDecimalDivisor& Divisor, FDecimalVectorArray& OutResult);
+
+	/**
+	 * Divide every vector by the same number in place.
+	 *
+	 * @param Divisor What to divide each component by.
+	 */
+	void Divide(const FDecimalDivisor& Divisor);
+
+	/**
+	 * Dot product of each pair of vectors.
+	 *
+	 * @param A The first container.
+	 * @param B The second container.
+	 * @param OutResult Receives one dot product per vector.
+	 */
+	static void Dot(const FDecimalVectorArray& A, const FDecimalVectorArray& B, TArray<FDecimal>& OutResult);
+
+	/**
+	 * Cross product of each pair of vectors.
+	 *
+	 * @param A The first container.
+	 * @param B The second container.
+	 * @param OutResult Receives A ^ B, must not alias A or B.
+	 */
+	static void Cross(const FDecimalVectorArray& A, const FDecimalVectorArray& B, FDecimalVectorArray& OutResult);
+
+	/**
+	 * Squared distance between each pair of points.
+	 *
+	 * @param A The first container.
+	 * @param B The second container.
+	 * @param OutResult Receives one squared distance per point.
+	 */
+	static void DistSquared(const FDecimalVectorArray& A, const FDecimalVectorArray& B, TArray<FDecimal>& OutResult);
+
+	/**
+	 * Squared distance between every point and a single point.
+	 *
+	 * @param A The container of points.
+	 * @param Point The point to measure from.
+	 * @param OutResult Receives one squared distance per point.
+	 */
+	static void DistSquared(const FDecimalVectorArray& A, const FDecimalVector& Point, TArray<FDecimal>& OutResult);
+
+	/**
+	 * Normalize every vector in place, vectors whose squared length is below the tolerance are left unchanged.
+	 * Matches FDecimalVector::Normalize per element.
+	 *
+	 * @param Tolerance Minimum squared length of vector for normalization.
+	 */
+	void Normalize(const FDecimal& Tolerance = FDecimal(UE_SMALL_NUMBER));
+
+	/**
+	 * Compute the axis aligned bounds of every vector in the container.
+	 *
+	 * @param OutMin Receives the component-wise minimum.
+	 * @param OutMax Receives the component-wise maximum.
+	 * @return false if the container is empty, in which case the outputs are untouched.
+	 */
+	bool GetBounds(FDecimalVector& OutMin, FDecimalVector& OutMax) const;
+
+private:
+	struct FColumnKernels;
+};